@@ -324,6 +324,23 @@ napi_value CameraInputNapi::CreateCameraInput(napi_env env, std::string cameraId
     return result;
 }
 
+bool CameraInputNapi::IsCameraInput(napi_env env, napi_value obj)
+{
+    bool result = false;
+    napi_status status;
+    napi_value constructor = nullptr;
+
+    status = napi_get_reference_value(env, sConstructor_, &constructor);
+    if (status == napi_ok) {
+        status = napi_instanceof(env, obj, constructor, &result);
+        if (status != napi_ok) {
+            result = false;
+        }
+    }
+
+    return result;
+}
+
 sptr<CameraInput> CameraInputNapi::GetCameraInput()
 {
     return cameraInput_;
@@ -197,6 +197,8 @@ napi_value PhotoOutputNapi::Init(napi_env env, napi_value exports)
 
     napi_property_descriptor photo_output_props[] = {
         DECLARE_NAPI_FUNCTION("capture", Capture),
+        DECLARE_NAPI_FUNCTION("burstCapture", BurstCapture),
+        DECLARE_NAPI_FUNCTION("cancelCapture", CancelCapture),
         DECLARE_NAPI_FUNCTION("release", Release),
         DECLARE_NAPI_FUNCTION("isMirrorSupported", IsMirrorSupported),
         DECLARE_NAPI_FUNCTION("setMirror", SetMirror),
@@ -477,6 +479,31 @@ static napi_value ConvertJSArgsToNative(napi_env env, size_t argc, const napi_va
     return result;
 }
 
+static std::shared_ptr<PhotoCaptureSetting> GetPhotoCaptureSetting(PhotoOutputAsyncContext &context,
+                                                                  bool isMirrorEnabled)
+{
+    if (!context.hasPhotoSettings && !isMirrorEnabled) {
+        return nullptr;
+    }
+    std::shared_ptr<PhotoCaptureSetting> capSettings = make_shared<PhotoCaptureSetting>();
+    if (context.quality != -1) {
+        capSettings->SetQuality(static_cast<PhotoCaptureSetting::QualityLevel>(context.quality));
+    }
+
+    if (context.rotation != -1) {
+        capSettings->SetRotation(static_cast<PhotoCaptureSetting::RotationConfig>(context.rotation));
+    }
+
+    if (isMirrorEnabled) {
+        capSettings->SetMirror(isMirrorEnabled);
+    }
+
+    if (context.location != nullptr) {
+        capSettings->SetLocation(context.location);
+    }
+    return capSettings;
+}
+
 napi_value PhotoOutputNapi::Capture(napi_env env, napi_callback_info info)
 {
     napi_status status;
@@ -512,27 +539,8 @@ napi_value PhotoOutputNapi::Capture(napi_env env, napi_callback_info info)
                 context->status = true;
                 sptr<PhotoOutput> photoOutput = ((sptr<PhotoOutput> &)(context->objectInfo->photoOutput_));
                 int32_t ret;
-                if ((context->hasPhotoSettings) || (enableMirror)) {
-                    std::shared_ptr<PhotoCaptureSetting> capSettings = make_shared<PhotoCaptureSetting>();
-
-                    if (context->quality != -1) {
-                        capSettings->SetQuality(
-                            static_cast<PhotoCaptureSetting::QualityLevel>(context->quality));
-                    }
-
-                    if (context->rotation != -1) {
-                        capSettings->SetRotation(
-                            static_cast<PhotoCaptureSetting::RotationConfig>(context->rotation));
-                    }
-
-                    if (enableMirror) {
-                        capSettings->SetMirror(enableMirror);
-                    }
-
-                    if (context->location != nullptr) {
-                        capSettings->SetLocation(context->location);
-                    }
-
+                std::shared_ptr<PhotoCaptureSetting> capSettings = GetPhotoCaptureSetting(*context, enableMirror);
+                if (capSettings != nullptr) {
                     ret = photoOutput->Capture(capSettings);
                 } else {
                     ret = photoOutput->Capture();
@@ -554,6 +562,123 @@ napi_value PhotoOutputNapi::Capture(napi_env env, napi_callback_info info)
     return result;
 }
 
+napi_value PhotoOutputNapi::BurstCapture(napi_env env, napi_callback_info info)
+{
+    napi_status status;
+    napi_value result = nullptr;
+    size_t argc = ARGS_THREE;
+    napi_value argv[ARGS_THREE] = {0};
+    napi_value thisVar = nullptr;
+    napi_value resource = nullptr;
+    napi_valuetype valueType = napi_undefined;
+
+    CAMERA_NAPI_GET_JS_ARGS(env, info, argc, argv, thisVar);
+    NAPI_ASSERT(env, argc >= ARGS_ONE && argc <= ARGS_THREE, "requires 1 parameter minimum and 3 maximum");
+    napi_typeof(env, argv[PARAM0], &valueType);
+    NAPI_ASSERT(env, valueType == napi_number, "type mismatch");
+
+    napi_get_undefined(env, &result);
+    unique_ptr<PhotoOutputAsyncContext> asyncContext = make_unique<PhotoOutputAsyncContext>();
+    status = napi_unwrap(env, thisVar, reinterpret_cast<void**>(&asyncContext->objectInfo));
+    if (status == napi_ok && asyncContext->objectInfo != nullptr) {
+        napi_get_value_int32(env, argv[PARAM0], &asyncContext->frameCount);
+        if (argc > ARGS_ONE) {
+            result = ConvertJSArgsToNative(env, argc - ARGS_ONE, &argv[PARAM1], *asyncContext);
+            CAMERA_NAPI_CHECK_NULL_PTR_RETURN_UNDEFINED(env, result, result, "Failed to obtain arguments");
+        }
+        CAMERA_NAPI_CREATE_PROMISE(env, asyncContext->callbackRef, asyncContext->deferred, result);
+        CAMERA_NAPI_CREATE_RESOURCE_NAME(env, resource, "BurstCapture");
+        status = napi_create_async_work(
+            env, nullptr, resource, [](napi_env env, void* data) {
+                PhotoOutputAsyncContext* context = static_cast<PhotoOutputAsyncContext*>(data);
+                // Start async trace
+                context->funcName = "PhotoOutputNapi::BurstCapture";
+                context->taskId = CameraNapiUtils::IncreamentAndGet(photoOutputTaskId);
+                CAMERA_START_ASYNC_TRACE(context->funcName, context->taskId);
+                if (context->objectInfo == nullptr) {
+                    context->status = false;
+                    return;
+                }
+                context->bRetBool = false;
+                context->status = true;
+                sptr<PhotoOutput> photoOutput = ((sptr<PhotoOutput> &)(context->objectInfo->photoOutput_));
+                int32_t ret;
+                std::shared_ptr<PhotoCaptureSetting> capSettings = GetPhotoCaptureSetting(*context, enableMirror);
+                if (capSettings != nullptr) {
+                    ret = photoOutput->BurstCapture(capSettings, context->frameCount);
+                } else {
+                    ret = photoOutput->BurstCapture(context->frameCount);
+                }
+                if (ret != 0) {
+                    context->status = false;
+                    context->errorMsg = "Photo output burst capture failure";
+                }
+            }, CommonCompleteCallback, static_cast<void*>(asyncContext.get()), &asyncContext->work);
+        if (status != napi_ok) {
+            MEDIA_ERR_LOG("Failed to create napi_create_async_work for PhotoOutputNapi::BurstCapture");
+            napi_get_undefined(env, &result);
+        } else {
+            napi_queue_async_work(env, asyncContext->work);
+            asyncContext.release();
+        }
+    }
+
+    return result;
+}
+
+napi_value PhotoOutputNapi::CancelCapture(napi_env env, napi_callback_info info)
+{
+    napi_status status;
+    napi_value result = nullptr;
+    const int32_t refCount = 1;
+    napi_value resource = nullptr;
+    size_t argc = ARGS_ONE;
+    napi_value argv[ARGS_ONE] = {0};
+    napi_value thisVar = nullptr;
+
+    CAMERA_NAPI_GET_JS_ARGS(env, info, argc, argv, thisVar);
+    NAPI_ASSERT(env, argc <= ARGS_ONE, "requires 1 parameter maximum");
+
+    napi_get_undefined(env, &result);
+    std::unique_ptr<PhotoOutputAsyncContext> asyncContext = std::make_unique<PhotoOutputAsyncContext>();
+    status = napi_unwrap(env, thisVar, reinterpret_cast<void**>(&asyncContext->objectInfo));
+    if (status == napi_ok && asyncContext->objectInfo != nullptr) {
+        if (argc == ARGS_ONE) {
+            CAMERA_NAPI_GET_JS_ASYNC_CB_REF(env, argv[PARAM0], refCount, asyncContext->callbackRef);
+        }
+
+        CAMERA_NAPI_CREATE_PROMISE(env, asyncContext->callbackRef, asyncContext->deferred, result);
+        CAMERA_NAPI_CREATE_RESOURCE_NAME(env, resource, "CancelCapture");
+        status = napi_create_async_work(
+            env, nullptr, resource, [](napi_env env, void* data) {
+                auto context = static_cast<PhotoOutputAsyncContext*>(data);
+                context->status = false;
+                // Start async trace
+                context->funcName = "PhotoOutputNapi::CancelCapture";
+                context->taskId = CameraNapiUtils::IncreamentAndGet(photoOutputTaskId);
+                CAMERA_START_ASYNC_TRACE(context->funcName, context->taskId);
+                if (context->objectInfo != nullptr) {
+                    context->bRetBool = false;
+                    int32_t ret = ((sptr<PhotoOutput> &)(context->objectInfo->photoOutput_))->CancelCapture();
+                    context->status = (ret == 0);
+                    if (ret != 0) {
+                        context->errorMsg = "Photo output cancel capture failure";
+                    }
+                }
+            },
+            CommonCompleteCallback, static_cast<void*>(asyncContext.get()), &asyncContext->work);
+        if (status != napi_ok) {
+            MEDIA_ERR_LOG("Failed to create napi_create_async_work for PhotoOutputNapi::CancelCapture");
+            napi_get_undefined(env, &result);
+        } else {
+            napi_queue_async_work(env, asyncContext->work);
+            asyncContext.release();
+        }
+    }
+
+    return result;
+}
+
 napi_value PhotoOutputNapi::Release(napi_env env, napi_callback_info info)
 {
     napi_status status;
@@ -112,6 +112,8 @@ napi_value CameraSessionNapi::Init(napi_env env, napi_value exports)
     napi_property_descriptor camera_session_props[] = {
         DECLARE_NAPI_FUNCTION("beginConfig", BeginConfig),
         DECLARE_NAPI_FUNCTION("commitConfig", CommitConfig),
+        DECLARE_NAPI_FUNCTION("commitConfigAsync", CommitConfigAsync),
+        DECLARE_NAPI_FUNCTION("configureSession", ConfigureSession),
 
         DECLARE_NAPI_FUNCTION("addInput", AddInput),
         DECLARE_NAPI_FUNCTION("removeInput", RemoveInput),
@@ -418,6 +420,120 @@ napi_value CameraSessionNapi::CommitConfig(napi_env env, napi_callback_info info
     return result;
 }
 
+static void CommitConfigAsyncCallback(napi_env env, CameraSessionAsyncContext *context)
+{
+    napi_value retVal;
+    napi_value callback = nullptr;
+    std::unique_ptr<JSAsyncContextOutput> jsContext = std::make_unique<JSAsyncContextOutput>();
+
+    if (!context->status) {
+        CameraNapiUtils::CreateNapiErrorObject(env, context->errorMsg.c_str(), jsContext);
+    } else {
+        jsContext->status = true;
+        napi_get_undefined(env, &jsContext->error);
+        napi_create_int32(env, context->transactionId, &jsContext->data);
+    }
+    CAMERA_FINISH_ASYNC_TRACE(context->funcName, context->taskId);
+
+    if (context->deferred) {
+        if (jsContext->status) {
+            napi_resolve_deferred(env, context->deferred, jsContext->data);
+        } else {
+            napi_reject_deferred(env, context->deferred, jsContext->error);
+        }
+    } else {
+        napi_value result[ARGS_TWO] = {jsContext->error, jsContext->data};
+        napi_get_reference_value(env, context->callbackRef, &callback);
+        napi_call_function(env, nullptr, callback, ARGS_TWO, result, &retVal);
+        napi_delete_reference(env, context->callbackRef);
+    }
+    delete context;
+}
+
+static void CommitConfigAsyncCallbackAsync(CameraSessionAsyncContext *context)
+{
+    uv_loop_s *loop = nullptr;
+    napi_get_uv_event_loop(context->env, &loop);
+    // The context is owned here, it is freed even when the result can no longer reach JS
+    if (!loop) {
+        MEDIA_ERR_LOG("CommitConfigAsyncCallbackAsync() failed to get event loop");
+        delete context;
+        return;
+    }
+    uv_work_t *work = new(std::nothrow) uv_work_t;
+    if (!work) {
+        MEDIA_ERR_LOG("CommitConfigAsyncCallbackAsync() failed to allocate work");
+        delete context;
+        return;
+    }
+    work->data = context;
+    int ret = uv_queue_work(loop, work, [] (uv_work_t *work) {}, [] (uv_work_t *work, int status) {
+        CameraSessionAsyncContext *context = reinterpret_cast<CameraSessionAsyncContext *>(work->data);
+        if (context) {
+            CommitConfigAsyncCallback(context->env, context);
+        }
+        delete work;
+    });
+    if (ret) {
+        MEDIA_ERR_LOG("CommitConfigAsyncCallbackAsync() failed to execute work");
+        delete context;
+        delete work;
+    }
+}
+
+napi_value CameraSessionNapi::CommitConfigAsync(napi_env env, napi_callback_info info)
+{
+    MEDIA_INFO_LOG("CommitConfigAsync called");
+    napi_status status;
+    napi_value result = nullptr;
+    const int32_t refCount = 1;
+    size_t argc = ARGS_ONE;
+    napi_value argv[ARGS_ONE] = {0};
+    napi_value thisVar = nullptr;
+
+    CAMERA_NAPI_GET_JS_ARGS(env, info, argc, argv, thisVar);
+    NAPI_ASSERT(env, argc <= 1, "requires 1 parameter maximum");
+
+    napi_get_undefined(env, &result);
+    std::unique_ptr<CameraSessionAsyncContext> asyncContext = std::make_unique<CameraSessionAsyncContext>();
+    status = napi_unwrap(env, thisVar, reinterpret_cast<void**>(&asyncContext->objectInfo));
+    if (status != napi_ok || asyncContext->objectInfo == nullptr) {
+        return result;
+    }
+    if (argc == ARGS_ONE) {
+        CAMERA_NAPI_GET_JS_ASYNC_CB_REF(env, argv[PARAM0], refCount, asyncContext->callbackRef);
+    }
+    CAMERA_NAPI_CREATE_PROMISE(env, asyncContext->callbackRef, asyncContext->deferred, result);
+
+    asyncContext->env = env;
+    asyncContext->funcName = "CameraSessionNapi::CommitConfigAsync";
+    asyncContext->taskId = CameraNapiUtils::IncreamentAndGet(cameraSessionTaskId);
+    CAMERA_START_ASYNC_TRACE(asyncContext->funcName, asyncContext->taskId);
+    // Settled from the session callback, no worker thread waits for the device to come up. Releasing the
+    // session settles it with an error when the result never arrives
+    CameraSessionAsyncContext *context = asyncContext.get();
+    int32_t transactionId = 0;
+    int32_t ret = context->objectInfo->cameraSession_->CommitConfigAsync(transactionId,
+        [context](int32_t transactionId, int32_t errorCode) {
+            context->transactionId = transactionId;
+            context->status = (errorCode == 0);
+            if (!context->status) {
+                context->errorMsg = "CommitConfigAsync( ) failure";
+            }
+            MEDIA_INFO_LOG("CommitConfigAsync transaction %{public}d done : %{public}d", transactionId, errorCode);
+            CommitConfigAsyncCallbackAsync(context);
+        });
+    if (ret != 0) {
+        MEDIA_ERR_LOG("CommitConfigAsync return : %{public}d", ret);
+        context->status = false;
+        context->errorMsg = "CommitConfigAsync( ) failure";
+        CommitConfigAsyncCallback(env, asyncContext.release());
+        return result;
+    }
+    asyncContext.release();
+    return result;
+}
+
 napi_value GetJSArgsForCameraInput(napi_env env, size_t argc, const napi_value argv[],
     CameraSessionAsyncContext &asyncContext)
 {
@@ -559,16 +675,40 @@ napi_value CameraSessionNapi::RemoveInput(napi_env env, napi_callback_info info)
     return result;
 }
 
+static sptr<CaptureOutput> GetCaptureOutput(napi_env env, napi_value value)
+{
+    PreviewOutputNapi *previewOutputNapiObj = nullptr;
+    PhotoOutputNapi *photoOutputNapiObj = nullptr;
+    VideoOutputNapi *videoOutputNapiObj = nullptr;
+    MetadataOutputNapi *metadataOutputNapiObj = nullptr;
+
+    if (PreviewOutputNapi::IsPreviewOutput(env, value)) {
+        MEDIA_INFO_LOG("preview output adding..");
+        napi_unwrap(env, value, reinterpret_cast<void**>(&previewOutputNapiObj));
+        return previewOutputNapiObj->GetPreviewOutput();
+    } else if (PhotoOutputNapi::IsPhotoOutput(env, value)) {
+        MEDIA_INFO_LOG("photo output adding..");
+        napi_unwrap(env, value, reinterpret_cast<void**>(&photoOutputNapiObj));
+        return photoOutputNapiObj->GetPhotoOutput();
+    } else if (VideoOutputNapi::IsVideoOutput(env, value)) {
+        MEDIA_INFO_LOG("video output adding..");
+        napi_unwrap(env, value, reinterpret_cast<void**>(&videoOutputNapiObj));
+        return videoOutputNapiObj->GetVideoOutput();
+    } else if (MetadataOutputNapi::IsMetadataOutput(env, value)) {
+        MEDIA_INFO_LOG("metadata output adding..");
+        napi_unwrap(env, value, reinterpret_cast<void**>(&metadataOutputNapiObj));
+        return metadataOutputNapiObj->GetMetadataOutput();
+    }
+    MEDIA_INFO_LOG("invalid output ..");
+    return nullptr;
+}
+
 napi_value GetJSArgsForCameraOutput(napi_env env, size_t argc, const napi_value argv[],
     CameraSessionAsyncContext &asyncContext)
 {
     const int32_t refCount = 1;
     napi_value result = nullptr;
     auto context = &asyncContext;
-    PreviewOutputNapi *previewOutputNapiObj = nullptr;
-    PhotoOutputNapi *photoOutputNapiObj = nullptr;
-    VideoOutputNapi *videoOutputNapiObj = nullptr;
-    MetadataOutputNapi *metadataOutputNapiObj = nullptr;
 
     NAPI_ASSERT(env, argv != nullptr, "Argument list is empty");
 
@@ -577,26 +717,8 @@ napi_value GetJSArgsForCameraOutput(napi_env env, size_t argc, const napi_value
         napi_typeof(env, argv[i], &valueType);
 
         if (i == PARAM0 && valueType == napi_object) {
-            if (PreviewOutputNapi::IsPreviewOutput(env, argv[i])) {
-                MEDIA_INFO_LOG("preview output adding..");
-                napi_unwrap(env, argv[i], reinterpret_cast<void**>(&previewOutputNapiObj));
-                context->cameraOutput = previewOutputNapiObj->GetPreviewOutput();
-            } else if (PhotoOutputNapi::IsPhotoOutput(env, argv[i])) {
-                MEDIA_INFO_LOG("photo output adding..");
-                napi_unwrap(env, argv[i], reinterpret_cast<void**>(&photoOutputNapiObj));
-                context->cameraOutput = photoOutputNapiObj->GetPhotoOutput();
-            } else if (VideoOutputNapi::IsVideoOutput(env, argv[i])) {
-                MEDIA_INFO_LOG("video output adding..");
-                napi_unwrap(env, argv[i], reinterpret_cast<void**>(&videoOutputNapiObj));
-                context->cameraOutput = videoOutputNapiObj->GetVideoOutput();
-            } else if (MetadataOutputNapi::IsMetadataOutput(env, argv[i])) {
-                MEDIA_INFO_LOG("metadata output adding..");
-                napi_unwrap(env, argv[i], reinterpret_cast<void**>(&metadataOutputNapiObj));
-                context->cameraOutput = metadataOutputNapiObj->GetMetadataOutput();
-            } else {
-                MEDIA_INFO_LOG("invalid output ..");
-                NAPI_ASSERT(env, false, "type mismatch");
-            }
+            context->cameraOutput = GetCaptureOutput(env, argv[i]);
+            NAPI_ASSERT(env, context->cameraOutput != nullptr, "type mismatch");
         } else if (i == PARAM1 && valueType == napi_function) {
             napi_create_reference(env, argv[i], refCount, &context->callbackRef);
             break;
@@ -610,6 +732,195 @@ napi_value GetJSArgsForCameraOutput(napi_env env, size_t argc, const napi_value
     return result;
 }
 
+static bool GetSettingsInt32(napi_env env, napi_value arg, const char *name, bool &present, int32_t &value)
+{
+    napi_value property = nullptr;
+    present = false;
+    if (napi_has_named_property(env, arg, name, &present) != napi_ok) {
+        return false;
+    }
+    if (!present) {
+        return true;
+    }
+    return napi_get_named_property(env, arg, name, &property) == napi_ok &&
+        napi_get_value_int32(env, property, &value) == napi_ok;
+}
+
+static bool AddSettingsEntry(std::shared_ptr<Camera::CameraMetadata> &settings, uint32_t tag,
+                             const void *data, size_t count)
+{
+    if (settings == nullptr) {
+        settings = std::make_shared<Camera::CameraMetadata>(SESSION_SETTINGS_ITEMS, SESSION_SETTINGS_DATA_LENGTH);
+    }
+    return settings->addEntry(tag, data, count);
+}
+
+static bool GetSessionSettings(napi_env env, napi_value arg, CameraSessionAsyncContext &context)
+{
+    bool present = false;
+    int32_t value = 0;
+    if (!GetSettingsInt32(env, arg, "flashMode", present, value)) {
+        return false;
+    }
+    if (present) {
+        if (value < FLASH_MODE_CLOSE || value > FLASH_MODE_ALWAYS_OPEN) {
+            MEDIA_ERR_LOG("Invalid flash mode %{public}d in session settings", value);
+            return false;
+        }
+        uint8_t flash = static_cast<uint8_t>(value);
+        if (!AddSettingsEntry(context.settings, OHOS_CONTROL_FLASH_MODE, &flash, 1)) {
+            return false;
+        }
+    }
+    if (!GetSettingsInt32(env, arg, "exposureMode", present, value)) {
+        return false;
+    }
+    if (present) {
+        camera_exposure_mode_enum_t exposureMode;
+        if (CameraNapiUtils::MapExposureModeEnumFromJs(value, exposureMode) == -1) {
+            return false;
+        }
+        uint8_t exposure = exposureMode;
+        if (!AddSettingsEntry(context.settings, OHOS_CONTROL_EXPOSURE_MODE, &exposure, 1)) {
+            return false;
+        }
+    }
+    if (!GetSettingsInt32(env, arg, "focusMode", present, value)) {
+        return false;
+    }
+    if (present) {
+        if (value < FOCUS_MODE_MANUAL || value > FOCUS_MODE_LOCKED) {
+            MEDIA_ERR_LOG("Invalid focus mode %{public}d in session settings", value);
+            return false;
+        }
+        uint8_t focus = static_cast<uint8_t>(value);
+        if (!AddSettingsEntry(context.settings, OHOS_CONTROL_FOCUS_MODE, &focus, 1)) {
+            return false;
+        }
+    }
+    napi_value property = nullptr;
+    if (napi_has_named_property(env, arg, "zoomRatio", &present) != napi_ok) {
+        return false;
+    }
+    if (present) {
+        double zoomRatio = 0;
+        if (napi_get_named_property(env, arg, "zoomRatio", &property) != napi_ok ||
+            napi_get_value_double(env, property, &zoomRatio) != napi_ok || zoomRatio <= 0) {
+            MEDIA_ERR_LOG("Invalid zoom ratio in session settings");
+            return false;
+        }
+        float zoom = static_cast<float>(zoomRatio);
+        if (!AddSettingsEntry(context.settings, OHOS_CONTROL_ZOOM_RATIO, &zoom, 1)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+napi_value GetJSArgsForConfigureSession(napi_env env, size_t argc, const napi_value argv[],
+    CameraSessionAsyncContext &asyncContext)
+{
+    const int32_t refCount = 1;
+    napi_value result = nullptr;
+    auto context = &asyncContext;
+    CameraInputNapi *cameraInputNapiObj = nullptr;
+
+    NAPI_ASSERT(env, argv != nullptr, "Argument list is empty");
+    NAPI_ASSERT(env, argc >= ARGS_TWO, "requires 2 parameters minimum");
+
+    for (size_t i = PARAM0; i < argc; i++) {
+        napi_valuetype valueType = napi_undefined;
+        napi_typeof(env, argv[i], &valueType);
+        bool isArray = false;
+
+        if (i == PARAM0 && valueType == napi_object) {
+            NAPI_ASSERT(env, CameraInputNapi::IsCameraInput(env, argv[i]), "type mismatch");
+            napi_unwrap(env, argv[i], reinterpret_cast<void**>(&cameraInputNapiObj));
+            NAPI_ASSERT(env, cameraInputNapiObj != nullptr, "type mismatch");
+            context->cameraInput = cameraInputNapiObj->GetCameraInput();
+        } else if (i == PARAM1 && napi_is_array(env, argv[i], &isArray) == napi_ok && isArray) {
+            uint32_t length = 0;
+            napi_get_array_length(env, argv[i], &length);
+            for (uint32_t j = 0; j < length; j++) {
+                napi_value element = nullptr;
+                napi_get_element(env, argv[i], j, &element);
+                sptr<CaptureOutput> output = GetCaptureOutput(env, element);
+                NAPI_ASSERT(env, output != nullptr, "type mismatch");
+                context->cameraOutputs.emplace_back(output);
+            }
+        } else if (i == PARAM2 && valueType == napi_object) {
+            NAPI_ASSERT(env, GetSessionSettings(env, argv[i], *context), "type mismatch");
+        } else if (i == PARAM2 && valueType == napi_undefined) {
+            continue;
+        } else if ((i == PARAM2 || i == PARAM3) && valueType == napi_function) {
+            napi_create_reference(env, argv[i], refCount, &context->callbackRef);
+            break;
+        } else {
+            NAPI_ASSERT(env, false, "type mismatch");
+        }
+    }
+
+    // Return true napi_value if params are successfully obtained
+    napi_get_boolean(env, true, &result);
+    return result;
+}
+
+napi_value CameraSessionNapi::ConfigureSession(napi_env env, napi_callback_info info)
+{
+    MEDIA_INFO_LOG("ConfigureSession called");
+    napi_status status;
+    napi_value result = nullptr;
+    napi_value resource = nullptr;
+    size_t argc = ARGS_FOUR;
+    napi_value argv[ARGS_FOUR] = {0};
+    napi_value thisVar = nullptr;
+
+    CAMERA_NAPI_GET_JS_ARGS(env, info, argc, argv, thisVar);
+    NAPI_ASSERT(env, argc <= ARGS_FOUR, "requires 4 parameters maximum");
+
+    napi_get_undefined(env, &result);
+    auto asyncContext = std::make_unique<CameraSessionAsyncContext>();
+    status = napi_unwrap(env, thisVar, reinterpret_cast<void**>(&asyncContext->objectInfo));
+    if (status == napi_ok && asyncContext->objectInfo != nullptr) {
+        result = GetJSArgsForConfigureSession(env, argc, argv, *asyncContext);
+        CAMERA_NAPI_CHECK_NULL_PTR_RETURN_UNDEFINED(env, result, result, "Failed to obtain arguments");
+        CAMERA_NAPI_CREATE_PROMISE(env, asyncContext->callbackRef, asyncContext->deferred, result);
+        CAMERA_NAPI_CREATE_RESOURCE_NAME(env, resource, "ConfigureSession");
+        status = napi_create_async_work(
+            env, nullptr, resource,
+            [](napi_env env, void* data) {
+                auto context = static_cast<CameraSessionAsyncContext*>(data);
+                context->status = false;
+                // Start async trace
+                context->funcName = "CameraSessionNapi::ConfigureSession";
+                context->taskId = CameraNapiUtils::IncreamentAndGet(cameraSessionTaskId);
+                CAMERA_START_ASYNC_TRACE(context->funcName, context->taskId);
+                if (context->objectInfo != nullptr) {
+                    context->bRetBool = false;
+                    context->status = true;
+                    int32_t ret = context->objectInfo->cameraSession_->ConfigureSession(context->cameraInput,
+                                                                                        context->cameraOutputs,
+                                                                                        context->settings);
+                    if (ret != 0) {
+                        context->status = false;
+                        context->errorMsg = "ConfigureSession( ) failure";
+                    }
+                    MEDIA_INFO_LOG("ConfigureSession return : %{public}d", ret);
+                }
+            },
+            CommonCompleteCallback, static_cast<void*>(asyncContext.get()), &asyncContext->work);
+        if (status != napi_ok) {
+            MEDIA_ERR_LOG("Failed to create napi_create_async_work for ConfigureSession");
+            napi_get_undefined(env, &result);
+        } else {
+            napi_queue_async_work(env, asyncContext->work);
+            asyncContext.release();
+        }
+    }
+
+    return result;
+}
+
 napi_value CameraSessionNapi::AddOutput(napi_env env, napi_callback_info info)
 {
     MEDIA_INFO_LOG("AddOutput called");
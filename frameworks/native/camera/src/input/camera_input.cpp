@@ -89,6 +89,12 @@ CameraInput::CameraInput(sptr<ICameraDeviceService> &deviceObj,
         return;
     }
     deviceObj_->SetCallback(CameraDeviceSvcCallback_);
+    // Only the results read by ProcessAutoFocusUpdates and ProcessAutoExposureUpdates are delivered
+    std::vector<int32_t> results = {OHOS_CONTROL_FOCUS_MODE, OHOS_CONTROL_FOCUS_STATE,
+                                    OHOS_CONTROL_EXPOSURE_MODE, OHOS_CONTROL_EXPOSURE_STATE};
+    if (deviceObj_->EnableResult(results) != CAMERA_OK) {
+        MEDIA_ERR_LOG("CameraInput::CameraInput Failed to subscribe to results");
+    }
 }
 
 void CameraInput::Release()
@@ -293,6 +293,29 @@ sptr<PreviewOutput> CameraManager::CreateCustomPreviewOutput(const sptr<OHOS::IB
     return result;
 }
 
+sptr<PreviewOutput> CameraManager::CreateDeferredPreviewOutput(int32_t format, int32_t width, int32_t height)
+{
+    CAMERA_SYNC_TRACE;
+    sptr<IStreamRepeat> streamRepeat = nullptr;
+    sptr<PreviewOutput> result = nullptr;
+    int32_t retCode = CAMERA_OK;
+
+    if ((serviceProxy_ == nullptr) || (width <= 0) || (height <= 0)) {
+        MEDIA_ERR_LOG("CameraManager::CreateDeferredPreviewOutput serviceProxy_ is null or invalid size");
+        return nullptr;
+    }
+    retCode = serviceProxy_->CreateDeferredPreviewOutput(format, width, height, streamRepeat);
+    if (retCode == CAMERA_OK) {
+        result = new(std::nothrow) PreviewOutput(streamRepeat);
+        if (result == nullptr) {
+            MEDIA_ERR_LOG("Failed to new PreviewOutput");
+        }
+    } else {
+        MEDIA_ERR_LOG("PreviewOutput: Failed to get stream repeat object from hcamera service!, %{public}d", retCode);
+    }
+    return result;
+}
+
 sptr<MetadataOutput> CameraManager::CreateMetadataOutput()
 {
     CAMERA_SYNC_TRACE;
@@ -387,6 +410,29 @@ sptr<VideoOutput> CameraManager::CreateVideoOutput(const sptr<OHOS::IBufferProdu
     return result;
 }
 
+sptr<VideoOutput> CameraManager::CreateDeferredVideoOutput(int32_t format, int32_t width, int32_t height)
+{
+    CAMERA_SYNC_TRACE;
+    sptr<IStreamRepeat> streamRepeat = nullptr;
+    sptr<VideoOutput> result = nullptr;
+    int32_t retCode = CAMERA_OK;
+
+    if ((serviceProxy_ == nullptr) || (width <= 0) || (height <= 0)) {
+        MEDIA_ERR_LOG("CameraManager::CreateDeferredVideoOutput serviceProxy_ is null or invalid size");
+        return nullptr;
+    }
+    retCode = serviceProxy_->CreateDeferredVideoOutput(format, width, height, streamRepeat);
+    if (retCode == CAMERA_OK) {
+        result = new(std::nothrow) VideoOutput(streamRepeat);
+        if (result == nullptr) {
+            MEDIA_ERR_LOG("Failed to new VideoOutput");
+        }
+    } else {
+        MEDIA_ERR_LOG("VideoOutpout: Failed to get stream repeat object from hcamera service! %{public}d", retCode);
+    }
+    return result;
+}
+
 void CameraManager::Init()
 {
     CAMERA_SYNC_TRACE;
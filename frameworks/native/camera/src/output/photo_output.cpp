@@ -163,6 +163,16 @@ void PhotoCaptureSetting::SetMirror(bool enable)
     return;
 }
 
+void PhotoCaptureSetting::SetZslSelection(ZslSelection selection)
+{
+    zslSelection_ = selection;
+}
+
+ZslSelection PhotoCaptureSetting::GetZslSelection()
+{
+    return zslSelection_;
+}
+
 std::shared_ptr<Camera::CameraMetadata> PhotoCaptureSetting::GetCaptureMetadataSetting()
 {
     return captureMetadataSetting_;
@@ -260,8 +270,12 @@ std::shared_ptr<PhotoCallback> PhotoOutput::GetApplicationCallback()
 
 int32_t PhotoOutput::Capture(std::shared_ptr<PhotoCaptureSetting> photoCaptureSettings)
 {
-    return static_cast<IStreamCapture *>(GetStream().GetRefPtr())->Capture(
-        photoCaptureSettings->GetCaptureMetadataSetting());
+    IStreamCapture *streamCapture = static_cast<IStreamCapture *>(GetStream().GetRefPtr());
+    if (photoCaptureSettings->GetZslSelection() != ZSL_SELECTION_DEFAULT) {
+        return streamCapture->ZslCapture(photoCaptureSettings->GetCaptureMetadataSetting(),
+                                         photoCaptureSettings->GetZslSelection());
+    }
+    return streamCapture->Capture(photoCaptureSettings->GetCaptureMetadataSetting());
 }
 
 int32_t PhotoOutput::Capture()
@@ -273,6 +287,25 @@ int32_t PhotoOutput::Capture()
     return static_cast<IStreamCapture *>(GetStream().GetRefPtr())->Capture(captureMetadataSetting);
 }
 
+int32_t PhotoOutput::BurstCapture(std::shared_ptr<PhotoCaptureSetting> photoCaptureSettings, int32_t frameCount)
+{
+    if (photoCaptureSettings == nullptr) {
+        MEDIA_ERR_LOG("PhotoOutput::BurstCapture photoCaptureSettings is null");
+        return CAMERA_INVALID_ARG;
+    }
+    return static_cast<IStreamCapture *>(GetStream().GetRefPtr())->BurstCapture(
+        photoCaptureSettings->GetCaptureMetadataSetting(), frameCount);
+}
+
+int32_t PhotoOutput::BurstCapture(int32_t frameCount)
+{
+    int32_t items = 0;
+    int32_t dataLength = 0;
+    std::shared_ptr<Camera::CameraMetadata> captureMetadataSetting =
+        std::make_shared<Camera::CameraMetadata>(items, dataLength);
+    return static_cast<IStreamCapture *>(GetStream().GetRefPtr())->BurstCapture(captureMetadataSetting, frameCount);
+}
+
 int32_t PhotoOutput::CancelCapture()
 {
     return static_cast<IStreamCapture *>(GetStream().GetRefPtr())->CancelCapture();
@@ -33,6 +33,34 @@ void PreviewOutput::Release()
     return;
 }
 
+int32_t PreviewOutput::SetFps(float fps)
+{
+    int32_t errCode = static_cast<IStreamRepeat *>(GetStream().GetRefPtr())->SetFps(fps);
+    if (errCode != CAMERA_OK) {
+        MEDIA_ERR_LOG("PreviewOutput::SetFps failed, errCode: %{public}d", errCode);
+    }
+    return errCode;
+}
+
+int32_t PreviewOutput::AddDeferredSurface(sptr<Surface> surface)
+{
+    if (surface == nullptr) {
+        MEDIA_ERR_LOG("PreviewOutput::AddDeferredSurface surface is null");
+        return CAMERA_INVALID_ARG;
+    }
+    sptr<IStreamRepeat> streamRepeat = static_cast<IStreamRepeat *>(GetStream().GetRefPtr());
+    int32_t errCode = streamRepeat->AddDeferredSurface(surface->GetProducer());
+    if (errCode != CAMERA_OK) {
+        MEDIA_ERR_LOG("PreviewOutput::AddDeferredSurface failed, errCode: %{public}d", errCode);
+    }
+    return errCode;
+}
+
+int32_t PreviewOutput::GetAchievedFps(float &fps)
+{
+    return static_cast<IStreamRepeat *>(GetStream().GetRefPtr())->GetAchievedFps(fps);
+}
+
 class HStreamRepeatCallbackImpl : public HStreamRepeatCallbackStub {
 public:
     sptr<PreviewOutput> previewOutput_ = nullptr;
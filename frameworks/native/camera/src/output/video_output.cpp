@@ -125,6 +125,20 @@ void VideoOutput::Release()
     return;
 }
 
+int32_t VideoOutput::AddDeferredSurface(sptr<Surface> surface)
+{
+    if (surface == nullptr) {
+        MEDIA_ERR_LOG("VideoOutput::AddDeferredSurface surface is null");
+        return CAMERA_INVALID_ARG;
+    }
+    sptr<IStreamRepeat> streamRepeat = static_cast<IStreamRepeat *>(GetStream().GetRefPtr());
+    int32_t errCode = streamRepeat->AddDeferredSurface(surface->GetProducer());
+    if (errCode != CAMERA_OK) {
+        MEDIA_ERR_LOG("VideoOutput::AddDeferredSurface failed, errCode: %{public}d", errCode);
+    }
+    return errCode;
+}
+
 std::shared_ptr<VideoCallback> VideoOutput::GetApplicationCallback()
 {
     return appCallback_;
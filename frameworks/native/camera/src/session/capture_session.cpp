@@ -42,13 +42,25 @@ public:
     {
         MEDIA_INFO_LOG("CaptureSessionCallback::OnError() is called!, errorCode: %{public}d",
                        errorCode);
-        if (captureSession_ != nullptr && captureSession_->GetApplicationCallback() != nullptr) {
-            captureSession_->GetApplicationCallback()->OnError(errorCode);
+        std::shared_ptr<SessionCallback> appCallback =
+            (captureSession_ != nullptr) ? captureSession_->GetApplicationCallback() : nullptr;
+        if (appCallback != nullptr) {
+            appCallback->OnError(errorCode);
         } else {
             MEDIA_INFO_LOG("CaptureSessionCallback::ApplicationCallback not set!, Discarding callback");
         }
         return CAMERA_OK;
     }
+
+    int32_t OnCommitConfigDone(int32_t transactionId, int32_t errorCode) override
+    {
+        MEDIA_INFO_LOG("CaptureSessionCallback::OnCommitConfigDone() is called!, transactionId: %{public}d, "
+                       "errorCode: %{public}d", transactionId, errorCode);
+        if (captureSession_ != nullptr) {
+            captureSession_->OnCommitConfigDone(transactionId, errorCode);
+        }
+        return CAMERA_OK;
+    }
 };
 
 CaptureSession::CaptureSession(sptr<ICaptureSession> &captureSession)
@@ -59,6 +71,7 @@ CaptureSession::CaptureSession(sptr<ICaptureSession> &captureSession)
 
 CaptureSession::~CaptureSession()
 {
+    CancelPendingCommits();
     if (inputDevice_ != nullptr) {
         inputDevice_ = nullptr;
     }
@@ -76,6 +89,70 @@ int32_t CaptureSession::CommitConfig()
     return captureSession_->CommitConfig();
 }
 
+int32_t CaptureSession::CommitConfigAsync(int32_t &transactionId, CommitConfigCompletion completion)
+{
+    CAMERA_SYNC_TRACE;
+    // Held over the request so the result cannot be delivered before the completion is registered
+    std::lock_guard<std::mutex> lock(commitMutex_);
+    if (captureSessionCallback_ == nullptr) {
+        sptr<ICaptureSessionCallback> callback = new(std::nothrow) CaptureSessionCallback(this);
+        if (callback == nullptr) {
+            MEDIA_ERR_LOG("CaptureSession::CommitConfigAsync failed to allocate session callback");
+            return CAMERA_ALLOC_ERROR;
+        }
+        int32_t errCode = captureSession_->SetCallback(callback);
+        if (errCode != CAMERA_OK) {
+            MEDIA_ERR_LOG("CaptureSession::CommitConfigAsync failed to register callback, errCode: %{public}d",
+                          errCode);
+            return errCode;
+        }
+        captureSessionCallback_ = callback;
+    }
+    int32_t errCode = captureSession_->CommitConfigAsync(transactionId);
+    if (errCode != CAMERA_OK) {
+        MEDIA_ERR_LOG("CaptureSession::CommitConfigAsync failed, errCode: %{public}d", errCode);
+        return errCode;
+    }
+    if (completion != nullptr) {
+        pendingCommits_[transactionId] = completion;
+    }
+    return CAMERA_OK;
+}
+
+void CaptureSession::OnCommitConfigDone(int32_t transactionId, int32_t errorCode)
+{
+    CommitConfigCompletion completion = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(commitMutex_);
+        auto it = pendingCommits_.find(transactionId);
+        if (it != pendingCommits_.end()) {
+            completion = it->second;
+            pendingCommits_.erase(it);
+        }
+    }
+    if (completion != nullptr) {
+        completion(transactionId, errorCode);
+    }
+    std::shared_ptr<SessionCallback> appCallback = GetApplicationCallback();
+    if (appCallback != nullptr) {
+        appCallback->OnCommitConfigDone(transactionId, errorCode);
+    }
+}
+
+void CaptureSession::CancelPendingCommits()
+{
+    // Taken out under the lock, so a result arriving concurrently finds no completion to call twice
+    std::map<int32_t, CommitConfigCompletion> pendingCommits;
+    {
+        std::lock_guard<std::mutex> lock(commitMutex_);
+        pendingCommits.swap(pendingCommits_);
+    }
+    for (auto &pendingCommit : pendingCommits) {
+        MEDIA_INFO_LOG("CaptureSession::CancelPendingCommits transaction %{public}d", pendingCommit.first);
+        pendingCommit.second(pendingCommit.first, CAMERA_INVALID_STATE);
+    }
+}
+
 int32_t CaptureSession::AddInput(sptr<CaptureInput> &input)
 {
     CAMERA_SYNC_TRACE;
@@ -122,12 +199,57 @@ int32_t CaptureSession::RemoveOutput(sptr<CaptureOutput> &output)
     return captureSession_->RemoveOutput(output->GetStreamType(), output->GetStream());
 }
 
+int32_t CaptureSession::ConfigureSession(sptr<CaptureInput> &input, std::vector<sptr<CaptureOutput>> &outputs,
+                                         std::shared_ptr<Camera::CameraMetadata> settings)
+{
+    CAMERA_SYNC_TRACE;
+    if (input == nullptr || outputs.empty()) {
+        MEDIA_ERR_LOG("CaptureSession::ConfigureSession input or outputs are missing");
+        return CAMERA_INVALID_ARG;
+    }
+    std::vector<SessionOutput> sessionOutputs;
+    for (auto &output : outputs) {
+        if (output == nullptr) {
+            MEDIA_ERR_LOG("CaptureSession::ConfigureSession output is null");
+            return CAMERA_INVALID_ARG;
+        }
+        sessionOutputs.emplace_back(output->GetStreamType(), output->GetStream());
+    }
+    int32_t errCode = captureSession_->ConfigureSession(((sptr<CameraInput> &)input)->GetCameraDevice(),
+                                                        sessionOutputs, settings);
+    if (errCode != CAMERA_OK) {
+        MEDIA_ERR_LOG("CaptureSession::ConfigureSession failed, errCode: %{public}d", errCode);
+        return errCode;
+    }
+    inputDevice_ = input;
+    for (auto &output : outputs) {
+        output->SetSession(this);
+    }
+    return CAMERA_OK;
+}
+
+int32_t CaptureSession::SetZslConfig(int32_t ringDepth, ZslSelection selection, uint64_t memoryBudget)
+{
+    CAMERA_SYNC_TRACE;
+    int32_t errCode = captureSession_->SetZslConfig(ringDepth, selection, memoryBudget);
+    if (errCode != CAMERA_OK) {
+        MEDIA_ERR_LOG("CaptureSession::SetZslConfig failed, errCode: %{public}d", errCode);
+    }
+    return errCode;
+}
+
 int32_t CaptureSession::Start()
 {
     CAMERA_SYNC_TRACE;
     return captureSession_->Start();
 }
 
+int32_t CaptureSession::StartGrouped()
+{
+    CAMERA_SYNC_TRACE;
+    return captureSession_->StartGrouped();
+}
+
 int32_t CaptureSession::Stop()
 {
     CAMERA_SYNC_TRACE;
@@ -141,8 +263,11 @@ void CaptureSession::SetCallback(std::shared_ptr<SessionCallback> callback)
     }
     int32_t errorCode = CAMERA_OK;
 
-    appCallback_ = callback;
-    if (appCallback_ != nullptr) {
+    {
+        std::lock_guard<std::mutex> lock(callbackMutex_);
+        appCallback_ = callback;
+    }
+    if (callback != nullptr) {
         if (captureSessionCallback_ == nullptr) {
             captureSessionCallback_ = new(std::nothrow) CaptureSessionCallback(this);
         }
@@ -150,6 +275,7 @@ void CaptureSession::SetCallback(std::shared_ptr<SessionCallback> callback)
         if (errorCode != CAMERA_OK) {
             MEDIA_ERR_LOG("CaptureSession::SetCallback: Failed to register callback, errorCode: %{public}d", errorCode);
             captureSessionCallback_ = nullptr;
+            std::lock_guard<std::mutex> lock(callbackMutex_);
             appCallback_ = nullptr;
         }
     }
@@ -243,6 +369,7 @@ std::vector<VideoStabilizationMode> CaptureSession::GetSupportedStabilizationMod
 
 std::shared_ptr<SessionCallback> CaptureSession::GetApplicationCallback()
 {
+    std::lock_guard<std::mutex> lock(callbackMutex_);
     return appCallback_;
 }
 
@@ -253,6 +380,8 @@ void CaptureSession::Release()
     if (errCode != CAMERA_OK) {
         MEDIA_ERR_LOG("Failed to Release capture session!, %{public}d", errCode);
     }
+    // A commit still in flight reports CAMERA_INVALID_STATE, its completion is settled here already
+    CancelPendingCommits();
 }
 } // CameraStandard
 } // OHOS
@@ -14,6 +14,16 @@
  */
 
 #include "camera_framework_unittest.h"
+#include "camera_format_converter.h"
+#include "camera_image_scaler.h"
+#include "camera_image_transform.h"
+#include "camera_jpeg_encoder.h"
+#include "camera_latency_stats.h"
+#include "camera_result_reader.h"
+#include "camera_settings.h"
+#include "camera_stream_fan_out.h"
+#include "camera_stream_validation_cache.h"
+#include "camera_telemetry.h"
 #include "camera_util.h"
 #include "gmock/gmock.h"
 #include "input/camera_input.h"
@@ -27,11 +37,21 @@
 #include "token_setproc.h"
 #include "metadata_utils.h"
 
+#include <csetjmp>
+#include <future>
+#include <set>
+#include <thread>
+
+extern "C" {
+#include "jpeglib.h"
+}
+
 using namespace testing::ext;
 using ::testing::A;
 using ::testing::InSequence;
 using ::testing::Mock;
 using ::testing::Return;
+using ::testing::Truly;
 using ::testing::_;
 
 namespace OHOS {
@@ -249,6 +269,57 @@ static OHOS::Security::AccessToken::HapPolicyParams g_infoManagerTestPolicyPrams
 
 OHOS::Security::AccessToken::AccessTokenIDEx tokenIdEx = {0};
 
+struct JpegDecodeError {
+    jpeg_error_mgr pub;
+    jmp_buf jumpBuffer;
+};
+
+static void JpegDecodeErrorExit(j_common_ptr cinfo)
+{
+    longjmp(reinterpret_cast<JpegDecodeError *>(cinfo->err)->jumpBuffer, 1);
+}
+
+// Decodes both images a row at a time, so frames of any size are compared without holding their pixels
+static bool IsSameDecodedJpeg(const std::vector<uint8_t> &first, const std::vector<uint8_t> &second)
+{
+    const int32_t imageCount = 2;
+    const std::vector<uint8_t> *images[imageCount] = {&first, &second};
+    jpeg_decompress_struct decoders[imageCount] = {};
+    std::vector<uint8_t> rows[imageCount];
+    JpegDecodeError error;
+    for (int32_t i = 0; i < imageCount; i++) {
+        decoders[i].err = jpeg_std_error(&error.pub);
+    }
+    error.pub.error_exit = JpegDecodeErrorExit;
+    if (setjmp(error.jumpBuffer)) {
+        for (int32_t i = 0; i < imageCount; i++) {
+            jpeg_destroy_decompress(&decoders[i]);
+        }
+        return false;
+    }
+    for (int32_t i = 0; i < imageCount; i++) {
+        jpeg_create_decompress(&decoders[i]);
+        jpeg_mem_src(&decoders[i], const_cast<uint8_t *>(images[i]->data()), images[i]->size());
+        jpeg_read_header(&decoders[i], TRUE);
+        decoders[i].out_color_space = JCS_YCbCr;
+        jpeg_start_decompress(&decoders[i]);
+        rows[i].resize(decoders[i].output_width * decoders[i].output_components);
+    }
+    bool isSame = decoders[0].output_width == decoders[1].output_width
+        && decoders[0].output_height == decoders[1].output_height;
+    while (isSame && decoders[0].output_scanline < decoders[0].output_height) {
+        for (int32_t i = 0; i < imageCount; i++) {
+            JSAMPROW row = rows[i].data();
+            jpeg_read_scanlines(&decoders[i], &row, 1);
+        }
+        isSame = (rows[0] == rows[1]);
+    }
+    for (int32_t i = 0; i < imageCount; i++) {
+        jpeg_destroy_decompress(&decoders[i]);
+    }
+    return isSame;
+}
+
 void CameraFrameworkUnitTest::SetUpTestCase(void)
 {
     int32_t ret = -1;
@@ -480,11 +551,11 @@ HWTEST_F(CameraFrameworkUnitTest, camera_framework_unittest_009, TestSize.Level0
 
 /*
  * Feature: Framework
- * Function: Test create custom preview output with width and height as 0
+ * Function: Test create custom preview output with width and height as 0 or negative
  * SubFunction: NA
  * FunctionPoints: NA
  * EnvConditions: NA
- * CaseDescription: Test create custom preview output with width and height as 0
+ * CaseDescription: Test create custom preview output with width and height as 0 or negative
  */
 HWTEST_F(CameraFrameworkUnitTest, camera_framework_unittest_010, TestSize.Level0)
 {
@@ -493,6 +564,12 @@ HWTEST_F(CameraFrameworkUnitTest, camera_framework_unittest_010, TestSize.Level0
     sptr<Surface> surface = Surface::CreateSurfaceAsConsumer();
     sptr<CaptureOutput> preview = cameraManager->CreateCustomPreviewOutput(surface, width, height);
     ASSERT_EQ(preview, nullptr);
+
+    width = -PREVIEW_DEFAULT_WIDTH;
+    height = PREVIEW_DEFAULT_HEIGHT;
+    surface->SetUserData(CameraManager::surfaceFormat, std::to_string(OHOS_CAMERA_FORMAT_YCRCB_420_SP));
+    preview = cameraManager->CreateCustomPreviewOutput(surface, width, height);
+    ASSERT_EQ(preview, nullptr);
 }
 
 
@@ -1680,5 +1757,1696 @@ HWTEST_F(CameraFrameworkUnitTest, camera_framework_unittest_049, TestSize.Level0
     EXPECT_CALL(*mockCameraDevice, Close());
     session->Release();
 }
+
+/*
+ * Feature: Framework
+ * Function: Test session configured with a single ConfigureSession call
+ * SubFunction: NA
+ * FunctionPoints: NA
+ * EnvConditions: NA
+ * CaseDescription: Test input, outputs and initial settings applied with one ConfigureSession call
+ */
+HWTEST_F(CameraFrameworkUnitTest, camera_framework_unittest_050, TestSize.Level0)
+{
+    InSequence s;
+    EXPECT_CALL(*mockCameraHostManager, GetCameras(_));
+    EXPECT_CALL(*mockCameraHostManager, GetCameraAbility(_, _));
+    std::vector<sptr<CameraInfo>> cameras = cameraManager->GetCameras();
+
+    sptr<CaptureInput> input = cameraManager->CreateCameraInput(cameras[0]);
+    ASSERT_NE(input, nullptr);
+
+    sptr<CaptureOutput> preview = CreatePreviewOutput();
+    ASSERT_NE(preview, nullptr);
+
+    sptr<CaptureOutput> photo = CreatePhotoOutput();
+    ASSERT_NE(photo, nullptr);
+
+    sptr<CaptureSession> session = cameraManager->CreateCaptureSession();
+    ASSERT_NE(session, nullptr);
+
+    std::vector<sptr<CaptureOutput>> outputs;
+    int32_t ret = session->ConfigureSession(input, outputs);
+    EXPECT_NE(ret, 0);
+
+    int32_t itemCount = 10;
+    int32_t dataSize = 100;
+    uint8_t flashMode = OHOS_CAMERA_FLASH_MODE_CLOSE;
+    std::shared_ptr<OHOS::Camera::CameraMetadata> settings =
+        std::make_shared<OHOS::Camera::CameraMetadata>(itemCount, dataSize);
+    settings->addEntry(OHOS_CONTROL_FLASH_MODE, &flashMode, 1);
+
+    outputs.emplace_back(preview);
+    outputs.emplace_back(photo);
+    EXPECT_CALL(*mockCameraHostManager, OpenCameraDevice(_, _, _));
+    EXPECT_CALL(*mockCameraDevice, UpdateSettings(_));
+    EXPECT_CALL(*mockCameraDevice, SetResultMode(ON_CHANGED));
+    EXPECT_CALL(*mockCameraDevice, GetStreamOperator(_, _));
+    EXPECT_CALL(*mockCameraHostManager, GetCameraAbility(_, _));
+#ifndef PRODUCT_M40
+    EXPECT_CALL(*mockStreamOperator, IsStreamsSupported(_, _,
+        A<const std::vector<StreamInfo> &>(), _));
+#endif
+    EXPECT_CALL(*mockStreamOperator, CreateStreams(_));
+    EXPECT_CALL(*mockStreamOperator, CommitStreams(_, _));
+    ret = session->ConfigureSession(input, outputs, settings);
+    EXPECT_EQ(ret, 0);
+
+    EXPECT_CALL(*mockStreamOperator, Capture(_, _, true));
+    ret = session->Start();
+    EXPECT_EQ(ret, 0);
+
+    EXPECT_CALL(*mockStreamOperator, CancelCapture(_));
+    ret = session->Stop();
+    EXPECT_EQ(ret, 0);
+
+    EXPECT_CALL(*mockStreamOperator, ReleaseStreams(_));
+    EXPECT_CALL(*mockCameraDevice, Close());
+    session->Release();
+}
+
+/*
+ * Feature: Framework
+ * Function: Test burst capture with preview + photo
+ * SubFunction: NA
+ * FunctionPoints: NA
+ * EnvConditions: NA
+ * CaseDescription: Test burst capture issues one streaming capture, rejects null settings and is cancelled
+ * through CancelCapture
+ */
+HWTEST_F(CameraFrameworkUnitTest, camera_framework_unittest_051, TestSize.Level0)
+{
+    InSequence s;
+    EXPECT_CALL(*mockCameraHostManager, GetCameras(_));
+    EXPECT_CALL(*mockCameraHostManager, GetCameraAbility(_, _));
+    std::vector<sptr<CameraInfo>> cameras = cameraManager->GetCameras();
+
+    sptr<CaptureInput> input = cameraManager->CreateCameraInput(cameras[0]);
+    ASSERT_NE(input, nullptr);
+
+    sptr<CaptureOutput> preview = CreatePreviewOutput();
+    ASSERT_NE(preview, nullptr);
+
+    sptr<CaptureOutput> photo = CreatePhotoOutput();
+    ASSERT_NE(photo, nullptr);
+
+    sptr<CaptureSession> session = cameraManager->CreateCaptureSession();
+    ASSERT_NE(session, nullptr);
+
+    int32_t ret = session->BeginConfig();
+    EXPECT_EQ(ret, 0);
+
+    ret = session->AddInput(input);
+    EXPECT_EQ(ret, 0);
+
+    ret = session->AddOutput(preview);
+    EXPECT_EQ(ret, 0);
+
+    ret = session->AddOutput(photo);
+    EXPECT_EQ(ret, 0);
+
+    EXPECT_CALL(*mockCameraHostManager, OpenCameraDevice(_, _, _));
+    EXPECT_CALL(*mockCameraDevice, SetResultMode(ON_CHANGED));
+    EXPECT_CALL(*mockCameraDevice, GetStreamOperator(_, _));
+    EXPECT_CALL(*mockCameraHostManager, GetCameraAbility(_, _));
+#ifndef PRODUCT_M40
+    EXPECT_CALL(*mockStreamOperator, IsStreamsSupported(_, _,
+        A<const std::vector<StreamInfo> &>(), _));
+#endif
+    EXPECT_CALL(*mockStreamOperator, CreateStreams(_));
+    EXPECT_CALL(*mockStreamOperator, CommitStreams(_, _));
+    ret = session->CommitConfig();
+    EXPECT_EQ(ret, 0);
+
+    EXPECT_CALL(*mockStreamOperator, Capture(_, _, true));
+    ret = session->Start();
+    EXPECT_EQ(ret, 0);
+
+    int32_t invalidFrameCount = -1;
+    ret = ((sptr<PhotoOutput> &)photo)->BurstCapture(invalidFrameCount);
+    EXPECT_NE(ret, 0);
+
+    int32_t burstFrameCount = 5;
+    ret = ((sptr<PhotoOutput> &)photo)->BurstCapture(nullptr, burstFrameCount);
+    EXPECT_NE(ret, 0);
+
+    EXPECT_CALL(*mockStreamOperator, Capture(_, _, true));
+    ret = ((sptr<PhotoOutput> &)photo)->BurstCapture(burstFrameCount);
+    EXPECT_EQ(ret, 0);
+
+    EXPECT_CALL(*mockStreamOperator, Capture(_, _, _)).Times(0);
+    ret = ((sptr<PhotoOutput> &)photo)->Capture();
+    EXPECT_NE(ret, 0);
+
+    EXPECT_CALL(*mockStreamOperator, CancelCapture(_));
+    ret = ((sptr<PhotoOutput> &)photo)->CancelCapture();
+    EXPECT_EQ(ret, 0);
+
+    EXPECT_CALL(*mockStreamOperator, CancelCapture(_));
+    ret = session->Stop();
+    EXPECT_EQ(ret, 0);
+
+    EXPECT_CALL(*mockStreamOperator, ReleaseStreams(_));
+    EXPECT_CALL(*mockCameraDevice, Close());
+    session->Release();
+}
+
+/*
+ * Feature: Framework
+ * Function: Test zero-shutter-lag capture with preview + photo
+ * SubFunction: NA
+ * FunctionPoints: NA
+ * EnvConditions: NA
+ * CaseDescription: Test zsl adds a streaming feed for a YUV photo output and falls back to device capture
+ * when no frame is buffered yet
+ */
+HWTEST_F(CameraFrameworkUnitTest, camera_framework_unittest_052, TestSize.Level0)
+{
+    InSequence s;
+    EXPECT_CALL(*mockCameraHostManager, GetCameras(_));
+    EXPECT_CALL(*mockCameraHostManager, GetCameraAbility(_, _));
+    std::vector<sptr<CameraInfo>> cameras = cameraManager->GetCameras();
+
+    sptr<CaptureInput> input = cameraManager->CreateCameraInput(cameras[0]);
+    ASSERT_NE(input, nullptr);
+
+    sptr<CaptureOutput> preview = CreatePreviewOutput();
+    ASSERT_NE(preview, nullptr);
+
+    // Buffered frames are YUV, without the service jpeg encoder only a YUV photo output takes them
+    sptr<Surface> photoSurface = Surface::CreateSurfaceAsConsumer();
+    ASSERT_NE(photoSurface, nullptr);
+    photoSurface->SetDefaultWidthAndHeight(PHOTO_DEFAULT_WIDTH, PHOTO_DEFAULT_HEIGHT);
+    photoSurface->SetUserData(CameraManager::surfaceFormat, std::to_string(OHOS_CAMERA_FORMAT_YCRCB_420_SP));
+    sptr<CaptureOutput> photo = cameraManager->CreatePhotoOutput(photoSurface);
+    ASSERT_NE(photo, nullptr);
+
+    sptr<CaptureSession> session = cameraManager->CreateCaptureSession();
+    ASSERT_NE(session, nullptr);
+
+    int32_t ret = session->SetZslConfig(MAX_ZSL_RING_DEPTH, ZSL_SELECTION_CLOSEST);
+    EXPECT_NE(ret, 0);
+
+    ret = session->BeginConfig();
+    EXPECT_EQ(ret, 0);
+
+    ret = session->SetZslConfig(MAX_ZSL_RING_DEPTH + 1, ZSL_SELECTION_CLOSEST);
+    EXPECT_NE(ret, 0);
+
+    int32_t ringDepth = 3;
+    ret = session->SetZslConfig(ringDepth, ZSL_SELECTION_CLOSEST);
+    EXPECT_EQ(ret, 0);
+
+    ret = session->AddInput(input);
+    EXPECT_EQ(ret, 0);
+
+    ret = session->AddOutput(preview);
+    EXPECT_EQ(ret, 0);
+
+    ret = session->AddOutput(photo);
+    EXPECT_EQ(ret, 0);
+
+    EXPECT_CALL(*mockCameraHostManager, OpenCameraDevice(_, _, _));
+    EXPECT_CALL(*mockCameraDevice, SetResultMode(ON_CHANGED));
+    EXPECT_CALL(*mockCameraDevice, GetStreamOperator(_, _));
+    EXPECT_CALL(*mockCameraHostManager, GetCameraAbility(_, _));
+#ifndef PRODUCT_M40
+    EXPECT_CALL(*mockStreamOperator, IsStreamsSupported(_, _,
+        A<const std::vector<StreamInfo> &>(), _));
+#endif
+    EXPECT_CALL(*mockStreamOperator, CreateStreams(_));
+    EXPECT_CALL(*mockStreamOperator, CommitStreams(_, _));
+    ret = session->CommitConfig();
+    EXPECT_EQ(ret, 0);
+
+    EXPECT_CALL(*mockStreamOperator, Capture(_, _, true)).Times(2);
+    ret = session->Start();
+    EXPECT_EQ(ret, 0);
+
+    EXPECT_CALL(*mockStreamOperator, Capture(_, _, false));
+    ret = ((sptr<PhotoOutput> &)photo)->Capture();
+    EXPECT_EQ(ret, 0);
+
+    EXPECT_CALL(*mockStreamOperator, CancelCapture(_)).Times(2);
+    ret = session->Stop();
+    EXPECT_EQ(ret, 0);
+
+    EXPECT_CALL(*mockStreamOperator, ReleaseStreams(_));
+    EXPECT_CALL(*mockCameraDevice, Close());
+    session->Release();
+}
+
+/*
+ * Feature: Framework
+ * Function: Test frame rate control of a preview output next to another preview output
+ * SubFunction: NA
+ * FunctionPoints: NA
+ * EnvConditions: NA
+ * CaseDescription: Test SetFps validates the frame rate and a decimated preview output streams with the
+ * other outputs
+ */
+HWTEST_F(CameraFrameworkUnitTest, camera_framework_unittest_053, TestSize.Level0)
+{
+    InSequence s;
+    EXPECT_CALL(*mockCameraHostManager, GetCameras(_));
+    EXPECT_CALL(*mockCameraHostManager, GetCameraAbility(_, _));
+    std::vector<sptr<CameraInfo>> cameras = cameraManager->GetCameras();
+
+    sptr<CaptureInput> input = cameraManager->CreateCameraInput(cameras[0]);
+    ASSERT_NE(input, nullptr);
+
+    sptr<CaptureOutput> preview = CreatePreviewOutput();
+    ASSERT_NE(preview, nullptr);
+
+    sptr<CaptureOutput> analysis = CreatePreviewOutput();
+    ASSERT_NE(analysis, nullptr);
+
+    float invalidFps = -1;
+    int32_t ret = ((sptr<PreviewOutput> &)analysis)->SetFps(invalidFps);
+    EXPECT_NE(ret, 0);
+
+    float analysisFps = 5;
+    ret = ((sptr<PreviewOutput> &)analysis)->SetFps(analysisFps);
+    EXPECT_EQ(ret, 0);
+
+    sptr<CaptureSession> session = cameraManager->CreateCaptureSession();
+    ASSERT_NE(session, nullptr);
+
+    ret = session->BeginConfig();
+    EXPECT_EQ(ret, 0);
+
+    ret = session->AddInput(input);
+    EXPECT_EQ(ret, 0);
+
+    ret = session->AddOutput(preview);
+    EXPECT_EQ(ret, 0);
+
+    ret = session->AddOutput(analysis);
+    EXPECT_EQ(ret, 0);
+
+    EXPECT_CALL(*mockCameraHostManager, OpenCameraDevice(_, _, _));
+    EXPECT_CALL(*mockCameraDevice, SetResultMode(ON_CHANGED));
+    EXPECT_CALL(*mockCameraDevice, GetStreamOperator(_, _));
+    EXPECT_CALL(*mockCameraHostManager, GetCameraAbility(_, _));
+#ifndef PRODUCT_M40
+    EXPECT_CALL(*mockStreamOperator, IsStreamsSupported(_, _,
+        A<const std::vector<StreamInfo> &>(), _));
+#endif
+    EXPECT_CALL(*mockStreamOperator, CreateStreams(_));
+    EXPECT_CALL(*mockStreamOperator, CommitStreams(_, _));
+    ret = session->CommitConfig();
+    EXPECT_EQ(ret, 0);
+
+    EXPECT_CALL(*mockStreamOperator, Capture(_, _, true)).Times(2);
+    ret = session->Start();
+    EXPECT_EQ(ret, 0);
+
+    float changedFps = 10;
+    EXPECT_CALL(*mockStreamOperator, Capture(_, _, _)).Times(0);
+    ret = ((sptr<PreviewOutput> &)analysis)->SetFps(changedFps);
+    EXPECT_EQ(ret, 0);
+
+    float achievedFps = -1;
+    ret = ((sptr<PreviewOutput> &)analysis)->GetAchievedFps(achievedFps);
+    EXPECT_EQ(ret, 0);
+    EXPECT_GE(achievedFps, 0);
+
+    EXPECT_CALL(*mockStreamOperator, CancelCapture(_)).Times(2);
+    ret = session->Stop();
+    EXPECT_EQ(ret, 0);
+
+    EXPECT_CALL(*mockStreamOperator, ReleaseStreams(_));
+    EXPECT_CALL(*mockCameraDevice, Close());
+    session->Release();
+}
+
+/*
+ * Feature: Framework
+ * Function: Test asynchronous commit of the session configuration
+ * SubFunction: NA
+ * FunctionPoints: NA
+ * EnvConditions: NA
+ * CaseDescription: Test CommitConfigAsync returns a transaction id and reports the commit result
+ * to the completion with the same transaction id
+ */
+HWTEST_F(CameraFrameworkUnitTest, camera_framework_unittest_054, TestSize.Level0)
+{
+    InSequence s;
+    EXPECT_CALL(*mockCameraHostManager, GetCameras(_));
+    EXPECT_CALL(*mockCameraHostManager, GetCameraAbility(_, _));
+    std::vector<sptr<CameraInfo>> cameras = cameraManager->GetCameras();
+
+    sptr<CaptureInput> input = cameraManager->CreateCameraInput(cameras[0]);
+    ASSERT_NE(input, nullptr);
+
+    sptr<CaptureOutput> preview = CreatePreviewOutput();
+    ASSERT_NE(preview, nullptr);
+
+    sptr<CaptureOutput> photo = CreatePhotoOutput();
+    ASSERT_NE(photo, nullptr);
+
+    sptr<CaptureSession> session = cameraManager->CreateCaptureSession();
+    ASSERT_NE(session, nullptr);
+
+    int32_t ret = session->BeginConfig();
+    EXPECT_EQ(ret, 0);
+
+    ret = session->AddInput(input);
+    EXPECT_EQ(ret, 0);
+
+    ret = session->AddOutput(preview);
+    EXPECT_EQ(ret, 0);
+
+    ret = session->AddOutput(photo);
+    EXPECT_EQ(ret, 0);
+
+    EXPECT_CALL(*mockCameraHostManager, OpenCameraDevice(_, _, _));
+    EXPECT_CALL(*mockCameraDevice, SetResultMode(ON_CHANGED));
+    EXPECT_CALL(*mockCameraDevice, GetStreamOperator(_, _));
+    EXPECT_CALL(*mockCameraHostManager, GetCameraAbility(_, _));
+#ifndef PRODUCT_M40
+    EXPECT_CALL(*mockStreamOperator, IsStreamsSupported(_, _,
+        A<const std::vector<StreamInfo> &>(), _));
+#endif
+    EXPECT_CALL(*mockStreamOperator, CreateStreams(_));
+    EXPECT_CALL(*mockStreamOperator, CommitStreams(_, _));
+    std::promise<std::pair<int32_t, int32_t>> commitDone;
+    std::future<std::pair<int32_t, int32_t>> commitResult = commitDone.get_future();
+    int32_t transactionId = 0;
+    ret = session->CommitConfigAsync(transactionId, [&commitDone](int32_t transactionId, int32_t errorCode) {
+        commitDone.set_value(std::make_pair(transactionId, errorCode));
+    });
+    EXPECT_EQ(ret, 0);
+    EXPECT_GT(transactionId, 0);
+
+    const int32_t commitTimeoutSec = 5;
+    ASSERT_EQ(commitResult.wait_for(std::chrono::seconds(commitTimeoutSec)), std::future_status::ready);
+    std::pair<int32_t, int32_t> result = commitResult.get();
+    EXPECT_EQ(result.first, transactionId);
+    EXPECT_EQ(result.second, 0);
+
+    EXPECT_CALL(*mockStreamOperator, Capture(_, _, true));
+    ret = session->Start();
+    EXPECT_EQ(ret, 0);
+
+    EXPECT_CALL(*mockStreamOperator, CancelCapture(_));
+    ret = session->Stop();
+    EXPECT_EQ(ret, 0);
+
+    EXPECT_CALL(*mockStreamOperator, ReleaseStreams(_));
+    EXPECT_CALL(*mockCameraDevice, Close());
+    session->Release();
+}
+
+/*
+ * Feature: Framework
+ * Function: Test reopen of a kept alive camera device
+ * SubFunction: NA
+ * FunctionPoints: NA
+ * EnvConditions: NA
+ * CaseDescription: Test a camera device released with keep-alive enabled stays open, is reused by the next
+ * session without opening the HDI device again and is closed once keep-alive is disabled
+ */
+HWTEST_F(CameraFrameworkUnitTest, camera_framework_unittest_055, TestSize.Level0)
+{
+    InSequence s;
+    const int32_t keepAliveMs = 3000;
+    mockCameraHostManager->SetDeviceKeepAliveTime(keepAliveMs);
+
+    EXPECT_CALL(*mockCameraHostManager, GetCameras(_));
+    EXPECT_CALL(*mockCameraHostManager, GetCameraAbility(_, _));
+    std::vector<sptr<CameraInfo>> cameras = cameraManager->GetCameras();
+
+    sptr<CaptureInput> input = cameraManager->CreateCameraInput(cameras[0]);
+    ASSERT_NE(input, nullptr);
+
+    sptr<CaptureOutput> preview = CreatePreviewOutput();
+    ASSERT_NE(preview, nullptr);
+
+    sptr<CaptureSession> session = cameraManager->CreateCaptureSession();
+    ASSERT_NE(session, nullptr);
+
+    int32_t ret = session->BeginConfig();
+    EXPECT_EQ(ret, 0);
+
+    ret = session->AddInput(input);
+    EXPECT_EQ(ret, 0);
+
+    ret = session->AddOutput(preview);
+    EXPECT_EQ(ret, 0);
+
+    EXPECT_CALL(*mockCameraHostManager, OpenCameraDevice(_, _, _));
+    EXPECT_CALL(*mockCameraDevice, SetResultMode(ON_CHANGED));
+    EXPECT_CALL(*mockCameraDevice, GetStreamOperator(_, _));
+    EXPECT_CALL(*mockCameraHostManager, GetCameraAbility(_, _));
+#ifndef PRODUCT_M40
+    EXPECT_CALL(*mockStreamOperator, IsStreamsSupported(_, _,
+        A<const std::vector<StreamInfo> &>(), _));
+#endif
+    EXPECT_CALL(*mockStreamOperator, CreateStreams(_));
+    EXPECT_CALL(*mockStreamOperator, CommitStreams(_, _));
+    ret = session->CommitConfig();
+    EXPECT_EQ(ret, 0);
+
+    EXPECT_CALL(*mockStreamOperator, ReleaseStreams(_));
+    EXPECT_CALL(*mockCameraDevice, Close()).Times(0);
+    session->Release();
+
+    sptr<CaptureOutput> reopenPreview = CreatePreviewOutput();
+    ASSERT_NE(reopenPreview, nullptr);
+
+    sptr<CaptureSession> reopenSession = cameraManager->CreateCaptureSession();
+    ASSERT_NE(reopenSession, nullptr);
+
+    ret = reopenSession->BeginConfig();
+    EXPECT_EQ(ret, 0);
+
+    ret = reopenSession->AddInput(input);
+    EXPECT_EQ(ret, 0);
+
+    ret = reopenSession->AddOutput(reopenPreview);
+    EXPECT_EQ(ret, 0);
+
+    EXPECT_CALL(*mockCameraHostManager, OpenCameraDevice(_, _, _)).Times(0);
+    EXPECT_CALL(*mockCameraDevice, SetResultMode(_)).Times(0);
+    EXPECT_CALL(*mockCameraDevice, GetStreamOperator(_, _));
+    EXPECT_CALL(*mockCameraHostManager, GetCameraAbility(_, _));
+#ifndef PRODUCT_M40
+    EXPECT_CALL(*mockStreamOperator, IsStreamsSupported(_, _,
+        A<const std::vector<StreamInfo> &>(), _));
+#endif
+    EXPECT_CALL(*mockStreamOperator, CreateStreams(_));
+    EXPECT_CALL(*mockStreamOperator, CommitStreams(_, _));
+    ret = reopenSession->CommitConfig();
+    EXPECT_EQ(ret, 0);
+
+    EXPECT_CALL(*mockStreamOperator, ReleaseStreams(_));
+    reopenSession->Release();
+
+    EXPECT_CALL(*mockCameraDevice, Close());
+    mockCameraHostManager->SetDeviceKeepAliveTime(0);
+}
+
+/*
+ * Feature: Framework
+ * Function: Test camera device prewarm
+ * SubFunction: NA
+ * FunctionPoints: NA
+ * EnvConditions: NA
+ * CaseDescription: Test with prewarm enabled the device and stream operator are obtained when the camera input
+ * is created, CommitConfig uses them and an unused prewarm is closed when the input is released. The prewarm
+ * runs on its own thread, so the test waits for it before setting up the next expectations
+ */
+HWTEST_F(CameraFrameworkUnitTest, camera_framework_unittest_056, TestSize.Level0)
+{
+    InSequence s;
+    mockCameraHostManager->SetDevicePrewarm(true);
+    const int32_t prewarmTimeoutSec = 5;
+    sptr<MockCameraDevice> cameraDevice = mockCameraDevice;
+    auto expectPrewarm = [cameraDevice](std::promise<void> &prewarmDone) {
+        EXPECT_CALL(*cameraDevice, GetStreamOperator(_, _)).WillOnce([cameraDevice, &prewarmDone](
+            const OHOS::sptr<IStreamOperatorCallback> &callback, OHOS::sptr<IStreamOperator> &streamOperator) {
+            streamOperator = cameraDevice->streamOperator;
+            prewarmDone.set_value();
+            return HDI::Camera::V1_0::NO_ERROR;
+        });
+    };
+
+    EXPECT_CALL(*mockCameraHostManager, GetCameras(_));
+    EXPECT_CALL(*mockCameraHostManager, GetCameraAbility(_, _));
+    std::vector<sptr<CameraInfo>> cameras = cameraManager->GetCameras();
+
+    std::promise<void> prewarmDone;
+    EXPECT_CALL(*mockCameraHostManager, OpenCameraDevice(_, _, _));
+    EXPECT_CALL(*mockCameraDevice, SetResultMode(ON_CHANGED));
+    expectPrewarm(prewarmDone);
+    sptr<CaptureInput> input = cameraManager->CreateCameraInput(cameras[0]);
+    ASSERT_NE(input, nullptr);
+    ASSERT_EQ(prewarmDone.get_future().wait_for(std::chrono::seconds(prewarmTimeoutSec)),
+              std::future_status::ready);
+
+    sptr<CaptureOutput> preview = CreatePreviewOutput();
+    ASSERT_NE(preview, nullptr);
+
+    sptr<CaptureSession> session = cameraManager->CreateCaptureSession();
+    ASSERT_NE(session, nullptr);
+
+    int32_t ret = session->BeginConfig();
+    EXPECT_EQ(ret, 0);
+
+    ret = session->AddInput(input);
+    EXPECT_EQ(ret, 0);
+
+    ret = session->AddOutput(preview);
+    EXPECT_EQ(ret, 0);
+
+    EXPECT_CALL(*mockCameraHostManager, GetCameraAbility(_, _));
+#ifndef PRODUCT_M40
+    EXPECT_CALL(*mockStreamOperator, IsStreamsSupported(_, _,
+        A<const std::vector<StreamInfo> &>(), _));
+#endif
+    EXPECT_CALL(*mockStreamOperator, CreateStreams(_));
+    EXPECT_CALL(*mockStreamOperator, CommitStreams(_, _));
+    ret = session->CommitConfig();
+    EXPECT_EQ(ret, 0);
+
+    EXPECT_CALL(*mockStreamOperator, ReleaseStreams(_));
+    EXPECT_CALL(*mockCameraDevice, Close());
+    session->Release();
+
+    std::promise<void> unusedPrewarmDone;
+    EXPECT_CALL(*mockCameraHostManager, OpenCameraDevice(_, _, _));
+    EXPECT_CALL(*mockCameraDevice, SetResultMode(ON_CHANGED));
+    expectPrewarm(unusedPrewarmDone);
+    sptr<CaptureInput> unusedInput = cameraManager->CreateCameraInput(cameras[0]);
+    ASSERT_NE(unusedInput, nullptr);
+    ASSERT_EQ(unusedPrewarmDone.get_future().wait_for(std::chrono::seconds(prewarmTimeoutSec)),
+              std::future_status::ready);
+
+    EXPECT_CALL(*mockCameraDevice, Close());
+    unusedInput->Release();
+    mockCameraHostManager->SetDevicePrewarm(false);
+}
+
+/*
+ * Feature: Framework
+ * Function: Test incremental session reconfiguration
+ * SubFunction: NA
+ * FunctionPoints: NA
+ * EnvConditions: NA
+ * CaseDescription: Test adding an output while previewing creates and commits only the new stream without
+ * stopping the preview, and removing it detaches and releases it without committing the streams again
+ */
+HWTEST_F(CameraFrameworkUnitTest, camera_framework_unittest_057, TestSize.Level0)
+{
+    InSequence s;
+    EXPECT_CALL(*mockCameraHostManager, GetCameras(_));
+    EXPECT_CALL(*mockCameraHostManager, GetCameraAbility(_, _));
+    std::vector<sptr<CameraInfo>> cameras = cameraManager->GetCameras();
+
+    sptr<CaptureInput> input = cameraManager->CreateCameraInput(cameras[0]);
+    ASSERT_NE(input, nullptr);
+
+    sptr<CaptureOutput> preview = CreatePreviewOutput();
+    ASSERT_NE(preview, nullptr);
+
+    sptr<CaptureOutput> video = CreateVideoOutput();
+    ASSERT_NE(video, nullptr);
+
+    sptr<CaptureSession> session = cameraManager->CreateCaptureSession();
+    ASSERT_NE(session, nullptr);
+
+    int32_t ret = session->BeginConfig();
+    EXPECT_EQ(ret, 0);
+
+    ret = session->AddInput(input);
+    EXPECT_EQ(ret, 0);
+
+    ret = session->AddOutput(preview);
+    EXPECT_EQ(ret, 0);
+
+    EXPECT_CALL(*mockCameraHostManager, OpenCameraDevice(_, _, _));
+    EXPECT_CALL(*mockCameraDevice, SetResultMode(ON_CHANGED));
+    EXPECT_CALL(*mockCameraDevice, GetStreamOperator(_, _));
+    EXPECT_CALL(*mockCameraHostManager, GetCameraAbility(_, _));
+#ifndef PRODUCT_M40
+    EXPECT_CALL(*mockStreamOperator, IsStreamsSupported(_, _,
+        A<const std::vector<StreamInfo> &>(), _));
+#endif
+    EXPECT_CALL(*mockStreamOperator, CreateStreams(_));
+    EXPECT_CALL(*mockStreamOperator, CommitStreams(_, _));
+    ret = session->CommitConfig();
+    EXPECT_EQ(ret, 0);
+
+    EXPECT_CALL(*mockStreamOperator, Capture(_, _, true));
+    ret = session->Start();
+    EXPECT_EQ(ret, 0);
+
+    ret = session->BeginConfig();
+    EXPECT_EQ(ret, 0);
+
+    ret = session->AddOutput(video);
+    EXPECT_EQ(ret, 0);
+
+    EXPECT_CALL(*mockStreamOperator, CancelCapture(_)).Times(0);
+    EXPECT_CALL(*mockStreamOperator, ReleaseStreams(_)).Times(0);
+#ifndef PRODUCT_M40
+    EXPECT_CALL(*mockStreamOperator, IsStreamsSupported(_, _,
+        A<const std::vector<StreamInfo> &>(), _));
+#endif
+    EXPECT_CALL(*mockStreamOperator, CreateStreams(_));
+    EXPECT_CALL(*mockStreamOperator, CommitStreams(_, _));
+    ret = session->CommitConfig();
+    EXPECT_EQ(ret, 0);
+
+    ret = session->BeginConfig();
+    EXPECT_EQ(ret, 0);
+
+    ret = session->RemoveOutput(video);
+    EXPECT_EQ(ret, 0);
+
+    EXPECT_CALL(*mockStreamOperator, DetachBufferQueue(_));
+    EXPECT_CALL(*mockStreamOperator, CommitStreams(_, _)).Times(0);
+    EXPECT_CALL(*mockStreamOperator, ReleaseStreams(_));
+    ret = session->CommitConfig();
+    EXPECT_EQ(ret, 0);
+
+    EXPECT_CALL(*mockStreamOperator, CancelCapture(_));
+    ret = session->Stop();
+    EXPECT_EQ(ret, 0);
+
+    EXPECT_CALL(*mockStreamOperator, ReleaseStreams(_));
+    EXPECT_CALL(*mockCameraDevice, Close());
+    session->Release();
+}
+
+/*
+ * Feature: Framework
+ * Function: Test deferred preview surface
+ * SubFunction: NA
+ * FunctionPoints: NA
+ * EnvConditions: NA
+ * CaseDescription: Test a preview output created with only a size and format can be committed and started,
+ * and its surface is attached to the running stream when it is added
+ */
+HWTEST_F(CameraFrameworkUnitTest, camera_framework_unittest_058, TestSize.Level0)
+{
+    InSequence s;
+    EXPECT_CALL(*mockCameraHostManager, GetCameras(_));
+    EXPECT_CALL(*mockCameraHostManager, GetCameraAbility(_, _));
+    std::vector<sptr<CameraInfo>> cameras = cameraManager->GetCameras();
+
+    sptr<CaptureInput> input = cameraManager->CreateCameraInput(cameras[0]);
+    ASSERT_NE(input, nullptr);
+
+    sptr<PreviewOutput> preview = cameraManager->CreateDeferredPreviewOutput(OHOS_CAMERA_FORMAT_YCRCB_420_SP,
+        PREVIEW_DEFAULT_WIDTH, PREVIEW_DEFAULT_HEIGHT);
+    ASSERT_NE(preview, nullptr);
+    EXPECT_EQ(cameraManager->CreateDeferredPreviewOutput(OHOS_CAMERA_FORMAT_YCRCB_420_SP, 0, 0), nullptr);
+
+    sptr<CaptureSession> session = cameraManager->CreateCaptureSession();
+    ASSERT_NE(session, nullptr);
+
+    int32_t ret = session->BeginConfig();
+    EXPECT_EQ(ret, 0);
+
+    ret = session->AddInput(input);
+    EXPECT_EQ(ret, 0);
+
+    sptr<CaptureOutput> output = preview;
+    ret = session->AddOutput(output);
+    EXPECT_EQ(ret, 0);
+
+    EXPECT_CALL(*mockCameraHostManager, OpenCameraDevice(_, _, _));
+    EXPECT_CALL(*mockCameraDevice, SetResultMode(ON_CHANGED));
+    EXPECT_CALL(*mockCameraDevice, GetStreamOperator(_, _));
+    EXPECT_CALL(*mockCameraHostManager, GetCameraAbility(_, _));
+#ifndef PRODUCT_M40
+    EXPECT_CALL(*mockStreamOperator, IsStreamsSupported(_, _,
+        A<const std::vector<StreamInfo> &>(), _));
+#endif
+    EXPECT_CALL(*mockStreamOperator, CreateStreams(_));
+    EXPECT_CALL(*mockStreamOperator, CommitStreams(_, _));
+    ret = session->CommitConfig();
+    EXPECT_EQ(ret, 0);
+
+    EXPECT_CALL(*mockStreamOperator, Capture(_, _, true));
+    ret = session->Start();
+    EXPECT_EQ(ret, 0);
+
+    sptr<Surface> surface = Surface::CreateSurfaceAsConsumer();
+    ASSERT_NE(surface, nullptr);
+    surface->SetDefaultWidthAndHeight(PREVIEW_DEFAULT_WIDTH, PREVIEW_DEFAULT_HEIGHT);
+    EXPECT_CALL(*mockStreamOperator, AttachBufferQueue(_, _));
+    ret = preview->AddDeferredSurface(surface);
+    EXPECT_EQ(ret, 0);
+
+    EXPECT_CALL(*mockStreamOperator, AttachBufferQueue(_, _)).Times(0);
+    ret = preview->AddDeferredSurface(surface);
+    EXPECT_NE(ret, 0);
+
+    EXPECT_CALL(*mockStreamOperator, CancelCapture(_));
+    ret = session->Stop();
+    EXPECT_EQ(ret, 0);
+
+    EXPECT_CALL(*mockStreamOperator, ReleaseStreams(_));
+    EXPECT_CALL(*mockCameraDevice, Close());
+    session->Release();
+}
+
+/*
+ * Feature: Framework
+ * Function: Test grouped session start
+ * SubFunction: NA
+ * FunctionPoints: NA
+ * EnvConditions: NA
+ * CaseDescription: Test StartGrouped starts preview, video and metadata outputs with one repeating request,
+ * stopping the video output alone reissues the request for the other outputs and session Stop cancels it once
+ */
+HWTEST_F(CameraFrameworkUnitTest, camera_framework_unittest_059, TestSize.Level0)
+{
+    InSequence s;
+    EXPECT_CALL(*mockCameraHostManager, GetCameras(_));
+    EXPECT_CALL(*mockCameraHostManager, GetCameraAbility(_, _));
+    std::vector<sptr<CameraInfo>> cameras = cameraManager->GetCameras();
+
+    sptr<CaptureInput> input = cameraManager->CreateCameraInput(cameras[0]);
+    ASSERT_NE(input, nullptr);
+
+    sptr<CaptureOutput> preview = CreatePreviewOutput();
+    ASSERT_NE(preview, nullptr);
+
+    sptr<CaptureOutput> video = CreateVideoOutput();
+    ASSERT_NE(video, nullptr);
+
+    sptr<CaptureOutput> metadata = cameraManager->CreateMetadataOutput();
+    ASSERT_NE(metadata, nullptr);
+
+    sptr<CaptureSession> session = cameraManager->CreateCaptureSession();
+    ASSERT_NE(session, nullptr);
+
+    int32_t ret = session->BeginConfig();
+    EXPECT_EQ(ret, 0);
+
+    ret = session->AddInput(input);
+    EXPECT_EQ(ret, 0);
+
+    ret = session->AddOutput(preview);
+    EXPECT_EQ(ret, 0);
+
+    ret = session->AddOutput(video);
+    EXPECT_EQ(ret, 0);
+
+    ret = session->AddOutput(metadata);
+    EXPECT_EQ(ret, 0);
+
+    EXPECT_CALL(*mockCameraHostManager, OpenCameraDevice(_, _, _));
+    EXPECT_CALL(*mockCameraDevice, SetResultMode(ON_CHANGED));
+    EXPECT_CALL(*mockCameraDevice, GetStreamOperator(_, _));
+    EXPECT_CALL(*mockCameraHostManager, GetCameraAbility(_, _));
+#ifndef PRODUCT_M40
+    EXPECT_CALL(*mockStreamOperator, IsStreamsSupported(_, _,
+        A<const std::vector<StreamInfo> &>(), _));
+#endif
+    EXPECT_CALL(*mockStreamOperator, CreateStreams(_));
+    EXPECT_CALL(*mockStreamOperator, CommitStreams(_, _));
+    ret = session->CommitConfig();
+    EXPECT_EQ(ret, 0);
+
+    const size_t groupSize = 3;
+    EXPECT_CALL(*mockStreamOperator, Capture(_, Truly([groupSize](const CaptureInfo &info) {
+        return info.streamIds_.size() == groupSize;
+    }), true));
+    ret = session->StartGrouped();
+    EXPECT_EQ(ret, 0);
+
+    EXPECT_CALL(*mockStreamOperator, Capture(_, _, _)).Times(0);
+    EXPECT_CALL(*mockStreamOperator, CancelCapture(_)).Times(0);
+    EXPECT_NE(session->StartGrouped(), 0);
+    EXPECT_NE(((sptr<VideoOutput> &)video)->Start(), 0);
+
+    EXPECT_CALL(*mockStreamOperator, CancelCapture(_));
+    EXPECT_CALL(*mockStreamOperator, Capture(_, Truly([groupSize](const CaptureInfo &info) {
+        return info.streamIds_.size() == groupSize - 1;
+    }), true));
+    EXPECT_EQ(((sptr<VideoOutput> &)video)->Stop(), 0);
+
+    EXPECT_CALL(*mockStreamOperator, CancelCapture(_));
+    ret = session->Stop();
+    EXPECT_EQ(ret, 0);
+
+    EXPECT_CALL(*mockStreamOperator, ReleaseStreams(_));
+    EXPECT_CALL(*mockCameraDevice, Close());
+    session->Release();
+}
+
+/*
+ * Feature: Framework
+ * Function: Test service jpeg encoder
+ * SubFunction: NA
+ * FunctionPoints: NA
+ * EnvConditions: NA
+ * CaseDescription: Test an NV21 frame tall enough to be split into strips is encoded into one JPEG
+ * with restart markers between the strips and the requested orientation in its EXIF data, that it
+ * decodes to the same pixels as the single pass encode and that a frame whose strips would need a
+ * restart interval above the 16 bit limit of the DRI segment is cut into more strips and still matches
+ */
+HWTEST_F(CameraFrameworkUnitTest, camera_framework_unittest_060, TestSize.Level0)
+{
+    const int32_t width = 64;
+    const int32_t height = 256;
+    const int32_t orientation = 90;
+    const uint8_t exifRotate90 = 6;
+    std::vector<uint8_t> frame(width * height * 3 / 2);
+    for (int32_t i = 0; i < width * height; i++) {
+        frame[i] = static_cast<uint8_t>(i % width);
+    }
+    std::fill(frame.begin() + width * height, frame.end(), 128);
+    NV21Image image = {frame.data(), frame.data() + width * height, width, height, width};
+
+    sptr<JpegEncoder> encoder = new(std::nothrow) JpegEncoder(nullptr);
+    ASSERT_NE(encoder, nullptr);
+    std::vector<uint8_t> jpeg;
+    int32_t ret = encoder->Encode(image, JPEG_DEFAULT_QUALITY, orientation, jpeg);
+    EXPECT_EQ(ret, 0);
+    ASSERT_GT(jpeg.size(), 4);
+    EXPECT_EQ(jpeg[0], 0xFF);
+    EXPECT_EQ(jpeg[1], 0xD8);
+    EXPECT_EQ(jpeg[jpeg.size() - 2], 0xFF);
+    EXPECT_EQ(jpeg[jpeg.size() - 1], 0xD9);
+
+    const uint8_t exifTag[] = {'E', 'x', 'i', 'f', 0x00, 0x00};
+    auto exif = std::search(jpeg.begin(), jpeg.end(), exifTag, exifTag + sizeof(exifTag));
+    ASSERT_NE(exif, jpeg.end());
+    const uint8_t orientationEntry[] = {0x01, 0x12, 0x00, 0x03, 0x00, 0x00, 0x00, 0x01, 0x00, exifRotate90};
+    EXPECT_NE(std::search(exif, jpeg.end(), orientationEntry, orientationEntry + sizeof(orientationEntry)),
+              jpeg.end());
+
+    const uint8_t firstRestart[] = {0xFF, 0xD0};
+    EXPECT_NE(std::search(jpeg.begin(), jpeg.end(), firstRestart, firstRestart + sizeof(firstRestart)),
+              jpeg.end());
+
+    std::vector<uint8_t> singlePass;
+    EXPECT_EQ(encoder->Encode(image, JPEG_DEFAULT_QUALITY, orientation, singlePass, false), 0);
+    EXPECT_EQ(std::search(singlePass.begin(), singlePass.end(), firstRestart, firstRestart + sizeof(firstRestart)),
+              singlePass.end());
+    EXPECT_TRUE(IsSameDecodedJpeg(jpeg, singlePass));
+
+    // 256 MCUs wide, four strips of 257 MCU rows would need a restart interval of 65792
+    const int32_t largeWidth = 4096;
+    const int32_t largeHeight = 16448;
+    const size_t largeLumaSize = static_cast<size_t>(largeWidth) * largeHeight;
+    std::vector<uint8_t> largeFrame(largeLumaSize * 3 / 2, 128);
+    for (size_t i = 0; i < largeLumaSize; i++) {
+        largeFrame[i] = static_cast<uint8_t>((i % largeWidth) ^ (i / largeWidth));
+    }
+    NV21Image largeImage = {largeFrame.data(), largeFrame.data() + largeLumaSize, largeWidth, largeHeight,
+                            largeWidth};
+    std::vector<uint8_t> largeStriped;
+    std::vector<uint8_t> largeSinglePass;
+    EXPECT_EQ(encoder->Encode(largeImage, JPEG_DEFAULT_QUALITY, 0, largeStriped), 0);
+    EXPECT_EQ(encoder->Encode(largeImage, JPEG_DEFAULT_QUALITY, 0, largeSinglePass, false), 0);
+    EXPECT_TRUE(IsSameDecodedJpeg(largeStriped, largeSinglePass));
+
+    EXPECT_NE(encoder->Encode({nullptr, nullptr, width, height, width}, JPEG_DEFAULT_QUALITY, 0, jpeg), 0);
+    encoder->Release();
+}
+
+/*
+ * Feature: Framework
+ * Function: Test service pixel format conversion
+ * SubFunction: NA
+ * FunctionPoints: NA
+ * EnvConditions: NA
+ * CaseDescription: Test conversions between NV21, NV12, I420 and RGBA_8888 give the same output with and
+ * without SIMD for sizes that leave partial vectors, that swapping the chroma order round trips exactly,
+ * that black and white keep their values through RGBA and that an odd width semi-planar image needs a stride
+ * that holds its last chroma pair
+ */
+HWTEST_F(CameraFrameworkUnitTest, camera_framework_unittest_061, TestSize.Level0)
+{
+    const int32_t formats[] = {PIXEL_FMT_YCRCB_420_SP, PIXEL_FMT_YCBCR_420_SP, PIXEL_FMT_YCBCR_420_P,
+                               PIXEL_FMT_RGBA_8888};
+    const int32_t sizes[][2] = {{1, 1}, {37, 19}, {64, 32}};
+    const int32_t rgbaBytesPerPixel = 4;
+    const int32_t padding = 6;
+    auto getStride = [rgbaBytesPerPixel, padding](int32_t format, int32_t width) {
+        return ((format == PIXEL_FMT_RGBA_8888) ? width * rgbaBytesPerPixel : width) + padding;
+    };
+    for (auto &size : sizes) {
+        int32_t width = size[0];
+        int32_t height = size[1];
+        for (int32_t srcFormat : formats) {
+            int32_t srcStride = getStride(srcFormat, width);
+            std::vector<uint8_t> srcData(GetImageSize(srcFormat, srcStride, height));
+            for (size_t i = 0; i < srcData.size(); i++) {
+                srcData[i] = static_cast<uint8_t>((i * 131) ^ (i >> 3));
+            }
+            ImageBuffer src = {srcData.data(), srcData.size(), srcFormat, width, height, srcStride};
+            for (int32_t dstFormat : formats) {
+                int32_t dstStride = getStride(dstFormat, width);
+                std::vector<uint8_t> scalarData(GetImageSize(dstFormat, dstStride, height));
+                std::vector<uint8_t> simdData(scalarData.size());
+                ImageBuffer scalarDst = {scalarData.data(), scalarData.size(), dstFormat, width, height, dstStride};
+                ImageBuffer simdDst = {simdData.data(), simdData.size(), dstFormat, width, height, dstStride};
+                EXPECT_EQ(ConvertImage(src, scalarDst, false), 0);
+                EXPECT_EQ(ConvertImage(src, simdDst, true), 0);
+                EXPECT_EQ(scalarData, simdData);
+            }
+        }
+    }
+
+    const int32_t width = 4;
+    const int32_t height = 2;
+    std::vector<uint8_t> nv21 = {16, 16, 235, 235, 16, 16, 235, 235, 128, 128, 128, 128};
+    std::vector<uint8_t> nv12(nv21.size());
+    std::vector<uint8_t> roundTrip(nv21.size());
+    ImageBuffer nv21Image = {nv21.data(), nv21.size(), PIXEL_FMT_YCRCB_420_SP, width, height, width};
+    ImageBuffer nv12Image = {nv12.data(), nv12.size(), PIXEL_FMT_YCBCR_420_SP, width, height, width};
+    ImageBuffer roundTripImage = {roundTrip.data(), roundTrip.size(), PIXEL_FMT_YCRCB_420_SP, width, height, width};
+    EXPECT_EQ(ConvertImage(nv21Image, nv12Image), 0);
+    EXPECT_EQ(ConvertImage(nv12Image, roundTripImage), 0);
+    EXPECT_EQ(nv21, roundTrip);
+
+    std::vector<uint8_t> rgba(width * height * rgbaBytesPerPixel);
+    ImageBuffer rgbaImage = {rgba.data(), rgba.size(), PIXEL_FMT_RGBA_8888, width, height, width * rgbaBytesPerPixel};
+    EXPECT_EQ(ConvertImage(nv21Image, rgbaImage), 0);
+    const std::vector<uint8_t> black = {0, 0, 0, 255};
+    const std::vector<uint8_t> white = {255, 255, 255, 255};
+    EXPECT_EQ(std::vector<uint8_t>(rgba.begin(), rgba.begin() + rgbaBytesPerPixel), black);
+    EXPECT_EQ(std::vector<uint8_t>(rgba.end() - rgbaBytesPerPixel, rgba.end()), white);
+    EXPECT_EQ(ConvertImage(rgbaImage, roundTripImage), 0);
+    EXPECT_EQ(nv21, roundTrip);
+
+    nv21Image.size = nv21.size() - 1;
+    EXPECT_NE(ConvertImage(nv21Image, nv12Image), 0);
+
+    // The interleaved chroma row of an odd width is one byte longer than its luma row
+    const int32_t oddWidth = 5;
+    const int32_t oddHeight = 3;
+    std::vector<uint8_t> oddSrc(GetImageSize(PIXEL_FMT_YCRCB_420_SP, oddWidth + 1, oddHeight), 128);
+    std::vector<uint8_t> oddDst(oddSrc.size());
+    ImageBuffer oddSrcImage = {oddSrc.data(), oddSrc.size(), PIXEL_FMT_YCRCB_420_SP, oddWidth, oddHeight, oddWidth};
+    ImageBuffer oddDstImage = {oddDst.data(), oddDst.size(), PIXEL_FMT_YCBCR_420_SP, oddWidth, oddHeight, oddWidth};
+    EXPECT_FALSE(IsValidImage(oddSrcImage));
+    EXPECT_NE(ConvertImage(oddSrcImage, oddDstImage), 0);
+    ImageBuffer oddScaledImage = {oddDst.data(), oddDst.size(), PIXEL_FMT_YCRCB_420_SP, oddWidth, oddHeight - 1,
+                                  oddWidth};
+    EXPECT_NE(ScaleImage(oddSrcImage, oddScaledImage), 0);
+    oddSrcImage.stride = oddWidth + 1;
+    oddDstImage.stride = oddWidth + 1;
+    EXPECT_TRUE(IsValidImage(oddSrcImage));
+    EXPECT_EQ(ConvertImage(oddSrcImage, oddDstImage), 0);
+}
+
+class HoldingSurfaceListener : public IBufferConsumerListener {
+public:
+    void OnBufferAvailable() override {}
+};
+
+class CountingSurfaceListener : public IBufferConsumerListener {
+public:
+    void OnBufferAvailable() override
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        count_++;
+        cond_.notify_all();
+    }
+
+    bool WaitForBuffers(uint32_t count)
+    {
+        const int32_t timeoutMs = 1000;
+        std::unique_lock<std::mutex> lock(mutex_);
+        return cond_.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this, count] { return count_ >= count; });
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    uint32_t count_ = 0;
+};
+
+/*
+ * Feature: Framework
+ * Function: Test service stream fan out
+ * SubFunction: NA
+ * FunctionPoints: NA
+ * EnvConditions: NA
+ * CaseDescription: Test every frame of the shared stream reaches each active consumer from the fan out
+ * worker and a consumer that holds its buffers drops frames without the other consumer losing any
+ */
+HWTEST_F(CameraFrameworkUnitTest, camera_framework_unittest_062, TestSize.Level0)
+{
+    const int32_t width = 64;
+    const int32_t height = 48;
+    const uint64_t frames = 4;
+    sptr<StreamFanOut> fanOut = new(std::nothrow) StreamFanOut();
+    ASSERT_NE(fanOut, nullptr);
+    ASSERT_EQ(fanOut->Init(width, height), 0);
+
+    sptr<IBufferConsumerListener> listener = new HoldingSurfaceListener();
+    sptr<CountingSurfaceListener> fastListener = new CountingSurfaceListener();
+    sptr<Surface> fastConsumer = Surface::CreateSurfaceAsConsumer();
+    sptr<Surface> slowConsumer = Surface::CreateSurfaceAsConsumer();
+    ASSERT_NE(fastConsumer, nullptr);
+    ASSERT_NE(slowConsumer, nullptr);
+    fastConsumer->RegisterConsumerListener(fastListener);
+    slowConsumer->RegisterConsumerListener(listener);
+    slowConsumer->SetQueueSize(1);
+    sptr<IBufferProducer> fastProducer = fastConsumer->GetProducer();
+    sptr<IBufferProducer> slowProducer = slowConsumer->GetProducer();
+    EXPECT_EQ(fanOut->AddConsumer(fastProducer), 0);
+    EXPECT_EQ(fanOut->AddConsumer(slowProducer), 0);
+    fanOut->SetConsumerActive(fastProducer, true);
+    fanOut->SetConsumerActive(slowProducer, true);
+
+    sptr<Surface> device = Surface::CreateSurfaceAsProducer(fanOut->GetProducer());
+    ASSERT_NE(device, nullptr);
+    BufferRequestConfig requestConfig = {
+        .width = width,
+        .height = height,
+        .strideAlignment = 8,
+        .format = PIXEL_FMT_YCRCB_420_SP,
+        .usage = HBM_USE_CPU_READ | HBM_USE_CPU_WRITE | HBM_USE_MEM_DMA,
+        .timeout = 0,
+    };
+    BufferFlushConfig flushConfig = {
+        .damage = {
+            .x = 0,
+            .y = 0,
+            .w = width,
+            .h = height,
+        },
+        .timestamp = 0,
+    };
+    for (uint64_t i = 0; i < frames; i++) {
+        sptr<SurfaceBuffer> buffer = nullptr;
+        int32_t fence = -1;
+        ASSERT_EQ(device->RequestBuffer(buffer, fence, requestConfig), SURFACE_ERROR_OK);
+        std::fill_n(static_cast<uint8_t *>(buffer->GetVirAddr()), buffer->GetSize(), static_cast<uint8_t>(i));
+        ASSERT_EQ(device->FlushBuffer(buffer, -1, flushConfig), SURFACE_ERROR_OK);
+
+        // The fast consumer returns every frame, the slow one never returns the first
+        ASSERT_TRUE(fastListener->WaitForBuffers(i + 1));
+        sptr<SurfaceBuffer> received = nullptr;
+        int64_t timestamp = 0;
+        OHOS::Rect damage;
+        ASSERT_EQ(fastConsumer->AcquireBuffer(received, fence, timestamp, damage), SURFACE_ERROR_OK);
+        EXPECT_EQ(static_cast<uint8_t *>(received->GetVirAddr())[0], static_cast<uint8_t>(i));
+        fastConsumer->ReleaseBuffer(received, -1);
+    }
+    // The counts of the last frame are updated after its copies
+    const int32_t pollMs = 10;
+    const int32_t pollCount = 100;
+    for (int32_t i = 0; i < pollCount && fanOut->GetDeliveredFrames(slowProducer)
+        + fanOut->GetDroppedFrames(slowProducer) < frames; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(pollMs));
+    }
+    EXPECT_EQ(fanOut->GetDeliveredFrames(fastProducer), frames);
+    EXPECT_EQ(fanOut->GetDroppedFrames(fastProducer), 0);
+    EXPECT_EQ(fanOut->GetDeliveredFrames(slowProducer), 1);
+    EXPECT_EQ(fanOut->GetDroppedFrames(slowProducer), frames - 1);
+
+    fanOut->RemoveConsumer(slowProducer);
+    EXPECT_EQ(fanOut->GetDeliveredFrames(slowProducer), 0);
+    fanOut->Release();
+    EXPECT_EQ(fanOut->GetProducer(), nullptr);
+}
+
+/*
+ * Feature: Framework
+ * Function: Test service image scaling
+ * SubFunction: NA
+ * FunctionPoints: NA
+ * EnvConditions: NA
+ * CaseDescription: Test scaling NV21, NV12, I420 and RGBA_8888 gives the same output with and without SIMD
+ * for sizes that leave partial vectors, that a flat image stays flat, that halving averages 2x2 blocks,
+ * that the crop to the destination aspect ratio drops the sides and that invalid images are rejected
+ */
+HWTEST_F(CameraFrameworkUnitTest, camera_framework_unittest_063, TestSize.Level0)
+{
+    const int32_t formats[] = {PIXEL_FMT_YCRCB_420_SP, PIXEL_FMT_YCBCR_420_SP, PIXEL_FMT_YCBCR_420_P,
+                               PIXEL_FMT_RGBA_8888};
+    const int32_t sizes[][4] = {{97, 61, 37, 19}, {64, 48, 32, 24}, {50, 30, 49, 29}, {160, 90, 17, 17}};
+    const int32_t rgbaBytesPerPixel = 4;
+    const int32_t padding = 6;
+    auto getStride = [rgbaBytesPerPixel, padding](int32_t format, int32_t width) {
+        return ((format == PIXEL_FMT_RGBA_8888) ? width * rgbaBytesPerPixel : width) + padding;
+    };
+    for (auto &size : sizes) {
+        for (int32_t format : formats) {
+            int32_t srcStride = getStride(format, size[0]);
+            std::vector<uint8_t> srcData(GetImageSize(format, srcStride, size[1]));
+            for (size_t i = 0; i < srcData.size(); i++) {
+                srcData[i] = static_cast<uint8_t>((i * 131) ^ (i >> 3));
+            }
+            ImageBuffer src = {srcData.data(), srcData.size(), format, size[0], size[1], srcStride};
+            int32_t dstStride = getStride(format, size[2]);
+            std::vector<uint8_t> scalarData(GetImageSize(format, dstStride, size[3]));
+            std::vector<uint8_t> simdData(scalarData.size());
+            ImageBuffer scalarDst = {scalarData.data(), scalarData.size(), format, size[2], size[3], dstStride};
+            ImageBuffer simdDst = {simdData.data(), simdData.size(), format, size[2], size[3], dstStride};
+            EXPECT_EQ(ScaleImage(src, scalarDst, false), 0);
+            EXPECT_EQ(ScaleImage(src, simdDst, true), 0);
+            EXPECT_EQ(scalarData, simdData);
+        }
+    }
+
+    const int32_t flatValue = 77;
+    std::vector<uint8_t> flat(GetImageSize(PIXEL_FMT_YCRCB_420_SP, 64, 48), flatValue);
+    std::vector<uint8_t> flatScaled(GetImageSize(PIXEL_FMT_YCRCB_420_SP, 20, 12));
+    ImageBuffer flatImage = {flat.data(), flat.size(), PIXEL_FMT_YCRCB_420_SP, 64, 48, 64};
+    ImageBuffer flatScaledImage = {flatScaled.data(), flatScaled.size(), PIXEL_FMT_YCRCB_420_SP, 20, 12, 20};
+    EXPECT_EQ(ScaleImage(flatImage, flatScaledImage), 0);
+    EXPECT_EQ(flatScaled, std::vector<uint8_t>(flatScaled.size(), flatValue));
+
+    std::vector<uint8_t> nv21 = {0, 2, 4, 6, 8, 10, 12, 14, 128, 128, 128, 128};
+    std::vector<uint8_t> halved(GetImageSize(PIXEL_FMT_YCRCB_420_SP, 2, 1));
+    ImageBuffer nv21Image = {nv21.data(), nv21.size(), PIXEL_FMT_YCRCB_420_SP, 4, 2, 4};
+    ImageBuffer halvedImage = {halved.data(), halved.size(), PIXEL_FMT_YCRCB_420_SP, 2, 1, 2};
+    EXPECT_EQ(ScaleImage(nv21Image, halvedImage), 0);
+    EXPECT_EQ(halved[0], 5);
+    EXPECT_EQ(halved[1], 9);
+
+    // 8x4 with two white columns on each side, cropped to a square before scaling to 2x2
+    const int32_t wideWidth = 8;
+    const int32_t wideHeight = 4;
+    const int32_t barWidth = 2;
+    const uint8_t centerValue = 100;
+    std::vector<uint8_t> wide(wideWidth * wideHeight * rgbaBytesPerPixel, centerValue);
+    for (int32_t row = 0; row < wideHeight; row++) {
+        for (int32_t column = 0; column < wideWidth; column++) {
+            if (column < barWidth || column >= wideWidth - barWidth) {
+                std::fill_n(wide.begin() + (row * wideWidth + column) * rgbaBytesPerPixel, rgbaBytesPerPixel, 255);
+            }
+        }
+    }
+    std::vector<uint8_t> square(2 * 2 * rgbaBytesPerPixel);
+    ImageBuffer wideImage = {wide.data(), wide.size(), PIXEL_FMT_RGBA_8888, wideWidth, wideHeight,
+                             wideWidth * rgbaBytesPerPixel};
+    ImageBuffer squareImage = {square.data(), square.size(), PIXEL_FMT_RGBA_8888, 2, 2, 2 * rgbaBytesPerPixel};
+    EXPECT_EQ(ScaleImage(wideImage, squareImage), 0);
+    EXPECT_EQ(square, std::vector<uint8_t>(square.size(), centerValue));
+
+    EXPECT_NE(ScaleImage(wideImage, halvedImage), 0);
+    wideImage.data = nullptr;
+    EXPECT_NE(ScaleImage(wideImage, squareImage), 0);
+}
+
+/*
+ * Feature: Framework
+ * Function: Test service image rotation and mirroring
+ * SubFunction: NA
+ * FunctionPoints: NA
+ * EnvConditions: NA
+ * CaseDescription: Test every rotation with and without mirroring gives the same output with and without
+ * SIMD for sizes that leave partial tiles, that pixels land where a clockwise rotation puts them, that the
+ * chroma pairs of NV21 keep their order and that invalid rotations and sizes are rejected
+ */
+HWTEST_F(CameraFrameworkUnitTest, camera_framework_unittest_064, TestSize.Level0)
+{
+    const int32_t formats[] = {PIXEL_FMT_YCRCB_420_SP, PIXEL_FMT_YCBCR_420_SP, PIXEL_FMT_YCBCR_420_P,
+                               PIXEL_FMT_RGBA_8888};
+    const int32_t sizes[][2] = {{1, 1}, {17, 9}, {40, 33}};
+    const int32_t rotations[] = {0, 90, 180, 270};
+    const int32_t rgbaBytesPerPixel = 4;
+    const int32_t padding = 6;
+    auto getStride = [rgbaBytesPerPixel, padding](int32_t format, int32_t width) {
+        return ((format == PIXEL_FMT_RGBA_8888) ? width * rgbaBytesPerPixel : width) + padding;
+    };
+    for (auto &size : sizes) {
+        for (int32_t format : formats) {
+            int32_t srcStride = getStride(format, size[0]);
+            std::vector<uint8_t> srcData(GetImageSize(format, srcStride, size[1]));
+            for (size_t i = 0; i < srcData.size(); i++) {
+                srcData[i] = static_cast<uint8_t>((i * 131) ^ (i >> 3));
+            }
+            ImageBuffer src = {srcData.data(), srcData.size(), format, size[0], size[1], srcStride};
+            for (int32_t rotation : rotations) {
+                bool isTransposed = (rotation == 90 || rotation == 270);
+                int32_t width = isTransposed ? size[1] : size[0];
+                int32_t height = isTransposed ? size[0] : size[1];
+                int32_t dstStride = getStride(format, width);
+                for (bool isMirrored : {false, true}) {
+                    std::vector<uint8_t> scalarData(GetImageSize(format, dstStride, height));
+                    std::vector<uint8_t> simdData(scalarData.size());
+                    ImageBuffer scalarDst = {scalarData.data(), scalarData.size(), format, width, height, dstStride};
+                    ImageBuffer simdDst = {simdData.data(), simdData.size(), format, width, height, dstStride};
+                    EXPECT_EQ(TransformImage(src, scalarDst, rotation, isMirrored, false), 0);
+                    EXPECT_EQ(TransformImage(src, simdDst, rotation, isMirrored, true), 0);
+                    EXPECT_EQ(scalarData, simdData);
+                }
+            }
+        }
+    }
+
+    // A 3x2 RGBA frame whose first channel numbers the pixels row by row
+    std::vector<uint8_t> rgba(3 * 2 * rgbaBytesPerPixel);
+    for (size_t i = 0; i < rgba.size(); i++) {
+        rgba[i] = static_cast<uint8_t>(i / rgbaBytesPerPixel);
+    }
+    ImageBuffer rgbaImage = {rgba.data(), rgba.size(), PIXEL_FMT_RGBA_8888, 3, 2, 3 * rgbaBytesPerPixel};
+    std::vector<uint8_t> transformed(rgba.size());
+    auto firstChannels = [&transformed, rgbaBytesPerPixel]() {
+        std::vector<uint8_t> channels;
+        for (size_t i = 0; i < transformed.size(); i += rgbaBytesPerPixel) {
+            channels.push_back(transformed[i]);
+        }
+        return channels;
+    };
+    ImageBuffer portrait = {transformed.data(), transformed.size(), PIXEL_FMT_RGBA_8888, 2, 3, 2 * rgbaBytesPerPixel};
+    ImageBuffer landscape = {transformed.data(), transformed.size(), PIXEL_FMT_RGBA_8888, 3, 2,
+                             3 * rgbaBytesPerPixel};
+    EXPECT_EQ(TransformImage(rgbaImage, portrait, 90, false), 0);
+    EXPECT_EQ(firstChannels(), std::vector<uint8_t>({3, 0, 4, 1, 5, 2}));
+    EXPECT_EQ(TransformImage(rgbaImage, portrait, 270, false), 0);
+    EXPECT_EQ(firstChannels(), std::vector<uint8_t>({2, 5, 1, 4, 0, 3}));
+    EXPECT_EQ(TransformImage(rgbaImage, landscape, 0, true), 0);
+    EXPECT_EQ(firstChannels(), std::vector<uint8_t>({2, 1, 0, 5, 4, 3}));
+    EXPECT_EQ(TransformImage(rgbaImage, landscape, 180, true), 0);
+    EXPECT_EQ(firstChannels(), std::vector<uint8_t>({3, 4, 5, 0, 1, 2}));
+
+    std::vector<uint8_t> nv21 = {1, 2, 3, 4, 5, 6, 7, 8, 10, 20, 30, 40};
+    std::vector<uint8_t> mirrored(nv21.size());
+    ImageBuffer nv21Image = {nv21.data(), nv21.size(), PIXEL_FMT_YCRCB_420_SP, 4, 2, 4};
+    ImageBuffer mirroredImage = {mirrored.data(), mirrored.size(), PIXEL_FMT_YCRCB_420_SP, 4, 2, 4};
+    EXPECT_EQ(TransformImage(nv21Image, mirroredImage, 0, true), 0);
+    EXPECT_EQ(mirrored, std::vector<uint8_t>({4, 3, 2, 1, 8, 7, 6, 5, 30, 40, 10, 20}));
+
+    EXPECT_NE(TransformImage(rgbaImage, landscape, 45, false), 0);
+    EXPECT_NE(TransformImage(rgbaImage, landscape, 90, false), 0);
+}
+
+/*
+ * Feature: Framework
+ * Function: Test reading HDI results in place
+ * SubFunction: NA
+ * FunctionPoints: NA
+ * EnvConditions: NA
+ * CaseDescription: Test the result reader finds the tags of a result serialized like the HDI does
+ * without decoding it, and that a truncated result passes the header check but fails item validation
+ */
+HWTEST_F(CameraFrameworkUnitTest, camera_framework_unittest_065, TestSize.Level0)
+{
+    int32_t itemCount = 10;
+    int32_t dataSize = 100;
+    std::shared_ptr<OHOS::Camera::CameraMetadata> metadata =
+        std::make_shared<OHOS::Camera::CameraMetadata>(itemCount, dataSize);
+    uint8_t flashMode = OHOS_CAMERA_FLASH_MODE_OPEN;
+    uint8_t focusState = OHOS_CAMERA_FOCUS_STATE_FOCUSED;
+    int32_t exposureCompensation = -2;
+    metadata->addEntry(OHOS_CONTROL_FLASH_MODE, &flashMode, 1);
+    metadata->addEntry(OHOS_CONTROL_AE_EXPOSURE_COMPENSATION, &exposureCompensation, 1);
+    metadata->addEntry(OHOS_CONTROL_FOCUS_STATE, &focusState, 1);
+    std::vector<uint8_t> result;
+    OHOS::Camera::MetadataUtils::ConvertMetadataToVec(metadata, result);
+
+    CameraResultReader reader(result);
+    ASSERT_TRUE(reader.IsValid());
+    EXPECT_TRUE(reader.ValidateItems());
+    EXPECT_EQ(reader.GetItemCount(), 3);
+    uint8_t value = 0;
+    EXPECT_TRUE(reader.FindByte(OHOS_CONTROL_FLASH_MODE, value));
+    EXPECT_EQ(value, flashMode);
+    EXPECT_TRUE(reader.FindByte(OHOS_CONTROL_FOCUS_STATE, value));
+    EXPECT_EQ(value, focusState);
+    EXPECT_FALSE(reader.FindByte(OHOS_CONTROL_FLASH_STATE, value));
+    ResultItem item;
+    ASSERT_TRUE(reader.Find(OHOS_CONTROL_AE_EXPOSURE_COMPENSATION, item));
+    EXPECT_EQ(item.dataType, META_TYPE_INT32);
+    EXPECT_EQ(item.count, 1);
+    const uint8_t *compensationBytes = reinterpret_cast<const uint8_t *>(&exposureCompensation);
+    EXPECT_EQ(std::vector<uint8_t>(item.data, item.data + item.dataSize),
+              std::vector<uint8_t>(compensationBytes, compensationBytes + sizeof(exposureCompensation)));
+
+    std::vector<uint8_t> truncated(result.begin(), result.end() - 1);
+    CameraResultReader truncatedReader(truncated);
+    EXPECT_TRUE(truncatedReader.IsValid());
+    EXPECT_FALSE(truncatedReader.ValidateItems());
+    EXPECT_FALSE(truncatedReader.FindByte(OHOS_CONTROL_FOCUS_STATE, value));
+    EXPECT_FALSE(truncatedReader.IsValid());
+}
+
+/*
+ * Feature: Framework
+ * Function: Test result subscription of a camera input
+ * SubFunction: NA
+ * FunctionPoints: NA
+ * EnvConditions: NA
+ * CaseDescription: Test the focus and exposure results subscribed by a camera input are enabled in the
+ * HDI along with the ones the service reads when the device opens, and that a result is narrowed to the
+ * subscribed tags the client can still decode
+ */
+HWTEST_F(CameraFrameworkUnitTest, camera_framework_unittest_066, TestSize.Level0)
+{
+    std::vector<sptr<CameraInfo>> cameras = cameraManager->GetCameras();
+    sptr<CameraInput> input = cameraManager->CreateCameraInput(cameras[0]);
+    ASSERT_NE(input, nullptr);
+    sptr<ICameraDeviceService> device = input->GetCameraDevice();
+    ASSERT_NE(device, nullptr);
+
+    std::vector<int32_t> subscribed;
+    EXPECT_EQ(device->GetEnabledResults(subscribed), 0);
+    EXPECT_NE(std::find(subscribed.begin(), subscribed.end(), OHOS_CONTROL_FOCUS_STATE), subscribed.end());
+    EXPECT_NE(std::find(subscribed.begin(), subscribed.end(), OHOS_CONTROL_EXPOSURE_STATE), subscribed.end());
+    EXPECT_EQ(std::find(subscribed.begin(), subscribed.end(), OHOS_CONTROL_FLASH_MODE), subscribed.end());
+
+    auto isAggregated = [](const std::vector<int32_t> &results) {
+        std::set<int32_t> tags(results.begin(), results.end());
+        return tags.count(OHOS_CONTROL_EXPOSURE_STATE) > 0 && tags.count(OHOS_CONTROL_FLASH_MODE) > 0;
+    };
+    EXPECT_CALL(*mockCameraHostManager, OpenCameraDevice(_, _, _));
+    EXPECT_CALL(*mockCameraDevice, GetEnabledResults(_));
+    EXPECT_CALL(*mockCameraDevice, EnableResult(Truly(isAggregated)));
+    EXPECT_EQ(device->Open(), 0);
+    EXPECT_EQ(device->Close(), 0);
+
+    int32_t itemCount = 10;
+    int32_t dataSize = 100;
+    std::shared_ptr<OHOS::Camera::CameraMetadata> metadata =
+        std::make_shared<OHOS::Camera::CameraMetadata>(itemCount, dataSize);
+    uint8_t flashMode = OHOS_CAMERA_FLASH_MODE_OPEN;
+    uint8_t focusState = OHOS_CAMERA_FOCUS_STATE_SCAN;
+    metadata->addEntry(OHOS_CONTROL_FLASH_MODE, &flashMode, 1);
+    metadata->addEntry(OHOS_CONTROL_FOCUS_STATE, &focusState, 1);
+    std::vector<uint8_t> result;
+    OHOS::Camera::MetadataUtils::ConvertMetadataToVec(metadata, result);
+
+    std::vector<uint8_t> filtered;
+    EXPECT_EQ(FilterResult(result, {OHOS_CONTROL_EXPOSURE_STATE}, filtered), 0);
+    ASSERT_EQ(FilterResult(result, {OHOS_CONTROL_FOCUS_STATE, OHOS_CONTROL_EXPOSURE_STATE}, filtered), 1);
+    std::shared_ptr<OHOS::Camera::CameraMetadata> decoded = nullptr;
+    OHOS::Camera::MetadataUtils::ConvertVecToMetadata(filtered, decoded);
+    ASSERT_NE(decoded, nullptr);
+    camera_metadata_item_t item;
+    ASSERT_EQ(OHOS::Camera::FindCameraMetadataItem(decoded->get(), OHOS_CONTROL_FOCUS_STATE, &item),
+              CAM_META_SUCCESS);
+    EXPECT_EQ(item.data.u8[0], focusState);
+    EXPECT_NE(OHOS::Camera::FindCameraMetadataItem(decoded->get(), OHOS_CONTROL_FLASH_MODE, &item),
+              CAM_META_SUCCESS);
+}
+
+/*
+ * Feature: Framework
+ * Function: Test change only result delivery
+ * SubFunction: NA
+ * FunctionPoints: NA
+ * EnvConditions: NA
+ * CaseDescription: Test only the tags whose value changed since the previous committed result are kept,
+ * that uncommitted values are reported again, that a malformed result reports nothing and that the
+ * snapshot of the remembered values decodes to the latest value of every tag
+ */
+HWTEST_F(CameraFrameworkUnitTest, camera_framework_unittest_067, TestSize.Level0)
+{
+    int32_t itemCount = 10;
+    int32_t dataSize = 100;
+    auto serialize = [itemCount, dataSize](uint8_t focusState, uint8_t exposureState) {
+        std::shared_ptr<OHOS::Camera::CameraMetadata> metadata =
+            std::make_shared<OHOS::Camera::CameraMetadata>(itemCount, dataSize);
+        metadata->addEntry(OHOS_CONTROL_FOCUS_STATE, &focusState, 1);
+        metadata->addEntry(OHOS_CONTROL_EXPOSURE_STATE, &exposureState, 1);
+        std::vector<uint8_t> result;
+        OHOS::Camera::MetadataUtils::ConvertMetadataToVec(metadata, result);
+        return result;
+    };
+    ResultValues lastValues;
+    ResultValues changedValues;
+    std::vector<uint8_t> changed;
+    std::vector<uint8_t> scanning = serialize(OHOS_CAMERA_FOCUS_STATE_SCAN, OHOS_CAMERA_EXPOSURE_STATE_SCAN);
+    EXPECT_EQ(DiffResult(scanning, nullptr, lastValues, changed, changedValues), 2);
+    // Not delivered, so not committed
+    EXPECT_EQ(DiffResult(scanning, nullptr, lastValues, changed, changedValues), 2);
+    CommitResultValues(changedValues, lastValues);
+    EXPECT_EQ(DiffResult(scanning, nullptr, lastValues, changed, changedValues), 0);
+    EXPECT_TRUE(changedValues.empty());
+
+    std::vector<uint8_t> focused = serialize(OHOS_CAMERA_FOCUS_STATE_FOCUSED, OHOS_CAMERA_EXPOSURE_STATE_SCAN);
+    std::vector<uint8_t> truncated(focused.begin(), focused.end() - 1);
+    EXPECT_EQ(DiffResult(truncated, nullptr, lastValues, changed, changedValues), 0);
+    EXPECT_TRUE(changedValues.empty());
+    std::set<int32_t> exposureOnly = {OHOS_CONTROL_EXPOSURE_STATE};
+    EXPECT_EQ(DiffResult(focused, &exposureOnly, lastValues, changed, changedValues), 0);
+    ASSERT_EQ(DiffResult(focused, nullptr, lastValues, changed, changedValues), 1);
+    CommitResultValues(changedValues, lastValues);
+    CameraResultReader reader(changed);
+    uint8_t value = 0;
+    EXPECT_TRUE(reader.FindByte(OHOS_CONTROL_FOCUS_STATE, value));
+    EXPECT_EQ(value, OHOS_CAMERA_FOCUS_STATE_FOCUSED);
+    EXPECT_FALSE(reader.FindByte(OHOS_CONTROL_EXPOSURE_STATE, value));
+
+    std::vector<uint8_t> serialized;
+    BuildResultSnapshot(lastValues, serialized);
+    std::shared_ptr<OHOS::Camera::CameraMetadata> snapshot = nullptr;
+    OHOS::Camera::MetadataUtils::ConvertVecToMetadata(serialized, snapshot);
+    ASSERT_NE(snapshot, nullptr);
+    camera_metadata_item_t item;
+    ASSERT_EQ(OHOS::Camera::FindCameraMetadataItem(snapshot->get(), OHOS_CONTROL_FOCUS_STATE, &item),
+              CAM_META_SUCCESS);
+    EXPECT_EQ(item.data.u8[0], OHOS_CAMERA_FOCUS_STATE_FOCUSED);
+    ASSERT_EQ(OHOS::Camera::FindCameraMetadataItem(snapshot->get(), OHOS_CONTROL_EXPOSURE_STATE, &item),
+              CAM_META_SUCCESS);
+    EXPECT_EQ(item.data.u8[0], OHOS_CAMERA_EXPOSURE_STATE_SCAN);
+}
+
+/*
+ * Feature: Framework
+ * Function: Test asynchronous telemetry
+ * SubFunction: NA
+ * FunctionPoints: NA
+ * EnvConditions: NA
+ * CaseDescription: Test a posted state event repeating the last written state and repeats of a fault
+ * are coalesced when the telemetry ring is drained
+ */
+HWTEST_F(CameraFrameworkUnitTest, camera_framework_unittest_068, TestSize.Level0)
+{
+    CameraTelemetry &telemetry = CameraTelemetry::GetInstance();
+    telemetry.Flush();
+    TelemetryStats before = telemetry.GetStats();
+    int32_t errorCode = -1;
+    EXPECT_TRUE(telemetry.Post(TELEMETRY_FOCUS_STATE, OHOS_CAMERA_FOCUS_STATE_SCAN));
+    EXPECT_TRUE(telemetry.Post(TELEMETRY_FOCUS_STATE, OHOS_CAMERA_FOCUS_STATE_SCAN));
+    EXPECT_TRUE(telemetry.Post(TELEMETRY_FRAME_ERROR, errorCode));
+    EXPECT_TRUE(telemetry.Post(TELEMETRY_FRAME_ERROR, errorCode));
+    EXPECT_TRUE(telemetry.Post(TELEMETRY_FRAME_ERROR, errorCode));
+    telemetry.Flush();
+    TelemetryStats after = telemetry.GetStats();
+
+    // The drain thread may have taken some of the records first, the second focus state is coalesced anyway
+    EXPECT_GE(after.posted - before.posted, 5);
+    EXPECT_EQ(after.dropped, before.dropped);
+    EXPECT_GE((after.written - before.written) + (after.coalesced - before.coalesced), 5);
+    EXPECT_GE(after.coalesced - before.coalesced, 1);
+
+    std::string dumpString;
+    telemetry.Dump(dumpString);
+    EXPECT_NE(dumpString.find("Coalesced:["), std::string::npos);
+}
+
+/*
+ * Feature: Framework
+ * Function: Test per stage latency histograms
+ * SubFunction: NA
+ * FunctionPoints: NA
+ * EnvConditions: NA
+ * CaseDescription: Test the percentiles of a latency histogram stay within its bucket precision, and that the
+ * latency recorded per camera is dumped and cleared by a reset
+ */
+HWTEST_F(CameraFrameworkUnitTest, camera_framework_unittest_069, TestSize.Level0)
+{
+    LatencyHistogram histogram;
+    EXPECT_EQ(histogram.GetPercentile(50.0), 0);
+    uint64_t maxLatency = 100000;
+    for (uint64_t latency = 1; latency <= maxLatency; latency++) {
+        histogram.Record(latency);
+    }
+    EXPECT_EQ(histogram.GetCount(), maxLatency);
+    EXPECT_EQ(histogram.GetMin(), 1);
+    EXPECT_EQ(histogram.GetMax(), maxLatency);
+    EXPECT_EQ(histogram.GetMean(), (maxLatency + 1) / 2);
+    uint64_t median = histogram.GetPercentile(50.0);
+    EXPECT_GE(median, maxLatency / 2);
+    EXPECT_LE(median, maxLatency / 2 * 33 / 32);
+    EXPECT_EQ(histogram.GetPercentile(100.0), maxLatency);
+
+    CameraLatencyStats &latencyStats = CameraLatencyStats::GetInstance();
+    std::string cameraId = "latency_unittest";
+    uint64_t openLatency = 20;
+    latencyStats.RecordDuration(cameraId, LATENCY_OPEN_CAMERA, openLatency);
+    LatencyHistogram openHistogram;
+    ASSERT_TRUE(latencyStats.GetHistogram(cameraId, LATENCY_OPEN_CAMERA, openHistogram));
+    EXPECT_EQ(openHistogram.GetPercentile(99.0), openLatency);
+    std::string dumpString;
+    latencyStats.Dump(dumpString);
+    EXPECT_NE(dumpString.find("OpenCamera: Count:[1]"), std::string::npos);
+
+    latencyStats.Reset();
+    EXPECT_FALSE(latencyStats.GetHistogram(cameraId, LATENCY_OPEN_CAMERA, openHistogram));
+}
+
+/*
+ * Feature: Framework
+ * Function: Test the stream validation cache
+ * SubFunction: NA
+ * FunctionPoints: NA
+ * EnvConditions: NA
+ * CaseDescription: Test a validated stream set is found whatever its stream ids and order, is missed with another
+ * ability generation or another configuration, is evicted least recently used first and is dropped on invalidation
+ */
+HWTEST_F(CameraFrameworkUnitTest, camera_framework_unittest_070, TestSize.Level0)
+{
+    size_t capacity = 2;
+    StreamValidationCache cache(capacity);
+    StreamInfo previewInfo {};
+    previewInfo.streamId_ = 1;
+    previewInfo.format_ = OHOS_CAMERA_FORMAT_YCRCB_420_SP;
+    previewInfo.width_ = PREVIEW_DEFAULT_WIDTH;
+    previewInfo.height_ = PREVIEW_DEFAULT_HEIGHT;
+    previewInfo.intent_ = PREVIEW;
+    StreamInfo photoInfo {};
+    photoInfo.streamId_ = 2;
+    photoInfo.format_ = OHOS_CAMERA_FORMAT_JPEG;
+    photoInfo.width_ = PHOTO_DEFAULT_WIDTH;
+    photoInfo.height_ = PHOTO_DEFAULT_HEIGHT;
+    photoInfo.intent_ = STILL_CAPTURE;
+    std::vector<StreamInfo> streamInfos = {previewInfo, photoInfo};
+    uint64_t generation = 1;
+
+    EXPECT_FALSE(cache.Find(streamInfos, generation));
+    cache.Add(streamInfos, generation);
+    EXPECT_TRUE(cache.Find(streamInfos, generation));
+    int32_t otherStreamId = 10;
+    photoInfo.streamId_ = otherStreamId;
+    std::vector<StreamInfo> reorderedInfos = {photoInfo, previewInfo};
+    EXPECT_TRUE(cache.Find(reorderedInfos, generation));
+
+    uint64_t otherGeneration = 2;
+    EXPECT_FALSE(cache.Find(streamInfos, otherGeneration));
+    std::vector<StreamInfo> videoInfos = streamInfos;
+    videoInfos[0].intent_ = VIDEO;
+    EXPECT_FALSE(cache.Find(videoInfos, generation));
+
+    cache.Add(streamInfos, otherGeneration);
+    EXPECT_TRUE(cache.Find(streamInfos, generation));
+    cache.Add(videoInfos, generation);
+    EXPECT_EQ(cache.GetSize(), capacity);
+    EXPECT_TRUE(cache.Find(streamInfos, generation));
+    EXPECT_TRUE(cache.Find(videoInfos, generation));
+    EXPECT_FALSE(cache.Find(streamInfos, otherGeneration));
+
+    cache.Clear();
+    EXPECT_EQ(cache.GetSize(), 0);
+    EXPECT_FALSE(cache.Find(streamInfos, generation));
+    uint32_t expectedHits = 5;
+    uint32_t expectedMisses = 5;
+    EXPECT_EQ(cache.GetHits(), expectedHits);
+    EXPECT_EQ(cache.GetMisses(), expectedMisses);
+}
+
+/*
+ * Feature: Framework
+ * Function: Test cached camera settings
+ * SubFunction: NA
+ * FunctionPoints: NA
+ * EnvConditions: NA
+ * CaseDescription: Test the settings version only moves when a merged entry changes, that merged settings grow
+ * past the capacity of the first request, and that an open device only sends the entries that changed
+ */
+HWTEST_F(CameraFrameworkUnitTest, camera_framework_unittest_071, TestSize.Level0)
+{
+    int32_t itemCount = 10;
+    int32_t dataSize = 100;
+    float zoomRatio = 2.0;
+    int32_t exposureValue = 1;
+    auto zoomSettings = std::make_shared<OHOS::Camera::CameraMetadata>(itemCount, dataSize);
+    zoomSettings->addEntry(OHOS_CONTROL_ZOOM_RATIO, &zoomRatio, 1);
+    auto exposureSettings = std::make_shared<OHOS::Camera::CameraMetadata>(itemCount, dataSize);
+    exposureSettings->addEntry(OHOS_CONTROL_AE_EXPOSURE_COMPENSATION, &exposureValue, 1);
+
+    CameraSettings cameraSettings(std::make_shared<OHOS::Camera::CameraMetadata>(itemCount, dataSize));
+    uint64_t version = cameraSettings.GetVersion();
+    EXPECT_EQ(cameraSettings.Merge(zoomSettings), CAMERA_OK);
+    EXPECT_EQ(cameraSettings.GetVersion(), version + 1);
+    SettingsBlob blob = cameraSettings.GetSerialized();
+    EXPECT_EQ(cameraSettings.Merge(zoomSettings), CAMERA_OK);
+    EXPECT_EQ(cameraSettings.GetVersion(), version + 1);
+    EXPECT_EQ(cameraSettings.GetSerialized(), blob);
+    EXPECT_EQ(cameraSettings.Merge(exposureSettings), CAMERA_OK);
+    EXPECT_EQ(cameraSettings.GetVersion(), version + 2);
+    EXPECT_NE(cameraSettings.GetSerialized(), blob);
+    camera_metadata_item_t item;
+    EXPECT_EQ(OHOS::Camera::FindCameraMetadataItem(cameraSettings.GetMetadata()->get(), OHOS_CONTROL_ZOOM_RATIO,
+                                                   &item), CAM_META_SUCCESS);
+    EXPECT_EQ(OHOS::Camera::FindCameraMetadataItem(cameraSettings.GetMetadata()->get(),
+                                                   OHOS_CONTROL_AE_EXPOSURE_COMPENSATION, &item), CAM_META_SUCCESS);
+
+    CameraSettings growingSettings(nullptr);
+    auto singleSettings = std::make_shared<OHOS::Camera::CameraMetadata>(1, sizeof(float));
+    singleSettings->addEntry(OHOS_CONTROL_ZOOM_RATIO, &zoomRatio, 1);
+    std::shared_ptr<OHOS::Camera::CameraMetadata> changed;
+    EXPECT_EQ(growingSettings.Merge(singleSettings, &changed), CAMERA_OK);
+    ASSERT_NE(changed, nullptr);
+    std::vector<int32_t> fpsRange = {15, 30};
+    uint8_t flashMode = OHOS_CAMERA_FLASH_MODE_OPEN;
+    uint8_t focusMode = OHOS_CAMERA_FOCUS_MODE_AUTO;
+    auto moreSettings = std::make_shared<OHOS::Camera::CameraMetadata>(itemCount, dataSize);
+    moreSettings->addEntry(OHOS_CONTROL_ZOOM_RATIO, &zoomRatio, 1);
+    moreSettings->addEntry(OHOS_CONTROL_AE_EXPOSURE_COMPENSATION, &exposureValue, 1);
+    moreSettings->addEntry(OHOS_CONTROL_FPS_RANGES, fpsRange.data(), fpsRange.size());
+    moreSettings->addEntry(OHOS_CONTROL_FLASH_MODE, &flashMode, 1);
+    moreSettings->addEntry(OHOS_CONTROL_FOCUS_MODE, &focusMode, 1);
+    changed = nullptr;
+    EXPECT_EQ(growingSettings.Merge(moreSettings, &changed), CAMERA_OK);
+    ASSERT_NE(changed, nullptr);
+    uint32_t changedCount = 4;
+    EXPECT_EQ(OHOS::Camera::GetCameraMetadataItemCount(changed->get()), changedCount);
+    EXPECT_NE(OHOS::Camera::FindCameraMetadataItem(changed->get(), OHOS_CONTROL_ZOOM_RATIO, &item),
+              CAM_META_SUCCESS);
+    uint32_t mergedCount = 5;
+    EXPECT_EQ(OHOS::Camera::GetCameraMetadataItemCount(growingSettings.GetMetadata()->get()), mergedCount);
+    changed = nullptr;
+    EXPECT_EQ(growingSettings.Merge(moreSettings, &changed), CAMERA_OK);
+    EXPECT_EQ(changed, nullptr);
+
+    sptr<HCameraHostManager> cameraHostManager = mockCameraHostManager;
+    sptr<HCameraDevice> device = new HCameraDevice(cameraHostManager, "cam0");
+    EXPECT_EQ(device->UpdateSetting(zoomSettings), CAMERA_OK);
+
+    std::vector<uint8_t> sentSettings;
+    auto saveSettings = [&sentSettings](const std::vector<uint8_t> &settings) {
+        sentSettings = settings;
+        return HDI::Camera::V1_0::NO_ERROR;
+    };
+    EXPECT_CALL(*mockCameraHostManager, OpenCameraDevice(_, _, _));
+    EXPECT_CALL(*mockCameraDevice, UpdateSettings(_)).WillOnce(saveSettings).WillOnce(saveSettings);
+    EXPECT_CALL(*mockCameraDevice, SetResultMode(ON_CHANGED));
+    EXPECT_EQ(device->Open(), CAMERA_OK);
+    EXPECT_FALSE(sentSettings.empty());
+
+    sentSettings.clear();
+    EXPECT_EQ(device->UpdateSetting(zoomSettings), CAMERA_OK);
+    EXPECT_TRUE(sentSettings.empty());
+
+    EXPECT_EQ(device->UpdateSetting(exposureSettings), CAMERA_OK);
+    std::shared_ptr<OHOS::Camera::CameraMetadata> sentMetadata;
+    OHOS::Camera::MetadataUtils::ConvertVecToMetadata(sentSettings, sentMetadata);
+    ASSERT_NE(sentMetadata, nullptr);
+    EXPECT_NE(OHOS::Camera::FindCameraMetadataItem(sentMetadata->get(), OHOS_CONTROL_ZOOM_RATIO, &item),
+              CAM_META_SUCCESS);
+    EXPECT_EQ(OHOS::Camera::FindCameraMetadataItem(sentMetadata->get(), OHOS_CONTROL_AE_EXPOSURE_COMPENSATION, &item),
+              CAM_META_SUCCESS);
+
+    EXPECT_CALL(*mockCameraDevice, Close());
+    device->Release();
+}
+
+/*
+ * Feature: Framework
+ * Function: Test telemetry wakeups
+ * SubFunction: NA
+ * FunctionPoints: NA
+ * EnvConditions: NA
+ * CaseDescription: Test a changed torch state is written by the drain thread well before the coalescing interval
+ * ends, without a Flush on the posting thread
+ */
+HWTEST_F(CameraFrameworkUnitTest, camera_framework_unittest_072, TestSize.Level0)
+{
+    CameraTelemetry &telemetry = CameraTelemetry::GetInstance();
+    const int32_t pollMs = 1;
+    const int32_t pollCount = 200;
+    const int32_t torchOff = 0;
+    const int32_t torchOn = 1;
+    // Each state below then differs from the one before it
+    telemetry.Post(TELEMETRY_FLASH_STATE, torchOn, IPCSkeleton::GetCallingPid(), IPCSkeleton::GetCallingUid());
+    for (int32_t torchState : {torchOff, torchOn}) {
+        telemetry.Flush();
+        uint64_t written = telemetry.GetStats().written;
+        EXPECT_TRUE(telemetry.Post(TELEMETRY_FLASH_STATE, torchState, IPCSkeleton::GetCallingPid(),
+                                   IPCSkeleton::GetCallingUid()));
+        for (int32_t i = 0; i < pollCount && telemetry.GetStats().written == written; i++) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(pollMs));
+        }
+        EXPECT_GT(telemetry.GetStats().written, written);
+    }
+}
 } // CameraStandard
 } // OHOS
@@ -123,6 +123,17 @@ public:
     */
     sptr<VideoOutput> CreateVideoOutput(const sptr<OHOS::IBufferProducer> &producer, int32_t format);
 
+    /**
+    * @brief Create video output instance without a surface, the surface is added
+    * later with VideoOutput::AddDeferredSurface.
+    *
+    * @param The format to be used for video capture.
+    * @param video width.
+    * @param video height.
+    * @return Returns pointer to video output instance.
+    */
+    sptr<VideoOutput> CreateDeferredVideoOutput(int32_t format, int32_t width, int32_t height);
+
     /**
     * @brief Create preview output instance using surface.
     *
@@ -164,6 +175,17 @@ public:
     sptr<PreviewOutput> CreateCustomPreviewOutput(const sptr<OHOS::IBufferProducer> &producer, int32_t format,
                                                   int32_t width, int32_t height);
 
+    /**
+    * @brief Create preview output instance without a surface, the session can be committed and
+    * started before the surface is added with PreviewOutput::AddDeferredSurface.
+    *
+    * @param The format to be used for preview.
+    * @param preview width.
+    * @param preview height.
+    * @return Returns pointer to preview output instance.
+    */
+    sptr<PreviewOutput> CreateDeferredPreviewOutput(int32_t format, int32_t width, int32_t height);
+
     /**
     * @brief Create metadata output instance.
     *
@@ -141,6 +141,21 @@ public:
      */
     void SetMirror(bool enable);
 
+    /**
+     * @brief Set how the photo is picked from the zero-shutter-lag ring.
+     *
+     * @param selection ZSL_SELECTION_NONE to always capture through the device,
+     * ZSL_SELECTION_DEFAULT to use the session configured selection.
+     */
+    void SetZslSelection(ZslSelection selection);
+
+    /**
+     * @brief Get the zero-shutter-lag selection for the photo capture.
+     *
+     * @return Returns the zero-shutter-lag selection.
+     */
+    ZslSelection GetZslSelection();
+
     /**
      * @brief Get the photo capture settings metadata information.
      *
@@ -150,6 +165,7 @@ public:
 
 private:
     std::shared_ptr<OHOS::Camera::CameraMetadata> captureMetadataSetting_;
+    ZslSelection zslSelection_ = ZSL_SELECTION_DEFAULT;
 };
 
 class PhotoOutput : public CaptureOutput {
@@ -176,6 +192,22 @@ public:
      */
     int32_t Capture();
 
+    /**
+     * @brief Burst photo capture request using photocapturesettings.
+     *
+     * @param photoCaptureSettings Requested for the photoCaptureSettings object which has metadata
+     * information such as: Rotation, Location, Mirror & Quality.
+     * @param frameCount Number of photos to capture, CONTINUOUS_CAPTURE_FRAME_COUNT to capture until cancelled.
+     */
+    int32_t BurstCapture(std::shared_ptr<PhotoCaptureSetting> photoCaptureSettings, int32_t frameCount);
+
+    /**
+     * @brief Initiate a burst photo capture.
+     *
+     * @param frameCount Number of photos to capture, CONTINUOUS_CAPTURE_FRAME_COUNT to capture until cancelled.
+     */
+    int32_t BurstCapture(int32_t frameCount);
+
     /**
      * @brief cancelling the photo capture. Applicable only for burst/ continuous capture.
      */
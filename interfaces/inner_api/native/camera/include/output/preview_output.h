@@ -58,6 +58,29 @@ public:
      */
     void SetCallback(std::shared_ptr<PreviewCallback> callback);
 
+    /**
+     * @brief Set the frame rate of the preview output, set it before CommitConfig when other
+     * preview or video outputs share the session.
+     *
+     * @param fps Frames per second delivered to the output surface, 0 for the sensor rate.
+     */
+    int32_t SetFps(float fps);
+
+    /**
+     * @brief Get the frame rate actually delivered to the preview output.
+     *
+     * @param fps Measured frames per second.
+     */
+    int32_t GetAchievedFps(float &fps);
+
+    /**
+     * @brief Add the surface of a preview output created without one, the output may
+     * already be committed and started.
+     *
+     * @param surface The surface to be used for preview.
+     */
+    int32_t AddDeferredSurface(sptr<Surface> surface);
+
     /**
      * @brief Releases a instance of the preview output.
      */
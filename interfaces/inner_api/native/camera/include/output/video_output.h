@@ -87,6 +87,14 @@ public:
      */
     int32_t Resume();
 
+    /**
+     * @brief Add the surface of a video output created without one, the output may
+     * already be committed.
+     *
+     * @param surface The surface to be used for video output.
+     */
+    int32_t AddDeferredSurface(sptr<Surface> surface);
+
     /**
      * @brief Get the application callback information.
      *
@@ -16,7 +16,10 @@
 #ifndef OHOS_CAMERA_CAPTURE_SESSION_H
 #define OHOS_CAMERA_CAPTURE_SESSION_H
 
+#include <functional>
 #include <iostream>
+#include <map>
+#include <mutex>
 #include <vector>
 #include "input/capture_input.h"
 #include "output/capture_output.h"
@@ -35,8 +38,18 @@ public:
      * @param errorCode Indicates a {@link ErrorCode} which will give information for capture session callback error.
      */
     virtual void OnError(int32_t errorCode) = 0;
+
+    /**
+     * @brief Called when a commit started with CommitConfigAsync has completed.
+     *
+     * @param transactionId Identifies the commit, as returned by CommitConfigAsync.
+     * @param errorCode CAMERA_OK on success, otherwise the reason the configuration was not applied.
+     */
+    virtual void OnCommitConfigDone(int32_t transactionId, int32_t errorCode) {}
 };
 
+using CommitConfigCompletion = std::function<void(int32_t transactionId, int32_t errorCode)>;
+
 enum VideoStabilizationMode {
     OFF = 0,
     LOW,
@@ -61,6 +74,23 @@ public:
      */
     int32_t CommitConfig();
 
+    /**
+     * @brief Commit the capture session config without waiting for the camera device. The result is
+     * reported through SessionCallback::OnCommitConfigDone and the completion, if one is given.
+     *
+     * @param transactionId Identifies this commit in the result.
+     * @param completion Called with the result of this commit, can be null.
+     */
+    int32_t CommitConfigAsync(int32_t &transactionId, CommitConfigCompletion completion = nullptr);
+
+    /**
+     * @brief Deliver the result of an asynchronous commit.
+     *
+     * @param transactionId Identifies the commit.
+     * @param errorCode Result of the commit.
+     */
+    void OnCommitConfigDone(int32_t transactionId, int32_t errorCode);
+
     /**
      * @brief Add CaptureInput for the capture session.
      *
@@ -89,11 +119,38 @@ public:
      */
     int32_t RemoveOutput(sptr<CaptureOutput> &output);
 
+    /**
+     * @brief Configure the capture session with an input, its outputs and initial settings in one call.
+     *
+     * @param CaptureInput to be used by the session.
+     * @param CaptureOutputs to be used by the session, outputs not listed are removed.
+     * @param Initial settings applied to the camera device, can be null.
+     */
+    int32_t ConfigureSession(sptr<CaptureInput> &input, std::vector<sptr<CaptureOutput>> &outputs,
+                             std::shared_ptr<Camera::CameraMetadata> settings = nullptr);
+
+    /**
+     * @brief Configure zero-shutter-lag for the photo outputs added after this call, call between
+     * BeginConfig and CommitConfig.
+     *
+     * @param Number of recent frames kept for each photo output, 0 disables zero-shutter-lag.
+     * @param Selection used by photo captures that do not set their own.
+     * @param Upper bound in bytes of buffered frames for each photo output, 0 for no bound.
+     */
+    int32_t SetZslConfig(int32_t ringDepth, ZslSelection selection, uint64_t memoryBudget = 0);
+
     /**
      * @brief Starts session and preview.
      */
     int32_t Start();
 
+    /**
+     * @brief Starts every preview, video and metadata output of the session in one repeating
+     * request, so their frames stay in step. The outputs are stopped together by Stop and
+     * cannot be started or stopped on their own meanwhile.
+     */
+    int32_t StartGrouped();
+
     /**
      * @brief Stop session and preview..
      */
@@ -148,9 +205,15 @@ public:
     void SetVideoStabilizationMode(VideoStabilizationMode stabilizationMode);
 
 private:
+    void CancelPendingCommits();
+
     sptr<ICaptureSession> captureSession_;
+    // Guards appCallback_, which the session callbacks read on IPC threads
+    std::mutex callbackMutex_;
     std::shared_ptr<SessionCallback> appCallback_;
     sptr<ICaptureSessionCallback> captureSessionCallback_;
+    std::mutex commitMutex_;
+    std::map<int32_t, CommitConfigCompletion> pendingCommits_;
     static const std::unordered_map<CameraVideoStabilizationMode, VideoStabilizationMode> metaToFwVideoStabModes_;
     static const std::unordered_map<VideoStabilizationMode, CameraVideoStabilizationMode> fwToMetaVideoStabModes_;
 };
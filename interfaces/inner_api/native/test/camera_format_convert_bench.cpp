@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+#include "camera_format_converter.h"
+#include "camera_image_scaler.h"
+#include "camera_image_transform.h"
+#include "display_type.h"
+#include "test_common.h"
+
+using namespace std;
+using namespace OHOS::CameraStandard;
+
+namespace {
+    struct FormatName {
+        int32_t format;
+        const char *name;
+    };
+    const FormatName FORMATS[] = {
+        {PIXEL_FMT_YCRCB_420_SP, "NV21"},
+        {PIXEL_FMT_YCBCR_420_SP, "NV12"},
+        {PIXEL_FMT_YCBCR_420_P, "I420"},
+        {PIXEL_FMT_RGBA_8888, "RGBA"},
+    };
+    constexpr int32_t RGBA_BYTES_PER_PIXEL = 4;
+
+    int32_t GetStride(int32_t format, int32_t width)
+    {
+        return (format == PIXEL_FMT_RGBA_8888) ? width * RGBA_BYTES_PER_PIXEL : width;
+    }
+
+    double MeasureConversion(const ImageBuffer &src, const ImageBuffer &dst, bool useSimd, int32_t iterations)
+    {
+        auto start = chrono::steady_clock::now();
+        for (int32_t i = 0; i < iterations; i++) {
+            ConvertImage(src, dst, useSimd);
+        }
+        chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+        return elapsed.count() / iterations;
+    }
+
+    double MeasureTransform(const ImageBuffer &src, const ImageBuffer &dst, int32_t rotation, bool isMirrored,
+                            bool useSimd, int32_t iterations)
+    {
+        auto start = chrono::steady_clock::now();
+        for (int32_t i = 0; i < iterations; i++) {
+            TransformImage(src, dst, rotation, isMirrored, useSimd);
+        }
+        chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+        return elapsed.count() / iterations;
+    }
+
+    double MeasureScaling(const ImageBuffer &src, const ImageBuffer &dst, bool useSimd, int32_t iterations)
+    {
+        auto start = chrono::steady_clock::now();
+        for (int32_t i = 0; i < iterations; i++) {
+            ScaleImage(src, dst, useSimd);
+        }
+        chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+        return elapsed.count() / iterations;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const int32_t widthIndex = 1;
+    const int32_t heightIndex = 2;
+    const int32_t iterationsIndex = 3;
+    const int32_t validArgCount = 4;
+    int32_t width = 1920;
+    int32_t height = 1080;
+    int32_t iterations = 50;
+
+    if (argc == validArgCount) {
+        for (int counter = 1; counter < argc; counter++) {
+            if (!TestUtils::IsNumber(argv[counter])) {
+                cout << "Invalid argument: " << argv[counter] << endl;
+                return 0;
+            }
+        }
+        width = atoi(argv[widthIndex]);
+        height = atoi(argv[heightIndex]);
+        iterations = atoi(argv[iterationsIndex]);
+    } else if (argc != 1) {
+        cout << "Pass Width, Height, Iterations or no arguments for 1920x1080 and 50 iterations" << endl;
+        return 0;
+    }
+    if (width <= 0 || height <= 0 || iterations <= 0) {
+        cout << "Width, Height and Iterations must be positive" << endl;
+        return 0;
+    }
+
+    cout << "Converting " << width << "x" << height << ", SIMD: " << GetConvertSimdName() << endl;
+    for (const auto &from : FORMATS) {
+        int32_t srcStride = GetStride(from.format, width);
+        std::vector<uint8_t> srcData(GetImageSize(from.format, srcStride, height));
+        for (size_t i = 0; i < srcData.size(); i++) {
+            srcData[i] = static_cast<uint8_t>(i * 7);
+        }
+        ImageBuffer src = {srcData.data(), srcData.size(), from.format, width, height, srcStride};
+        for (const auto &to : FORMATS) {
+            if (from.format == to.format) {
+                continue;
+            }
+            int32_t dstStride = GetStride(to.format, width);
+            std::vector<uint8_t> scalarData(GetImageSize(to.format, dstStride, height));
+            std::vector<uint8_t> simdData(scalarData.size());
+            ImageBuffer scalarDst = {scalarData.data(), scalarData.size(), to.format, width, height, dstStride};
+            ImageBuffer simdDst = {simdData.data(), simdData.size(), to.format, width, height, dstStride};
+            double scalarTime = MeasureConversion(src, scalarDst, false, iterations);
+            double simdTime = MeasureConversion(src, simdDst, true, iterations);
+            cout << from.name << " -> " << to.name << ": scalar " << scalarTime << " ms, simd " << simdTime
+                 << " ms, speedup " << (simdTime > 0 ? scalarTime / simdTime : 0)
+                 << (scalarData == simdData ? "" : ", OUTPUT MISMATCH") << endl;
+        }
+    }
+
+    // Halving only, halving then bilinear, and bilinear only with a crop to another aspect ratio
+    const int32_t scaledSizes[][2] = {
+        {width / 2, height / 2}, {(width / 3) & ~1, (height / 3) & ~1}, {(width * 3 / 4) & ~1, (height / 2) & ~1},
+    };
+    cout << "Scaling " << width << "x" << height << endl;
+    for (const auto &format : FORMATS) {
+        int32_t srcStride = GetStride(format.format, width);
+        std::vector<uint8_t> srcData(GetImageSize(format.format, srcStride, height));
+        for (size_t i = 0; i < srcData.size(); i++) {
+            srcData[i] = static_cast<uint8_t>(i * 7);
+        }
+        ImageBuffer src = {srcData.data(), srcData.size(), format.format, width, height, srcStride};
+        for (const auto &size : scaledSizes) {
+            if (size[0] <= 0 || size[1] <= 0) {
+                continue;
+            }
+            int32_t dstStride = GetStride(format.format, size[0]);
+            std::vector<uint8_t> scalarData(GetImageSize(format.format, dstStride, size[1]));
+            std::vector<uint8_t> simdData(scalarData.size());
+            ImageBuffer scalarDst = {scalarData.data(), scalarData.size(), format.format, size[0], size[1], dstStride};
+            ImageBuffer simdDst = {simdData.data(), simdData.size(), format.format, size[0], size[1], dstStride};
+            double scalarTime = MeasureScaling(src, scalarDst, false, iterations);
+            double simdTime = MeasureScaling(src, simdDst, true, iterations);
+            cout << format.name << " -> " << size[0] << "x" << size[1] << ": scalar " << scalarTime << " ms, simd "
+                 << simdTime << " ms, speedup " << (simdTime > 0 ? scalarTime / simdTime : 0)
+                 << (scalarData == simdData ? "" : ", OUTPUT MISMATCH") << endl;
+        }
+    }
+
+    const int32_t rotations[] = {0, 90, 180, 270};
+    const int32_t rightAngle = 90;
+    cout << "Transforming " << width << "x" << height << endl;
+    for (const auto &format : FORMATS) {
+        int32_t srcStride = GetStride(format.format, width);
+        std::vector<uint8_t> srcData(GetImageSize(format.format, srcStride, height));
+        for (size_t i = 0; i < srcData.size(); i++) {
+            srcData[i] = static_cast<uint8_t>(i * 7);
+        }
+        ImageBuffer src = {srcData.data(), srcData.size(), format.format, width, height, srcStride};
+        for (int32_t rotation : rotations) {
+            bool isTransposed = (rotation % (2 * rightAngle) != 0);
+            int32_t dstWidth = isTransposed ? height : width;
+            int32_t dstHeight = isTransposed ? width : height;
+            int32_t dstStride = GetStride(format.format, dstWidth);
+            std::vector<uint8_t> scalarData(GetImageSize(format.format, dstStride, dstHeight));
+            std::vector<uint8_t> simdData(scalarData.size());
+            ImageBuffer scalarDst = {scalarData.data(), scalarData.size(), format.format, dstWidth, dstHeight,
+                                     dstStride};
+            ImageBuffer simdDst = {simdData.data(), simdData.size(), format.format, dstWidth, dstHeight, dstStride};
+            // Rotation 0 is measured mirrored, a plain copy says nothing about the transform
+            bool isMirrored = (rotation == 0);
+            double scalarTime = MeasureTransform(src, scalarDst, rotation, isMirrored, false, iterations);
+            double simdTime = MeasureTransform(src, simdDst, rotation, isMirrored, true, iterations);
+            cout << format.name << (isMirrored ? " mirror" : " rotate ") << (isMirrored ? "" : to_string(rotation))
+                 << ": scalar " << scalarTime << " ms, simd " << simdTime << " ms, speedup "
+                 << (simdTime > 0 ? scalarTime / simdTime : 0)
+                 << (scalarData == simdData ? "" : ", OUTPUT MISMATCH") << endl;
+        }
+    }
+    return 0;
+}
@@ -987,6 +987,41 @@ declare namespace camera {
     AUTO
   }
 
+  /**
+   * Initial camera settings applied when a capture session is configured.
+   * @since 9
+   * @syscap SystemCapability.Multimedia.Camera.Core
+   */
+  interface SessionSettings {
+    /**
+     * Flash mode.
+     * @since 9
+     * @syscap SystemCapability.Multimedia.Camera.Core
+     */
+    flashMode?: FlashMode;
+
+    /**
+     * Exposure mode.
+     * @since 9
+     * @syscap SystemCapability.Multimedia.Camera.Core
+     */
+    exposureMode?: ExposureMode;
+
+    /**
+     * Focus mode.
+     * @since 9
+     * @syscap SystemCapability.Multimedia.Camera.Core
+     */
+    focusMode?: FocusMode;
+
+    /**
+     * Zoom ratio.
+     * @since 9
+     * @syscap SystemCapability.Multimedia.Camera.Core
+     */
+    zoomRatio?: number;
+  }
+
   /**
    * Capture session object.
    * @since 9
@@ -1025,6 +1060,61 @@ declare namespace camera {
      */
     commitConfig(): Promise<void>;
 
+    /**
+     * Commit capture session config without holding a worker thread while the camera device is brought up.
+     * @param callback Callback used to return the transaction id of the commit once it has completed.
+     * @since 9
+     * @syscap SystemCapability.Multimedia.Camera.Core
+     */
+    commitConfigAsync(callback: AsyncCallback<number>): void;
+
+    /**
+     * Commit capture session config without holding a worker thread while the camera device is brought up.
+     * @return Promise used to return the transaction id of the commit once it has completed.
+     * @since 9
+     * @syscap SystemCapability.Multimedia.Camera.Core
+     */
+    commitConfigAsync(): Promise<number>;
+
+    /**
+     * Configures the capture session with the camera input and all outputs in one call.
+     * Outputs that are not listed are removed from the session.
+     * @param cameraInput Target camera input.
+     * @param outputs Target camera outputs.
+     * @param callback Callback used to return the result.
+     * @since 9
+     * @syscap SystemCapability.Multimedia.Camera.Core
+     */
+    configureSession(cameraInput: CameraInput, outputs: Array<PreviewOutput | PhotoOutput | VideoOutput | MetadataOutput>,
+      callback: AsyncCallback<void>): void;
+
+    /**
+     * Configures the capture session with the camera input, all outputs and initial settings in one call.
+     * Outputs that are not listed are removed from the session.
+     * @param cameraInput Target camera input.
+     * @param outputs Target camera outputs.
+     * @param settings Initial settings applied to the camera device.
+     * @param callback Callback used to return the result.
+     * @since 9
+     * @syscap SystemCapability.Multimedia.Camera.Core
+     */
+    configureSession(cameraInput: CameraInput, outputs: Array<PreviewOutput | PhotoOutput | VideoOutput | MetadataOutput>,
+      settings: SessionSettings, callback: AsyncCallback<void>): void;
+
+    /**
+     * Configures the capture session with the camera input and all outputs in one call.
+     * Outputs that are not listed are removed from the session.
+     * @param cameraInput Target camera input.
+     * @param outputs Target camera outputs.
+     * @param settings Initial settings applied to the camera device.
+     * @return Promise used to return the result.
+     * @since 9
+     * @syscap SystemCapability.Multimedia.Camera.Core
+     */
+    configureSession(cameraInput: CameraInput,
+      outputs: Array<PreviewOutput | PhotoOutput | VideoOutput | MetadataOutput>,
+      settings?: SessionSettings): Promise<void>;
+
     /**
      * Adds a camera input.
      * @param cameraInput Target camera input to add.
@@ -1577,6 +1667,51 @@ declare namespace camera {
      */
     capture(setting?: PhotoCaptureSetting): Promise<void>;
 
+    /**
+     * Start burst capture output, frameCount 0 keeps capturing until cancelCapture is called.
+     * @param frameCount Number of photos to capture.
+     * @param callback Callback used to return the result.
+     * @since 9
+     * @syscap SystemCapability.Multimedia.Camera.Core
+     */
+    burstCapture(frameCount: number, callback: AsyncCallback<void>): void;
+
+    /**
+     * Start burst capture output, frameCount 0 keeps capturing until cancelCapture is called.
+     * @param frameCount Number of photos to capture.
+     * @param setting Photo capture settings.
+     * @param callback Callback used to return the result.
+     * @since 9
+     * @syscap SystemCapability.Multimedia.Camera.Core
+     */
+    burstCapture(frameCount: number, setting: PhotoCaptureSetting, callback: AsyncCallback<void>): void;
+
+    /**
+     * Start burst capture output, frameCount 0 keeps capturing until cancelCapture is called.
+     * @param frameCount Number of photos to capture.
+     * @param setting Photo capture settings.
+     * @return Promise used to return the result.
+     * @since 9
+     * @syscap SystemCapability.Multimedia.Camera.Core
+     */
+    burstCapture(frameCount: number, setting?: PhotoCaptureSetting): Promise<void>;
+
+    /**
+     * Cancel the burst or continuous capture in progress.
+     * @param callback Callback used to return the result.
+     * @since 9
+     * @syscap SystemCapability.Multimedia.Camera.Core
+     */
+    cancelCapture(callback: AsyncCallback<void>): void;
+
+    /**
+     * Cancel the burst or continuous capture in progress.
+     * @return Promise used to return the result.
+     * @since 9
+     * @syscap SystemCapability.Multimedia.Camera.Core
+     */
+    cancelCapture(): Promise<void>;
+
     /**
      * Release output instance.
      * @param callback Callback used to return the result.
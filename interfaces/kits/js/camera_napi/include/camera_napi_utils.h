@@ -116,11 +116,13 @@ namespace CameraStandard {
 const int32_t PARAM0 = 0;
 const int32_t PARAM1 = 1;
 const int32_t PARAM2 = 2;
+const int32_t PARAM3 = 3;
 
 /* Constants for array size */
 const int32_t ARGS_ONE = 1;
 const int32_t ARGS_TWO = 2;
 const int32_t ARGS_THREE = 3;
+const int32_t ARGS_FOUR = 4;
 const int32_t SIZE = 100;
 
 struct JSAsyncContextOutput {
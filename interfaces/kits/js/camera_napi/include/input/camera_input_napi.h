@@ -113,6 +113,7 @@ public:
     static napi_value Init(napi_env env, napi_value exports);
     static napi_value CreateCameraInput(napi_env env, std::string cameraId,
                                                 sptr<CameraInput> cameraInput);
+    static bool IsCameraInput(napi_env env, napi_value obj);
     CameraInputNapi();
     ~CameraInputNapi();
     sptr<CameraInput> GetCameraInput();
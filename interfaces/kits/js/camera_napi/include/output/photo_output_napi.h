@@ -98,6 +98,8 @@ private:
     static napi_value PhotoOutputNapiConstructor(napi_env env, napi_callback_info info);
 
     static napi_value Capture(napi_env env, napi_callback_info info);
+    static napi_value BurstCapture(napi_env env, napi_callback_info info);
+    static napi_value CancelCapture(napi_env env, napi_callback_info info);
     static napi_value Release(napi_env env, napi_callback_info info);
     static napi_value IsMirrorSupported(napi_env env, napi_callback_info info);
     static napi_value SetMirror(napi_env env, napi_callback_info info);
@@ -127,6 +129,7 @@ struct PhotoOutputAsyncContext {
     double latitude = -1.0;
     double longitude = -1.0;
     int32_t rotation = -1;
+    int32_t frameCount = 0;
     PhotoOutputNapi* objectInfo;
     int32_t status;
     bool hasPhotoSettings = false;
@@ -46,6 +46,8 @@
 namespace OHOS {
 namespace CameraStandard {
 static const char CAMERA_SESSION_NAPI_CLASS_NAME[] = "CaptureSession";
+static const int32_t SESSION_SETTINGS_ITEMS = 4;
+static const int32_t SESSION_SETTINGS_DATA_LENGTH = 16;
 
 class SessionCallbackListener : public SessionCallback {
 public:
@@ -81,6 +83,8 @@ private:
 
     static napi_value BeginConfig(napi_env env, napi_callback_info info);
     static napi_value CommitConfig(napi_env env, napi_callback_info info);
+    static napi_value CommitConfigAsync(napi_env env, napi_callback_info info);
+    static napi_value ConfigureSession(napi_env env, napi_callback_info info);
 
     static napi_value AddInput(napi_env env, napi_callback_info info);
     static napi_value RemoveInput(napi_env env, napi_callback_info info);
@@ -114,6 +118,8 @@ struct CameraSessionAsyncContext {
     CameraSessionNapi* objectInfo;
     sptr<CaptureInput> cameraInput;
     sptr<CaptureOutput> cameraOutput;
+    std::vector<sptr<CaptureOutput>> cameraOutputs;
+    std::shared_ptr<Camera::CameraMetadata> settings;
     bool status;
     std::string errorMsg;
     bool bRetBool;
@@ -122,6 +128,7 @@ struct CameraSessionAsyncContext {
     std::string enumType;
     VideoStabilizationMode videoStabilizationMode;
     bool isSupported;
+    int32_t transactionId;
 };
 } // namespace CameraStandard
 } // namespace OHOS
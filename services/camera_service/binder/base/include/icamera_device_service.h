@@ -40,6 +40,9 @@ public:
 
     virtual int32_t DisableResult(std::vector<int32_t> &results) = 0;
 
+    // Latest value of every result delivered so far, results only carry the tags that changed
+    virtual int32_t GetResultSnapshot(std::shared_ptr<OHOS::Camera::CameraMetadata> &snapshot) = 0;
+
     DECLARE_INTERFACE_DESCRIPTOR(u"ICameraDeviceService");
 };
 } // namespace CameraStandard
@@ -26,6 +26,8 @@ public:
     virtual int32_t OnError(const int32_t errorType, const int32_t errorMsg) = 0;
     virtual int32_t OnResult(const uint64_t timestamp,
                              const std::shared_ptr<OHOS::Camera::CameraMetadata> &result) = 0;
+    // Result as serialized by the HDI, forwarded without decoding it
+    virtual int32_t OnRawResult(const uint64_t timestamp, const std::vector<uint8_t> &result) = 0;
     DECLARE_INTERFACE_DESCRIPTOR(u"ICameraDeviceServiceCallback");
 };
 } // namespace CameraStandard
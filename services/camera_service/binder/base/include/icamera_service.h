@@ -48,12 +48,18 @@ public:
     virtual int32_t CreateCustomPreviewOutput(const sptr<OHOS::IBufferProducer> &producer, int32_t format,
                                               int32_t width, int32_t height, sptr<IStreamRepeat> &previewOutput) = 0;
 
+    virtual int32_t CreateDeferredPreviewOutput(int32_t format, int32_t width, int32_t height,
+                                                sptr<IStreamRepeat> &previewOutput) = 0;
+
     virtual int32_t CreateMetadataOutput(const sptr<OHOS::IBufferProducer> &producer, int32_t format,
                                          sptr<IStreamMetadata> &metadataOutput) = 0;
 
     virtual int32_t CreateVideoOutput(const sptr<OHOS::IBufferProducer> &producer, int32_t format,
                                       sptr<IStreamRepeat> &videoOutput) = 0;
 
+    virtual int32_t CreateDeferredVideoOutput(int32_t format, int32_t width, int32_t height,
+                                              sptr<IStreamRepeat> &videoOutput) = 0;
+
     virtual int32_t SetListenerObject(const sptr<IRemoteObject> &object) = 0;
 
     DECLARE_INTERFACE_DESCRIPTOR(u"ICameraService");
@@ -19,10 +19,16 @@
 #include "icamera_device_service.h"
 #include "icapture_session_callback.h"
 #include "iremote_broker.h"
+#include "istream_capture.h"
 #include "istream_common.h"
 
+#include <utility>
+#include <vector>
+
 namespace OHOS {
 namespace CameraStandard {
+using SessionOutput = std::pair<StreamType, sptr<IStreamCommon>>;
+
 class ICaptureSession : public IRemoteBroker {
 public:
     virtual int32_t BeginConfig() = 0;
@@ -37,14 +43,23 @@ public:
 
     virtual int32_t CommitConfig() = 0;
 
+    virtual int32_t CommitConfigAsync(int32_t &transactionId) = 0;
+
     virtual int32_t Start() = 0;
 
+    virtual int32_t StartGrouped() = 0;
+
     virtual int32_t Stop() = 0;
 
     virtual int32_t Release(pid_t pid) = 0;
 
     virtual int32_t SetCallback(sptr<ICaptureSessionCallback> &callback) = 0;
 
+    virtual int32_t ConfigureSession(sptr<ICameraDeviceService> cameraDevice, std::vector<SessionOutput> &outputs,
+                                     const std::shared_ptr<Camera::CameraMetadata> &settings) = 0;
+
+    virtual int32_t SetZslConfig(int32_t ringDepth, int32_t selection, uint64_t memoryBudget) = 0;
+
     DECLARE_INTERFACE_DESCRIPTOR(u"ICaptureSession");
 };
 } // namespace CameraStandard
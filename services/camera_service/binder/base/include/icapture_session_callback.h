@@ -24,6 +24,8 @@ class ICaptureSessionCallback : public IRemoteBroker {
 public:
     virtual int32_t OnError(int32_t errorCode) = 0;
 
+    virtual int32_t OnCommitConfigDone(int32_t transactionId, int32_t errorCode) = 0;
+
     DECLARE_INTERFACE_DESCRIPTOR(u"ICaptureSessionCallback");
 };
 } // namespace CameraStandard
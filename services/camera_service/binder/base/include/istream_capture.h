@@ -22,10 +22,33 @@
 
 namespace OHOS {
 namespace CameraStandard {
+// Frame count passed to BurstCapture to keep capturing until CancelCapture is called
+static const int32_t CONTINUOUS_CAPTURE_FRAME_COUNT = 0;
+
+// Upper bound of frames kept in a zero-shutter-lag ring
+static const int32_t MAX_ZSL_RING_DEPTH = 8;
+
+enum ZslSelection {
+    // Use the selection configured for the session
+    ZSL_SELECTION_DEFAULT = -1,
+    // Regular capture through the HDI
+    ZSL_SELECTION_NONE = 0,
+    // Buffered frame closest to the shutter time
+    ZSL_SELECTION_CLOSEST,
+    // Sharpest buffered frame
+    ZSL_SELECTION_SHARPEST
+};
+
 class IStreamCapture : public IStreamCommon {
 public:
     virtual int32_t Capture(const std::shared_ptr<OHOS::Camera::CameraMetadata> &captureSettings) = 0;
 
+    virtual int32_t BurstCapture(const std::shared_ptr<OHOS::Camera::CameraMetadata> &captureSettings,
+                                 int32_t frameCount) = 0;
+
+    virtual int32_t ZslCapture(const std::shared_ptr<OHOS::Camera::CameraMetadata> &captureSettings,
+                               int32_t selection) = 0;
+
     virtual int32_t CancelCapture() = 0;
 
     virtual int32_t SetCallback(sptr<IStreamCaptureCallback> &callback) = 0;
@@ -18,6 +18,7 @@
 
 #include "istream_common.h"
 #include "istream_repeat_callback.h"
+#include "surface.h"
 
 namespace OHOS {
 namespace CameraStandard {
@@ -29,8 +30,12 @@ public:
 
     virtual int32_t SetFps(float Fps) = 0;
 
+    virtual int32_t GetAchievedFps(float &fps) = 0;
+
     virtual int32_t SetCallback(sptr<IStreamRepeatCallback> &callback) = 0;
 
+    virtual int32_t AddDeferredSurface(const sptr<OHOS::IBufferProducer> &producer) = 0;
+
     virtual int32_t Release() = 0;
 
     DECLARE_INTERFACE_DESCRIPTOR(u"IStreamRepeat");
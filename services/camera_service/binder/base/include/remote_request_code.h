@@ -32,7 +32,8 @@ enum CameraDeviceRequestCode {
     CAMERA_DEVICE_UPDATE_SETTNGS,
     CAMERA_DEVICE_GET_ENABLED_RESULT,
     CAMERA_DEVICE_ENABLED_RESULT,
-    CAMERA_DEVICE_DISABLED_RESULT
+    CAMERA_DEVICE_DISABLED_RESULT,
+    CAMERA_DEVICE_GET_RESULT_SNAPSHOT
 };
 
 /**
@@ -63,6 +64,8 @@ enum CameraServiceRequestCode {
     CAMERA_SERVICE_CREATE_VIDEO_OUTPUT,
     CAMERA_SERVICE_SET_LISTENER_OBJ,
     CAMERA_SERVICE_CREATE_METADATA_OUTPUT,
+    CAMERA_SERVICE_CREATE_DEFERRED_PREVIEW_OUTPUT,
+    CAMERA_SERVICE_CREATE_DEFERRED_VIDEO_OUTPUT,
 };
 
 /**
@@ -81,7 +84,11 @@ enum CaptureSessionRequestCode {
     CAMERA_CAPTURE_SESSION_START,
     CAMERA_CAPTURE_SESSION_STOP,
     CAMERA_CAPTURE_SESSION_RELEASE,
-    CAMERA_CAPTURE_SESSION_SET_CALLBACK
+    CAMERA_CAPTURE_SESSION_SET_CALLBACK,
+    CAMERA_CAPTURE_SESSION_CONFIGURE,
+    CAMERA_CAPTURE_SESSION_SET_ZSL_CONFIG,
+    CAMERA_CAPTURE_SESSION_COMMIT_CONFIG_ASYNC,
+    CAMERA_CAPTURE_SESSION_START_GROUPED
 };
 
 /**
@@ -94,7 +101,9 @@ enum StreamCaptureRequestCode {
     CAMERA_STREAM_CAPTURE_START = 0,
     CAMERA_STREAM_CAPTURE_CANCEL,
     CAMERA_STREAM_CAPTURE_SET_CALLBACK,
-    CAMERA_STREAM_CAPTURE_RELEASE
+    CAMERA_STREAM_CAPTURE_RELEASE,
+    CAMERA_STREAM_CAPTURE_BURST,
+    CAMERA_STREAM_CAPTURE_ZSL
 };
 
 /**
@@ -108,7 +117,9 @@ enum StreamRepeatRequestCode {
     CAMERA_STOP_VIDEO_RECORDING,
     CAMERA_STREAM_REPEAT_SET_FPS,
     CAMERA_STREAM_REPEAT_SET_CALLBACK,
-    CAMERA_STREAM_REPEAT_RELEASE
+    CAMERA_STREAM_REPEAT_RELEASE,
+    CAMERA_STREAM_REPEAT_GET_ACHIEVED_FPS,
+    CAMERA_STREAM_REPEAT_ADD_DEFERRED_SURFACE
 };
 
 /**
@@ -131,7 +142,8 @@ enum StreamMetadataRequestCode {
  */
 enum CameraDeviceCallbackRequestCode {
     CAMERA_DEVICE_ON_ERROR = 0,
-    CAMERA_DEVICE_ON_RESULT
+    CAMERA_DEVICE_ON_RESULT,
+    CAMERA_DEVICE_ON_RAW_RESULT
 };
 
 /**
@@ -166,7 +178,8 @@ enum StreamCaptureCallbackRequestCode {
 * @version 1.0
 */
 enum CaptureSessionCallbackRequestCode {
-    CAMERA_CAPTURE_SESSION_ON_ERROR = 0
+    CAMERA_CAPTURE_SESSION_ON_ERROR = 0,
+    CAMERA_CAPTURE_SESSION_ON_COMMIT_CONFIG_DONE
 };
 } // namespace CameraStandard
 } // namespace OHOS
@@ -28,6 +28,7 @@ public:
 
     int32_t OnError(const int32_t errorType, const int32_t errorMsg) override;
     int32_t OnResult(const uint64_t timestamp, const std::shared_ptr<OHOS::Camera::CameraMetadata> &result) override;
+    int32_t OnRawResult(const uint64_t timestamp, const std::vector<uint8_t> &result) override;
 
 private:
     static inline BrokerDelegator<HCameraDeviceCallbackProxy> delegator_;
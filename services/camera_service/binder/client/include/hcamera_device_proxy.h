@@ -43,6 +43,8 @@ public:
 
     int32_t DisableResult(std::vector<int32_t> &results) override;
 
+    int32_t GetResultSnapshot(std::shared_ptr<OHOS::Camera::CameraMetadata> &snapshot) override;
+
 private:
     static inline BrokerDelegator<HCameraDeviceProxy> delegator_;
 };
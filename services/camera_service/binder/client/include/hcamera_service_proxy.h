@@ -46,11 +46,18 @@ public:
     int32_t CreateCustomPreviewOutput(const sptr<OHOS::IBufferProducer> &producer, int32_t format, int32_t width,
                                       int32_t height, sptr<IStreamRepeat>& previewOutput) override;
 
+    int32_t CreateDeferredPreviewOutput(int32_t format, int32_t width, int32_t height,
+                                        sptr<IStreamRepeat> &previewOutput) override;
+
     int32_t CreateMetadataOutput(const sptr<OHOS::IBufferProducer> &producer, int32_t format,
                                  sptr<IStreamMetadata>& metadataOutput) override;
 
     int32_t CreateVideoOutput(const sptr<OHOS::IBufferProducer> &producer, int32_t format,
                               sptr<IStreamRepeat>& videoOutput) override;
+
+    int32_t CreateDeferredVideoOutput(int32_t format, int32_t width, int32_t height,
+                                      sptr<IStreamRepeat> &videoOutput) override;
+
     int32_t SetListenerObject(const sptr<IRemoteObject> &object) override;
 
 private:
@@ -28,6 +28,8 @@ public:
 
     int32_t OnError(int32_t errorCode) override;
 
+    int32_t OnCommitConfigDone(int32_t transactionId, int32_t errorCode) override;
+
 private:
     static inline BrokerDelegator<HCaptureSessionCallbackProxy> delegator_;
 };
@@ -39,14 +39,23 @@ public:
 
     int32_t CommitConfig() override;
 
+    int32_t CommitConfigAsync(int32_t &transactionId) override;
+
     int32_t Start() override;
 
+    int32_t StartGrouped() override;
+
     int32_t Stop() override;
 
     int32_t Release(pid_t pid) override;
 
     int32_t SetCallback(sptr<ICaptureSessionCallback> &callback) override;
 
+    int32_t ConfigureSession(sptr<ICameraDeviceService> cameraDevice, std::vector<SessionOutput> &outputs,
+                             const std::shared_ptr<Camera::CameraMetadata> &settings) override;
+
+    int32_t SetZslConfig(int32_t ringDepth, int32_t selection, uint64_t memoryBudget) override;
+
 private:
     static inline BrokerDelegator<HCaptureSessionProxy> delegator_;
 };
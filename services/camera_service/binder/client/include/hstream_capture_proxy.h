@@ -29,6 +29,12 @@ public:
 
     int32_t Capture(const std::shared_ptr<OHOS::Camera::CameraMetadata> &captureSettings) override;
 
+    int32_t BurstCapture(const std::shared_ptr<OHOS::Camera::CameraMetadata> &captureSettings,
+                         int32_t frameCount) override;
+
+    int32_t ZslCapture(const std::shared_ptr<OHOS::Camera::CameraMetadata> &captureSettings,
+                       int32_t selection) override;
+
     int32_t CancelCapture() override;
 
     int32_t Release() override;
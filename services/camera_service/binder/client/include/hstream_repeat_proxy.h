@@ -32,8 +32,12 @@ public:
 
     int32_t SetFps(float fps) override;
 
+    int32_t GetAchievedFps(float &fps) override;
+
     int32_t SetCallback(sptr<IStreamRepeatCallback> &callback) override;
 
+    int32_t AddDeferredSurface(const sptr<OHOS::IBufferProducer> &producer) override;
+
     int32_t Release() override;
 
 private:
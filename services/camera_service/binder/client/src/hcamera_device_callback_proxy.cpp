@@ -53,7 +53,7 @@ int32_t HCameraDeviceCallbackProxy::OnResult(const uint64_t timestamp,
 {
     MessageParcel data;
     MessageParcel reply;
-    MessageOption option;
+    MessageOption option(MessageOption::TF_ASYNC);
 
     if (!data.WriteInterfaceToken(GetDescriptor())) {
         MEDIA_ERR_LOG("HCameraDeviceCallbackProxy OnResult Write interface token failed");
@@ -69,7 +69,35 @@ int32_t HCameraDeviceCallbackProxy::OnResult(const uint64_t timestamp,
     }
     int error = Remote()->SendRequest(CAMERA_DEVICE_ON_RESULT, data, reply, option);
     if (error != ERR_NONE) {
-        MEDIA_ERR_LOG("HCameraDeviceCallbackProxy OnResult failed, error: %{public}d", error);
+        MEDIA_ERR_LOG_LIMITED(DROPPED_CALLBACK_LOG_INTERVAL_MS,
+                              "HCameraDeviceCallbackProxy OnResult failed, error: %{public}d", error);
+    }
+    return error;
+}
+
+int32_t HCameraDeviceCallbackProxy::OnRawResult(const uint64_t timestamp, const std::vector<uint8_t> &result)
+{
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option(MessageOption::TF_ASYNC);
+
+    if (!data.WriteInterfaceToken(GetDescriptor())) {
+        MEDIA_ERR_LOG("HCameraDeviceCallbackProxy OnRawResult Write interface token failed");
+        return IPC_PROXY_ERR;
+    }
+    if (!data.WriteUint64(timestamp)) {
+        MEDIA_ERR_LOG("HCameraDeviceCallbackProxy OnRawResult Write timestamp failed");
+        return IPC_PROXY_ERR;
+    }
+    // One copy of the HDI bytes, WriteUInt8Vector would pad every byte to 4
+    if (!data.WriteUint32(result.size()) || !data.WriteBuffer(result.data(), result.size())) {
+        MEDIA_ERR_LOG("HCameraDeviceCallbackProxy OnRawResult Write result failed");
+        return IPC_PROXY_ERR;
+    }
+    int error = Remote()->SendRequest(CAMERA_DEVICE_ON_RAW_RESULT, data, reply, option);
+    if (error != ERR_NONE) {
+        MEDIA_ERR_LOG_LIMITED(DROPPED_CALLBACK_LOG_INTERVAL_MS,
+                              "HCameraDeviceCallbackProxy OnRawResult failed, error: %{public}d", error);
     }
     return error;
 }
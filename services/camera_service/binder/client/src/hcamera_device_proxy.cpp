@@ -197,5 +197,30 @@ int32_t HCameraDeviceProxy::DisableResult(std::vector<int32_t> &results)
 
     return error;
 }
+
+int32_t HCameraDeviceProxy::GetResultSnapshot(std::shared_ptr<Camera::CameraMetadata> &snapshot)
+{
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option;
+
+    if (!data.WriteInterfaceToken(GetDescriptor())) {
+        MEDIA_ERR_LOG("HCameraDeviceProxy GetResultSnapshot Write interface token failed");
+        return IPC_PROXY_ERR;
+    }
+    int error = Remote()->SendRequest(CAMERA_DEVICE_GET_RESULT_SNAPSHOT, data, reply, option);
+    if (error != ERR_NONE) {
+        MEDIA_ERR_LOG("HCameraDeviceProxy GetResultSnapshot failed, error: %{public}d", error);
+        return IPC_PROXY_ERR;
+    }
+
+    Camera::MetadataUtils::DecodeCameraMetadata(reply, snapshot);
+    if (snapshot == nullptr) {
+        MEDIA_ERR_LOG("HCameraDeviceProxy GetResultSnapshot read snapshot failed");
+        return IPC_PROXY_ERR;
+    }
+
+    return error;
+}
 } // namespace CameraStandard
 } // namespace OHOS
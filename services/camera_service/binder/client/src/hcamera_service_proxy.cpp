@@ -282,6 +282,49 @@ int32_t HCameraServiceProxy::CreateCustomPreviewOutput(const sptr<OHOS::IBufferP
     return error;
 }
 
+int32_t HCameraServiceProxy::CreateDeferredPreviewOutput(int32_t format, int32_t width, int32_t height,
+                                                         sptr<IStreamRepeat> &previewOutput)
+{
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option;
+
+    if ((width == 0) || (height == 0)) {
+        MEDIA_ERR_LOG("HCameraServiceProxy CreateDeferredPreviewOutput invalid size is set");
+        return IPC_PROXY_ERR;
+    }
+
+    if (!data.WriteInterfaceToken(GetDescriptor())) {
+        MEDIA_ERR_LOG("HCameraServiceProxy CreateDeferredPreviewOutput Write interface token failed");
+        return IPC_PROXY_ERR;
+    }
+    if (!data.WriteInt32(format)) {
+        MEDIA_ERR_LOG("HCameraServiceProxy CreateDeferredPreviewOutput Write format failed");
+        return IPC_PROXY_ERR;
+    }
+    if (!data.WriteInt32(width)) {
+        MEDIA_ERR_LOG("HCameraServiceProxy CreateDeferredPreviewOutput Write width failed");
+        return IPC_PROXY_ERR;
+    }
+    if (!data.WriteInt32(height)) {
+        MEDIA_ERR_LOG("HCameraServiceProxy CreateDeferredPreviewOutput Write height failed");
+        return IPC_PROXY_ERR;
+    }
+    int error = Remote()->SendRequest(CAMERA_SERVICE_CREATE_DEFERRED_PREVIEW_OUTPUT, data, reply, option);
+    if (error != ERR_NONE) {
+        MEDIA_ERR_LOG("HCameraServiceProxy CreateDeferredPreviewOutput failed, error: %{public}d", error);
+        return error;
+    }
+    auto remoteObject = reply.ReadRemoteObject();
+    if (remoteObject != nullptr) {
+        previewOutput = iface_cast<IStreamRepeat>(remoteObject);
+    } else {
+        MEDIA_ERR_LOG("HCameraServiceProxy CreateDeferredPreviewOutput previewOutput is null");
+        error = IPC_PROXY_ERR;
+    }
+    return error;
+}
+
 int32_t HCameraServiceProxy::CreateMetadataOutput(const sptr<OHOS::IBufferProducer> &producer, int32_t format,
                                                   sptr<IStreamMetadata>& metadataOutput)
 {
@@ -368,6 +411,49 @@ int32_t HCameraServiceProxy::CreateVideoOutput(const sptr<OHOS::IBufferProducer>
     return error;
 }
 
+int32_t HCameraServiceProxy::CreateDeferredVideoOutput(int32_t format, int32_t width, int32_t height,
+                                                       sptr<IStreamRepeat> &videoOutput)
+{
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option;
+
+    if ((width == 0) || (height == 0)) {
+        MEDIA_ERR_LOG("HCameraServiceProxy CreateDeferredVideoOutput invalid size is set");
+        return IPC_PROXY_ERR;
+    }
+
+    if (!data.WriteInterfaceToken(GetDescriptor())) {
+        MEDIA_ERR_LOG("HCameraServiceProxy CreateDeferredVideoOutput Write interface token failed");
+        return IPC_PROXY_ERR;
+    }
+    if (!data.WriteInt32(format)) {
+        MEDIA_ERR_LOG("HCameraServiceProxy CreateDeferredVideoOutput Write format failed");
+        return IPC_PROXY_ERR;
+    }
+    if (!data.WriteInt32(width)) {
+        MEDIA_ERR_LOG("HCameraServiceProxy CreateDeferredVideoOutput Write width failed");
+        return IPC_PROXY_ERR;
+    }
+    if (!data.WriteInt32(height)) {
+        MEDIA_ERR_LOG("HCameraServiceProxy CreateDeferredVideoOutput Write height failed");
+        return IPC_PROXY_ERR;
+    }
+    int error = Remote()->SendRequest(CAMERA_SERVICE_CREATE_DEFERRED_VIDEO_OUTPUT, data, reply, option);
+    if (error != ERR_NONE) {
+        MEDIA_ERR_LOG("HCameraServiceProxy CreateDeferredVideoOutput failed, error: %{public}d", error);
+        return error;
+    }
+    auto remoteObject = reply.ReadRemoteObject();
+    if (remoteObject != nullptr) {
+        videoOutput = iface_cast<IStreamRepeat>(remoteObject);
+    } else {
+        MEDIA_ERR_LOG("HCameraServiceProxy CreateDeferredVideoOutput videoOutput is null");
+        error = IPC_PROXY_ERR;
+    }
+    return error;
+}
+
 int32_t HCameraServiceProxy::SetListenerObject(const sptr<IRemoteObject> &object)
 {
     MessageParcel data;
@@ -43,6 +43,31 @@ int32_t HCaptureSessionCallbackProxy::OnError(int32_t errorCode)
     }
     return error;
 }
+
+int32_t HCaptureSessionCallbackProxy::OnCommitConfigDone(int32_t transactionId, int32_t errorCode)
+{
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option(MessageOption::TF_ASYNC);
+
+    if (!data.WriteInterfaceToken(GetDescriptor())) {
+        MEDIA_ERR_LOG("HCaptureSessionCallbackProxy OnCommitConfigDone Write interface token failed");
+        return IPC_PROXY_ERR;
+    }
+    if (!data.WriteInt32(transactionId)) {
+        MEDIA_ERR_LOG("HCaptureSessionCallbackProxy OnCommitConfigDone Write transactionId failed");
+        return IPC_PROXY_ERR;
+    }
+    if (!data.WriteInt32(errorCode)) {
+        MEDIA_ERR_LOG("HCaptureSessionCallbackProxy OnCommitConfigDone Write errorCode failed");
+        return IPC_PROXY_ERR;
+    }
+    int error = Remote()->SendRequest(CAMERA_CAPTURE_SESSION_ON_COMMIT_CONFIG_DONE, data, reply, option);
+    if (error != ERR_NONE) {
+        MEDIA_ERR_LOG("HCaptureSessionCallbackProxy OnCommitConfigDone failed, error: %{public}d", error);
+    }
+    return error;
+}
 } // namespace CameraStandard
 } // namespace OHOS
 
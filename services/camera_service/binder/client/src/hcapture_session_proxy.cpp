@@ -15,6 +15,7 @@
 
 #include "hcapture_session_proxy.h"
 #include "camera_log.h"
+#include "metadata_utils.h"
 #include "remote_request_code.h"
 
 namespace OHOS {
@@ -178,6 +179,26 @@ int32_t HCaptureSessionProxy::CommitConfig()
     return error;
 }
 
+int32_t HCaptureSessionProxy::CommitConfigAsync(int32_t &transactionId)
+{
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option;
+
+    if (!data.WriteInterfaceToken(GetDescriptor())) {
+        MEDIA_ERR_LOG("HCaptureSessionProxy CommitConfigAsync Write interface token failed");
+        return IPC_PROXY_ERR;
+    }
+    int error = Remote()->SendRequest(CAMERA_CAPTURE_SESSION_COMMIT_CONFIG_ASYNC, data, reply, option);
+    if (error != ERR_NONE) {
+        MEDIA_ERR_LOG("HCaptureSessionProxy CommitConfigAsync failed, error: %{public}d", error);
+        return error;
+    }
+    transactionId = reply.ReadInt32();
+
+    return error;
+}
+
 int32_t HCaptureSessionProxy::Start()
 {
     MessageParcel data;
@@ -196,6 +217,24 @@ int32_t HCaptureSessionProxy::Start()
     return error;
 }
 
+int32_t HCaptureSessionProxy::StartGrouped()
+{
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option;
+
+    if (!data.WriteInterfaceToken(GetDescriptor())) {
+        MEDIA_ERR_LOG("HCaptureSessionProxy StartGrouped Write interface token failed");
+        return IPC_PROXY_ERR;
+    }
+    int error = Remote()->SendRequest(CAMERA_CAPTURE_SESSION_START_GROUPED, data, reply, option);
+    if (error != ERR_NONE) {
+        MEDIA_ERR_LOG("HCaptureSessionProxy StartGrouped failed, error: %{public}d", error);
+    }
+
+    return error;
+}
+
 int32_t HCaptureSessionProxy::Stop()
 {
     MessageParcel data;
@@ -259,5 +298,81 @@ int32_t HCaptureSessionProxy::SetCallback(sptr<ICaptureSessionCallback> &callbac
 
     return error;
 }
+
+int32_t HCaptureSessionProxy::ConfigureSession(sptr<ICameraDeviceService> cameraDevice,
+                                               std::vector<SessionOutput> &outputs,
+                                               const std::shared_ptr<Camera::CameraMetadata> &settings)
+{
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option;
+
+    if (cameraDevice == nullptr) {
+        MEDIA_ERR_LOG("HCaptureSessionProxy ConfigureSession cameraDevice is null");
+        return IPC_PROXY_ERR;
+    }
+
+    if (!data.WriteInterfaceToken(GetDescriptor())) {
+        MEDIA_ERR_LOG("HCaptureSessionProxy ConfigureSession Write interface token failed");
+        return IPC_PROXY_ERR;
+    }
+    if (!data.WriteRemoteObject(cameraDevice->AsObject())) {
+        MEDIA_ERR_LOG("HCaptureSessionProxy ConfigureSession write cameraDevice obj failed");
+        return IPC_PROXY_ERR;
+    }
+    if (!data.WriteUint32(static_cast<uint32_t>(outputs.size()))) {
+        MEDIA_ERR_LOG("HCaptureSessionProxy ConfigureSession Write output count failed");
+        return IPC_PROXY_ERR;
+    }
+    for (auto &output : outputs) {
+        if (output.second == nullptr) {
+            MEDIA_ERR_LOG("HCaptureSessionProxy ConfigureSession stream is null");
+            return IPC_PROXY_ERR;
+        }
+        if (!data.WriteUint32(static_cast<uint32_t>(output.first))
+            || !data.WriteRemoteObject(output.second->AsObject())) {
+            MEDIA_ERR_LOG("HCaptureSessionProxy ConfigureSession write stream failed");
+            return IPC_PROXY_ERR;
+        }
+    }
+    if (!data.WriteBool(settings != nullptr)) {
+        MEDIA_ERR_LOG("HCaptureSessionProxy ConfigureSession Write settings flag failed");
+        return IPC_PROXY_ERR;
+    }
+    if (settings != nullptr && !(Camera::MetadataUtils::EncodeCameraMetadata(settings, data))) {
+        MEDIA_ERR_LOG("HCaptureSessionProxy ConfigureSession EncodeCameraMetadata failed");
+        return IPC_PROXY_ERR;
+    }
+
+    int error = Remote()->SendRequest(CAMERA_CAPTURE_SESSION_CONFIGURE, data, reply, option);
+    if (error != ERR_NONE) {
+        MEDIA_ERR_LOG("HCaptureSessionProxy ConfigureSession failed, error: %{public}d", error);
+    }
+
+    return error;
+}
+
+int32_t HCaptureSessionProxy::SetZslConfig(int32_t ringDepth, int32_t selection, uint64_t memoryBudget)
+{
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option;
+
+    if (!data.WriteInterfaceToken(GetDescriptor())) {
+        MEDIA_ERR_LOG("HCaptureSessionProxy SetZslConfig Write interface token failed");
+        return IPC_PROXY_ERR;
+    }
+    if (!data.WriteInt32(ringDepth) || !data.WriteInt32(selection) || !data.WriteUint64(memoryBudget)) {
+        MEDIA_ERR_LOG("HCaptureSessionProxy SetZslConfig Write zsl config failed");
+        return IPC_PROXY_ERR;
+    }
+
+    int error = Remote()->SendRequest(CAMERA_CAPTURE_SESSION_SET_ZSL_CONFIG, data, reply, option);
+    if (error != ERR_NONE) {
+        MEDIA_ERR_LOG("HCaptureSessionProxy SetZslConfig failed, error: %{public}d", error);
+    }
+
+    return error;
+}
 } // namespace CameraStandard
 } // namespace OHOS
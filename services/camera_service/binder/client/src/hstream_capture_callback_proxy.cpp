@@ -26,7 +26,7 @@ int32_t HStreamCaptureCallbackProxy::OnCaptureStarted(int32_t captureId)
 {
     MessageParcel data;
     MessageParcel reply;
-    MessageOption option;
+    MessageOption option(MessageOption::TF_ASYNC);
 
     if (!data.WriteInterfaceToken(GetDescriptor())) {
         MEDIA_ERR_LOG("HStreamCaptureCallbackProxy OnCaptureStarted Write interface token failed");
@@ -38,7 +38,8 @@ int32_t HStreamCaptureCallbackProxy::OnCaptureStarted(int32_t captureId)
     }
     int error = Remote()->SendRequest(CAMERA_STREAM_CAPTURE_ON_CAPTURE_STARTED, data, reply, option);
     if (error != ERR_NONE) {
-        MEDIA_ERR_LOG("HStreamCaptureCallbackProxy OnCaptureStarted failed, error: %{public}d", error);
+        MEDIA_ERR_LOG_LIMITED(DROPPED_CALLBACK_LOG_INTERVAL_MS,
+                              "HStreamCaptureCallbackProxy OnCaptureStarted failed, error: %{public}d", error);
     }
 
     return error;
@@ -48,7 +49,7 @@ int32_t HStreamCaptureCallbackProxy::OnCaptureEnded(int32_t captureId, int32_t f
 {
     MessageParcel data;
     MessageParcel reply;
-    MessageOption option;
+    MessageOption option(MessageOption::TF_ASYNC);
 
     if (!data.WriteInterfaceToken(GetDescriptor())) {
         MEDIA_ERR_LOG("HStreamCaptureCallbackProxy OnCaptureEnded Write interface token failed");
@@ -64,7 +65,8 @@ int32_t HStreamCaptureCallbackProxy::OnCaptureEnded(int32_t captureId, int32_t f
     }
     int error = Remote()->SendRequest(CAMERA_STREAM_CAPTURE_ON_CAPTURE_ENDED, data, reply, option);
     if (error != ERR_NONE) {
-        MEDIA_ERR_LOG("HStreamCaptureCallbackProxy OnCaptureEnded failed, error: %{public}d", error);
+        MEDIA_ERR_LOG_LIMITED(DROPPED_CALLBACK_LOG_INTERVAL_MS,
+                              "HStreamCaptureCallbackProxy OnCaptureEnded failed, error: %{public}d", error);
     }
 
     return error;
@@ -74,7 +76,7 @@ int32_t HStreamCaptureCallbackProxy::OnCaptureError(int32_t captureId, int32_t e
 {
     MessageParcel data;
     MessageParcel reply;
-    MessageOption option;
+    MessageOption option(MessageOption::TF_ASYNC);
 
     if (!data.WriteInterfaceToken(GetDescriptor())) {
         MEDIA_ERR_LOG("HStreamCaptureCallbackProxy OnCaptureError Write interface token failed");
@@ -91,7 +93,8 @@ int32_t HStreamCaptureCallbackProxy::OnCaptureError(int32_t captureId, int32_t e
 
     int error = Remote()->SendRequest(CAMERA_STREAM_CAPTURE_ON_CAPTURE_ERROR, data, reply, option);
     if (error != ERR_NONE) {
-        MEDIA_ERR_LOG("HStreamCaptureCallbackProxy OnCaptureError failed, error: %{public}d", error);
+        MEDIA_ERR_LOG_LIMITED(DROPPED_CALLBACK_LOG_INTERVAL_MS,
+                              "HStreamCaptureCallbackProxy OnCaptureError failed, error: %{public}d", error);
     }
 
     return error;
@@ -101,7 +104,7 @@ int32_t HStreamCaptureCallbackProxy::OnFrameShutter(int32_t captureId, uint64_t
 {
     MessageParcel data;
     MessageParcel reply;
-    MessageOption option;
+    MessageOption option(MessageOption::TF_ASYNC);
 
     if (!data.WriteInterfaceToken(GetDescriptor())) {
         MEDIA_ERR_LOG("HStreamCaptureCallbackProxy OnFrameShutter Write interface token failed");
@@ -118,7 +121,8 @@ int32_t HStreamCaptureCallbackProxy::OnFrameShutter(int32_t captureId, uint64_t
 
     int error = Remote()->SendRequest(CAMERA_STREAM_CAPTURE_ON_FRAME_SHUTTER, data, reply, option);
     if (error != ERR_NONE) {
-        MEDIA_ERR_LOG("HStreamCaptureCallbackProxy OnFrameShutter failed, error: %{public}d", error);
+        MEDIA_ERR_LOG_LIMITED(DROPPED_CALLBACK_LOG_INTERVAL_MS,
+                              "HStreamCaptureCallbackProxy OnFrameShutter failed, error: %{public}d", error);
     }
 
     return error;
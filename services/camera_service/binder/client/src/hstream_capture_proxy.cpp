@@ -46,6 +46,62 @@ int32_t HStreamCaptureProxy::Capture(const std::shared_ptr<Camera::CameraMetadat
     return error;
 }
 
+int32_t HStreamCaptureProxy::BurstCapture(const std::shared_ptr<Camera::CameraMetadata> &captureSettings,
+                                          int32_t frameCount)
+{
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option;
+
+    if (!data.WriteInterfaceToken(GetDescriptor())) {
+        MEDIA_ERR_LOG("HStreamCaptureProxy BurstCapture Write interface token failed");
+        return IPC_PROXY_ERR;
+    }
+    if (!(Camera::MetadataUtils::EncodeCameraMetadata(captureSettings, data))) {
+        MEDIA_ERR_LOG("HStreamCaptureProxy BurstCapture EncodeCameraMetadata failed");
+        return IPC_PROXY_ERR;
+    }
+    if (!data.WriteInt32(frameCount)) {
+        MEDIA_ERR_LOG("HStreamCaptureProxy BurstCapture Write frameCount failed");
+        return IPC_PROXY_ERR;
+    }
+
+    int error = Remote()->SendRequest(CAMERA_STREAM_CAPTURE_BURST, data, reply, option);
+    if (error != ERR_NONE) {
+        MEDIA_ERR_LOG("HStreamCaptureProxy BurstCapture failed, error: %{public}d", error);
+    }
+
+    return error;
+}
+
+int32_t HStreamCaptureProxy::ZslCapture(const std::shared_ptr<Camera::CameraMetadata> &captureSettings,
+                                        int32_t selection)
+{
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option;
+
+    if (!data.WriteInterfaceToken(GetDescriptor())) {
+        MEDIA_ERR_LOG("HStreamCaptureProxy ZslCapture Write interface token failed");
+        return IPC_PROXY_ERR;
+    }
+    if (!(Camera::MetadataUtils::EncodeCameraMetadata(captureSettings, data))) {
+        MEDIA_ERR_LOG("HStreamCaptureProxy ZslCapture EncodeCameraMetadata failed");
+        return IPC_PROXY_ERR;
+    }
+    if (!data.WriteInt32(selection)) {
+        MEDIA_ERR_LOG("HStreamCaptureProxy ZslCapture Write selection failed");
+        return IPC_PROXY_ERR;
+    }
+
+    int error = Remote()->SendRequest(CAMERA_STREAM_CAPTURE_ZSL, data, reply, option);
+    if (error != ERR_NONE) {
+        MEDIA_ERR_LOG("HStreamCaptureProxy ZslCapture failed, error: %{public}d", error);
+    }
+
+    return error;
+}
+
 int32_t HStreamCaptureProxy::CancelCapture()
 {
     MessageParcel data;
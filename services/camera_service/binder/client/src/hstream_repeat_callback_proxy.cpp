@@ -26,7 +26,7 @@ int32_t HStreamRepeatCallbackProxy::OnFrameStarted()
 {
     MessageParcel data;
     MessageParcel reply;
-    MessageOption option;
+    MessageOption option(MessageOption::TF_ASYNC);
 
     if (!data.WriteInterfaceToken(GetDescriptor())) {
         MEDIA_ERR_LOG("HStreamRepeatCallbackProxy OnFrameStarted Write interface token failed");
@@ -34,7 +34,8 @@ int32_t HStreamRepeatCallbackProxy::OnFrameStarted()
     }
     int error = Remote()->SendRequest(CAMERA_STREAM_REPEAT_ON_FRAME_STARTED, data, reply, option);
     if (error != ERR_NONE) {
-        MEDIA_ERR_LOG("HStreamRepeatCallbackProxy OnFrameStarted failed, error: %{public}d", error);
+        MEDIA_ERR_LOG_LIMITED(DROPPED_CALLBACK_LOG_INTERVAL_MS,
+                              "HStreamRepeatCallbackProxy OnFrameStarted failed, error: %{public}d", error);
     }
 
     return error;
@@ -44,7 +45,7 @@ int32_t HStreamRepeatCallbackProxy::OnFrameEnded(int32_t frameCount)
 {
     MessageParcel data;
     MessageParcel reply;
-    MessageOption option;
+    MessageOption option(MessageOption::TF_ASYNC);
 
     if (!data.WriteInterfaceToken(GetDescriptor())) {
         MEDIA_ERR_LOG("HStreamRepeatCallbackProxy OnFrameEnded Write interface token failed");
@@ -57,7 +58,8 @@ int32_t HStreamRepeatCallbackProxy::OnFrameEnded(int32_t frameCount)
 
     int error = Remote()->SendRequest(CAMERA_STREAM_REPEAT_ON_FRAME_ENDED, data, reply, option);
     if (error != ERR_NONE) {
-        MEDIA_ERR_LOG("HStreamRepeatCallbackProxy OnFrameEnded failed, error: %{public}d", error);
+        MEDIA_ERR_LOG_LIMITED(DROPPED_CALLBACK_LOG_INTERVAL_MS,
+                              "HStreamRepeatCallbackProxy OnFrameEnded failed, error: %{public}d", error);
     }
 
     return error;
@@ -67,7 +69,7 @@ int32_t HStreamRepeatCallbackProxy::OnFrameError(int32_t errorCode)
 {
     MessageParcel data;
     MessageParcel reply;
-    MessageOption option;
+    MessageOption option(MessageOption::TF_ASYNC);
 
     if (!data.WriteInterfaceToken(GetDescriptor())) {
         MEDIA_ERR_LOG("HStreamRepeatCallbackProxy OnFrameError Write interface token failed");
@@ -80,7 +82,8 @@ int32_t HStreamRepeatCallbackProxy::OnFrameError(int32_t errorCode)
 
     int error = Remote()->SendRequest(CAMERA_STREAM_REPEAT_ON_ERROR, data, reply, option);
     if (error != ERR_NONE) {
-        MEDIA_ERR_LOG("HStreamRepeatCallbackProxy OnFrameError failed, error: %{public}d", error);
+        MEDIA_ERR_LOG_LIMITED(DROPPED_CALLBACK_LOG_INTERVAL_MS,
+                              "HStreamRepeatCallbackProxy OnFrameError failed, error: %{public}d", error);
     }
 
     return error;
@@ -98,6 +98,54 @@ int32_t HStreamRepeatProxy::SetFps(float fps)
     return error;
 }
 
+int32_t HStreamRepeatProxy::GetAchievedFps(float &fps)
+{
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option;
+
+    if (!data.WriteInterfaceToken(GetDescriptor())) {
+        MEDIA_ERR_LOG("HStreamRepeatProxy GetAchievedFps Write interface token failed");
+        return IPC_PROXY_ERR;
+    }
+
+    int error = Remote()->SendRequest(CAMERA_STREAM_REPEAT_GET_ACHIEVED_FPS, data, reply, option);
+    if (error != ERR_NONE) {
+        MEDIA_ERR_LOG("HStreamRepeatProxy GetAchievedFps failed, error: %{public}d", error);
+        return error;
+    }
+    fps = reply.ReadFloat();
+
+    return error;
+}
+
+int32_t HStreamRepeatProxy::AddDeferredSurface(const sptr<OHOS::IBufferProducer> &producer)
+{
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option;
+
+    if (producer == nullptr) {
+        MEDIA_ERR_LOG("HStreamRepeatProxy AddDeferredSurface producer is null");
+        return IPC_PROXY_ERR;
+    }
+    if (!data.WriteInterfaceToken(GetDescriptor())) {
+        MEDIA_ERR_LOG("HStreamRepeatProxy AddDeferredSurface Write interface token failed");
+        return IPC_PROXY_ERR;
+    }
+    if (!data.WriteRemoteObject(producer->AsObject())) {
+        MEDIA_ERR_LOG("HStreamRepeatProxy AddDeferredSurface write producer obj failed");
+        return IPC_PROXY_ERR;
+    }
+
+    int error = Remote()->SendRequest(CAMERA_STREAM_REPEAT_ADD_DEFERRED_SURFACE, data, reply, option);
+    if (error != ERR_NONE) {
+        MEDIA_ERR_LOG("HStreamRepeatProxy AddDeferredSurface failed, error: %{public}d", error);
+    }
+
+    return error;
+}
+
 int32_t HStreamRepeatProxy::SetCallback(sptr<IStreamRepeatCallback> &callback)
 {
     MessageParcel data;
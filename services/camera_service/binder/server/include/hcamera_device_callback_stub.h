@@ -25,10 +25,12 @@ class HCameraDeviceCallbackStub : public IRemoteStub<ICameraDeviceServiceCallbac
 public:
     int OnRemoteRequest(uint32_t code, MessageParcel &data,
                                 MessageParcel &reply, MessageOption &option) override;
+    int32_t OnRawResult(const uint64_t timestamp, const std::vector<uint8_t> &result) override;
 
 private:
     int HandleDeviceOnError(MessageParcel& data);
     int HandleDeviceOnResult(MessageParcel& data);
+    int HandleDeviceOnRawResult(MessageParcel& data);
 };
 } // namespace CameraStandard
 } // namespace OHOS
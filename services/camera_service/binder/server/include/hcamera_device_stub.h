@@ -32,6 +32,7 @@ private:
     int HandleGetEnabledResults(MessageParcel &reply);
     int HandleEnableResult(MessageParcel &data);
     int HandleDisableResult(MessageParcel &data);
+    int HandleGetResultSnapshot(MessageParcel &reply);
 };
 } // namespace CameraStandard
 } // namespace OHOS
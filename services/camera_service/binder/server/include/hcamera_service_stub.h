@@ -41,6 +41,8 @@ private:
     int HandleCreatePreviewOutputCustomSize(MessageParcel &data, MessageParcel &reply);
     int HandleCreateMetadataOutput(MessageParcel &data, MessageParcel &reply);
     int HandleCreateVideoOutput(MessageParcel &data, MessageParcel &reply);
+    int HandleCreateDeferredPreviewOutput(MessageParcel &data, MessageParcel &reply);
+    int HandleCreateDeferredVideoOutput(MessageParcel &data, MessageParcel &reply);
     int DestroyStubForPid(pid_t pid);
     void ClientDied(pid_t pid);
     int SetListenerObject(const sptr<IRemoteObject> &object) override;
@@ -28,6 +28,7 @@ public:
 
 private:
     int HandleSessionOnError(MessageParcel& data);
+    int HandleSessionOnCommitConfigDone(MessageParcel& data);
 };
 } // namespace CameraStandard
 } // namespace OHOS
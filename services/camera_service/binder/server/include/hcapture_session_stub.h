@@ -32,6 +32,9 @@ private:
     int HandleRemoveInput(MessageParcel &data);
     int HandleRemoveOutput(MessageParcel &data);
     int HandleSetCallback(MessageParcel &data);
+    int HandleConfigureSession(MessageParcel &data);
+    int HandleSetZslConfig(MessageParcel &data);
+    int HandleCommitConfigAsync(MessageParcel &reply);
 };
 } // namespace CameraStandard
 } // namespace OHOS
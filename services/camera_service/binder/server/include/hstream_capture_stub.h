@@ -28,6 +28,8 @@ public:
 
 public:
     int HandleCapture(MessageParcel &data);
+    int HandleBurstCapture(MessageParcel &data);
+    int HandleZslCapture(MessageParcel &data);
     int HandleSetCallback(MessageParcel &data);
 };
 } // namespace CameraStandard
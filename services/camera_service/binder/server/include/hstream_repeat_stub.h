@@ -28,6 +28,8 @@ public:
 
 private:
     int HandleSetCallback(MessageParcel &data);
+    int HandleGetAchievedFps(MessageParcel &reply);
+    int HandleAddDeferredSurface(MessageParcel &data);
 };
 } // namespace CameraStandard
 } // namespace OHOS
@@ -35,6 +35,9 @@ int HCameraDeviceCallbackStub::OnRemoteRequest(
         case CAMERA_DEVICE_ON_RESULT:
             errCode = HCameraDeviceCallbackStub::HandleDeviceOnResult(data);
             break;
+        case CAMERA_DEVICE_ON_RAW_RESULT:
+            errCode = HCameraDeviceCallbackStub::HandleDeviceOnRawResult(data);
+            break;
         default:
             MEDIA_ERR_LOG("HCameraDeviceCallbackStub request code %{public}u not handled", code);
             errCode = IPCObjectStub::OnRemoteRequest(code, data, reply, option);
@@ -61,5 +64,30 @@ int HCameraDeviceCallbackStub::HandleDeviceOnResult(MessageParcel& data)
     Camera::MetadataUtils::DecodeCameraMetadata(data, metadata);
     return OnResult(timestamp, metadata);
 }
+
+int HCameraDeviceCallbackStub::HandleDeviceOnRawResult(MessageParcel& data)
+{
+    uint64_t timestamp = data.ReadUint64();
+    uint32_t size = data.ReadUint32();
+    const uint8_t *buffer = data.ReadBuffer(size);
+    if (buffer == nullptr) {
+        MEDIA_ERR_LOG("HCameraDeviceCallbackStub HandleDeviceOnRawResult read result failed");
+        return IPC_STUB_INVALID_DATA_ERR;
+    }
+    std::vector<uint8_t> result(buffer, buffer + size);
+    return OnRawResult(timestamp, result);
+}
+
+int32_t HCameraDeviceCallbackStub::OnRawResult(const uint64_t timestamp, const std::vector<uint8_t> &result)
+{
+    // Clients implement OnResult, the result is decoded once here on their side
+    std::shared_ptr<OHOS::Camera::CameraMetadata> metadata = nullptr;
+    OHOS::Camera::MetadataUtils::ConvertVecToMetadata(result, metadata);
+    if (metadata == nullptr) {
+        MEDIA_ERR_LOG("HCameraDeviceCallbackStub OnRawResult failed to decode %{public}zu bytes", result.size());
+        return IPC_STUB_INVALID_DATA_ERR;
+    }
+    return OnResult(timestamp, metadata);
+}
 } // namespace CameraStandard
 } // namespace OHOS
@@ -54,6 +54,9 @@ int HCameraDeviceStub::OnRemoteRequest(
         case CAMERA_DEVICE_DISABLED_RESULT:
             errCode = HCameraDeviceStub::HandleDisableResult(data);
             break;
+        case CAMERA_DEVICE_GET_RESULT_SNAPSHOT:
+            errCode = HCameraDeviceStub::HandleGetResultSnapshot(reply);
+            break;
         default:
             MEDIA_ERR_LOG("HCameraDeviceStub request code %{public}d not handled", code);
             errCode = IPCObjectStub::OnRemoteRequest(code, data, reply, option);
@@ -132,5 +135,22 @@ int HCameraDeviceStub::HandleDisableResult(MessageParcel &data)
 
     return ret;
 }
+
+int HCameraDeviceStub::HandleGetResultSnapshot(MessageParcel &reply)
+{
+    std::shared_ptr<OHOS::Camera::CameraMetadata> snapshot = nullptr;
+    int ret = GetResultSnapshot(snapshot);
+    if (ret != ERR_NONE) {
+        MEDIA_ERR_LOG("CameraDeviceStub::HandleGetResultSnapshot GetResultSnapshot failed : %{public}d", ret);
+        return ret;
+    }
+
+    if (!(Camera::MetadataUtils::EncodeCameraMetadata(snapshot, reply))) {
+        MEDIA_ERR_LOG("HCameraDeviceStub::HandleGetResultSnapshot write snapshot failed");
+        return IPC_STUB_WRITE_PARCEL_ERR;
+    }
+
+    return ret;
+}
 } // namespace CameraStandard
 } // namespace OHOS
@@ -78,6 +78,12 @@ int HCameraServiceStub::OnRemoteRequest(
         case CAMERA_SERVICE_CREATE_VIDEO_OUTPUT:
             errCode = HCameraServiceStub::HandleCreateVideoOutput(data, reply);
             break;
+        case CAMERA_SERVICE_CREATE_DEFERRED_PREVIEW_OUTPUT:
+            errCode = HCameraServiceStub::HandleCreateDeferredPreviewOutput(data, reply);
+            break;
+        case CAMERA_SERVICE_CREATE_DEFERRED_VIDEO_OUTPUT:
+            errCode = HCameraServiceStub::HandleCreateDeferredVideoOutput(data, reply);
+            break;
         case CAMERA_SERVICE_SET_LISTENER_OBJ:
             errCode = HCameraServiceStub::SetListenerObject(data, reply);
             break;
@@ -246,6 +252,25 @@ int HCameraServiceStub::HandleCreatePreviewOutputCustomSize(MessageParcel &data,
     return errCode;
 }
 
+int HCameraServiceStub::HandleCreateDeferredPreviewOutput(MessageParcel &data, MessageParcel &reply)
+{
+    sptr<IStreamRepeat> previewOutput = nullptr;
+
+    int32_t format = data.ReadInt32();
+    int32_t width = data.ReadInt32();
+    int32_t height = data.ReadInt32();
+    int errCode = CreateDeferredPreviewOutput(format, width, height, previewOutput);
+    if (errCode != ERR_NONE) {
+        MEDIA_ERR_LOG("HandleCreateDeferredPreviewOutput CreateDeferredPreviewOutput failed : %{public}d", errCode);
+        return errCode;
+    }
+    if (!reply.WriteRemoteObject(previewOutput->AsObject())) {
+        MEDIA_ERR_LOG("HCameraServiceStub HandleCreateDeferredPreviewOutput Write previewOutput obj failed");
+        return IPC_STUB_WRITE_PARCEL_ERR;
+    }
+    return errCode;
+}
+
 int HCameraServiceStub::HandleCreateMetadataOutput(MessageParcel &data, MessageParcel &reply)
 {
     sptr<IStreamMetadata> metadataOutput = nullptr;
@@ -295,6 +320,25 @@ int HCameraServiceStub::HandleCreateVideoOutput(MessageParcel &data, MessageParc
     return errCode;
 }
 
+int HCameraServiceStub::HandleCreateDeferredVideoOutput(MessageParcel &data, MessageParcel &reply)
+{
+    sptr<IStreamRepeat> videoOutput = nullptr;
+
+    int32_t format = data.ReadInt32();
+    int32_t width = data.ReadInt32();
+    int32_t height = data.ReadInt32();
+    int errCode = CreateDeferredVideoOutput(format, width, height, videoOutput);
+    if (errCode != ERR_NONE) {
+        MEDIA_ERR_LOG("HandleCreateDeferredVideoOutput CreateDeferredVideoOutput failed : %{public}d", errCode);
+        return errCode;
+    }
+    if (!reply.WriteRemoteObject(videoOutput->AsObject())) {
+        MEDIA_ERR_LOG("HCameraServiceStub HandleCreateDeferredVideoOutput Write videoOutput obj failed");
+        return IPC_STUB_WRITE_PARCEL_ERR;
+    }
+    return errCode;
+}
+
 int HCameraServiceStub::DestroyStubForPid(pid_t pid)
 {
     sptr<CameraDeathRecipient> deathRecipient = nullptr;
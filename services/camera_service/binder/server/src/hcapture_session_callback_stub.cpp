@@ -32,6 +32,9 @@ int HCaptureSessionCallbackStub::OnRemoteRequest(
         case CAMERA_CAPTURE_SESSION_ON_ERROR:
             errCode = HCaptureSessionCallbackStub::HandleSessionOnError(data);
             break;
+        case CAMERA_CAPTURE_SESSION_ON_COMMIT_CONFIG_DONE:
+            errCode = HCaptureSessionCallbackStub::HandleSessionOnCommitConfigDone(data);
+            break;
         default:
             MEDIA_ERR_LOG("HCaptureSessionCallbackStub request code %{public}d not handled", code);
             errCode = IPCObjectStub::OnRemoteRequest(code, data, reply, option);
@@ -45,5 +48,12 @@ int HCaptureSessionCallbackStub::HandleSessionOnError(MessageParcel& data)
     int32_t errorCode = data.ReadInt32();
     return OnError(errorCode);
 }
+
+int HCaptureSessionCallbackStub::HandleSessionOnCommitConfigDone(MessageParcel& data)
+{
+    int32_t transactionId = data.ReadInt32();
+    int32_t errorCode = data.ReadInt32();
+    return OnCommitConfigDone(transactionId, errorCode);
+}
 } // namespace CameraStandard
 } // namespace OHOS
@@ -16,10 +16,24 @@
 #include "hcapture_session_stub.h"
 #include "camera_log.h"
 #include "ipc_skeleton.h"
+#include "metadata_utils.h"
 #include "remote_request_code.h"
 
 namespace OHOS {
 namespace CameraStandard {
+static const uint32_t MAX_SESSION_OUTPUTS = 16;
+
+static bool ReadStreamType(MessageParcel &data, StreamType &streamType)
+{
+    uint32_t value = data.ReadUint32();
+    if (value < static_cast<uint32_t>(StreamType::CAPTURE) || value > static_cast<uint32_t>(StreamType::METADATA)) {
+        MEDIA_ERR_LOG("HCaptureSessionStub invalid stream type: %{public}u", value);
+        return false;
+    }
+    streamType = static_cast<StreamType>(value);
+    return true;
+}
+
 int HCaptureSessionStub::OnRemoteRequest(
     uint32_t code, MessageParcel &data, MessageParcel &reply, MessageOption &option)
 {
@@ -50,6 +64,9 @@ int HCaptureSessionStub::OnRemoteRequest(
         case CAMERA_CAPTURE_SESSION_START:
             errCode = Start();
             break;
+        case CAMERA_CAPTURE_SESSION_START_GROUPED:
+            errCode = StartGrouped();
+            break;
         case CAMERA_CAPTURE_SESSION_STOP:
             errCode = Stop();
             break;
@@ -61,6 +78,15 @@ int HCaptureSessionStub::OnRemoteRequest(
         case CAMERA_CAPTURE_SESSION_SET_CALLBACK:
             errCode = HandleSetCallback(data);
             break;
+        case CAMERA_CAPTURE_SESSION_CONFIGURE:
+            errCode = HandleConfigureSession(data);
+            break;
+        case CAMERA_CAPTURE_SESSION_SET_ZSL_CONFIG:
+            errCode = HandleSetZslConfig(data);
+            break;
+        case CAMERA_CAPTURE_SESSION_COMMIT_CONFIG_ASYNC:
+            errCode = HandleCommitConfigAsync(reply);
+            break;
         default:
             MEDIA_ERR_LOG("HCaptureSessionStub request code %{public}u not handled", code);
             errCode = IPCObjectStub::OnRemoteRequest(code, data, reply, option);
@@ -98,7 +124,10 @@ int HCaptureSessionStub::HandleRemoveInput(MessageParcel &data)
 
 int HCaptureSessionStub::HandleAddOutput(MessageParcel &data)
 {
-    StreamType streamType = static_cast<StreamType>(data.ReadUint32());
+    StreamType streamType;
+    if (!ReadStreamType(data, streamType)) {
+        return IPC_STUB_INVALID_DATA_ERR;
+    }
     sptr<IRemoteObject> remoteObj = data.ReadRemoteObject();
     if (remoteObj == nullptr) {
         MEDIA_ERR_LOG("HCaptureSessionStub HandleAddOutput remoteObj is null");
@@ -112,7 +141,10 @@ int HCaptureSessionStub::HandleAddOutput(MessageParcel &data)
 
 int HCaptureSessionStub::HandleRemoveOutput(MessageParcel &data)
 {
-    StreamType streamType = static_cast<StreamType>(data.ReadUint32());
+    StreamType streamType;
+    if (!ReadStreamType(data, streamType)) {
+        return IPC_STUB_INVALID_DATA_ERR;
+    }
     sptr<IRemoteObject> remoteObj = data.ReadRemoteObject();
     if (remoteObj == nullptr) {
         MEDIA_ERR_LOG("HCaptureSessionStub HandleRemoveOutput remoteObj is null");
@@ -136,5 +168,68 @@ int HCaptureSessionStub::HandleSetCallback(MessageParcel &data)
 
     return SetCallback(callback);
 }
+
+int HCaptureSessionStub::HandleConfigureSession(MessageParcel &data)
+{
+    sptr<IRemoteObject> remoteObj = data.ReadRemoteObject();
+    if (remoteObj == nullptr) {
+        MEDIA_ERR_LOG("HCaptureSessionStub HandleConfigureSession CameraDevice is null");
+        return IPC_STUB_INVALID_DATA_ERR;
+    }
+    sptr<ICameraDeviceService> cameraDevice = iface_cast<ICameraDeviceService>(remoteObj);
+
+    uint32_t outputCount = data.ReadUint32();
+    if (outputCount > MAX_SESSION_OUTPUTS) {
+        MEDIA_ERR_LOG("HCaptureSessionStub HandleConfigureSession too many outputs: %{public}u", outputCount);
+        return IPC_STUB_INVALID_DATA_ERR;
+    }
+    std::vector<SessionOutput> outputs;
+    for (uint32_t i = 0; i < outputCount; i++) {
+        StreamType streamType;
+        if (!ReadStreamType(data, streamType)) {
+            return IPC_STUB_INVALID_DATA_ERR;
+        }
+        remoteObj = data.ReadRemoteObject();
+        if (remoteObj == nullptr) {
+            MEDIA_ERR_LOG("HCaptureSessionStub HandleConfigureSession remoteObj is null");
+            return IPC_STUB_INVALID_DATA_ERR;
+        }
+        outputs.emplace_back(streamType, iface_cast<IStreamCommon>(remoteObj));
+    }
+
+    std::shared_ptr<OHOS::Camera::CameraMetadata> settings = nullptr;
+    if (data.ReadBool()) {
+        Camera::MetadataUtils::DecodeCameraMetadata(data, settings);
+        if (settings == nullptr) {
+            MEDIA_ERR_LOG("HCaptureSessionStub HandleConfigureSession decode settings failed");
+            return IPC_STUB_INVALID_DATA_ERR;
+        }
+    }
+
+    return ConfigureSession(cameraDevice, outputs, settings);
+}
+
+int HCaptureSessionStub::HandleSetZslConfig(MessageParcel &data)
+{
+    int32_t ringDepth = data.ReadInt32();
+    int32_t selection = data.ReadInt32();
+    uint64_t memoryBudget = data.ReadUint64();
+
+    return SetZslConfig(ringDepth, selection, memoryBudget);
+}
+
+int HCaptureSessionStub::HandleCommitConfigAsync(MessageParcel &reply)
+{
+    int32_t transactionId = 0;
+    int errCode = CommitConfigAsync(transactionId);
+    if (errCode != ERR_NONE) {
+        return errCode;
+    }
+    if (!reply.WriteInt32(transactionId)) {
+        MEDIA_ERR_LOG("HCaptureSessionStub HandleCommitConfigAsync Write transactionId failed");
+        return IPC_STUB_WRITE_PARCEL_ERR;
+    }
+    return errCode;
+}
 } // namespace CameraStandard
 } // namespace OHOS
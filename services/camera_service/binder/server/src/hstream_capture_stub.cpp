@@ -32,6 +32,12 @@ int HStreamCaptureStub::OnRemoteRequest(
         case CAMERA_STREAM_CAPTURE_START:
             errCode = HStreamCaptureStub::HandleCapture(data);
             break;
+        case CAMERA_STREAM_CAPTURE_BURST:
+            errCode = HStreamCaptureStub::HandleBurstCapture(data);
+            break;
+        case CAMERA_STREAM_CAPTURE_ZSL:
+            errCode = HStreamCaptureStub::HandleZslCapture(data);
+            break;
         case CAMERA_STREAM_CAPTURE_CANCEL:
             errCode = CancelCapture();
             break;
@@ -58,6 +64,24 @@ int HStreamCaptureStub::HandleCapture(MessageParcel &data)
     return Capture(metadata);
 }
 
+int HStreamCaptureStub::HandleBurstCapture(MessageParcel &data)
+{
+    std::shared_ptr<OHOS::Camera::CameraMetadata> metadata = nullptr;
+    Camera::MetadataUtils::DecodeCameraMetadata(data, metadata);
+    int32_t frameCount = data.ReadInt32();
+
+    return BurstCapture(metadata, frameCount);
+}
+
+int HStreamCaptureStub::HandleZslCapture(MessageParcel &data)
+{
+    std::shared_ptr<OHOS::Camera::CameraMetadata> metadata = nullptr;
+    Camera::MetadataUtils::DecodeCameraMetadata(data, metadata);
+    int32_t selection = data.ReadInt32();
+
+    return ZslCapture(metadata, selection);
+}
+
 int HStreamCaptureStub::HandleSetCallback(MessageParcel &data)
 {
     auto remoteObject = data.ReadRemoteObject();
@@ -45,6 +45,12 @@ int HStreamRepeatStub::OnRemoteRequest(
         case CAMERA_STREAM_REPEAT_RELEASE:
             errCode = Release();
             break;
+        case CAMERA_STREAM_REPEAT_GET_ACHIEVED_FPS:
+            errCode = HStreamRepeatStub::HandleGetAchievedFps(reply);
+            break;
+        case CAMERA_STREAM_REPEAT_ADD_DEFERRED_SURFACE:
+            errCode = HStreamRepeatStub::HandleAddDeferredSurface(data);
+            break;
         default:
             MEDIA_ERR_LOG("HStreamRepeatStub request code %{public}u not handled", code);
             errCode = IPCObjectStub::OnRemoteRequest(code, data, reply, option);
@@ -66,5 +72,30 @@ int HStreamRepeatStub::HandleSetCallback(MessageParcel &data)
 
     return SetCallback(callback);
 }
+
+int HStreamRepeatStub::HandleGetAchievedFps(MessageParcel &reply)
+{
+    float fps = 0;
+    int errCode = GetAchievedFps(fps);
+    if (errCode != ERR_NONE) {
+        return errCode;
+    }
+    if (!reply.WriteFloat(fps)) {
+        MEDIA_ERR_LOG("HStreamRepeatStub HandleGetAchievedFps Write fps failed");
+        return IPC_STUB_WRITE_PARCEL_ERR;
+    }
+    return errCode;
+}
+
+int HStreamRepeatStub::HandleAddDeferredSurface(MessageParcel &data)
+{
+    sptr<IRemoteObject> remoteObj = data.ReadRemoteObject();
+    if (remoteObj == nullptr) {
+        MEDIA_ERR_LOG("HStreamRepeatStub HandleAddDeferredSurface BufferProducer is null");
+        return IPC_STUB_INVALID_DATA_ERR;
+    }
+    sptr<OHOS::IBufferProducer> producer = iface_cast<OHOS::IBufferProducer>(remoteObj);
+    return AddDeferredSurface(producer);
+}
 } // namespace CameraStandard
 } // namespace OHOS
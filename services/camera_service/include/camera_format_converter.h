@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_CAMERA_FORMAT_CONVERTER_H
+#define OHOS_CAMERA_FORMAT_CONVERTER_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace OHOS {
+namespace CameraStandard {
+/*
+ * A frame in one of the convertible PIXEL_FMT_* layouts. stride is the byte length of a row of
+ * the first plane, the chroma planes of the YUV 4:2:0 layouts follow it with no vertical padding.
+ */
+struct ImageBuffer {
+    uint8_t *data;
+    size_t size;
+    int32_t format;
+    int32_t width;
+    int32_t height;
+    int32_t stride;
+};
+
+bool IsConvertibleFormat(int32_t pixelFormat);
+size_t GetImageSize(int32_t pixelFormat, int32_t stride, int32_t height);
+bool IsValidImage(const ImageBuffer &image);
+
+/*
+ * Converts between NV21, NV12, I420 and RGBA_8888 using BT.601 limited range for the color
+ * conversions. The SIMD kernels of the build target are bit exact with the scalar ones, which
+ * are used instead when useSimd is false or no SIMD instruction set is available.
+ */
+int32_t ConvertImage(const ImageBuffer &src, const ImageBuffer &dst, bool useSimd = true);
+const char *GetConvertSimdName();
+} // namespace CameraStandard
+} // namespace OHOS
+#endif // OHOS_CAMERA_FORMAT_CONVERTER_H
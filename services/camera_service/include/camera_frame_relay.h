@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_CAMERA_FRAME_RELAY_H
+#define OHOS_CAMERA_FRAME_RELAY_H
+
+#include "surface.h"
+
+#include <mutex>
+#include <refbase.h>
+#include <string>
+#include <vector>
+
+namespace OHOS {
+namespace CameraStandard {
+int32_t CopyBufferToSurface(const sptr<SurfaceBuffer> &buffer, int64_t timestamp, sptr<Surface> &output);
+int32_t ConvertBufferToSurface(const sptr<SurfaceBuffer> &buffer, int32_t srcFormat, int32_t dstFormat,
+                               int64_t timestamp, sptr<Surface> &output);
+int32_t ScaleBufferToSurface(const sptr<SurfaceBuffer> &buffer, int32_t srcFormat, int32_t dstFormat,
+                             int32_t width, int32_t height, int64_t timestamp, sptr<Surface> &output,
+                             std::vector<uint8_t> &scratch);
+int32_t TransformBufferToSurface(const sptr<SurfaceBuffer> &buffer, int32_t srcFormat, int32_t dstFormat,
+                                 int32_t width, int32_t height, int32_t rotation, bool isMirrored,
+                                 int64_t timestamp, sptr<Surface> &output, std::vector<uint8_t> &scratch);
+
+/*
+ * Receives the frames of a stream in a service owned consumer surface and forwards to
+ * the client surface only the ones due for the target frame rate, 0 forwards every frame.
+ * The client surface may be set after Init for deferred outputs, frames are dropped until then.
+ * Frames are converted on the way when the device produces another pixel format than the client asked for,
+ * and scaled down when it produces a larger size. Frames are rotated or mirrored last when the client
+ * surface cannot apply the transform itself.
+ */
+class FrameRelay : public RefBase {
+public:
+    explicit FrameRelay(sptr<IBufferProducer> clientProducer);
+    ~FrameRelay();
+
+    int32_t Init(int32_t width, int32_t height);
+    sptr<IBufferProducer> GetProducer();
+    void SetClientProducer(sptr<IBufferProducer> clientProducer);
+    void SetTargetFps(float fps);
+    void SetConversion(int32_t srcFormat, int32_t dstFormat);
+    void SetOutputSize(int32_t width, int32_t height);
+    void SetTransform(int32_t rotation, bool isMirrored);
+    void OnBufferAvailable();
+    float GetAchievedFps();
+    void Release();
+    void DumpRelayInfo(std::string &dumpString);
+
+private:
+    void UpdateFrameRateLocked(int64_t now);
+
+    std::mutex mutex_;
+    // Serializes the frame callbacks, held across the copy and guards scaleBuffer_
+    std::mutex processLock_;
+    sptr<IBufferProducer> clientProducer_;
+    sptr<Surface> surface_;
+    sptr<Surface> output_;
+    int64_t frameInterval_ = 0;
+    int64_t nextFrameTime_ = 0;
+    int64_t lastInputTime_ = 0;
+    int64_t windowStart_ = 0;
+    uint32_t windowInputFrames_ = 0;
+    uint32_t windowOutputFrames_ = 0;
+    float inputFps_ = 0;
+    float achievedFps_ = 0;
+    int32_t srcFormat_ = 0;
+    int32_t dstFormat_ = 0;
+    // 0 keeps the size of the device frames
+    int32_t outputWidth_ = 0;
+    int32_t outputHeight_ = 0;
+    std::vector<uint8_t> scaleBuffer_;
+    // Clockwise degrees, applied after the horizontal mirroring
+    int32_t rotation_ = 0;
+    bool isMirrored_ = false;
+    uint64_t transformedFrames_ = 0;
+    int64_t lastTransformTime_ = 0;
+    int64_t maxTransformTime_ = 0;
+    int64_t totalTransformTime_ = 0;
+    uint64_t forwardedFrames_ = 0;
+    uint64_t skippedFrames_ = 0;
+};
+} // namespace CameraStandard
+} // namespace OHOS
+#endif // OHOS_CAMERA_FRAME_RELAY_H
@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_CAMERA_IMAGE_SCALER_H
+#define OHOS_CAMERA_IMAGE_SCALER_H
+
+#include "camera_format_converter.h"
+
+namespace OHOS {
+namespace CameraStandard {
+/*
+ * Scales a frame to the size of dst in the same pixel format. The source is first cropped around
+ * its center to the aspect ratio of dst, then halved with a 2x2 box filter while it is at least
+ * twice the destination size, which approximates an area filter, and finally resampled bilinearly.
+ * The SIMD kernels are bit exact with the scalar ones, which are used when useSimd is false.
+ */
+int32_t ScaleImage(const ImageBuffer &src, const ImageBuffer &dst, bool useSimd = true);
+} // namespace CameraStandard
+} // namespace OHOS
+#endif // OHOS_CAMERA_IMAGE_SCALER_H
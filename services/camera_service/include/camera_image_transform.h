@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_CAMERA_IMAGE_TRANSFORM_H
+#define OHOS_CAMERA_IMAGE_TRANSFORM_H
+
+#include "camera_format_converter.h"
+
+namespace OHOS {
+namespace CameraStandard {
+/*
+ * Mirrors a frame horizontally when isMirrored is set, then rotates it clockwise by rotation
+ * degrees, one of 0, 90, 180 or 270, into dst in the same pixel format. dst has the width and
+ * height of src swapped for 90 and 270. Rotations by 90 and 270 are transposes done in cache
+ * sized blocks of 8x8 SIMD tiles. The SIMD kernels are bit exact with the scalar ones, which are
+ * used when useSimd is false.
+ */
+int32_t TransformImage(const ImageBuffer &src, const ImageBuffer &dst, int32_t rotation, bool isMirrored,
+                       bool useSimd = true);
+} // namespace CameraStandard
+} // namespace OHOS
+#endif // OHOS_CAMERA_IMAGE_TRANSFORM_H
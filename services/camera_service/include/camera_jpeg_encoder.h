@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_CAMERA_JPEG_ENCODER_H
+#define OHOS_CAMERA_JPEG_ENCODER_H
+
+#include "surface.h"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <refbase.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace OHOS {
+namespace CameraStandard {
+static const int32_t JPEG_DEFAULT_QUALITY = 90;
+
+struct NV21Image {
+    const uint8_t *luma;
+    const uint8_t *chroma;
+    int32_t width;
+    int32_t height;
+    int32_t stride;
+};
+
+/*
+ * Encodes the NV21 photo frames the HDI delivers to a service owned consumer surface into
+ * JPEG and writes them to the client surface. A frame is cut into horizontal strips of whole
+ * MCU rows that are encoded in parallel, then stitched into one baseline JPEG with a restart
+ * marker between the strips. Photos are mirrored before encoding when the HDI cannot mirror them.
+ */
+class JpegEncoder : public RefBase {
+public:
+    explicit JpegEncoder(sptr<IBufferProducer> clientProducer);
+    ~JpegEncoder();
+
+    int32_t Init(int32_t width, int32_t height);
+    sptr<IBufferProducer> GetProducer();
+    void QueueCapture(int32_t captureId, int32_t frameCount, int32_t quality, int32_t orientation,
+                      bool isMirrored = false);
+    // Drops the frames of a cancelled capture that are still to come
+    void DropCapture(int32_t captureId);
+    // Drops the frames of a capture that arrive beyond the ones it requested
+    void EndCapture(int32_t captureId);
+    void OnBufferAvailable();
+    // Encodes in one pass without restart markers when isStriped is false
+    int32_t Encode(const NV21Image &image, int32_t quality, int32_t orientation, std::vector<uint8_t> &jpeg,
+                   bool isStriped = true);
+    void Release();
+    void DumpEncoderInfo(std::string &dumpString);
+
+private:
+    struct PendingCapture {
+        int32_t captureId;
+        int32_t remainingFrames;
+        int32_t quality;
+        int32_t orientation;
+        bool isMirrored;
+        int64_t requestTime;
+        bool isEnded = false;
+    };
+    // False when the frame belongs to a capture that was cancelled or already got all its frames
+    bool NextCapture(PendingCapture &capture);
+    void StartWorkers();
+    void StopWorkers();
+    void WorkerLoop();
+    void RunParallel(std::vector<std::function<void()>> &jobs);
+    int32_t WriteToClient(const std::vector<uint8_t> &jpeg, int32_t width, int32_t height, int64_t timestamp);
+
+    std::mutex mutex_;
+    sptr<IBufferProducer> clientProducer_;
+    sptr<Surface> surface_;
+    sptr<Surface> output_;
+    std::mutex captureLock_;
+    std::deque<PendingCapture> pendingCaptures_;
+    PendingCapture lastCapture_ = {0, 0, JPEG_DEFAULT_QUALITY, 0, false, 0};
+    std::vector<uint8_t> mirrorBuffer_;
+
+    std::mutex workerLock_;
+    std::condition_variable workerCond_;
+    std::deque<std::function<void()>> jobs_;
+    std::vector<std::thread> workers_;
+    bool isWorkerStopped_ = false;
+
+    std::mutex statsLock_;
+    uint32_t encodedPhotos_ = 0;
+    uint32_t failedPhotos_ = 0;
+    uint32_t droppedFrames_ = 0;
+    int64_t lastEncodeTime_ = 0;
+    int64_t maxEncodeTime_ = 0;
+    int64_t totalEncodeTime_ = 0;
+    int64_t lastCaptureLatency_ = 0;
+    uint32_t mirroredPhotos_ = 0;
+    int64_t lastMirrorTime_ = 0;
+};
+} // namespace CameraStandard
+} // namespace OHOS
+#endif // OHOS_CAMERA_JPEG_ENCODER_H
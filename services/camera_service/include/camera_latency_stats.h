@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_CAMERA_LATENCY_STATS_H
+#define OHOS_CAMERA_LATENCY_STATS_H
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace OHOS {
+namespace CameraStandard {
+enum LatencyStage : uint32_t {
+    LATENCY_OPEN_CAMERA = 0,
+    LATENCY_GET_STREAM_OPERATOR,
+    LATENCY_IS_STREAMS_SUPPORTED,
+    LATENCY_CREATE_STREAMS,
+    LATENCY_COMMIT_STREAMS,
+    LATENCY_CAPTURE,
+    LATENCY_CANCEL_CAPTURE,
+    LATENCY_UPDATE_SETTINGS,
+    // From a streaming capture request to the HDI capture started callback of that request
+    LATENCY_FIRST_FRAME,
+    // From the shutter callback of a photo to its capture ended callback
+    LATENCY_SHUTTER_TO_CAPTURE_ENDED,
+    LATENCY_STAGE_COUNT
+};
+
+/*
+ * Log-linear buckets in the manner of an HDR histogram: exact below 64 us, then 32 buckets per
+ * power of two, so a percentile is reported within about 3% of the recorded value. Values above
+ * MAX_TRACKABLE_US land in the last bucket, the maximum is kept exactly.
+ */
+class LatencyHistogram {
+public:
+    static constexpr uint64_t MAX_TRACKABLE_US = (1ULL << 27) - 1;
+
+    void Record(uint64_t valueUs);
+    uint64_t GetCount() const;
+    uint64_t GetMin() const;
+    uint64_t GetMax() const;
+    uint64_t GetMean() const;
+    // Highest value of the bucket holding the given percentile, 0 when nothing was recorded
+    uint64_t GetPercentile(double percentile) const;
+
+private:
+    static constexpr uint32_t SUB_BUCKET_BITS = 5;
+    static constexpr uint32_t SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+    // Values below it have a bucket each
+    static constexpr uint32_t LINEAR_BUCKET_COUNT = SUB_BUCKET_COUNT * 2;
+    static constexpr uint32_t LINEAR_BITS = SUB_BUCKET_BITS + 1;
+    static constexpr uint32_t TRACKABLE_BITS = 27;
+    static constexpr size_t BUCKET_COUNT = LINEAR_BUCKET_COUNT + (TRACKABLE_BITS - LINEAR_BITS) * SUB_BUCKET_COUNT;
+
+    static size_t GetBucketIndex(uint64_t valueUs);
+    static uint64_t GetBucketUpperBound(size_t index);
+
+    std::array<uint64_t, BUCKET_COUNT> counts_ {};
+    uint64_t count_ = 0;
+    uint64_t sum_ = 0;
+    uint64_t min_ = 0;
+    uint64_t max_ = 0;
+};
+
+/*
+ * Latency of the HDI calls and callbacks of each stage, per camera id. Recorded on every call,
+ * dumped with the "perf" argument of the service dump and cleared with "perfreset".
+ */
+class CameraLatencyStats {
+public:
+    static CameraLatencyStats &GetInstance();
+    // Steady clock, the start time to pass to Record
+    static int64_t GetTimestampUs();
+
+    // Records the time elapsed since startUs
+    void Record(const std::string &cameraId, LatencyStage stage, int64_t startUs);
+    void RecordDuration(const std::string &cameraId, LatencyStage stage, uint64_t durationUs);
+    // False when nothing was recorded for the camera
+    bool GetHistogram(const std::string &cameraId, LatencyStage stage, LatencyHistogram &histogram);
+    void Reset();
+    void Dump(std::string &dumpString);
+
+private:
+    CameraLatencyStats() = default;
+    ~CameraLatencyStats() = delete;
+
+    std::mutex statsLock_;
+    std::map<std::string, std::array<LatencyHistogram, LATENCY_STAGE_COUNT>> histograms_;
+};
+} // namespace CameraStandard
+} // namespace OHOS
+#endif // OHOS_CAMERA_LATENCY_STATS_H
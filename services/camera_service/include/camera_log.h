@@ -16,6 +16,8 @@
 #ifndef OHOS_CAMERA_LOG_H
 #define OHOS_CAMERA_LOG_H
 
+#include <atomic>
+#include <chrono>
 #include <stdio.h>
 
 #include "hilog/log.h"
@@ -70,6 +72,26 @@
         }                                              \
     } while (0)
 
+// One-way callbacks fail when the client falls behind; the streams and devices count every drop,
+// so the proxies only log the drops once per interval
+#define DROPPED_CALLBACK_LOG_INTERVAL_MS 1000
+
+// Logs at most once per intervalMs from one call site, for failures counted elsewhere
+#define MEDIA_ERR_LOG_LIMITED(intervalMs, fmt, ...)                                                     \
+    do {                                                                                                \
+        static std::atomic<int64_t> lastLogTimeMs {0};                                                  \
+        static std::atomic<uint32_t> suppressedLogs {0};                                                \
+        int64_t nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(                          \
+            std::chrono::steady_clock::now().time_since_epoch()).count();                               \
+        int64_t lastMs = lastLogTimeMs.load();                                                          \
+        if (nowMs - lastMs >= (intervalMs) && lastLogTimeMs.compare_exchange_strong(lastMs, nowMs)) {   \
+            MEDIA_ERR_LOG(fmt ", %{public}u similar logs suppressed", ##__VA_ARGS__,                    \
+                          suppressedLogs.exchange(0));                                                  \
+        } else {                                                                                        \
+            suppressedLogs++;                                                                           \
+        }                                                                                               \
+    } while (0)
+
 #define POINTER_MASK 0x00FFFFFF
 
 #define CAMERA_SYNC_TRACE HITRACE_METER_NAME(HITRACE_TAG_ZCAMERA, __PRETTY_FUNCTION__)
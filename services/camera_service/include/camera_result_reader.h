@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_CAMERA_RESULT_READER_H
+#define OHOS_CAMERA_RESULT_READER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <vector>
+
+namespace OHOS {
+namespace CameraStandard {
+// Last serialized value of each tag, the item without its index
+using ResultValues = std::map<uint32_t, std::vector<uint8_t>>;
+
+struct ResultItem {
+    uint32_t tag;
+    uint32_t dataType;
+    uint32_t count;
+    // Unaligned, points into the serialized result
+    const uint8_t *data;
+    size_t dataSize;
+    // Byte range of the whole item, header included, in the serialized result
+    size_t offset;
+    size_t size;
+};
+
+/*
+ * Walks a result in the layout of MetadataUtils::ConvertMetadataToVec in place, without
+ * decoding it into a CameraMetadata. The result must outlive the reader.
+ */
+class CameraResultReader {
+public:
+    explicit CameraResultReader(const std::vector<uint8_t> &result);
+
+    bool IsValid() const;
+    // Walks every item, false when one of them is malformed. IsValid only checks the header
+    bool ValidateItems();
+    uint32_t GetItemCount() const;
+    uint32_t GetItemCapacity() const;
+    uint32_t GetDataCapacity() const;
+    void Rewind();
+    // False at the end of the result or on a malformed item
+    bool Next(ResultItem &item);
+    bool Find(uint32_t tag, ResultItem &item);
+    bool FindByte(uint32_t tag, uint8_t &value);
+
+private:
+    const std::vector<uint8_t> &result_;
+    bool isValid_ = false;
+    uint32_t itemCount_ = 0;
+    uint32_t itemCapacity_ = 0;
+    uint32_t dataCapacity_ = 0;
+    uint32_t nextIndex_ = 0;
+    size_t nextOffset_ = 0;
+};
+
+/*
+ * Copies into filtered, in the same layout, the items of result whose tag is in tags.
+ * Returns the number of items copied, 0 when none matched or result is malformed.
+ */
+uint32_t FilterResult(const std::vector<uint8_t> &result, const std::set<int32_t> &tags,
+                      std::vector<uint8_t> &filtered);
+
+/*
+ * Like FilterResult, with every tag when tags is null, but also leaves out the items whose value
+ * matches lastValues. The values of the copied items go to changedValues, which stays empty when
+ * 0 is returned, for the caller to commit once the changed result is delivered.
+ */
+uint32_t DiffResult(const std::vector<uint8_t> &result, const std::set<int32_t> *tags,
+                    const ResultValues &lastValues, std::vector<uint8_t> &changed, ResultValues &changedValues);
+
+// Moves the values DiffResult reported as changed into lastValues
+void CommitResultValues(ResultValues &changedValues, ResultValues &lastValues);
+
+// Serializes the remembered values as one result
+void BuildResultSnapshot(const ResultValues &values, std::vector<uint8_t> &snapshot);
+} // namespace CameraStandard
+} // namespace OHOS
+#endif // OHOS_CAMERA_RESULT_READER_H
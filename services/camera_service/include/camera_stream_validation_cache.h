@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_CAMERA_STREAM_VALIDATION_CACHE_H
+#define OHOS_CAMERA_STREAM_VALIDATION_CACHE_H
+
+#include <cstdint>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "v1_0/types.h"
+
+namespace OHOS {
+namespace CameraStandard {
+/*
+ * Stream sets the HDI accepted for one camera. An entry is keyed by the complete configuration
+ * of every stream, ids and buffer queues aside, together with the generation of the ability the
+ * set was checked with. The least recently used set is evicted when the cache is full.
+ * Not thread safe, the owner serializes the calls.
+ */
+class StreamValidationCache {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 32;
+
+    explicit StreamValidationCache(size_t capacity = DEFAULT_CAPACITY);
+
+    // Counts a hit or a miss and marks a found set as the most recently used
+    bool Find(const std::vector<HDI::Camera::V1_0::StreamInfo> &streamInfos, uint64_t abilityGeneration);
+    void Add(const std::vector<HDI::Camera::V1_0::StreamInfo> &streamInfos, uint64_t abilityGeneration);
+    void Clear();
+    size_t GetSize() const;
+    uint32_t GetHits() const;
+    uint32_t GetMisses() const;
+
+private:
+    static std::string GetKey(const std::vector<HDI::Camera::V1_0::StreamInfo> &streamInfos,
+                              uint64_t abilityGeneration);
+
+    size_t capacity_;
+    // Most recently used first
+    std::list<std::string> entries_;
+    std::unordered_map<std::string, std::list<std::string>::iterator> index_;
+    uint32_t hits_ = 0;
+    uint32_t misses_ = 0;
+};
+} // namespace CameraStandard
+} // namespace OHOS
+#endif // OHOS_CAMERA_STREAM_VALIDATION_CACHE_H
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_CAMERA_TELEMETRY_H
+#define OHOS_CAMERA_TELEMETRY_H
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace OHOS {
+namespace CameraStandard {
+enum TelemetryEventType : uint32_t {
+    // State events, values[0] is the new state
+    TELEMETRY_FLASH_MODE = 0,
+    // values[1] and values[2] are the pid and uid reported with the torch state
+    TELEMETRY_FLASH_STATE,
+    TELEMETRY_FOCUS_MODE,
+    TELEMETRY_FOCUS_STATE,
+    // Fault events, repeats are written once with their count
+    TELEMETRY_DEVICE_ERROR,
+    TELEMETRY_FRAME_ERROR,
+    TELEMETRY_CAPTURE_ERROR,
+    TELEMETRY_EVENT_COUNT
+};
+
+// Fixed size so that posting never allocates
+struct TelemetryRecord {
+    uint32_t type;
+    int32_t values[3];
+};
+
+struct TelemetryStats {
+    uint64_t posted;
+    uint64_t dropped;
+    uint64_t written;
+    uint64_t coalesced;
+};
+
+/*
+ * Sysevents of the HDI callback paths. Post only writes a record into a bounded lock-free ring and
+ * wakes a low priority thread, which waits a coalescing interval, drains the ring and writes the
+ * sysevents. A state event repeating the last written state is left out and repeats of a fault in
+ * one drain are written once. A changed torch state is drained without waiting for the interval.
+ */
+class CameraTelemetry {
+public:
+    static CameraTelemetry &GetInstance();
+
+    // False when the ring is full, the record is then dropped
+    bool Post(uint32_t type, int32_t value0, int32_t value1 = 0, int32_t value2 = 0);
+    // Drains the ring on the calling thread, returns the number of records drained
+    uint32_t Flush();
+    // Stops the drain thread and writes the records already posted, later records wait for a Flush
+    void Stop();
+    TelemetryStats GetStats();
+    void Dump(std::string &dumpString);
+
+private:
+    static constexpr size_t RING_SIZE = 1024;
+
+    struct Cell {
+        std::atomic<size_t> sequence;
+        TelemetryRecord record;
+    };
+
+    CameraTelemetry();
+    ~CameraTelemetry();
+    void Wake(uint32_t type, int32_t value0);
+    bool Pop(TelemetryRecord &record);
+    void Write(const TelemetryRecord &record, uint32_t count);
+    void Run();
+
+    std::array<Cell, RING_SIZE> ring_;
+    std::atomic<size_t> enqueuePos_ {0};
+    std::atomic<uint64_t> posted_ {0};
+    std::atomic<uint64_t> dropped_ {0};
+    // Set by the first post after a drain, the drain thread sleeps on wakeCondition_ while it is clear
+    std::atomic<bool> isWakeRequested_ {false};
+    std::atomic<bool> isUrgent_ {false};
+    std::atomic<int32_t> lastTorchState_ {-1};
+    std::mutex wakeLock_;
+    std::condition_variable wakeCondition_;
+    bool isStopping_ = false;
+    std::thread drainThread_;
+    // Consumer side, guarded by flushLock_
+    std::mutex flushLock_;
+    size_t dequeuePos_ = 0;
+    uint64_t written_ = 0;
+    uint64_t coalesced_ = 0;
+    bool hasLastState_[TELEMETRY_EVENT_COUNT] = {};
+    int32_t lastState_[TELEMETRY_EVENT_COUNT] = {};
+};
+} // namespace CameraStandard
+} // namespace OHOS
+#endif // OHOS_CAMERA_TELEMETRY_H
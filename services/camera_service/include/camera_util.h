@@ -62,6 +62,18 @@ void ReleaseCaptureId(int32_t captureId);
 
 bool IsValidSize(std::shared_ptr<OHOS::Camera::CameraMetadata> cameraAbility,
     int32_t format, int32_t width, int32_t height);
+
+// Checks the ability's stream configurations on every product, unlike IsValidSize
+bool IsSupportedSize(std::shared_ptr<OHOS::Camera::CameraMetadata> cameraAbility,
+    int32_t format, int32_t width, int32_t height);
+
+int32_t GetPixelFormat(int32_t format);
+
+bool FindConvertibleFormat(std::shared_ptr<OHOS::Camera::CameraMetadata> cameraAbility,
+    int32_t format, int32_t width, int32_t height, int32_t &hdiFormat);
+
+bool FindScaledSize(std::shared_ptr<OHOS::Camera::CameraMetadata> cameraAbility,
+    int32_t format, int32_t width, int32_t height, int32_t &hdiFormat, int32_t &hdiWidth, int32_t &hdiHeight);
 } // namespace CameraStandard
 } // namespace OHOS
 #endif // OHOS_CAMERA_UTIL_H
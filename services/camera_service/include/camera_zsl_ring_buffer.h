@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_CAMERA_ZSL_RING_BUFFER_H
+#define OHOS_CAMERA_ZSL_RING_BUFFER_H
+
+#include "istream_capture.h"
+#include "surface.h"
+
+#include <deque>
+#include <mutex>
+#include <refbase.h>
+#include <string>
+
+namespace OHOS {
+namespace CameraStandard {
+/*
+ * Keeps the most recent full resolution frames of a ZSL stream pinned in its consumer
+ * surface, bounded both by frame count and by a memory budget in bytes (0 means no budget).
+ */
+class ZslRingBuffer : public RefBase {
+public:
+    ZslRingBuffer(int32_t depth, uint64_t memoryBudget);
+    ~ZslRingBuffer();
+
+    int32_t Init(int32_t width, int32_t height);
+    // Applies a new depth and budget to a live ring, evicting the oldest frames that no longer fit
+    int32_t Reconfigure(int32_t depth, uint64_t memoryBudget);
+    sptr<IBufferProducer> GetProducer();
+    void OnBufferAvailable();
+    // shutterTime is on the steady clock, frameTimestamp is the HDI timestamp of the delivered frame
+    int32_t CopyFrame(int32_t selection, int64_t shutterTime, sptr<Surface> &output, int64_t &frameTimestamp);
+    void Flush();
+    void Release();
+    void DumpRingInfo(std::string &dumpString);
+
+private:
+    struct ZslFrame {
+        sptr<SurfaceBuffer> buffer;
+        int64_t timestamp;
+        // Steady clock time the frame was acquired, the HDI timestamp is on a clock of its own
+        int64_t arrivalTime;
+        uint32_t size;
+        int64_t sharpness;
+    };
+    void PushFrameLocked(const ZslFrame &frame);
+    void EvictFramesLocked(size_t maxFrames, uint64_t incomingSize);
+    void ReleaseFrameLocked(const ZslFrame &frame);
+    int32_t SelectFrameLocked(int32_t selection, int64_t shutterTime);
+
+    std::mutex mutex_;
+    sptr<Surface> surface_;
+    std::deque<ZslFrame> frames_;
+    int32_t depth_;
+    uint64_t memoryBudget_;
+    uint64_t usedMemory_ = 0;
+    uint64_t peakMemory_ = 0;
+    uint32_t evictedFrames_ = 0;
+    uint32_t zslHits_ = 0;
+    uint32_t zslMisses_ = 0;
+};
+} // namespace CameraStandard
+} // namespace OHOS
+#endif // OHOS_CAMERA_ZSL_RING_BUFFER_H
@@ -18,17 +18,31 @@
 
 #include "v1_0/icamera_device_callback.h"
 #include "camera_metadata_info.h"
+#include "camera_result_reader.h"
+#include "camera_settings.h"
 #include "hcamera_device_stub.h"
 #include "hcamera_host_manager.h"
 #include "v1_0/icamera_device.h"
 #include "v1_0/icamera_host.h"
+#include "v1_0/istream_operator_callback.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <set>
 #include <iostream>
 
 namespace OHOS {
 namespace CameraStandard {
 using namespace OHOS::HDI::Camera::V1_0;
 class CameraDeviceCallback;
+class StreamOperatorCallbackRelay;
+
+enum class PrewarmState {
+    NONE = 0,
+    PREWARMING,
+    PREWARMED,
+    CLAIMED,
+};
 
 class HCameraDevice : public HCameraDeviceStub {
 public:
@@ -37,45 +51,103 @@ public:
 
     int32_t Open() override;
     int32_t Close() override;
+    int32_t Prewarm();
     int32_t Release() override;
     int32_t UpdateSetting(const std::shared_ptr<OHOS::Camera::CameraMetadata> &settings) override;
     int32_t GetEnabledResults(std::vector<int32_t> &results) override;
     int32_t EnableResult(std::vector<int32_t> &results) override;
     int32_t DisableResult(std::vector<int32_t> &results) override;
+    int32_t GetResultSnapshot(std::shared_ptr<OHOS::Camera::CameraMetadata> &snapshot) override;
     int32_t GetStreamOperator(sptr<IStreamOperatorCallback> callback,
             sptr<IStreamOperator> &streamOperator);
     sptr<IStreamOperator> GetStreamOperator();
     int32_t SetCallback(sptr<ICameraDeviceServiceCallback> &callback) override;
     int32_t OnError(const ErrorType type, const int32_t errorMsg);
-    int32_t OnResult(const uint64_t timestamp, const std::shared_ptr<OHOS::Camera::CameraMetadata> &result);
+    int32_t OnResult(const uint64_t timestamp, const std::vector<uint8_t> &result);
     std::shared_ptr<OHOS::Camera::CameraMetadata> GetSettings();
     std::string GetCameraId();
     bool IsReleaseCameraDevice();
     int32_t SetReleaseCameraDevice(bool isRelease);
+    void DumpResultInfo(std::string &dumpString);
 
 private:
     sptr<ICameraDevice> hdiCameraDevice_;
     sptr<HCameraHostManager> cameraHostManager_;
     std::string cameraID_;
+    int32_t ownerUid_;
     bool isReleaseCameraDevice_;
     sptr<ICameraDeviceServiceCallback> deviceSvcCallback_;
     sptr<CameraDeviceCallback> deviceHDICallback_;
-    std::shared_ptr<OHOS::Camera::CameraMetadata> updateSettings_;
+    // Merged settings of the open device, sent whole when it opens and as changes after
+    std::shared_ptr<CameraSettings> updateSettings_;
     sptr<IStreamOperator> streamOperator_;
     std::mutex deviceLock_;
+    std::atomic<uint32_t> droppedResults_ {0};
+    // Results are forwarded as the HDI serialized them, one copy into the parcel and no decoding
+    std::atomic<uint64_t> forwardedResults_ {0};
+    std::atomic<uint64_t> copiedResultBytes_ {0};
+    std::atomic<uint64_t> malformedResults_ {0};
+    std::atomic<uint64_t> filteredResults_ {0};
+    // Tags the client enabled, results are narrowed to them once it enabled any
+    std::mutex resultLock_;
+    bool hasResultSubscription_ = false;
+    std::set<int32_t> subscribedResults_;
+    std::vector<uint8_t> filteredResult_;
+    // Tags whose value did not change since the last result are left out
+    ResultValues lastResultValues_;
+    std::mutex prewarmLock_;
+    std::condition_variable prewarmCond_;
+    PrewarmState prewarmState_ = PrewarmState::NONE;
+    sptr<StreamOperatorCallbackRelay> streamOperatorRelay_;
 
+    int32_t OpenDevice();
+    int32_t CloseDevice(bool isKeepAliveAllowed);
+    int32_t ApplyPendingSettings();
+    int32_t ApplyResultSubscription();
+    void ForwardResult(const uint64_t timestamp, const std::vector<uint8_t> &result, uint32_t itemCount);
+    void PrewarmDevice();
+    int32_t PrewarmStreamOperator();
     void ReportFlashEvent(const std::shared_ptr<OHOS::Camera::CameraMetadata> &settings);
 };
 
+/*
+ * Stream operator callback of a prewarmed device, routes to the session callback once a
+ * session takes the device over.
+ */
+class StreamOperatorCallbackRelay : public IStreamOperatorCallback {
+public:
+    StreamOperatorCallbackRelay() = default;
+    virtual ~StreamOperatorCallbackRelay() = default;
+    void SetCallback(const sptr<IStreamOperatorCallback> &callback);
+    int32_t OnCaptureStarted(int32_t captureId, const std::vector<int32_t>& streamIds) override;
+    int32_t OnCaptureEnded(int32_t captureId, const std::vector<CaptureEndedInfo>& infos) override;
+    int32_t OnCaptureError(int32_t captureId, const std::vector<CaptureErrorInfo>& infos) override;
+    int32_t OnFrameShutter(int32_t captureId, const std::vector<int32_t>& streamIds, uint64_t timestamp) override;
+
+private:
+    sptr<IStreamOperatorCallback> GetCallback();
+
+    std::mutex mutex_;
+    sptr<IStreamOperatorCallback> callback_;
+};
+
 class CameraDeviceCallback : public ICameraDeviceCallback {
 public:
-    explicit CameraDeviceCallback(sptr<HCameraDevice> hCameraDevice);
+    CameraDeviceCallback(sptr<HCameraDevice> hCameraDevice, sptr<HCameraHostManager> cameraHostManager,
+                         std::string cameraId);
     virtual ~CameraDeviceCallback() = default;
     int32_t OnError(ErrorType type, int32_t errorCode) override;
     int32_t OnResult(uint64_t timestamp, const std::vector<uint8_t>& result) override;
+    void SetCameraDevice(sptr<HCameraDevice> hCameraDevice);
 
 private:
+    sptr<HCameraDevice> GetCameraDevice();
+
+    std::mutex mutex_;
+    // Null while the HDI device is kept alive without an owner
     sptr<HCameraDevice> hCameraDevice_;
+    sptr<HCameraHostManager> cameraHostManager_;
+    std::string cameraId_;
 };
 } // namespace CameraStandard
 } // namespace OHOS
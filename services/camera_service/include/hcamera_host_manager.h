@@ -17,10 +17,15 @@
 #define OHOS_CAMERA_H_CAMERA_HOST_MANAGER_H
 
 #include <refbase.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <iostream>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 #include "camera_metadata_info.h"
 #include "v1_0/icamera_device.h"
@@ -51,6 +56,24 @@ public:
                                      const sptr<ICameraDeviceCallback> &callback,
                                      sptr<ICameraDevice> &pDevice);
     virtual int32_t SetFlashlight(const std::string& cameraId, bool isEnable);
+    // Reuses the ability bytes the HDI sent when the ability is the cached one
+    void GetSerializedAbility(const std::string& cameraId, const std::shared_ptr<OHOS::Camera::CameraMetadata>& ability,
+                              std::vector<uint8_t>& setting);
+    bool IsStreamsValidated(const std::string& cameraId, const std::vector<StreamInfo>& streamInfos,
+                            uint64_t& abilityGeneration);
+    void AddValidatedStreams(const std::string& cameraId, const std::vector<StreamInfo>& streamInfos,
+                             uint64_t abilityGeneration);
+    void DumpValidationCache(const std::string& cameraId, std::string& dumpString);
+    void SetDeviceKeepAliveTime(int32_t keepAliveMs);
+    bool KeepAliveCameraDevice(const std::string& cameraId, int32_t ownerUid,
+                               const sptr<ICameraDevice>& device, const sptr<ICameraDeviceCallback>& callback);
+    bool AcquireKeptAliveDevice(const std::string& cameraId, int32_t ownerUid,
+                                sptr<ICameraDevice>& device, sptr<ICameraDeviceCallback>& callback);
+    void EvictKeptAliveDevice(const std::string& cameraId, bool isDeviceLost);
+    int32_t FlushKeptAliveDevices();
+    void DumpDevicePool(std::string& dumpString);
+    void SetDevicePrewarm(bool isEnabled);
+    bool IsDevicePrewarmEnabled();
 
     // HDI::ServiceManager::V1_0::IServStatListener
     void OnReceive(const HDI::ServiceManager::V1_0::ServiceStatus& status) override;
@@ -59,14 +82,37 @@ private:
     struct CameraDeviceInfo;
     class CameraHostInfo;
 
+    struct KeptAliveDevice {
+        sptr<ICameraDevice> device;
+        sptr<ICameraDeviceCallback> callback;
+        int32_t ownerUid;
+        std::chrono::steady_clock::time_point expiry;
+    };
+
     void AddCameraHost(const std::string& svcName);
     void RemoveCameraHost(const std::string& svcName);
     sptr<CameraHostInfo> FindCameraHostInfo(const std::string& cameraId);
     bool IsCameraHostInfoAdded(const std::string& svcName);
+    void DevicePoolReaper();
+    void StopDevicePool();
 
     std::mutex mutex_;
     StatusCallback* statusCallback_;
     std::vector<sptr<CameraHostInfo>> cameraHostInfos_;
+
+    // Recently closed devices kept open so a matching open skips the HDI open
+    std::mutex poolMutex_;
+    std::condition_variable poolCond_;
+    std::thread poolReaper_;
+    bool isPoolStopping_ = false;
+    int32_t keepAliveMs_;
+    std::map<std::string, KeptAliveDevice> devicePool_;
+    uint32_t poolHits_ = 0;
+    uint32_t poolMisses_ = 0;
+    uint32_t poolExpired_ = 0;
+    uint32_t poolEvicted_ = 0;
+    uint32_t poolLost_ = 0;
+    std::atomic<bool> isDevicePrewarmEnabled_;
 };
 } // namespace CameraStandard
 } // namespace OHOS
@@ -49,10 +49,14 @@ public:
                                 sptr<IStreamRepeat> &previewOutput) override;
     int32_t CreateCustomPreviewOutput(const sptr<OHOS::IBufferProducer> &producer, int32_t format, int32_t width,
                                       int32_t height, sptr<IStreamRepeat> &previewOutput) override;
+    int32_t CreateDeferredPreviewOutput(int32_t format, int32_t width, int32_t height,
+                                        sptr<IStreamRepeat> &previewOutput) override;
     int32_t CreateMetadataOutput(const sptr<OHOS::IBufferProducer> &producer, int32_t format,
                                  sptr<IStreamMetadata> &metadataOutput) override;
     int32_t CreateVideoOutput(const sptr<OHOS::IBufferProducer> &producer, int32_t format,
                               sptr<IStreamRepeat> &videoOutput) override;
+    int32_t CreateDeferredVideoOutput(int32_t format, int32_t width, int32_t height,
+                                      sptr<IStreamRepeat> &videoOutput) override;
     int32_t SetCallback(sptr<ICameraServiceCallback> &callback) override;
     void OnDump() override;
     void OnStart() override;
@@ -90,7 +94,6 @@ private:
 
     std::mutex mutex_;
     sptr<HCameraHostManager> cameraHostManager_;
-    sptr<StreamOperatorCallback> streamOperatorCallback_;
     sptr<ICameraServiceCallback> cameraServiceCallback_;
     std::map<std::string, sptr<HCameraDevice>> devices_;
 };
@@ -25,7 +25,11 @@
 #include "v1_0/istream_operator.h"
 
 #include <refbase.h>
+#include <atomic>
 #include <iostream>
+#include <memory>
+#include <thread>
+#include <unordered_map>
 
 namespace OHOS {
 namespace CameraStandard {
@@ -36,9 +40,12 @@ enum class CaptureSessionState {
     SESSION_INIT = 0,
     SESSION_CONFIG_INPROGRESS,
     SESSION_CONFIG_COMMITTED,
+    SESSION_CONFIG_COMMITTING,
 };
 
 static const int32_t STREAMID_BEGIN = 1;
+static const int32_t CAMERA_CLIENT_PRIORITY_APP = 0;
+static const int32_t CAMERA_CLIENT_PRIORITY_SYSTEM = 1;
 
 class HCaptureSession : public HCaptureSessionStub {
 public:
@@ -47,6 +54,7 @@ public:
 
     int32_t BeginConfig() override;
     int32_t CommitConfig() override;
+    int32_t CommitConfigAsync(int32_t &transactionId) override;
 
     int32_t AddInput(sptr<ICameraDeviceService> cameraDevice) override;
     int32_t AddOutput(StreamType streamType, sptr<IStreamCommon> stream) override;
@@ -55,12 +63,15 @@ public:
     int32_t RemoveOutput(StreamType streamType, sptr<IStreamCommon> stream) override;
 
     int32_t Start() override;
+    int32_t StartGrouped() override;
     int32_t Stop() override;
     int32_t Release(pid_t pid) override;
     static void DestroyStubObjectForPid(pid_t pid);
     int32_t SetCallback(sptr<ICaptureSessionCallback> &callback) override;
+    int32_t ConfigureSession(sptr<ICameraDeviceService> cameraDevice, std::vector<SessionOutput> &outputs,
+                             const std::shared_ptr<OHOS::Camera::CameraMetadata> &settings) override;
+    int32_t SetZslConfig(int32_t ringDepth, int32_t selection, uint64_t memoryBudget) override;
 
-    friend class StreamOperatorCallback;
     static void dumpSessions(std::string& dumpString);
     void dumpSessionInfo(std::string& dumpString);
     static void CameraSessionSummary(std::string& dumpString);
@@ -68,11 +79,18 @@ public:
 private:
     int32_t ValidateSessionInputs();
     int32_t ValidateSessionOutputs();
+    int32_t ValidateCommitConfig();
+    int32_t ApplyConfig();
+    void ApplyConfigAsync(int32_t transactionId);
+    void JoinCommitWorker();
     int32_t AddOutputStream(sptr<HStreamCommon> stream);
     int32_t RemoveOutputStream(sptr<HStreamCommon> stream);
     int32_t GetCameraDevice(sptr<HCameraDevice> &device);
     int32_t GetCurrentCameraDevice(sptr<HCameraDevice> &device);
-    int32_t HandleCaptureOuputsConfig(sptr<HCameraDevice> &device);
+    int32_t ArbitrateCameraDevice(const std::string &cameraId);
+    int32_t HandleCaptureOuputsConfig(sptr<HCameraDevice> &device, bool isFullCommit);
+    int32_t ApplyDeltaConfig(sptr<HCameraDevice> &device, bool &isStreamsReleased);
+    int32_t ApplyFullConfig(sptr<HCameraDevice> &device, std::vector<sptr<HStreamRepeat>> &liveStreams);
     int32_t CreateAndCommitStreams(sptr<HCameraDevice> &device,
 	                               std::shared_ptr<OHOS::Camera::CameraMetadata> &deviceSettings,
                                    std::vector<StreamInfo> &streamInfos);
@@ -86,14 +104,27 @@ private:
     void UpdateSessionConfig(sptr<HCameraDevice> &device);
     void DeleteReleasedStream();
     void RestorePreviousState(sptr<HCameraDevice> &device, bool isCreateReleaseStreams);
+    int32_t StageSessionConfig(sptr<ICameraDeviceService> &cameraDevice, std::vector<SessionOutput> &outputs);
+    void AbortConfig(const std::vector<sptr<HStreamCommon>> &activeStreams, bool isDeviceReleased);
+    void PrepareZslStreams();
+    void PrepareSharedStreams();
+    void UpdateSensorRateSharing();
     void ReleaseStreams();
+    int32_t StartCaptureGroup(const std::vector<sptr<HStreamCommon>> &groupStreams);
+    int32_t StopCaptureGroup();
+    int32_t RemoveFromCaptureGroup(const sptr<HStreamCommon> &stream);
     void ClearCaptureSession(pid_t pid);
     std::string GetSessionState();
+    void SetHeldCameraDevice(const sptr<HCameraDevice> &device);
+    sptr<HCameraDevice> GetHeldCameraDevice();
 
     std::mutex mutex_;
-    CaptureSessionState curState_ = CaptureSessionState::SESSION_INIT;
+    // Also written by the commit worker while binder threads check it
+    std::atomic<CaptureSessionState> curState_ {CaptureSessionState::SESSION_INIT};
     CaptureSessionState prevState_ = CaptureSessionState::SESSION_INIT;
+    // Written under deviceLock_, which other sessions take to read it while arbitrating
     sptr<HCameraDevice> cameraDevice_;
+    std::mutex deviceLock_;
     std::vector<sptr<HStreamCommon>> repeatStreams_;
     std::vector<sptr<HStreamCommon>> captureStreams_;
     std::vector<sptr<HStreamCommon>> metadataStreams_;
@@ -109,23 +140,38 @@ private:
     std::map<CaptureSessionState, std::string> sessionState_;
     pid_t pid_;
     int32_t uid_;
+    int32_t priority_;
+    int32_t zslRingDepth_ = 0;
+    int32_t zslSelection_ = ZSL_SELECTION_CLOSEST;
+    uint64_t zslMemoryBudget_ = 0;
+    std::mutex commitLock_;
+    // Runs the pending asynchronous commit, joined by the next commit and by Release
+    std::thread commitWorker_;
+    int32_t commitTransactionId_ = 0;
+    bool isCommitPending_ = false;
+    bool isReleasePending_ = false;
+    pid_t releasePid_ = 0;
+    int32_t groupCaptureId_ = 0;
+    std::vector<sptr<HStreamCommon>> groupStreams_;
 };
 
+using StreamRoutingTable = std::unordered_map<int32_t, sptr<HStreamCommon>>;
+
 class StreamOperatorCallback : public IStreamOperatorCallback {
 public:
     StreamOperatorCallback() = default;
-    explicit StreamOperatorCallback(sptr<HCaptureSession> session);
     virtual ~StreamOperatorCallback() = default;
 
     int32_t OnCaptureStarted(int32_t captureId, const std::vector<int32_t>& streamIds) override;
     int32_t OnCaptureEnded(int32_t captureId, const std::vector<CaptureEndedInfo>& infos) override;
     int32_t OnCaptureError(int32_t captureId, const std::vector<CaptureErrorInfo>& infos) override;
     int32_t OnFrameShutter(int32_t captureId, const std::vector<int32_t>& streamIds, uint64_t timestamp) override;
-    void SetCaptureSession(sptr<HCaptureSession> captureSession);
+    void PublishStreams(const std::vector<sptr<HStreamCommon>> &streams);
 
 private:
     sptr<HStreamCommon> GetStreamByStreamID(int32_t streamId);
-    sptr<HCaptureSession> captureSession_;
+    // Immutable snapshot, replaced as a whole on reconfiguration and read without taking a lock
+    std::shared_ptr<const StreamRoutingTable> routingTable_;
 };
 } // namespace CameraStandard
 } // namespace OHOS
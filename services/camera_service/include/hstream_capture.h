@@ -16,18 +16,28 @@
 #ifndef OHOS_CAMERA_H_STREAM_CAPTURE_H
 #define OHOS_CAMERA_H_STREAM_CAPTURE_H
 
+#include <condition_variable>
+#include <deque>
 #include <iostream>
+#include <map>
+#include <mutex>
 #include <refbase.h>
+#include <thread>
 
+#include "camera_jpeg_encoder.h"
 #include "camera_metadata_info.h"
+#include "camera_zsl_ring_buffer.h"
 #include "display_type.h"
 #include "hstream_capture_stub.h"
 #include "hstream_common.h"
+#include "hstream_repeat.h"
 #include "v1_0/istream_operator.h"
 
 namespace OHOS {
 namespace CameraStandard {
 using namespace OHOS::HDI::Camera::V1_0;
+static const int32_t MAX_BURST_FRAME_COUNT = 100;
+
 class HStreamCapture : public HStreamCaptureStub, public HStreamCommon {
 public:
     HStreamCapture(sptr<OHOS::IBufferProducer> surface, int32_t format);
@@ -37,6 +47,10 @@ public:
         std::shared_ptr<OHOS::Camera::CameraMetadata> cameraAbility, int32_t streamId) override;
     void SetStreamInfo(StreamInfo &streamInfo) override;
     int32_t Capture(const std::shared_ptr<OHOS::Camera::CameraMetadata> &captureSettings) override;
+    int32_t BurstCapture(const std::shared_ptr<OHOS::Camera::CameraMetadata> &captureSettings,
+                         int32_t frameCount) override;
+    int32_t ZslCapture(const std::shared_ptr<OHOS::Camera::CameraMetadata> &captureSettings,
+                       int32_t selection) override;
     int32_t CancelCapture() override;
     int32_t Release() override;
     int32_t SetCallback(sptr<IStreamCaptureCallback> &callback) override;
@@ -45,9 +59,44 @@ public:
     int32_t OnCaptureError(int32_t captureId, int32_t errorType);
     int32_t OnFrameShutter(int32_t captureId, uint64_t timestamp);
     void DumpStreamInfo(std::string& dumpString) override;
+    int32_t EnableZsl(int32_t ringDepth, int32_t selection, uint64_t memoryBudget);
+    void DisableZsl();
+    void FlushZsl();
+    sptr<HStreamRepeat> GetZslStream();
 
 private:
+    int32_t CaptureFromZsl(int32_t captureId, int32_t selection);
+    int32_t PrepareJpegEncoder();
+    bool IsHdiMirrorSupported();
+    void QueueJpegCapture(const std::shared_ptr<OHOS::Camera::CameraMetadata> &captureSettings,
+                          int32_t captureId, int32_t frameCount);
+    void SetCaptureSetting(const std::shared_ptr<OHOS::Camera::CameraMetadata> &captureSettings,
+                           std::vector<uint8_t> &setting);
+    int32_t StopBurst();
+    int32_t CancelHdiCapture(int32_t captureId);
+    void PostCancelCapture(int32_t captureId);
+    void CancelWorker();
+    void StopCancelWorker();
+
     sptr<IStreamCaptureCallback> streamCaptureCallback_;
+    std::mutex burstLock_;
+    bool isBurstActive_ = false;
+    int32_t burstCaptureId_ = 0;
+    int32_t burstFrameCount_ = 0;
+    int32_t burstShutterCount_ = 0;
+    // A burst that reached its frame count is cancelled here rather than on the HDI callback thread
+    std::mutex cancelLock_;
+    std::condition_variable cancelCond_;
+    std::deque<int32_t> pendingCancels_;
+    std::thread cancelWorker_;
+    bool isCancelWorkerStopped_ = false;
+    // Steady clock time in us of the first shutter callback of each capture not ended yet
+    std::map<int32_t, int64_t> shutterTimes_;
+    sptr<ZslRingBuffer> zslRingBuffer_;
+    sptr<HStreamRepeat> zslStream_;
+    sptr<Surface> zslOutput_;
+    int32_t zslSelection_ = ZSL_SELECTION_NONE;
+    sptr<JpegEncoder> jpegEncoder_;
 };
 } // namespace CameraStandard
 } // namespace OHOS
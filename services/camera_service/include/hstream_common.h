@@ -17,15 +17,24 @@
 #define OHOS_CAMERA_H_STREAM_COMMON_H
 
 #include "camera_metadata_info.h"
+#include "camera_settings.h"
 #include "istream_common.h"
 #include "v1_0/istream_operator.h"
 
 #include <refbase.h>
+#include <atomic>
+#include <functional>
 #include <iostream>
+#include <mutex>
+#include <string>
 
 namespace OHOS {
 namespace CameraStandard {
 using namespace OHOS::HDI::Camera::V1_0;
+class HStreamCommon;
+// Takes a stream out of its session's grouped request and reissues the request for the others
+using CaptureGroupLeaver = std::function<int32_t(const sptr<HStreamCommon> &stream)>;
+
 class HStreamCommon : virtual public RefBase {
 public:
     HStreamCommon(StreamType streamType, sptr<OHOS::IBufferProducer> producer, int32_t format);
@@ -39,19 +48,44 @@ public:
     virtual int32_t SetReleaseStream(bool isReleaseStream) final;
     virtual int32_t GetStreamId() final;
     virtual StreamType GetStreamType() final;
+    virtual void JoinCaptureGroup(int32_t captureId, CaptureGroupLeaver leaver);
+    virtual void LeaveCaptureGroup();
+    bool IsGroupCapture();
+    // Asks the session to stop the stream alone while the rest of its group keeps running
+    int32_t ExitCaptureGroup();
+    int32_t AttachBufferQueue();
+    int32_t DetachBufferQueue();
+    void CheckCallbackDelivery(int32_t result);
+    SettingsBlob GetAbilitySettings();
+    // Camera the stream is linked to, set by the session along with LinkInput and read by HDI callbacks
+    void SetCameraId(const std::string &cameraId);
+    std::string GetCameraId();
 
     int32_t curCaptureID_;
     int32_t streamId_;
     int32_t format_;
+    // Format the HDI stream runs in, differs from format_ when the service converts the frames
+    int32_t hdiFormat_;
     int32_t width_;
     int32_t height_;
+    // Size the HDI stream runs in, larger than width_ x height_ when the service scales the frames
+    int32_t hdiWidth_;
+    int32_t hdiHeight_;
     sptr<OHOS::IBufferProducer> producer_;
     sptr<IStreamOperator> streamOperator_;
     std::shared_ptr<OHOS::Camera::CameraMetadata> cameraAbility_;
+    std::atomic<uint32_t> droppedCallbacks_ {0};
 
 private:
+    std::mutex cameraIdLock_;
+    std::string cameraId_;
+    std::shared_ptr<CameraSettings> abilitySettings_;
     StreamType streamType_;
     bool isReleaseStream_;
+    // Started through the session's grouped request, whose capture id the stream does not own
+    bool isGroupCapture_;
+    std::mutex groupLock_;
+    CaptureGroupLeaver groupLeaver_;
 };
 } // namespace CameraStandard
 } // namespace OHOS
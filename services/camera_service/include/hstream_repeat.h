@@ -16,23 +16,31 @@
 #ifndef OHOS_CAMERA_H_STREAM_REPEAT_H
 #define OHOS_CAMERA_H_STREAM_REPEAT_H
 
+#include "camera_frame_relay.h"
 #include "camera_metadata_info.h"
+#include "camera_stream_fan_out.h"
 #include "display_type.h"
 #include "hstream_repeat_stub.h"
 #include "hstream_common.h"
 #include "v1_0/istream_operator.h"
 
 #include <refbase.h>
+#include <atomic>
 #include <iostream>
+#include <mutex>
+#include <vector>
 
 namespace OHOS {
 namespace CameraStandard {
 using namespace OHOS::HDI::Camera::V1_0;
+static const float MAX_STREAM_FPS = 240.0f;
+
 class HStreamRepeat : public HStreamRepeatStub, public HStreamCommon {
 public:
     HStreamRepeat(sptr<OHOS::IBufferProducer> producer, int32_t format);
     HStreamRepeat(sptr<OHOS::IBufferProducer> producer, int32_t format, int32_t width, int32_t height);
     HStreamRepeat(sptr<OHOS::IBufferProducer> producer, int32_t format, bool isVideo);
+    HStreamRepeat(sptr<OHOS::IBufferProducer> producer, int32_t format, int32_t width, int32_t height, bool isVideo);
     ~HStreamRepeat();
 
     int32_t LinkInput(sptr<IStreamOperator> streamOperator,
@@ -42,17 +50,78 @@ public:
     int32_t Start() override;
     int32_t Stop() override;
     int32_t SetFps(float Fps) override;
+    int32_t GetAchievedFps(float &fps) override;
     int32_t SetCallback(sptr<IStreamRepeatCallback> &callback) override;
+    int32_t AddDeferredSurface(const sptr<OHOS::IBufferProducer> &producer) override;
     int32_t OnFrameStarted();
     int32_t OnFrameEnded(int32_t frameCount);
     int32_t OnFrameError(int32_t errorType);
+    int32_t OnFrameShutter(int32_t captureId, uint64_t timestamp);
+    void JoinCaptureGroup(int32_t captureId, CaptureGroupLeaver leaver) override;
+    void LeaveCaptureGroup() override;
+    bool IsFrameGapMonitored();
+    // Steady clock time in us of the request whose capture started callback ends the first frame latency
+    void SetFirstFrameStartTime(int64_t startTime);
+    void BeginReconfigure();
+    void EndReconfigure();
     bool IsVideo();
+    void SetSensorRateShared(bool isShared);
+    void SetFanOut(sptr<StreamFanOut> fanOut);
+    bool IsSharedSource();
+    void SetSharedSource(sptr<HStreamRepeat> source);
+    sptr<HStreamRepeat> GetSharedSource();
+    int32_t AddSharedOutput(const sptr<HStreamRepeat> &output, const sptr<OHOS::IBufferProducer> &producer);
+    void RemoveSharedOutput(const sptr<HStreamRepeat> &output);
+    int32_t StartSharedOutput(const sptr<HStreamRepeat> &output, bool isGroupCapture);
+    int32_t StopSharedOutput(const sptr<HStreamRepeat> &output);
     void DumpStreamInfo(std::string& dumpString) override;
 
 private:
+    // Clockwise rotation the client surface needs for the sensor orientation, 0 on a landscape display
+    int32_t GetStreamRotation();
     void SetStreamTransform();
+    bool IsHdiFrameRateSupported(float fps);
+    void GetStreamingSettings(std::vector<uint8_t> &settings);
+    void DumpFrameGapInfo(std::string& dumpString);
+    void OnSharedOutputStarted(int32_t captureId, bool isStreaming);
+    void OnSharedOutputStopped(uint64_t frameCount);
+    std::vector<sptr<HStreamRepeat>> GetActiveSharedOutputs();
     bool isVideo_;
+    std::mutex fpsLock_;
+    // 0 streams at the sensor rate
+    float targetFps_ = 0;
+    bool isSensorRateShared_ = false;
+    bool isHdiFrameRate_ = false;
+    sptr<FrameRelay> frameRelay_;
+    // Clockwise degrees the frame relay rotates by when the client surface rejects the transform
+    int32_t softwareRotation_ = 0;
+    int64_t streamingStartTime_ = 0;
+    float lastAchievedFps_ = 0;
+    std::atomic<int64_t> firstFrameStartTime_ {0};
     sptr<IStreamRepeatCallback> streamRepeatCallback_;
+    std::mutex frameGapLock_;
+    bool isFrameGapMonitored_;
+    uint64_t lastShutterTime_ = 0;
+    uint64_t frameInterval_ = 0;
+    uint64_t maxFrameGap_ = 0;
+    uint64_t monitoredFrames_ = 0;
+    uint64_t missedFrames_ = 0;
+    // A reconfiguration window spans the commit and the first frame delivered after it
+    bool isReconfiguring_ = false;
+    bool isReconfigureEnding_ = false;
+    uint64_t reconfigureGap_ = 0;
+    uint64_t reconfigureMissedFrames_ = 0;
+    // A shared source runs the HDI stream of outputs with the same format and size and fans its
+    // frames out to them, the outputs have no HDI stream of their own
+    struct SharedOutput {
+        wptr<HStreamRepeat> stream;
+        sptr<OHOS::IBufferProducer> producer;
+        bool isActive;
+    };
+    std::mutex sharedLock_;
+    sptr<StreamFanOut> fanOut_;
+    std::vector<SharedOutput> sharedOutputs_;
+    sptr<HStreamRepeat> sharedSource_;
 };
 } // namespace CameraStandard
 } // namespace OHOS
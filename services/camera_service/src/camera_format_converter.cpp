@@ -0,0 +1,746 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "camera_format_converter.h"
+
+#include <algorithm>
+#include <vector>
+#include <securec.h>
+#include "camera_util.h"
+#include "camera_log.h"
+#include "display_type.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define CAMERA_CONVERT_NEON
+#endif
+
+namespace OHOS {
+namespace CameraStandard {
+namespace {
+    constexpr int32_t RGBA_BYTES_PER_PIXEL = 4;
+    constexpr int32_t UV_BYTES_PER_PAIR = 2;
+    /*
+     * BT.601 limited range. YUV to RGB uses 6 fractional bits so every product fits in int16,
+     * RGB to YUV uses 8 fractional bits on unsigned (Y) or signed (UV) 16 bit sums.
+     */
+    constexpr int32_t YUV_Y_OFFSET = 16;
+    constexpr int32_t YUV_UV_OFFSET = 128;
+    constexpr int32_t YUV_TO_RGB_SHIFT = 6;
+    constexpr int32_t YUV_TO_RGB_ROUND = 32;
+    // 1.164 * 64 is 74.5, applied as 74 plus half of the luma
+    constexpr int32_t YUV_TO_RGB_Y = 74;
+    constexpr int32_t YUV_TO_RGB_RV = 102;
+    constexpr int32_t YUV_TO_RGB_GU = 25;
+    constexpr int32_t YUV_TO_RGB_GV = 52;
+    constexpr int32_t YUV_TO_RGB_BU = 129;
+    constexpr int32_t RGB_TO_YUV_SHIFT = 8;
+    constexpr int32_t RGB_TO_YUV_ROUND = 128;
+    constexpr int32_t RGB_TO_Y_R = 66;
+    constexpr int32_t RGB_TO_Y_G = 129;
+    constexpr int32_t RGB_TO_Y_B = 25;
+    constexpr int32_t RGB_TO_U_R = -38;
+    constexpr int32_t RGB_TO_U_G = -74;
+    constexpr int32_t RGB_TO_U_B = 112;
+    constexpr int32_t RGB_TO_V_R = 112;
+    constexpr int32_t RGB_TO_V_G = -94;
+    constexpr int32_t RGB_TO_V_B = -18;
+    constexpr int32_t CHROMA_AVERAGE_SHIFT = 2;
+    constexpr int32_t CHROMA_AVERAGE_ROUND = 2;
+    constexpr int32_t MAX_CHANNEL_VALUE = 255;
+    constexpr uint8_t OPAQUE_ALPHA = 0xFF;
+}
+
+struct YuvPlanes {
+    uint8_t *y;
+    uint8_t *u;
+    uint8_t *v;
+    int32_t yStride;
+    int32_t uvStride;
+    // 2 for the interleaved chroma of the semi-planar layouts, 1 for planar
+    int32_t uvStep;
+};
+
+static inline uint8_t ClampChannel(int32_t value)
+{
+    return static_cast<uint8_t>(std::clamp(value, 0, MAX_CHANNEL_VALUE));
+}
+
+static inline int32_t ChromaWidth(int32_t width)
+{
+    return (width + 1) / 2;
+}
+
+static inline int32_t ChromaHeight(int32_t height)
+{
+    return (height + 1) / 2;
+}
+
+static bool IsYuvFormat(int32_t pixelFormat)
+{
+    return pixelFormat == PIXEL_FMT_YCRCB_420_SP || pixelFormat == PIXEL_FMT_YCBCR_420_SP
+        || pixelFormat == PIXEL_FMT_YCBCR_420_P;
+}
+
+static YuvPlanes GetYuvPlanes(const ImageBuffer &image)
+{
+    YuvPlanes planes;
+    uint8_t *chroma = image.data + static_cast<size_t>(image.stride) * image.height;
+    planes.y = image.data;
+    planes.yStride = image.stride;
+    if (image.format == PIXEL_FMT_YCBCR_420_P) {
+        planes.uvStride = image.stride / 2;
+        planes.uvStep = 1;
+        planes.u = chroma;
+        planes.v = chroma + static_cast<size_t>(planes.uvStride) * ChromaHeight(image.height);
+    } else {
+        planes.uvStride = image.stride;
+        planes.uvStep = UV_BYTES_PER_PAIR;
+        planes.u = (image.format == PIXEL_FMT_YCBCR_420_SP) ? chroma : chroma + 1;
+        planes.v = (image.format == PIXEL_FMT_YCBCR_420_SP) ? chroma + 1 : chroma;
+    }
+    return planes;
+}
+
+static void SwapUVRowScalar(const uint8_t *src, uint8_t *dst, int32_t pairs)
+{
+    for (int32_t i = 0; i < pairs; i++) {
+        uint8_t first = src[i * UV_BYTES_PER_PAIR];
+        dst[i * UV_BYTES_PER_PAIR] = src[i * UV_BYTES_PER_PAIR + 1];
+        dst[i * UV_BYTES_PER_PAIR + 1] = first;
+    }
+}
+
+static void SplitUVRowScalar(const uint8_t *src, uint8_t *first, uint8_t *second, int32_t pairs)
+{
+    for (int32_t i = 0; i < pairs; i++) {
+        first[i] = src[i * UV_BYTES_PER_PAIR];
+        second[i] = src[i * UV_BYTES_PER_PAIR + 1];
+    }
+}
+
+static void MergeUVRowScalar(const uint8_t *first, const uint8_t *second, uint8_t *dst, int32_t pairs)
+{
+    for (int32_t i = 0; i < pairs; i++) {
+        dst[i * UV_BYTES_PER_PAIR] = first[i];
+        dst[i * UV_BYTES_PER_PAIR + 1] = second[i];
+    }
+}
+
+static void YuvToRgbaRowScalar(const uint8_t *y, const uint8_t *u, const uint8_t *v, uint8_t *rgba,
+                               int32_t width)
+{
+    for (int32_t x = 0; x < width; x++) {
+        int32_t luma = y[x] - YUV_Y_OFFSET;
+        int32_t c = YUV_TO_RGB_Y * luma + (luma >> 1) + YUV_TO_RGB_ROUND;
+        int32_t d = u[x / 2] - YUV_UV_OFFSET;
+        int32_t e = v[x / 2] - YUV_UV_OFFSET;
+        uint8_t *pixel = rgba + x * RGBA_BYTES_PER_PIXEL;
+        pixel[0] = ClampChannel((c + YUV_TO_RGB_RV * e) >> YUV_TO_RGB_SHIFT);
+        pixel[1] = ClampChannel((c - YUV_TO_RGB_GU * d - YUV_TO_RGB_GV * e) >> YUV_TO_RGB_SHIFT);
+        pixel[2] = ClampChannel((c + YUV_TO_RGB_BU * d) >> YUV_TO_RGB_SHIFT);
+        pixel[3] = OPAQUE_ALPHA;
+    }
+}
+
+static void RgbaToYRowScalar(const uint8_t *rgba, uint8_t *y, int32_t width)
+{
+    for (int32_t x = 0; x < width; x++) {
+        const uint8_t *pixel = rgba + x * RGBA_BYTES_PER_PIXEL;
+        y[x] = static_cast<uint8_t>(((RGB_TO_Y_R * pixel[0] + RGB_TO_Y_G * pixel[1] + RGB_TO_Y_B * pixel[2]
+            + RGB_TO_YUV_ROUND) >> RGB_TO_YUV_SHIFT) + YUV_Y_OFFSET);
+    }
+}
+
+static void RgbaToUVRowScalar(const uint8_t *rgba0, const uint8_t *rgba1, uint8_t *u, uint8_t *v, int32_t width)
+{
+    // Each chroma sample is computed from the average of the 2x2 pixels it covers
+    for (int32_t i = 0; i < ChromaWidth(width); i++) {
+        int32_t x0 = i * 2 * RGBA_BYTES_PER_PIXEL;
+        int32_t x1 = std::min(i * 2 + 1, width - 1) * RGBA_BYTES_PER_PIXEL;
+        int32_t average[3];
+        for (int32_t channel = 0; channel < 3; channel++) {
+            average[channel] = (rgba0[x0 + channel] + rgba0[x1 + channel] + rgba1[x0 + channel]
+                + rgba1[x1 + channel] + CHROMA_AVERAGE_ROUND) >> CHROMA_AVERAGE_SHIFT;
+        }
+        u[i] = static_cast<uint8_t>(((RGB_TO_U_R * average[0] + RGB_TO_U_G * average[1] + RGB_TO_U_B * average[2]
+            + RGB_TO_YUV_ROUND) >> RGB_TO_YUV_SHIFT) + YUV_UV_OFFSET);
+        v[i] = static_cast<uint8_t>(((RGB_TO_V_R * average[0] + RGB_TO_V_G * average[1] + RGB_TO_V_B * average[2]
+            + RGB_TO_YUV_ROUND) >> RGB_TO_YUV_SHIFT) + YUV_UV_OFFSET);
+    }
+}
+
+#if defined(__SSE2__)
+static inline __m128i YuvToChannelSse2(__m128i c, __m128i d, __m128i e, int16_t du, int16_t ev)
+{
+    // Saturation only happens on sums far above 255 and the pack clamps those to 255 like the scalar code
+    __m128i sum = _mm_adds_epi16(c, _mm_mullo_epi16(d, _mm_set1_epi16(du)));
+    sum = _mm_adds_epi16(sum, _mm_mullo_epi16(e, _mm_set1_epi16(ev)));
+    return _mm_srai_epi16(sum, YUV_TO_RGB_SHIFT);
+}
+
+static void YuvToRgbaRowSse2(const uint8_t *y, const uint8_t *u, const uint8_t *v, uint8_t *rgba, int32_t width)
+{
+    constexpr int32_t step = 16;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i yOffset = _mm_set1_epi16(YUV_Y_OFFSET);
+    const __m128i uvOffset = _mm_set1_epi16(YUV_UV_OFFSET);
+    const __m128i yScale = _mm_set1_epi16(YUV_TO_RGB_Y);
+    const __m128i round = _mm_set1_epi16(YUV_TO_RGB_ROUND);
+    const __m128i alpha = _mm_set1_epi8(static_cast<char>(OPAQUE_ALPHA));
+    int32_t x = 0;
+    for (; x + step <= width; x += step) {
+        __m128i y8 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(y + x));
+        __m128i u8 = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(u + x / 2));
+        __m128i v8 = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(v + x / 2));
+        u8 = _mm_unpacklo_epi8(u8, u8);
+        v8 = _mm_unpacklo_epi8(v8, v8);
+        __m128i channels[3][2];
+        for (int32_t half = 0; half < 2; half++) {
+            __m128i y16 = half ? _mm_unpackhi_epi8(y8, zero) : _mm_unpacklo_epi8(y8, zero);
+            __m128i u16 = half ? _mm_unpackhi_epi8(u8, zero) : _mm_unpacklo_epi8(u8, zero);
+            __m128i v16 = half ? _mm_unpackhi_epi8(v8, zero) : _mm_unpacklo_epi8(v8, zero);
+            __m128i luma = _mm_sub_epi16(y16, yOffset);
+            __m128i c = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(luma, yScale), _mm_srai_epi16(luma, 1)), round);
+            __m128i d = _mm_sub_epi16(u16, uvOffset);
+            __m128i e = _mm_sub_epi16(v16, uvOffset);
+            channels[0][half] = YuvToChannelSse2(c, d, e, 0, YUV_TO_RGB_RV);
+            channels[1][half] = YuvToChannelSse2(c, d, e, -YUV_TO_RGB_GU, -YUV_TO_RGB_GV);
+            channels[2][half] = YuvToChannelSse2(c, d, e, YUV_TO_RGB_BU, 0);
+        }
+        __m128i r = _mm_packus_epi16(channels[0][0], channels[0][1]);
+        __m128i g = _mm_packus_epi16(channels[1][0], channels[1][1]);
+        __m128i b = _mm_packus_epi16(channels[2][0], channels[2][1]);
+        __m128i rgLow = _mm_unpacklo_epi8(r, g);
+        __m128i rgHigh = _mm_unpackhi_epi8(r, g);
+        __m128i baLow = _mm_unpacklo_epi8(b, alpha);
+        __m128i baHigh = _mm_unpackhi_epi8(b, alpha);
+        __m128i *out = reinterpret_cast<__m128i *>(rgba + x * RGBA_BYTES_PER_PIXEL);
+        _mm_storeu_si128(out, _mm_unpacklo_epi16(rgLow, baLow));
+        _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(rgLow, baLow));
+        _mm_storeu_si128(out + 2, _mm_unpacklo_epi16(rgHigh, baHigh));
+        _mm_storeu_si128(out + 3, _mm_unpackhi_epi16(rgHigh, baHigh));
+    }
+    YuvToRgbaRowScalar(y + x, u + x / 2, v + x / 2, rgba + x * RGBA_BYTES_PER_PIXEL, width - x);
+}
+
+static inline void LoadRgbaSse2(const uint8_t *rgba, __m128i &r, __m128i &g, __m128i &b)
+{
+    // 8 pixels to 16 bit channels
+    const __m128i mask = _mm_set1_epi32(0xFF);
+    __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i *>(rgba));
+    __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i *>(rgba) + 1);
+    r = _mm_packs_epi32(_mm_and_si128(low, mask), _mm_and_si128(high, mask));
+    g = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(low, 8), mask), _mm_and_si128(_mm_srli_epi32(high, 8), mask));
+    b = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(low, 16), mask),
+                        _mm_and_si128(_mm_srli_epi32(high, 16), mask));
+}
+
+static inline __m128i RgbToChromaSse2(__m128i r, __m128i g, __m128i b, int16_t cr, int16_t cg, int16_t cb)
+{
+    __m128i sum = _mm_add_epi16(_mm_mullo_epi16(r, _mm_set1_epi16(cr)), _mm_mullo_epi16(g, _mm_set1_epi16(cg)));
+    sum = _mm_add_epi16(sum, _mm_mullo_epi16(b, _mm_set1_epi16(cb)));
+    sum = _mm_srai_epi16(_mm_add_epi16(sum, _mm_set1_epi16(RGB_TO_YUV_ROUND)), RGB_TO_YUV_SHIFT);
+    return _mm_add_epi16(sum, _mm_set1_epi16(YUV_UV_OFFSET));
+}
+
+static void RgbaToYRowSse2(const uint8_t *rgba, uint8_t *y, int32_t width)
+{
+    constexpr int32_t step = 8;
+    int32_t x = 0;
+    for (; x + step <= width; x += step) {
+        __m128i r;
+        __m128i g;
+        __m128i b;
+        LoadRgbaSse2(rgba + x * RGBA_BYTES_PER_PIXEL, r, g, b);
+        // Unsigned 16 bit sums, the largest is 255 * 220 + 128
+        __m128i sum = _mm_add_epi16(_mm_mullo_epi16(r, _mm_set1_epi16(RGB_TO_Y_R)),
+                                    _mm_mullo_epi16(g, _mm_set1_epi16(RGB_TO_Y_G)));
+        sum = _mm_add_epi16(sum, _mm_mullo_epi16(b, _mm_set1_epi16(RGB_TO_Y_B)));
+        sum = _mm_srli_epi16(_mm_add_epi16(sum, _mm_set1_epi16(RGB_TO_YUV_ROUND)), RGB_TO_YUV_SHIFT);
+        sum = _mm_add_epi16(sum, _mm_set1_epi16(YUV_Y_OFFSET));
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(y + x), _mm_packus_epi16(sum, sum));
+    }
+    RgbaToYRowScalar(rgba + x * RGBA_BYTES_PER_PIXEL, y + x, width - x);
+}
+
+static void RgbaToUVRowSse2(const uint8_t *rgba0, const uint8_t *rgba1, uint8_t *u, uint8_t *v, int32_t width)
+{
+    constexpr int32_t step = 16;
+    const __m128i ones = _mm_set1_epi16(1);
+    const __m128i round = _mm_set1_epi16(CHROMA_AVERAGE_ROUND);
+    int32_t x = 0;
+    for (; x + step <= width; x += step) {
+        __m128i average[3];
+        __m128i pairSums[3][2];
+        for (int32_t half = 0; half < 2; half++) {
+            __m128i channels0[3];
+            __m128i channels1[3];
+            int32_t offset = (x + half * step / 2) * RGBA_BYTES_PER_PIXEL;
+            LoadRgbaSse2(rgba0 + offset, channels0[0], channels0[1], channels0[2]);
+            LoadRgbaSse2(rgba1 + offset, channels1[0], channels1[1], channels1[2]);
+            for (int32_t channel = 0; channel < 3; channel++) {
+                pairSums[channel][half] = _mm_madd_epi16(_mm_add_epi16(channels0[channel], channels1[channel]), ones);
+            }
+        }
+        for (int32_t channel = 0; channel < 3; channel++) {
+            __m128i sum = _mm_packs_epi32(pairSums[channel][0], pairSums[channel][1]);
+            average[channel] = _mm_srli_epi16(_mm_add_epi16(sum, round), CHROMA_AVERAGE_SHIFT);
+        }
+        __m128i u16 = RgbToChromaSse2(average[0], average[1], average[2], RGB_TO_U_R, RGB_TO_U_G, RGB_TO_U_B);
+        __m128i v16 = RgbToChromaSse2(average[0], average[1], average[2], RGB_TO_V_R, RGB_TO_V_G, RGB_TO_V_B);
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(u + x / 2), _mm_packus_epi16(u16, u16));
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(v + x / 2), _mm_packus_epi16(v16, v16));
+    }
+    RgbaToUVRowScalar(rgba0 + x * RGBA_BYTES_PER_PIXEL, rgba1 + x * RGBA_BYTES_PER_PIXEL,
+                      u + x / 2, v + x / 2, width - x);
+}
+#endif
+
+#if defined(__AVX2__)
+static void SwapUVRowSimd(const uint8_t *src, uint8_t *dst, int32_t pairs)
+{
+    constexpr int32_t step = 16;
+    int32_t i = 0;
+    for (; i + step <= pairs; i += step) {
+        __m256i uv = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i * UV_BYTES_PER_PAIR));
+        uv = _mm256_or_si256(_mm256_slli_epi16(uv, 8), _mm256_srli_epi16(uv, 8));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i * UV_BYTES_PER_PAIR), uv);
+    }
+    SwapUVRowScalar(src + i * UV_BYTES_PER_PAIR, dst + i * UV_BYTES_PER_PAIR, pairs - i);
+}
+
+static void SplitUVRowSimd(const uint8_t *src, uint8_t *first, uint8_t *second, int32_t pairs)
+{
+    constexpr int32_t step = 32;
+    // The 256 bit pack works per 128 bit lane, the permute puts the quadwords back in order
+    constexpr int32_t laneOrder = 0xD8;
+    const __m256i mask = _mm256_set1_epi16(0xFF);
+    int32_t i = 0;
+    for (; i + step <= pairs; i += step) {
+        const __m256i *in = reinterpret_cast<const __m256i *>(src + i * UV_BYTES_PER_PAIR);
+        __m256i low = _mm256_loadu_si256(in);
+        __m256i high = _mm256_loadu_si256(in + 1);
+        __m256i a = _mm256_packus_epi16(_mm256_and_si256(low, mask), _mm256_and_si256(high, mask));
+        __m256i b = _mm256_packus_epi16(_mm256_srli_epi16(low, 8), _mm256_srli_epi16(high, 8));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(first + i), _mm256_permute4x64_epi64(a, laneOrder));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(second + i), _mm256_permute4x64_epi64(b, laneOrder));
+    }
+    SplitUVRowScalar(src + i * UV_BYTES_PER_PAIR, first + i, second + i, pairs - i);
+}
+
+static void MergeUVRowSimd(const uint8_t *first, const uint8_t *second, uint8_t *dst, int32_t pairs)
+{
+    constexpr int32_t step = 32;
+    constexpr int32_t lowLanes = 0x20;
+    constexpr int32_t highLanes = 0x31;
+    int32_t i = 0;
+    for (; i + step <= pairs; i += step) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(second + i));
+        __m256i low = _mm256_unpacklo_epi8(a, b);
+        __m256i high = _mm256_unpackhi_epi8(a, b);
+        __m256i *out = reinterpret_cast<__m256i *>(dst + i * UV_BYTES_PER_PAIR);
+        _mm256_storeu_si256(out, _mm256_permute2x128_si256(low, high, lowLanes));
+        _mm256_storeu_si256(out + 1, _mm256_permute2x128_si256(low, high, highLanes));
+    }
+    MergeUVRowScalar(first + i, second + i, dst + i * UV_BYTES_PER_PAIR, pairs - i);
+}
+#elif defined(__SSE2__)
+static void SwapUVRowSimd(const uint8_t *src, uint8_t *dst, int32_t pairs)
+{
+    constexpr int32_t step = 8;
+    int32_t i = 0;
+    for (; i + step <= pairs; i += step) {
+        __m128i uv = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i * UV_BYTES_PER_PAIR));
+        uv = _mm_or_si128(_mm_slli_epi16(uv, 8), _mm_srli_epi16(uv, 8));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * UV_BYTES_PER_PAIR), uv);
+    }
+    SwapUVRowScalar(src + i * UV_BYTES_PER_PAIR, dst + i * UV_BYTES_PER_PAIR, pairs - i);
+}
+
+static void SplitUVRowSimd(const uint8_t *src, uint8_t *first, uint8_t *second, int32_t pairs)
+{
+    constexpr int32_t step = 16;
+    const __m128i mask = _mm_set1_epi16(0xFF);
+    int32_t i = 0;
+    for (; i + step <= pairs; i += step) {
+        const __m128i *in = reinterpret_cast<const __m128i *>(src + i * UV_BYTES_PER_PAIR);
+        __m128i low = _mm_loadu_si128(in);
+        __m128i high = _mm_loadu_si128(in + 1);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(first + i),
+                         _mm_packus_epi16(_mm_and_si128(low, mask), _mm_and_si128(high, mask)));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(second + i),
+                         _mm_packus_epi16(_mm_srli_epi16(low, 8), _mm_srli_epi16(high, 8)));
+    }
+    SplitUVRowScalar(src + i * UV_BYTES_PER_PAIR, first + i, second + i, pairs - i);
+}
+
+static void MergeUVRowSimd(const uint8_t *first, const uint8_t *second, uint8_t *dst, int32_t pairs)
+{
+    constexpr int32_t step = 16;
+    int32_t i = 0;
+    for (; i + step <= pairs; i += step) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(first + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(second + i));
+        __m128i *out = reinterpret_cast<__m128i *>(dst + i * UV_BYTES_PER_PAIR);
+        _mm_storeu_si128(out, _mm_unpacklo_epi8(a, b));
+        _mm_storeu_si128(out + 1, _mm_unpackhi_epi8(a, b));
+    }
+    MergeUVRowScalar(first + i, second + i, dst + i * UV_BYTES_PER_PAIR, pairs - i);
+}
+#endif
+
+#if defined(__SSE2__)
+static void YuvToRgbaRowSimd(const uint8_t *y, const uint8_t *u, const uint8_t *v, uint8_t *rgba, int32_t width)
+{
+    YuvToRgbaRowSse2(y, u, v, rgba, width);
+}
+
+static void RgbaToYRowSimd(const uint8_t *rgba, uint8_t *y, int32_t width)
+{
+    RgbaToYRowSse2(rgba, y, width);
+}
+
+static void RgbaToUVRowSimd(const uint8_t *rgba0, const uint8_t *rgba1, uint8_t *u, uint8_t *v, int32_t width)
+{
+    RgbaToUVRowSse2(rgba0, rgba1, u, v, width);
+}
+#endif
+
+#if defined(CAMERA_CONVERT_NEON)
+static void SwapUVRowSimd(const uint8_t *src, uint8_t *dst, int32_t pairs)
+{
+    constexpr int32_t step = 8;
+    int32_t i = 0;
+    for (; i + step <= pairs; i += step) {
+        vst1q_u8(dst + i * UV_BYTES_PER_PAIR, vrev16q_u8(vld1q_u8(src + i * UV_BYTES_PER_PAIR)));
+    }
+    SwapUVRowScalar(src + i * UV_BYTES_PER_PAIR, dst + i * UV_BYTES_PER_PAIR, pairs - i);
+}
+
+static void SplitUVRowSimd(const uint8_t *src, uint8_t *first, uint8_t *second, int32_t pairs)
+{
+    constexpr int32_t step = 16;
+    int32_t i = 0;
+    for (; i + step <= pairs; i += step) {
+        uint8x16x2_t uv = vld2q_u8(src + i * UV_BYTES_PER_PAIR);
+        vst1q_u8(first + i, uv.val[0]);
+        vst1q_u8(second + i, uv.val[1]);
+    }
+    SplitUVRowScalar(src + i * UV_BYTES_PER_PAIR, first + i, second + i, pairs - i);
+}
+
+static void MergeUVRowSimd(const uint8_t *first, const uint8_t *second, uint8_t *dst, int32_t pairs)
+{
+    constexpr int32_t step = 16;
+    int32_t i = 0;
+    for (; i + step <= pairs; i += step) {
+        uint8x16x2_t uv;
+        uv.val[0] = vld1q_u8(first + i);
+        uv.val[1] = vld1q_u8(second + i);
+        vst2q_u8(dst + i * UV_BYTES_PER_PAIR, uv);
+    }
+    MergeUVRowScalar(first + i, second + i, dst + i * UV_BYTES_PER_PAIR, pairs - i);
+}
+
+static inline uint8x8_t YuvToChannelNeon(int16x8_t c, int16x8_t d, int16x8_t e, int16_t du, int16_t ev)
+{
+    // Saturation only happens on sums far above 255 and the narrowing clamps those to 255 like the scalar code
+    int16x8_t sum = vqaddq_s16(c, vmulq_n_s16(d, du));
+    sum = vqaddq_s16(sum, vmulq_n_s16(e, ev));
+    return vqshrun_n_s16(sum, YUV_TO_RGB_SHIFT);
+}
+
+static void YuvToRgbaRowSimd(const uint8_t *y, const uint8_t *u, const uint8_t *v, uint8_t *rgba, int32_t width)
+{
+    constexpr int32_t step = 16;
+    constexpr int32_t halfStep = 8;
+    const int16x8_t yOffset = vdupq_n_s16(YUV_Y_OFFSET);
+    const int16x8_t uvOffset = vdupq_n_s16(YUV_UV_OFFSET);
+    const int16x8_t round = vdupq_n_s16(YUV_TO_RGB_ROUND);
+    int32_t x = 0;
+    for (; x + step <= width; x += step) {
+        uint8x16_t y8 = vld1q_u8(y + x);
+        // 8 chroma samples duplicated to the 16 pixels they cover
+        uint8x8_t u8 = vld1_u8(u + x / 2);
+        uint8x8_t v8 = vld1_u8(v + x / 2);
+        uint8x8x2_t uDup = vzip_u8(u8, u8);
+        uint8x8x2_t vDup = vzip_u8(v8, v8);
+        for (int32_t half = 0; half < 2; half++) {
+            uint8x8_t yHalf = half ? vget_high_u8(y8) : vget_low_u8(y8);
+            int16x8_t y16 = vreinterpretq_s16_u16(vmovl_u8(yHalf));
+            int16x8_t luma = vsubq_s16(y16, yOffset);
+            int16x8_t c = vaddq_s16(vaddq_s16(vmulq_n_s16(luma, YUV_TO_RGB_Y), vshrq_n_s16(luma, 1)), round);
+            int16x8_t d = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(uDup.val[half])), uvOffset);
+            int16x8_t e = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vDup.val[half])), uvOffset);
+            uint8x8x4_t pixels;
+            pixels.val[0] = YuvToChannelNeon(c, d, e, 0, YUV_TO_RGB_RV);
+            pixels.val[1] = YuvToChannelNeon(c, d, e, -YUV_TO_RGB_GU, -YUV_TO_RGB_GV);
+            pixels.val[2] = YuvToChannelNeon(c, d, e, YUV_TO_RGB_BU, 0);
+            pixels.val[3] = vdup_n_u8(OPAQUE_ALPHA);
+            vst4_u8(rgba + (x + half * halfStep) * RGBA_BYTES_PER_PIXEL, pixels);
+        }
+    }
+    YuvToRgbaRowScalar(y + x, u + x / 2, v + x / 2, rgba + x * RGBA_BYTES_PER_PIXEL, width - x);
+}
+
+static void RgbaToYRowSimd(const uint8_t *rgba, uint8_t *y, int32_t width)
+{
+    constexpr int32_t step = 8;
+    int32_t x = 0;
+    for (; x + step <= width; x += step) {
+        uint8x8x4_t pixels = vld4_u8(rgba + x * RGBA_BYTES_PER_PIXEL);
+        // Unsigned 16 bit sums, the largest is 255 * 220 + 128
+        uint16x8_t sum = vmull_u8(pixels.val[0], vdup_n_u8(RGB_TO_Y_R));
+        sum = vmlal_u8(sum, pixels.val[1], vdup_n_u8(RGB_TO_Y_G));
+        sum = vmlal_u8(sum, pixels.val[2], vdup_n_u8(RGB_TO_Y_B));
+        sum = vshrq_n_u16(vaddq_u16(sum, vdupq_n_u16(RGB_TO_YUV_ROUND)), RGB_TO_YUV_SHIFT);
+        vst1_u8(y + x, vmovn_u16(vaddq_u16(sum, vdupq_n_u16(YUV_Y_OFFSET))));
+    }
+    RgbaToYRowScalar(rgba + x * RGBA_BYTES_PER_PIXEL, y + x, width - x);
+}
+
+static inline uint8x8_t RgbToChromaNeon(int16x8_t r, int16x8_t g, int16x8_t b, int16_t cr, int16_t cg, int16_t cb)
+{
+    int16x8_t sum = vmulq_n_s16(r, cr);
+    sum = vmlaq_n_s16(sum, g, cg);
+    sum = vmlaq_n_s16(sum, b, cb);
+    sum = vshrq_n_s16(vaddq_s16(sum, vdupq_n_s16(RGB_TO_YUV_ROUND)), RGB_TO_YUV_SHIFT);
+    return vqmovun_s16(vaddq_s16(sum, vdupq_n_s16(YUV_UV_OFFSET)));
+}
+
+static void RgbaToUVRowSimd(const uint8_t *rgba0, const uint8_t *rgba1, uint8_t *u, uint8_t *v, int32_t width)
+{
+    constexpr int32_t step = 16;
+    int32_t x = 0;
+    for (; x + step <= width; x += step) {
+        uint8x16x4_t pixels0 = vld4q_u8(rgba0 + x * RGBA_BYTES_PER_PIXEL);
+        uint8x16x4_t pixels1 = vld4q_u8(rgba1 + x * RGBA_BYTES_PER_PIXEL);
+        int16x8_t average[3];
+        for (int32_t channel = 0; channel < 3; channel++) {
+            uint16x8_t sum = vaddq_u16(vpaddlq_u8(pixels0.val[channel]), vpaddlq_u8(pixels1.val[channel]));
+            average[channel] = vreinterpretq_s16_u16(vrshrq_n_u16(sum, CHROMA_AVERAGE_SHIFT));
+        }
+        vst1_u8(u + x / 2, RgbToChromaNeon(average[0], average[1], average[2], RGB_TO_U_R, RGB_TO_U_G, RGB_TO_U_B));
+        vst1_u8(v + x / 2, RgbToChromaNeon(average[0], average[1], average[2], RGB_TO_V_R, RGB_TO_V_G, RGB_TO_V_B));
+    }
+    RgbaToUVRowScalar(rgba0 + x * RGBA_BYTES_PER_PIXEL, rgba1 + x * RGBA_BYTES_PER_PIXEL,
+                      u + x / 2, v + x / 2, width - x);
+}
+#endif
+
+#if defined(__SSE2__) || defined(CAMERA_CONVERT_NEON)
+#define CAMERA_CONVERT_SIMD
+#endif
+
+struct ConvertKernels {
+    void (*swapUV)(const uint8_t *src, uint8_t *dst, int32_t pairs);
+    void (*splitUV)(const uint8_t *src, uint8_t *first, uint8_t *second, int32_t pairs);
+    void (*mergeUV)(const uint8_t *first, const uint8_t *second, uint8_t *dst, int32_t pairs);
+    void (*yuvToRgba)(const uint8_t *y, const uint8_t *u, const uint8_t *v, uint8_t *rgba, int32_t width);
+    void (*rgbaToY)(const uint8_t *rgba, uint8_t *y, int32_t width);
+    void (*rgbaToUV)(const uint8_t *rgba0, const uint8_t *rgba1, uint8_t *u, uint8_t *v, int32_t width);
+};
+
+static const ConvertKernels SCALAR_KERNELS = {
+    SwapUVRowScalar, SplitUVRowScalar, MergeUVRowScalar, YuvToRgbaRowScalar, RgbaToYRowScalar, RgbaToUVRowScalar,
+};
+
+#ifdef CAMERA_CONVERT_SIMD
+static const ConvertKernels SIMD_KERNELS = {
+    SwapUVRowSimd, SplitUVRowSimd, MergeUVRowSimd, YuvToRgbaRowSimd, RgbaToYRowSimd, RgbaToUVRowSimd,
+};
+#endif
+
+static const ConvertKernels &GetKernels(bool useSimd)
+{
+#ifdef CAMERA_CONVERT_SIMD
+    if (useSimd) {
+        return SIMD_KERNELS;
+    }
+#endif
+    return SCALAR_KERNELS;
+}
+
+static void CopyRows(const uint8_t *src, int32_t srcStride, uint8_t *dst, int32_t dstStride,
+                     int32_t rowBytes, int32_t rows)
+{
+    for (int32_t row = 0; row < rows; row++) {
+        (void)memcpy_s(dst + static_cast<size_t>(row) * dstStride, rowBytes,
+                       src + static_cast<size_t>(row) * srcStride, rowBytes);
+    }
+}
+
+static void ConvertYuvToYuv(const ImageBuffer &src, const ImageBuffer &dst, const ConvertKernels &kernels)
+{
+    YuvPlanes in = GetYuvPlanes(src);
+    YuvPlanes out = GetYuvPlanes(dst);
+    CopyRows(in.y, in.yStride, out.y, out.yStride, src.width, src.height);
+    int32_t pairs = ChromaWidth(src.width);
+    for (int32_t row = 0; row < ChromaHeight(src.height); row++) {
+        size_t inOffset = static_cast<size_t>(row) * in.uvStride;
+        size_t outOffset = static_cast<size_t>(row) * out.uvStride;
+        if (in.uvStep == 1 && out.uvStep == 1) {
+            (void)memcpy_s(out.u + outOffset, pairs, in.u + inOffset, pairs);
+            (void)memcpy_s(out.v + outOffset, pairs, in.v + inOffset, pairs);
+        } else if (in.uvStep == 1) {
+            uint8_t *interleaved = std::min(out.u, out.v) + outOffset;
+            bool isUFirst = out.u < out.v;
+            kernels.mergeUV(isUFirst ? in.u + inOffset : in.v + inOffset,
+                            isUFirst ? in.v + inOffset : in.u + inOffset, interleaved, pairs);
+        } else if (out.uvStep == 1) {
+            const uint8_t *interleaved = std::min(in.u, in.v) + inOffset;
+            bool isUFirst = in.u < in.v;
+            kernels.splitUV(interleaved, isUFirst ? out.u + outOffset : out.v + outOffset,
+                            isUFirst ? out.v + outOffset : out.u + outOffset, pairs);
+        } else if ((in.u < in.v) == (out.u < out.v)) {
+            (void)memcpy_s(std::min(out.u, out.v) + outOffset, pairs * UV_BYTES_PER_PAIR,
+                           std::min(in.u, in.v) + inOffset, pairs * UV_BYTES_PER_PAIR);
+        } else {
+            kernels.swapUV(std::min(in.u, in.v) + inOffset, std::min(out.u, out.v) + outOffset, pairs);
+        }
+    }
+}
+
+static void ConvertYuvToRgba(const ImageBuffer &src, const ImageBuffer &dst, const ConvertKernels &kernels)
+{
+    YuvPlanes in = GetYuvPlanes(src);
+    int32_t pairs = ChromaWidth(src.width);
+    std::vector<uint8_t> uRow(pairs);
+    std::vector<uint8_t> vRow(pairs);
+    for (int32_t row = 0; row < src.height; row++) {
+        size_t chromaOffset = static_cast<size_t>(row / 2) * in.uvStride;
+        const uint8_t *u = in.u + chromaOffset;
+        const uint8_t *v = in.v + chromaOffset;
+        if (in.uvStep != 1) {
+            if (row % 2 == 0) {
+                bool isUFirst = in.u < in.v;
+                kernels.splitUV(std::min(u, v), isUFirst ? uRow.data() : vRow.data(),
+                                isUFirst ? vRow.data() : uRow.data(), pairs);
+            }
+            u = uRow.data();
+            v = vRow.data();
+        }
+        kernels.yuvToRgba(in.y + static_cast<size_t>(row) * in.yStride, u, v,
+                          dst.data + static_cast<size_t>(row) * dst.stride, src.width);
+    }
+}
+
+static void ConvertRgbaToYuv(const ImageBuffer &src, const ImageBuffer &dst, const ConvertKernels &kernels)
+{
+    YuvPlanes out = GetYuvPlanes(dst);
+    int32_t pairs = ChromaWidth(src.width);
+    std::vector<uint8_t> uRow(pairs);
+    std::vector<uint8_t> vRow(pairs);
+    for (int32_t row = 0; row < src.height; row += 2) {
+        const uint8_t *rgba0 = src.data + static_cast<size_t>(row) * src.stride;
+        // The last row of an odd height frame is paired with itself
+        const uint8_t *rgba1 = (row + 1 < src.height) ? rgba0 + src.stride : rgba0;
+        kernels.rgbaToY(rgba0, out.y + static_cast<size_t>(row) * out.yStride, src.width);
+        if (row + 1 < src.height) {
+            kernels.rgbaToY(rgba1, out.y + static_cast<size_t>(row + 1) * out.yStride, src.width);
+        }
+        size_t chromaOffset = static_cast<size_t>(row / 2) * out.uvStride;
+        if (out.uvStep == 1) {
+            kernels.rgbaToUV(rgba0, rgba1, out.u + chromaOffset, out.v + chromaOffset, src.width);
+            continue;
+        }
+        kernels.rgbaToUV(rgba0, rgba1, uRow.data(), vRow.data(), src.width);
+        bool isUFirst = out.u < out.v;
+        kernels.mergeUV(isUFirst ? uRow.data() : vRow.data(), isUFirst ? vRow.data() : uRow.data(),
+                        std::min(out.u, out.v) + chromaOffset, pairs);
+    }
+}
+
+bool IsConvertibleFormat(int32_t pixelFormat)
+{
+    return IsYuvFormat(pixelFormat) || pixelFormat == PIXEL_FMT_RGBA_8888;
+}
+
+size_t GetImageSize(int32_t pixelFormat, int32_t stride, int32_t height)
+{
+    size_t planeSize = static_cast<size_t>(stride) * height;
+    if (pixelFormat == PIXEL_FMT_RGBA_8888) {
+        return planeSize;
+    }
+    if (pixelFormat == PIXEL_FMT_YCBCR_420_P) {
+        return planeSize + static_cast<size_t>(stride / 2) * ChromaHeight(height) * UV_BYTES_PER_PAIR;
+    }
+    return planeSize + static_cast<size_t>(stride) * ChromaHeight(height);
+}
+
+bool IsValidImage(const ImageBuffer &image)
+{
+    if (image.data == nullptr || !IsConvertibleFormat(image.format) || image.width <= 0 || image.height <= 0) {
+        return false;
+    }
+    int32_t rowBytes = (image.format == PIXEL_FMT_RGBA_8888) ? image.width * RGBA_BYTES_PER_PIXEL : image.width;
+    if (image.stride < rowBytes) {
+        return false;
+    }
+    if (image.format == PIXEL_FMT_YCBCR_420_P && image.stride / 2 < ChromaWidth(image.width)) {
+        return false;
+    }
+    // An odd width still has a whole chroma pair for its last pixel in the interleaved plane
+    bool isSemiPlanar = IsYuvFormat(image.format) && image.format != PIXEL_FMT_YCBCR_420_P;
+    if (isSemiPlanar && image.stride < ChromaWidth(image.width) * UV_BYTES_PER_PAIR) {
+        return false;
+    }
+    return GetImageSize(image.format, image.stride, image.height) <= image.size;
+}
+
+int32_t ConvertImage(const ImageBuffer &src, const ImageBuffer &dst, bool useSimd)
+{
+    CAMERA_SYNC_TRACE;
+    if (!IsValidImage(src) || !IsValidImage(dst) || src.width != dst.width || src.height != dst.height) {
+        MEDIA_ERR_LOG("ConvertImage invalid images, format %{public}d %{public}dx%{public}d to "
+                      "format %{public}d %{public}dx%{public}d", src.format, src.width, src.height,
+                      dst.format, dst.width, dst.height);
+        return CAMERA_INVALID_ARG;
+    }
+    const ConvertKernels &kernels = GetKernels(useSimd);
+    bool isSrcYuv = IsYuvFormat(src.format);
+    bool isDstYuv = IsYuvFormat(dst.format);
+    if (isSrcYuv && isDstYuv) {
+        ConvertYuvToYuv(src, dst, kernels);
+    } else if (isSrcYuv) {
+        ConvertYuvToRgba(src, dst, kernels);
+    } else if (isDstYuv) {
+        ConvertRgbaToYuv(src, dst, kernels);
+    } else {
+        CopyRows(src.data, src.stride, dst.data, dst.stride, src.width * RGBA_BYTES_PER_PIXEL, src.height);
+    }
+    return CAMERA_OK;
+}
+
+const char *GetConvertSimdName()
+{
+#if defined(__AVX2__)
+    return "AVX2";
+#elif defined(__SSE2__)
+    return "SSE2";
+#elif defined(CAMERA_CONVERT_NEON)
+    return "NEON";
+#else
+    return "None";
+#endif
+}
+} // namespace CameraStandard
+} // namespace OHOS
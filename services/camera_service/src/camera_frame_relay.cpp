@@ -0,0 +1,583 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "camera_frame_relay.h"
+
+#include <algorithm>
+#include <chrono>
+#include <securec.h>
+#include "camera_format_converter.h"
+#include "camera_image_scaler.h"
+#include "camera_image_transform.h"
+#include "camera_util.h"
+#include "camera_log.h"
+#include "display_type.h"
+
+namespace OHOS {
+namespace CameraStandard {
+namespace {
+    constexpr int32_t RELAY_STRIDE_ALIGNMENT = 8;
+    constexpr int32_t RELAY_QUEUE_SIZE = 3;
+    constexpr int32_t RGBA_BYTES_PER_PIXEL = 4;
+    constexpr int64_t NANOSECONDS_PER_SECOND = 1000000000;
+    constexpr int64_t NANOSECONDS_PER_MICROSECOND = 1000;
+    constexpr int32_t ROTATION_90 = 90;
+    constexpr int32_t ROTATION_270 = 270;
+}
+
+class RelayBufferListener : public IBufferConsumerListener {
+public:
+    explicit RelayBufferListener(const wptr<FrameRelay> &relay) : relay_(relay) {}
+    ~RelayBufferListener() = default;
+
+    void OnBufferAvailable() override
+    {
+        sptr<FrameRelay> relay = relay_.promote();
+        if (relay != nullptr) {
+            relay->OnBufferAvailable();
+        }
+    }
+
+private:
+    wptr<FrameRelay> relay_;
+};
+
+int32_t CopyBufferToSurface(const sptr<SurfaceBuffer> &buffer, int64_t timestamp, sptr<Surface> &output)
+{
+    if (buffer == nullptr || output == nullptr) {
+        return CAMERA_INVALID_ARG;
+    }
+    BufferRequestConfig requestConfig = {
+        .width = buffer->GetWidth(),
+        .height = buffer->GetHeight(),
+        .strideAlignment = RELAY_STRIDE_ALIGNMENT,
+        .format = buffer->GetFormat(),
+        .usage = HBM_USE_CPU_READ | HBM_USE_CPU_WRITE | HBM_USE_MEM_DMA,
+        .timeout = 0,
+    };
+    sptr<SurfaceBuffer> outputBuffer = nullptr;
+    int32_t releaseFence = -1;
+    SurfaceError surfaceRet = output->RequestBuffer(outputBuffer, releaseFence, requestConfig);
+    if (surfaceRet != SURFACE_ERROR_OK || outputBuffer == nullptr) {
+        MEDIA_ERR_LOG("CopyBufferToSurface Failed to request output buffer: %{public}d", surfaceRet);
+        return CAMERA_STREAM_BUFFER_LOST;
+    }
+    int32_t format = buffer->GetFormat();
+    if (IsConvertibleFormat(format) && buffer->GetStride() != outputBuffer->GetStride()) {
+        // The output is laid out with its own stride, so the planes are copied row by row
+        ImageBuffer src = {
+            .data = static_cast<uint8_t *>(buffer->GetVirAddr()),
+            .size = buffer->GetSize(),
+            .format = format,
+            .width = buffer->GetWidth(),
+            .height = buffer->GetHeight(),
+            .stride = buffer->GetStride(),
+        };
+        ImageBuffer dst = {
+            .data = static_cast<uint8_t *>(outputBuffer->GetVirAddr()),
+            .size = outputBuffer->GetSize(),
+            .format = format,
+            .width = outputBuffer->GetWidth(),
+            .height = outputBuffer->GetHeight(),
+            .stride = outputBuffer->GetStride(),
+        };
+        int32_t ret = ConvertImage(src, dst);
+        if (ret != CAMERA_OK) {
+            MEDIA_ERR_LOG("CopyBufferToSurface Failed to copy image planes: %{public}d", ret);
+            output->CancelBuffer(outputBuffer);
+            return ret;
+        }
+    } else if (memcpy_s(outputBuffer->GetVirAddr(), outputBuffer->GetSize(),
+                        buffer->GetVirAddr(), std::min(buffer->GetSize(), outputBuffer->GetSize())) != EOK) {
+        MEDIA_ERR_LOG("CopyBufferToSurface Failed to copy buffer");
+        output->CancelBuffer(outputBuffer);
+        return CAMERA_UNKNOWN_ERROR;
+    }
+    BufferFlushConfig flushConfig = {
+        .damage = {
+            .x = 0,
+            .y = 0,
+            .w = buffer->GetWidth(),
+            .h = buffer->GetHeight(),
+        },
+        .timestamp = timestamp,
+    };
+    output->FlushBuffer(outputBuffer, -1, flushConfig);
+    return CAMERA_OK;
+}
+
+int32_t ConvertBufferToSurface(const sptr<SurfaceBuffer> &buffer, int32_t srcFormat, int32_t dstFormat,
+                               int64_t timestamp, sptr<Surface> &output)
+{
+    if (buffer == nullptr || output == nullptr) {
+        return CAMERA_INVALID_ARG;
+    }
+    BufferRequestConfig requestConfig = {
+        .width = buffer->GetWidth(),
+        .height = buffer->GetHeight(),
+        .strideAlignment = RELAY_STRIDE_ALIGNMENT,
+        .format = dstFormat,
+        .usage = HBM_USE_CPU_READ | HBM_USE_CPU_WRITE | HBM_USE_MEM_DMA,
+        .timeout = 0,
+    };
+    sptr<SurfaceBuffer> outputBuffer = nullptr;
+    int32_t releaseFence = -1;
+    SurfaceError surfaceRet = output->RequestBuffer(outputBuffer, releaseFence, requestConfig);
+    if (surfaceRet != SURFACE_ERROR_OK || outputBuffer == nullptr) {
+        MEDIA_ERR_LOG("ConvertBufferToSurface Failed to request output buffer: %{public}d", surfaceRet);
+        return CAMERA_STREAM_BUFFER_LOST;
+    }
+    ImageBuffer src = {
+        .data = static_cast<uint8_t *>(buffer->GetVirAddr()),
+        .size = buffer->GetSize(),
+        .format = srcFormat,
+        .width = buffer->GetWidth(),
+        .height = buffer->GetHeight(),
+        .stride = buffer->GetStride(),
+    };
+    ImageBuffer dst = {
+        .data = static_cast<uint8_t *>(outputBuffer->GetVirAddr()),
+        .size = outputBuffer->GetSize(),
+        .format = dstFormat,
+        .width = outputBuffer->GetWidth(),
+        .height = outputBuffer->GetHeight(),
+        .stride = outputBuffer->GetStride(),
+    };
+    int32_t ret = ConvertImage(src, dst);
+    if (ret != CAMERA_OK) {
+        output->CancelBuffer(outputBuffer);
+        return ret;
+    }
+    BufferFlushConfig flushConfig = {
+        .damage = {
+            .x = 0,
+            .y = 0,
+            .w = buffer->GetWidth(),
+            .h = buffer->GetHeight(),
+        },
+        .timestamp = timestamp,
+    };
+    output->FlushBuffer(outputBuffer, -1, flushConfig);
+    return CAMERA_OK;
+}
+
+int32_t ScaleBufferToSurface(const sptr<SurfaceBuffer> &buffer, int32_t srcFormat, int32_t dstFormat,
+                             int32_t width, int32_t height, int64_t timestamp, sptr<Surface> &output,
+                             std::vector<uint8_t> &scratch)
+{
+    if (buffer == nullptr || output == nullptr) {
+        return CAMERA_INVALID_ARG;
+    }
+    BufferRequestConfig requestConfig = {
+        .width = width,
+        .height = height,
+        .strideAlignment = RELAY_STRIDE_ALIGNMENT,
+        .format = dstFormat,
+        .usage = HBM_USE_CPU_READ | HBM_USE_CPU_WRITE | HBM_USE_MEM_DMA,
+        .timeout = 0,
+    };
+    sptr<SurfaceBuffer> outputBuffer = nullptr;
+    int32_t releaseFence = -1;
+    SurfaceError surfaceRet = output->RequestBuffer(outputBuffer, releaseFence, requestConfig);
+    if (surfaceRet != SURFACE_ERROR_OK || outputBuffer == nullptr) {
+        MEDIA_ERR_LOG("ScaleBufferToSurface Failed to request output buffer: %{public}d", surfaceRet);
+        return CAMERA_STREAM_BUFFER_LOST;
+    }
+    ImageBuffer src = {
+        .data = static_cast<uint8_t *>(buffer->GetVirAddr()),
+        .size = buffer->GetSize(),
+        .format = srcFormat,
+        .width = buffer->GetWidth(),
+        .height = buffer->GetHeight(),
+        .stride = buffer->GetStride(),
+    };
+    ImageBuffer dst = {
+        .data = static_cast<uint8_t *>(outputBuffer->GetVirAddr()),
+        .size = outputBuffer->GetSize(),
+        .format = dstFormat,
+        .width = outputBuffer->GetWidth(),
+        .height = outputBuffer->GetHeight(),
+        .stride = outputBuffer->GetStride(),
+    };
+    int32_t ret = CAMERA_OK;
+    if (srcFormat == dstFormat) {
+        ret = ScaleImage(src, dst);
+    } else {
+        // Scaled first in the device format so the conversion only runs on the smaller frame
+        int32_t stride = (srcFormat == PIXEL_FMT_RGBA_8888) ? dst.width * RGBA_BYTES_PER_PIXEL
+                                                            : (dst.width + 1) & ~1;
+        scratch.resize(GetImageSize(srcFormat, stride, dst.height));
+        ImageBuffer scaled = {
+            .data = scratch.data(),
+            .size = scratch.size(),
+            .format = srcFormat,
+            .width = dst.width,
+            .height = dst.height,
+            .stride = stride,
+        };
+        ret = ScaleImage(src, scaled);
+        if (ret == CAMERA_OK) {
+            ret = ConvertImage(scaled, dst);
+        }
+    }
+    if (ret != CAMERA_OK) {
+        output->CancelBuffer(outputBuffer);
+        return ret;
+    }
+    BufferFlushConfig flushConfig = {
+        .damage = {
+            .x = 0,
+            .y = 0,
+            .w = width,
+            .h = height,
+        },
+        .timestamp = timestamp,
+    };
+    output->FlushBuffer(outputBuffer, -1, flushConfig);
+    return CAMERA_OK;
+}
+
+static int32_t GetTightStride(int32_t format, int32_t width)
+{
+    // I420 needs an even stride to hold its half stride chroma rows
+    return (format == PIXEL_FMT_RGBA_8888) ? width * RGBA_BYTES_PER_PIXEL : (width + 1) & ~1;
+}
+
+static int32_t PrepareFrame(const ImageBuffer &src, int32_t dstFormat, int32_t width, int32_t height,
+                            std::vector<uint8_t> &scratch, ImageBuffer &prepared)
+{
+    bool isScaled = (src.width != width || src.height != height);
+    bool isConverted = (src.format != dstFormat);
+    int32_t scaledStride = GetTightStride(src.format, width);
+    int32_t convertedStride = GetTightStride(dstFormat, width);
+    size_t scaledSize = isScaled ? GetImageSize(src.format, scaledStride, height) : 0;
+    size_t convertedSize = isConverted ? GetImageSize(dstFormat, convertedStride, height) : 0;
+    scratch.resize(scaledSize + convertedSize);
+    prepared = src;
+    int32_t ret = CAMERA_OK;
+    if (isScaled) {
+        ImageBuffer scaled = {scratch.data(), scaledSize, src.format, width, height, scaledStride};
+        ret = ScaleImage(prepared, scaled);
+        prepared = scaled;
+    }
+    if (ret == CAMERA_OK && isConverted) {
+        ImageBuffer converted = {scratch.data() + scaledSize, convertedSize, dstFormat, width, height,
+                                 convertedStride};
+        ret = ConvertImage(prepared, converted);
+        prepared = converted;
+    }
+    return ret;
+}
+
+int32_t TransformBufferToSurface(const sptr<SurfaceBuffer> &buffer, int32_t srcFormat, int32_t dstFormat,
+                                 int32_t width, int32_t height, int32_t rotation, bool isMirrored,
+                                 int64_t timestamp, sptr<Surface> &output, std::vector<uint8_t> &scratch)
+{
+    if (buffer == nullptr || output == nullptr) {
+        return CAMERA_INVALID_ARG;
+    }
+    bool isTransposed = (rotation == ROTATION_90 || rotation == ROTATION_270);
+    int32_t outputWidth = isTransposed ? height : width;
+    int32_t outputHeight = isTransposed ? width : height;
+    BufferRequestConfig requestConfig = {
+        .width = outputWidth,
+        .height = outputHeight,
+        .strideAlignment = RELAY_STRIDE_ALIGNMENT,
+        .format = dstFormat,
+        .usage = HBM_USE_CPU_READ | HBM_USE_CPU_WRITE | HBM_USE_MEM_DMA,
+        .timeout = 0,
+    };
+    sptr<SurfaceBuffer> outputBuffer = nullptr;
+    int32_t releaseFence = -1;
+    SurfaceError surfaceRet = output->RequestBuffer(outputBuffer, releaseFence, requestConfig);
+    if (surfaceRet != SURFACE_ERROR_OK || outputBuffer == nullptr) {
+        MEDIA_ERR_LOG("TransformBufferToSurface Failed to request output buffer: %{public}d", surfaceRet);
+        return CAMERA_STREAM_BUFFER_LOST;
+    }
+    ImageBuffer src = {
+        .data = static_cast<uint8_t *>(buffer->GetVirAddr()),
+        .size = buffer->GetSize(),
+        .format = srcFormat,
+        .width = buffer->GetWidth(),
+        .height = buffer->GetHeight(),
+        .stride = buffer->GetStride(),
+    };
+    ImageBuffer dst = {
+        .data = static_cast<uint8_t *>(outputBuffer->GetVirAddr()),
+        .size = outputBuffer->GetSize(),
+        .format = dstFormat,
+        .width = outputBuffer->GetWidth(),
+        .height = outputBuffer->GetHeight(),
+        .stride = outputBuffer->GetStride(),
+    };
+    // Scaled and converted first, so the transform moves the fewest bytes it can
+    ImageBuffer prepared;
+    int32_t ret = PrepareFrame(src, dstFormat, width, height, scratch, prepared);
+    if (ret == CAMERA_OK) {
+        ret = TransformImage(prepared, dst, rotation, isMirrored);
+    }
+    if (ret != CAMERA_OK) {
+        output->CancelBuffer(outputBuffer);
+        return ret;
+    }
+    BufferFlushConfig flushConfig = {
+        .damage = {
+            .x = 0,
+            .y = 0,
+            .w = outputWidth,
+            .h = outputHeight,
+        },
+        .timestamp = timestamp,
+    };
+    output->FlushBuffer(outputBuffer, -1, flushConfig);
+    return CAMERA_OK;
+}
+
+FrameRelay::FrameRelay(sptr<IBufferProducer> clientProducer)
+{
+    clientProducer_ = clientProducer;
+    surface_ = nullptr;
+    output_ = nullptr;
+}
+
+FrameRelay::~FrameRelay()
+{
+    Release();
+}
+
+int32_t FrameRelay::Init(int32_t width, int32_t height)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (clientProducer_ != nullptr) {
+        output_ = Surface::CreateSurfaceAsProducer(clientProducer_);
+    }
+    surface_ = Surface::CreateSurfaceAsConsumer("FrameRelay");
+    if ((clientProducer_ != nullptr && output_ == nullptr) || surface_ == nullptr) {
+        MEDIA_ERR_LOG("FrameRelay::Init failed to create relay surfaces");
+        output_ = nullptr;
+        surface_ = nullptr;
+        return CAMERA_ALLOC_ERROR;
+    }
+    sptr<IBufferConsumerListener> listener = new(std::nothrow) RelayBufferListener(this);
+    if (listener == nullptr) {
+        MEDIA_ERR_LOG("FrameRelay::Init failed to create buffer listener");
+        output_ = nullptr;
+        surface_ = nullptr;
+        return CAMERA_ALLOC_ERROR;
+    }
+    surface_->SetDefaultWidthAndHeight(width, height);
+    surface_->SetQueueSize(RELAY_QUEUE_SIZE);
+    surface_->RegisterConsumerListener(listener);
+    return CAMERA_OK;
+}
+
+sptr<IBufferProducer> FrameRelay::GetProducer()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (surface_ == nullptr) {
+        return nullptr;
+    }
+    return surface_->GetProducer();
+}
+
+void FrameRelay::SetClientProducer(sptr<IBufferProducer> clientProducer)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    clientProducer_ = clientProducer;
+    output_ = (clientProducer_ != nullptr) ? Surface::CreateSurfaceAsProducer(clientProducer_) : nullptr;
+}
+
+void FrameRelay::SetTargetFps(float fps)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    frameInterval_ = (fps > 0) ? static_cast<int64_t>(NANOSECONDS_PER_SECOND / fps) : 0;
+    nextFrameTime_ = 0;
+}
+
+void FrameRelay::SetConversion(int32_t srcFormat, int32_t dstFormat)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    srcFormat_ = srcFormat;
+    dstFormat_ = dstFormat;
+}
+
+void FrameRelay::SetOutputSize(int32_t width, int32_t height)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    outputWidth_ = width;
+    outputHeight_ = height;
+}
+
+void FrameRelay::SetTransform(int32_t rotation, bool isMirrored)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    rotation_ = rotation;
+    isMirrored_ = isMirrored;
+}
+
+void FrameRelay::UpdateFrameRateLocked(int64_t now)
+{
+    if (windowStart_ == 0) {
+        windowStart_ = now;
+        return;
+    }
+    int64_t elapsed = now - windowStart_;
+    if (elapsed < NANOSECONDS_PER_SECOND) {
+        return;
+    }
+    inputFps_ = static_cast<float>(windowInputFrames_) * NANOSECONDS_PER_SECOND / elapsed;
+    achievedFps_ = static_cast<float>(windowOutputFrames_) * NANOSECONDS_PER_SECOND / elapsed;
+    windowStart_ = now;
+    windowInputFrames_ = 0;
+    windowOutputFrames_ = 0;
+}
+
+void FrameRelay::OnBufferAvailable()
+{
+    // The frame is copied outside of mutex_, so setters, dumps and fps queries never wait on it
+    std::lock_guard<std::mutex> processLock(processLock_);
+    sptr<Surface> surface = nullptr;
+    sptr<Surface> output = nullptr;
+    sptr<SurfaceBuffer> buffer = nullptr;
+    int64_t timestamp = 0;
+    int64_t now = 0;
+    bool isFrameDue = true;
+    int32_t srcFormat = 0;
+    int32_t dstFormat = 0;
+    int32_t outputWidth = 0;
+    int32_t outputHeight = 0;
+    int32_t rotation = 0;
+    bool isMirrored = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (surface_ == nullptr) {
+            return;
+        }
+        surface = surface_;
+        int32_t fence = -1;
+        OHOS::Rect damage;
+        SurfaceError surfaceRet = surface->AcquireBuffer(buffer, fence, timestamp, damage);
+        if (surfaceRet != SURFACE_ERROR_OK || buffer == nullptr) {
+            MEDIA_ERR_LOG("FrameRelay::OnBufferAvailable Failed to acquire surface buffer");
+            return;
+        }
+        now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+        if (frameInterval_ > 0) {
+            // Half an input frame of slack so a frame arriving just ahead of its slot is not skipped
+            int64_t slack = (lastInputTime_ > 0) ? (now - lastInputTime_) / 2 : 0;
+            isFrameDue = (now + slack >= nextFrameTime_);
+            if (isFrameDue) {
+                // Keep to the slot grid so the average rate does not drift with arrival jitter,
+                // restart it after a stall instead of bursting to catch up
+                nextFrameTime_ += frameInterval_;
+                if (nextFrameTime_ <= now) {
+                    nextFrameTime_ = now + frameInterval_;
+                }
+            }
+        }
+        lastInputTime_ = now;
+        windowInputFrames_++;
+        output = output_;
+        srcFormat = srcFormat_;
+        dstFormat = dstFormat_;
+        outputWidth = outputWidth_;
+        outputHeight = outputHeight_;
+        rotation = rotation_;
+        isMirrored = isMirrored_;
+    }
+    int32_t ret = CAMERA_OK;
+    int64_t transformTime = -1;
+    bool isConverted = (srcFormat != dstFormat);
+    bool isScaled = (outputWidth > 0 && outputHeight > 0
+        && (buffer->GetWidth() != outputWidth || buffer->GetHeight() != outputHeight));
+    if (isFrameDue && (rotation != 0 || isMirrored)) {
+        ret = TransformBufferToSurface(buffer, isConverted ? srcFormat : buffer->GetFormat(),
+                                       isConverted ? dstFormat : buffer->GetFormat(),
+                                       isScaled ? outputWidth : buffer->GetWidth(),
+                                       isScaled ? outputHeight : buffer->GetHeight(), rotation, isMirrored,
+                                       timestamp, output, scaleBuffer_);
+        transformTime = (std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count() - now) / NANOSECONDS_PER_MICROSECOND;
+    } else if (isFrameDue && isScaled) {
+        ret = ScaleBufferToSurface(buffer, isConverted ? srcFormat : buffer->GetFormat(),
+                                   isConverted ? dstFormat : buffer->GetFormat(), outputWidth, outputHeight,
+                                   timestamp, output, scaleBuffer_);
+    } else if (isFrameDue) {
+        ret = isConverted ? ConvertBufferToSurface(buffer, srcFormat, dstFormat, timestamp, output)
+                          : CopyBufferToSurface(buffer, timestamp, output);
+    }
+    surface->ReleaseBuffer(buffer, -1);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (ret == CAMERA_OK && transformTime >= 0) {
+        transformedFrames_++;
+        lastTransformTime_ = transformTime;
+        maxTransformTime_ = std::max(maxTransformTime_, transformTime);
+        totalTransformTime_ += transformTime;
+    }
+    if (isFrameDue && ret == CAMERA_OK) {
+        forwardedFrames_++;
+        windowOutputFrames_++;
+    } else {
+        skippedFrames_++;
+    }
+    UpdateFrameRateLocked(now);
+}
+
+float FrameRelay::GetAchievedFps()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return achievedFps_;
+}
+
+void FrameRelay::Release()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (surface_ != nullptr) {
+        surface_->UnregisterConsumerListener();
+        surface_ = nullptr;
+    }
+    output_ = nullptr;
+}
+
+void FrameRelay::DumpRelayInfo(std::string &dumpString)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    float targetFps = (frameInterval_ > 0) ? static_cast<float>(NANOSECONDS_PER_SECOND) / frameInterval_ : 0;
+    dumpString += "Frame Relay Target Fps:[" + std::to_string(targetFps) + "]:"
+        + " Input Fps:[" + std::to_string(inputFps_) + "]:"
+        + " Achieved Fps:[" + std::to_string(achievedFps_) + "]:"
+        + " Forwarded:[" + std::to_string(forwardedFrames_) + "]:"
+        + " Skipped:[" + std::to_string(skippedFrames_) + "]\n";
+    if (srcFormat_ != dstFormat_) {
+        dumpString += "Frame Relay Conversion:[" + std::to_string(srcFormat_) + " -> " + std::to_string(dstFormat_)
+            + "]: SIMD:[" + GetConvertSimdName() + "]\n";
+    }
+    if (rotation_ != 0 || isMirrored_) {
+        int64_t avgTransformTime = (transformedFrames_ > 0) ? totalTransformTime_ / transformedFrames_ : 0;
+        dumpString += "Frame Relay Transform Rotation:[" + std::to_string(rotation_) + "]:"
+            + " Mirrored:[" + std::to_string(isMirrored_) + "]:"
+            + " Frames:[" + std::to_string(transformedFrames_) + "]:"
+            + " Last Us:[" + std::to_string(lastTransformTime_) + "]:"
+            + " Avg Us:[" + std::to_string(avgTransformTime) + "]:"
+            + " Max Us:[" + std::to_string(maxTransformTime_) + "]\n";
+    }
+    if (outputWidth_ > 0 && outputHeight_ > 0) {
+        dumpString += "Frame Relay Scaling To:[" + std::to_string(outputWidth_) + "x" + std::to_string(outputHeight_)
+            + "]\n";
+    }
+}
+} // namespace CameraStandard
+} // namespace OHOS
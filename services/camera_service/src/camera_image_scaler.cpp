@@ -0,0 +1,403 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "camera_image_scaler.h"
+
+#include <algorithm>
+#include <vector>
+#include <securec.h>
+#include "camera_util.h"
+#include "camera_log.h"
+#include "display_type.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define CAMERA_SCALE_NEON
+#endif
+
+namespace OHOS {
+namespace CameraStandard {
+namespace {
+    constexpr int32_t RGBA_BYTES_PER_PIXEL = 4;
+    constexpr int32_t UV_BYTES_PER_PAIR = 2;
+    // Bilinear weights have 7 fractional bits so a weighted pair of 8 bit samples fits in int16
+    constexpr int32_t BILINEAR_SHIFT = 7;
+    constexpr int32_t BILINEAR_ONE = 1 << BILINEAR_SHIFT;
+    constexpr int32_t BILINEAR_ROUND = BILINEAR_ONE / 2;
+    constexpr int32_t POSITION_SHIFT = 16;
+    constexpr int32_t POSITION_TO_WEIGHT_SHIFT = POSITION_SHIFT - BILINEAR_SHIFT;
+    constexpr int64_t POSITION_HALF = 1 << (POSITION_SHIFT - 1);
+    constexpr int64_t POSITION_FRACTION_MASK = (1 << POSITION_SHIFT) - 1;
+}
+
+struct Plane {
+    uint8_t *data;
+    int32_t width;
+    int32_t height;
+    int32_t stride;
+};
+
+struct ScaleKernels {
+    // Blends two rows of bytes, weight is the share of row1 out of BILINEAR_ONE
+    void (*blendRows)(const uint8_t *row0, const uint8_t *row1, uint8_t *dst, int32_t bytes, int32_t weight);
+    // Averages each 2x2 block of pixels of two rows into one pixel
+    void (*halveRows)(const uint8_t *row0, const uint8_t *row1, uint8_t *dst, int32_t dstWidth, int32_t channels);
+};
+
+static inline uint8_t Average(uint8_t first, uint8_t second)
+{
+    return static_cast<uint8_t>((first + second + 1) >> 1);
+}
+
+static void BlendRowsScalar(const uint8_t *row0, const uint8_t *row1, uint8_t *dst, int32_t bytes, int32_t weight)
+{
+    for (int32_t i = 0; i < bytes; i++) {
+        dst[i] = static_cast<uint8_t>((row0[i] * (BILINEAR_ONE - weight) + row1[i] * weight + BILINEAR_ROUND)
+            >> BILINEAR_SHIFT);
+    }
+}
+
+static void HalveRowsScalar(const uint8_t *row0, const uint8_t *row1, uint8_t *dst, int32_t dstWidth,
+                            int32_t channels)
+{
+    // Vertical pairs first, then horizontal ones, in the order the SIMD kernels round
+    for (int32_t x = 0; x < dstWidth; x++) {
+        for (int32_t channel = 0; channel < channels; channel++) {
+            int32_t left = x * 2 * channels + channel;
+            int32_t right = left + channels;
+            dst[x * channels + channel] = Average(Average(row0[left], row1[left]), Average(row0[right], row1[right]));
+        }
+    }
+}
+
+#if defined(__SSE2__)
+static void BlendRowsSimd(const uint8_t *row0, const uint8_t *row1, uint8_t *dst, int32_t bytes, int32_t weight)
+{
+    constexpr int32_t step = 16;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i weight0 = _mm_set1_epi16(static_cast<int16_t>(BILINEAR_ONE - weight));
+    const __m128i weight1 = _mm_set1_epi16(static_cast<int16_t>(weight));
+    const __m128i round = _mm_set1_epi16(BILINEAR_ROUND);
+    int32_t i = 0;
+    for (; i + step <= bytes; i += step) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row0 + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row1 + i));
+        __m128i low = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(a, zero), weight0),
+                                    _mm_mullo_epi16(_mm_unpacklo_epi8(b, zero), weight1));
+        __m128i high = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(a, zero), weight0),
+                                     _mm_mullo_epi16(_mm_unpackhi_epi8(b, zero), weight1));
+        low = _mm_srli_epi16(_mm_add_epi16(low, round), BILINEAR_SHIFT);
+        high = _mm_srli_epi16(_mm_add_epi16(high, round), BILINEAR_SHIFT);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_packus_epi16(low, high));
+    }
+    BlendRowsScalar(row0 + i, row1 + i, dst + i, bytes - i, weight);
+}
+
+static inline __m128i HalvePairsSse2(__m128i low, __m128i high, int32_t channels)
+{
+    // low and high hold 32 bytes of vertically averaged samples, the result their 16 horizontal averages
+    if (channels == 1) {
+        const __m128i mask = _mm_set1_epi16(0x00FF);
+        __m128i lowAverage = _mm_avg_epu16(_mm_and_si128(low, mask), _mm_srli_epi16(low, 8));
+        __m128i highAverage = _mm_avg_epu16(_mm_and_si128(high, mask), _mm_srli_epi16(high, 8));
+        return _mm_packus_epi16(lowAverage, highAverage);
+    }
+    if (channels == UV_BYTES_PER_PAIR) {
+        const __m128i mask = _mm_set1_epi32(0x0000FFFF);
+        __m128i lowAverage = _mm_avg_epu8(_mm_and_si128(low, mask), _mm_srli_epi32(low, 16));
+        __m128i highAverage = _mm_avg_epu8(_mm_and_si128(high, mask), _mm_srli_epi32(high, 16));
+        // Sign extended so the saturating pack keeps the 16 bit patterns
+        lowAverage = _mm_srai_epi32(_mm_slli_epi32(lowAverage, 16), 16);
+        highAverage = _mm_srai_epi32(_mm_slli_epi32(highAverage, 16), 16);
+        return _mm_packs_epi32(lowAverage, highAverage);
+    }
+    __m128 lowPixels = _mm_castsi128_ps(low);
+    __m128 highPixels = _mm_castsi128_ps(high);
+    __m128i even = _mm_castps_si128(_mm_shuffle_ps(lowPixels, highPixels, _MM_SHUFFLE(2, 0, 2, 0)));
+    __m128i odd = _mm_castps_si128(_mm_shuffle_ps(lowPixels, highPixels, _MM_SHUFFLE(3, 1, 3, 1)));
+    return _mm_avg_epu8(even, odd);
+}
+
+static void HalveRowsSimd(const uint8_t *row0, const uint8_t *row1, uint8_t *dst, int32_t dstWidth,
+                          int32_t channels)
+{
+    constexpr int32_t step = 16;
+    int32_t bytes = dstWidth * channels;
+    int32_t i = 0;
+    for (; i + step <= bytes; i += step) {
+        const uint8_t *in0 = row0 + i * 2;
+        const uint8_t *in1 = row1 + i * 2;
+        __m128i low = _mm_avg_epu8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in0)),
+                                   _mm_loadu_si128(reinterpret_cast<const __m128i *>(in1)));
+        __m128i high = _mm_avg_epu8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in0 + step)),
+                                    _mm_loadu_si128(reinterpret_cast<const __m128i *>(in1 + step)));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), HalvePairsSse2(low, high, channels));
+    }
+    HalveRowsScalar(row0 + i * 2, row1 + i * 2, dst + i, (bytes - i) / channels, channels);
+}
+#elif defined(CAMERA_SCALE_NEON)
+static void BlendRowsSimd(const uint8_t *row0, const uint8_t *row1, uint8_t *dst, int32_t bytes, int32_t weight)
+{
+    constexpr int32_t step = 16;
+    const uint8x8_t weight0 = vdup_n_u8(static_cast<uint8_t>(BILINEAR_ONE - weight));
+    const uint8x8_t weight1 = vdup_n_u8(static_cast<uint8_t>(weight));
+    int32_t i = 0;
+    for (; i + step <= bytes; i += step) {
+        uint8x16_t a = vld1q_u8(row0 + i);
+        uint8x16_t b = vld1q_u8(row1 + i);
+        uint16x8_t low = vmlal_u8(vmull_u8(vget_low_u8(a), weight0), vget_low_u8(b), weight1);
+        uint16x8_t high = vmlal_u8(vmull_u8(vget_high_u8(a), weight0), vget_high_u8(b), weight1);
+        vst1q_u8(dst + i, vcombine_u8(vrshrn_n_u16(low, BILINEAR_SHIFT), vrshrn_n_u16(high, BILINEAR_SHIFT)));
+    }
+    BlendRowsScalar(row0 + i, row1 + i, dst + i, bytes - i, weight);
+}
+
+static void HalveRowsSimd(const uint8_t *row0, const uint8_t *row1, uint8_t *dst, int32_t dstWidth,
+                          int32_t channels)
+{
+    constexpr int32_t step = 16;
+    int32_t bytes = dstWidth * channels;
+    int32_t i = 0;
+    for (; i + step <= bytes; i += step) {
+        const uint8_t *in0 = row0 + i * 2;
+        const uint8_t *in1 = row1 + i * 2;
+        uint8x16_t even;
+        uint8x16_t odd;
+        // De-interleaving by the pixel size puts the left and right pixel of each pair in separate registers
+        if (channels == 1) {
+            uint8x16x2_t top = vld2q_u8(in0);
+            uint8x16x2_t bottom = vld2q_u8(in1);
+            even = vrhaddq_u8(top.val[0], bottom.val[0]);
+            odd = vrhaddq_u8(top.val[1], bottom.val[1]);
+        } else if (channels == UV_BYTES_PER_PAIR) {
+            uint16x8x2_t top = vld2q_u16(reinterpret_cast<const uint16_t *>(in0));
+            uint16x8x2_t bottom = vld2q_u16(reinterpret_cast<const uint16_t *>(in1));
+            even = vrhaddq_u8(vreinterpretq_u8_u16(top.val[0]), vreinterpretq_u8_u16(bottom.val[0]));
+            odd = vrhaddq_u8(vreinterpretq_u8_u16(top.val[1]), vreinterpretq_u8_u16(bottom.val[1]));
+        } else {
+            uint32x4x2_t top = vld2q_u32(reinterpret_cast<const uint32_t *>(in0));
+            uint32x4x2_t bottom = vld2q_u32(reinterpret_cast<const uint32_t *>(in1));
+            even = vrhaddq_u8(vreinterpretq_u8_u32(top.val[0]), vreinterpretq_u8_u32(bottom.val[0]));
+            odd = vrhaddq_u8(vreinterpretq_u8_u32(top.val[1]), vreinterpretq_u8_u32(bottom.val[1]));
+        }
+        vst1q_u8(dst + i, vrhaddq_u8(even, odd));
+    }
+    HalveRowsScalar(row0 + i * 2, row1 + i * 2, dst + i, (bytes - i) / channels, channels);
+}
+#endif
+
+#if defined(__SSE2__) || defined(CAMERA_SCALE_NEON)
+#define CAMERA_SCALE_SIMD
+#endif
+
+static const ScaleKernels SCALAR_KERNELS = {
+    BlendRowsScalar, HalveRowsScalar,
+};
+
+#ifdef CAMERA_SCALE_SIMD
+static const ScaleKernels SIMD_KERNELS = {
+    BlendRowsSimd, HalveRowsSimd,
+};
+#endif
+
+static const ScaleKernels &GetKernels(bool useSimd)
+{
+#ifdef CAMERA_SCALE_SIMD
+    if (useSimd) {
+        return SIMD_KERNELS;
+    }
+#endif
+    return SCALAR_KERNELS;
+}
+
+static inline int32_t ChromaSize(int32_t size)
+{
+    return (size + 1) / 2;
+}
+
+/*
+ * Maps a destination sample to the source, with sample centers aligned, as the index of the
+ * first source sample and the weight of the next one.
+ */
+static void MapSample(int32_t index, int32_t srcSize, int32_t dstSize, int32_t &srcIndex, int32_t &weight)
+{
+    int64_t position = ((2 * static_cast<int64_t>(index) + 1) * srcSize << POSITION_SHIFT)
+        / (2 * static_cast<int64_t>(dstSize)) - POSITION_HALF;
+    position = std::max<int64_t>(position, 0);
+    srcIndex = static_cast<int32_t>(position >> POSITION_SHIFT);
+    weight = static_cast<int32_t>((position & POSITION_FRACTION_MASK) >> POSITION_TO_WEIGHT_SHIFT);
+    if (srcIndex >= srcSize - 1) {
+        srcIndex = srcSize - 1;
+        weight = 0;
+    }
+}
+
+static void CopyPlane(const Plane &src, const Plane &dst, int32_t channels)
+{
+    for (int32_t row = 0; row < dst.height; row++) {
+        (void)memcpy_s(dst.data + static_cast<size_t>(row) * dst.stride, dst.width * channels,
+                       src.data + static_cast<size_t>(row) * src.stride, dst.width * channels);
+    }
+}
+
+static void HalvePlane(const Plane &src, const Plane &dst, int32_t channels, const ScaleKernels &kernels)
+{
+    for (int32_t row = 0; row < dst.height; row++) {
+        const uint8_t *row0 = src.data + static_cast<size_t>(row) * 2 * src.stride;
+        kernels.halveRows(row0, row0 + src.stride, dst.data + static_cast<size_t>(row) * dst.stride, dst.width,
+                          channels);
+    }
+}
+
+// The channel count is a constant so the per pixel loop unrolls
+template<int32_t CHANNELS>
+static void ResampleRow(const uint8_t *srcRow, uint8_t *dstRow, int32_t width, const std::vector<int32_t> &offsets,
+                        const std::vector<int32_t> &nextOffsets, const std::vector<int32_t> &weights)
+{
+    for (int32_t x = 0; x < width; x++) {
+        int32_t weight = weights[x];
+        const uint8_t *first = srcRow + offsets[x];
+        const uint8_t *second = srcRow + nextOffsets[x];
+        for (int32_t channel = 0; channel < CHANNELS; channel++) {
+            dstRow[x * CHANNELS + channel] = static_cast<uint8_t>((first[channel] * (BILINEAR_ONE - weight)
+                + second[channel] * weight + BILINEAR_ROUND) >> BILINEAR_SHIFT);
+        }
+    }
+}
+
+static void ResamplePlane(const Plane &src, const Plane &dst, int32_t channels, const ScaleKernels &kernels)
+{
+    if (src.width == dst.width && src.height == dst.height) {
+        CopyPlane(src, dst, channels);
+        return;
+    }
+    std::vector<int32_t> offsets(dst.width);
+    std::vector<int32_t> nextOffsets(dst.width);
+    std::vector<int32_t> weights(dst.width);
+    for (int32_t x = 0; x < dst.width; x++) {
+        int32_t srcX = 0;
+        MapSample(x, src.width, dst.width, srcX, weights[x]);
+        offsets[x] = srcX * channels;
+        nextOffsets[x] = std::min(srcX + 1, src.width - 1) * channels;
+    }
+    std::vector<uint8_t> blended(static_cast<size_t>(src.width) * channels);
+    for (int32_t row = 0; row < dst.height; row++) {
+        int32_t srcY = 0;
+        int32_t weight = 0;
+        MapSample(row, src.height, dst.height, srcY, weight);
+        const uint8_t *srcRow = src.data + static_cast<size_t>(srcY) * src.stride;
+        if (weight != 0) {
+            kernels.blendRows(srcRow, srcRow + src.stride, blended.data(), src.width * channels, weight);
+            srcRow = blended.data();
+        }
+        uint8_t *dstRow = dst.data + static_cast<size_t>(row) * dst.stride;
+        if (src.width == dst.width) {
+            (void)memcpy_s(dstRow, dst.width * channels, srcRow, dst.width * channels);
+            continue;
+        }
+        if (channels == 1) {
+            ResampleRow<1>(srcRow, dstRow, dst.width, offsets, nextOffsets, weights);
+        } else if (channels == UV_BYTES_PER_PAIR) {
+            ResampleRow<UV_BYTES_PER_PAIR>(srcRow, dstRow, dst.width, offsets, nextOffsets, weights);
+        } else {
+            ResampleRow<RGBA_BYTES_PER_PIXEL>(srcRow, dstRow, dst.width, offsets, nextOffsets, weights);
+        }
+    }
+}
+
+static void ScalePlane(const Plane &src, const Plane &dst, int32_t channels, const ScaleKernels &kernels)
+{
+    std::vector<uint8_t> halved[2];
+    Plane current = src;
+    int32_t index = 0;
+    while (current.width >= dst.width * 2 && current.height >= dst.height * 2) {
+        Plane next = {nullptr, current.width / 2, current.height / 2, current.width / 2 * channels};
+        halved[index].resize(static_cast<size_t>(next.stride) * next.height);
+        next.data = halved[index].data();
+        HalvePlane(current, next, channels, kernels);
+        current = next;
+        index ^= 1;
+    }
+    ResamplePlane(current, dst, channels, kernels);
+}
+
+static Plane CropPlane(const Plane &plane, int32_t x, int32_t y, int32_t width, int32_t height, int32_t channels)
+{
+    Plane cropped = plane;
+    cropped.data = plane.data + static_cast<size_t>(y) * plane.stride + static_cast<size_t>(x) * channels;
+    cropped.width = std::min(width, plane.width - x);
+    cropped.height = std::min(height, plane.height - y);
+    return cropped;
+}
+
+int32_t ScaleImage(const ImageBuffer &src, const ImageBuffer &dst, bool useSimd)
+{
+    CAMERA_SYNC_TRACE;
+    if (!IsValidImage(src) || !IsValidImage(dst) || src.format != dst.format) {
+        MEDIA_ERR_LOG("ScaleImage invalid images, format %{public}d %{public}dx%{public}d to "
+                      "format %{public}d %{public}dx%{public}d", src.format, src.width, src.height,
+                      dst.format, dst.width, dst.height);
+        return CAMERA_INVALID_ARG;
+    }
+    const ScaleKernels &kernels = GetKernels(useSimd);
+    // Center crop to the destination aspect ratio, on even offsets to keep the chroma sited
+    int32_t cropWidth = src.width;
+    int32_t cropHeight = src.height;
+    if (static_cast<int64_t>(src.width) * dst.height > static_cast<int64_t>(dst.width) * src.height) {
+        cropWidth = std::max<int32_t>(static_cast<int64_t>(src.height) * dst.width / dst.height, 1);
+    } else {
+        cropHeight = std::max<int32_t>(static_cast<int64_t>(src.width) * dst.height / dst.width, 1);
+    }
+    int32_t cropX = ((src.width - cropWidth) / 2) & ~1;
+    int32_t cropY = ((src.height - cropHeight) / 2) & ~1;
+    if (src.format == PIXEL_FMT_RGBA_8888) {
+        Plane in = {src.data, src.width, src.height, src.stride};
+        Plane out = {dst.data, dst.width, dst.height, dst.stride};
+        ScalePlane(CropPlane(in, cropX, cropY, cropWidth, cropHeight, RGBA_BYTES_PER_PIXEL), out,
+                   RGBA_BYTES_PER_PIXEL, kernels);
+        return CAMERA_OK;
+    }
+    Plane inLuma = {src.data, src.width, src.height, src.stride};
+    Plane outLuma = {dst.data, dst.width, dst.height, dst.stride};
+    ScalePlane(CropPlane(inLuma, cropX, cropY, cropWidth, cropHeight, 1), outLuma, 1, kernels);
+
+    uint8_t *inChroma = src.data + static_cast<size_t>(src.stride) * src.height;
+    uint8_t *outChroma = dst.data + static_cast<size_t>(dst.stride) * dst.height;
+    int32_t inChromaHeight = ChromaSize(src.height);
+    int32_t outChromaHeight = ChromaSize(dst.height);
+    if (src.format != PIXEL_FMT_YCBCR_420_P) {
+        // The interleaved chroma is scaled as one plane of two byte pixels
+        Plane in = {inChroma, ChromaSize(src.width), inChromaHeight, src.stride};
+        Plane out = {outChroma, ChromaSize(dst.width), outChromaHeight, dst.stride};
+        ScalePlane(CropPlane(in, cropX / 2, cropY / 2, ChromaSize(cropWidth), ChromaSize(cropHeight),
+                             UV_BYTES_PER_PAIR), out, UV_BYTES_PER_PAIR, kernels);
+        return CAMERA_OK;
+    }
+    int32_t inUVStride = src.stride / 2;
+    int32_t outUVStride = dst.stride / 2;
+    for (int32_t planeIndex = 0; planeIndex < UV_BYTES_PER_PAIR; planeIndex++) {
+        Plane in = {inChroma + static_cast<size_t>(planeIndex) * inUVStride * inChromaHeight,
+                    ChromaSize(src.width), inChromaHeight, inUVStride};
+        Plane out = {outChroma + static_cast<size_t>(planeIndex) * outUVStride * outChromaHeight,
+                     ChromaSize(dst.width), outChromaHeight, outUVStride};
+        ScalePlane(CropPlane(in, cropX / 2, cropY / 2, ChromaSize(cropWidth), ChromaSize(cropHeight), 1), out, 1,
+                   kernels);
+    }
+    return CAMERA_OK;
+}
+} // namespace CameraStandard
+} // namespace OHOS
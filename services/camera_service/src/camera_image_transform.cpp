@@ -0,0 +1,458 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "camera_image_transform.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <securec.h>
+#include "camera_util.h"
+#include "camera_log.h"
+#include "display_type.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define CAMERA_TRANSFORM_NEON
+#endif
+
+namespace OHOS {
+namespace CameraStandard {
+namespace {
+    constexpr int32_t RGBA_BYTES_PER_PIXEL = 4;
+    constexpr int32_t UV_BYTES_PER_PAIR = 2;
+    constexpr int32_t ROTATION_0 = 0;
+    constexpr int32_t ROTATION_90 = 90;
+    constexpr int32_t ROTATION_180 = 180;
+    constexpr int32_t ROTATION_270 = 270;
+    // Elements per side of a SIMD transpose tile
+    constexpr int32_t TILE_SIZE = 8;
+    // Elements per side of a cache block, its source and destination rows stay in L1 while it is transposed
+    constexpr int32_t BLOCK_SIZE = 32;
+}
+
+struct TransformKernels {
+    // Transposes a TILE_SIZE x TILE_SIZE tile of elements, a negative stride walks the rows backwards
+    void (*transposeTile)(const uint8_t *src, ptrdiff_t srcStride, uint8_t *dst, ptrdiff_t dstStride,
+                          int32_t elementSize);
+    // Writes the elements of a row in reverse order
+    void (*reverseRow)(const uint8_t *src, uint8_t *dst, int32_t count, int32_t elementSize);
+};
+
+static inline void CopyElement(const uint8_t *src, uint8_t *dst, int32_t elementSize)
+{
+    // Constant sizes so the copies compile to single loads and stores
+    switch (elementSize) {
+        case 1:
+            *dst = *src;
+            break;
+        case UV_BYTES_PER_PAIR:
+            (void)memcpy_s(dst, UV_BYTES_PER_PAIR, src, UV_BYTES_PER_PAIR);
+            break;
+        default:
+            (void)memcpy_s(dst, RGBA_BYTES_PER_PIXEL, src, RGBA_BYTES_PER_PIXEL);
+            break;
+    }
+}
+
+static void TransposeRange(const uint8_t *src, ptrdiff_t srcStride, uint8_t *dst, ptrdiff_t dstStride,
+                           int32_t rows, int32_t columns, int32_t elementSize)
+{
+    for (int32_t row = 0; row < rows; row++) {
+        const uint8_t *srcRow = src + row * srcStride;
+        for (int32_t column = 0; column < columns; column++) {
+            CopyElement(srcRow + column * elementSize, dst + column * dstStride + row * elementSize, elementSize);
+        }
+    }
+}
+
+static void TransposeTileScalar(const uint8_t *src, ptrdiff_t srcStride, uint8_t *dst, ptrdiff_t dstStride,
+                                int32_t elementSize)
+{
+    TransposeRange(src, srcStride, dst, dstStride, TILE_SIZE, TILE_SIZE, elementSize);
+}
+
+/*
+ * Transposes a RGBA tile as four 4x4 quarters, each landing at the mirrored quarter of the destination.
+ * One 4x4 transpose moves sixteen pixels with four loads and four stores instead of sixteen of each.
+ */
+static inline void TransposeDwordQuarters(const uint8_t *src, ptrdiff_t srcStride, uint8_t *dst, ptrdiff_t dstStride,
+    void (*transpose4x4)(const uint8_t *, ptrdiff_t, uint8_t *, ptrdiff_t))
+{
+    constexpr int32_t half = TILE_SIZE / 2;
+    constexpr int32_t halfBytes = half * RGBA_BYTES_PER_PIXEL;
+    transpose4x4(src, srcStride, dst, dstStride);
+    transpose4x4(src + halfBytes, srcStride, dst + half * dstStride, dstStride);
+    transpose4x4(src + half * srcStride, srcStride, dst + halfBytes, dstStride);
+    transpose4x4(src + half * srcStride + halfBytes, srcStride, dst + half * dstStride + halfBytes, dstStride);
+}
+
+static void ReverseRowScalar(const uint8_t *src, uint8_t *dst, int32_t count, int32_t elementSize)
+{
+    for (int32_t i = 0; i < count; i++) {
+        CopyElement(src + (count - 1 - i) * elementSize, dst + i * elementSize, elementSize);
+    }
+}
+
+#if defined(__SSE2__)
+static inline __m128i LoadRow(const uint8_t *src)
+{
+    return _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+}
+
+static inline void StoreRow(uint8_t *dst, __m128i row)
+{
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), row);
+}
+
+static void TransposeBytesSse2(const uint8_t *src, ptrdiff_t srcStride, uint8_t *dst, ptrdiff_t dstStride)
+{
+    __m128i rows[TILE_SIZE];
+    for (int32_t i = 0; i < TILE_SIZE; i++) {
+        rows[i] = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(src + i * srcStride));
+    }
+    // Interleaving bytes, then pairs, then quads of row pairs leaves two columns in each register
+    __m128i pairs0 = _mm_unpacklo_epi8(rows[0], rows[1]);
+    __m128i pairs1 = _mm_unpacklo_epi8(rows[2], rows[3]);
+    __m128i pairs2 = _mm_unpacklo_epi8(rows[4], rows[5]);
+    __m128i pairs3 = _mm_unpacklo_epi8(rows[6], rows[7]);
+    __m128i quads0 = _mm_unpacklo_epi16(pairs0, pairs1);
+    __m128i quads1 = _mm_unpackhi_epi16(pairs0, pairs1);
+    __m128i quads2 = _mm_unpacklo_epi16(pairs2, pairs3);
+    __m128i quads3 = _mm_unpackhi_epi16(pairs2, pairs3);
+    __m128i columns[TILE_SIZE / 2] = {
+        _mm_unpacklo_epi32(quads0, quads2), _mm_unpackhi_epi32(quads0, quads2),
+        _mm_unpacklo_epi32(quads1, quads3), _mm_unpackhi_epi32(quads1, quads3),
+    };
+    for (int32_t i = 0; i < TILE_SIZE / 2; i++) {
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(dst + (2 * i) * dstStride), columns[i]);
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(dst + (2 * i + 1) * dstStride),
+                         _mm_unpackhi_epi64(columns[i], columns[i]));
+    }
+}
+
+static void TransposeWordsSse2(const uint8_t *src, ptrdiff_t srcStride, uint8_t *dst, ptrdiff_t dstStride)
+{
+    __m128i rows[TILE_SIZE];
+    for (int32_t i = 0; i < TILE_SIZE; i++) {
+        rows[i] = LoadRow(src + i * srcStride);
+    }
+    __m128i pairs[TILE_SIZE];
+    for (int32_t i = 0; i < TILE_SIZE / 2; i++) {
+        pairs[2 * i] = _mm_unpacklo_epi16(rows[2 * i], rows[2 * i + 1]);
+        pairs[2 * i + 1] = _mm_unpackhi_epi16(rows[2 * i], rows[2 * i + 1]);
+    }
+    // Each register holds two columns of four rows, the top half of the tile first
+    __m128i quads[TILE_SIZE] = {
+        _mm_unpacklo_epi32(pairs[0], pairs[2]), _mm_unpackhi_epi32(pairs[0], pairs[2]),
+        _mm_unpacklo_epi32(pairs[1], pairs[3]), _mm_unpackhi_epi32(pairs[1], pairs[3]),
+        _mm_unpacklo_epi32(pairs[4], pairs[6]), _mm_unpackhi_epi32(pairs[4], pairs[6]),
+        _mm_unpacklo_epi32(pairs[5], pairs[7]), _mm_unpackhi_epi32(pairs[5], pairs[7]),
+    };
+    for (int32_t i = 0; i < TILE_SIZE / 2; i++) {
+        StoreRow(dst + (2 * i) * dstStride, _mm_unpacklo_epi64(quads[i], quads[i + TILE_SIZE / 2]));
+        StoreRow(dst + (2 * i + 1) * dstStride, _mm_unpackhi_epi64(quads[i], quads[i + TILE_SIZE / 2]));
+    }
+}
+
+static void TransposeDwords4x4Sse2(const uint8_t *src, ptrdiff_t srcStride, uint8_t *dst, ptrdiff_t dstStride)
+{
+    __m128i pairs0 = _mm_unpacklo_epi32(LoadRow(src), LoadRow(src + srcStride));
+    __m128i pairs1 = _mm_unpackhi_epi32(LoadRow(src), LoadRow(src + srcStride));
+    __m128i pairs2 = _mm_unpacklo_epi32(LoadRow(src + 2 * srcStride), LoadRow(src + 3 * srcStride));
+    __m128i pairs3 = _mm_unpackhi_epi32(LoadRow(src + 2 * srcStride), LoadRow(src + 3 * srcStride));
+    StoreRow(dst, _mm_unpacklo_epi64(pairs0, pairs2));
+    StoreRow(dst + dstStride, _mm_unpackhi_epi64(pairs0, pairs2));
+    StoreRow(dst + 2 * dstStride, _mm_unpacklo_epi64(pairs1, pairs3));
+    StoreRow(dst + 3 * dstStride, _mm_unpackhi_epi64(pairs1, pairs3));
+}
+
+static void TransposeTileSimd(const uint8_t *src, ptrdiff_t srcStride, uint8_t *dst, ptrdiff_t dstStride,
+                              int32_t elementSize)
+{
+    if (elementSize == 1) {
+        TransposeBytesSse2(src, srcStride, dst, dstStride);
+        return;
+    }
+    if (elementSize == UV_BYTES_PER_PAIR) {
+        TransposeWordsSse2(src, srcStride, dst, dstStride);
+        return;
+    }
+    TransposeDwordQuarters(src, srcStride, dst, dstStride, TransposeDwords4x4Sse2);
+}
+
+static inline __m128i ReverseElementsSse2(__m128i value, int32_t elementSize)
+{
+    value = _mm_shuffle_epi32(value, _MM_SHUFFLE(0, 1, 2, 3));
+    if (elementSize == RGBA_BYTES_PER_PIXEL) {
+        return value;
+    }
+    value = _mm_shufflelo_epi16(value, _MM_SHUFFLE(2, 3, 0, 1));
+    value = _mm_shufflehi_epi16(value, _MM_SHUFFLE(2, 3, 0, 1));
+    if (elementSize == UV_BYTES_PER_PAIR) {
+        return value;
+    }
+    return _mm_or_si128(_mm_slli_epi16(value, 8), _mm_srli_epi16(value, 8));
+}
+
+static void ReverseRowSimd(const uint8_t *src, uint8_t *dst, int32_t count, int32_t elementSize)
+{
+    constexpr int32_t step = 16;
+    int32_t bytes = count * elementSize;
+    int32_t i = 0;
+    for (; i + step <= bytes; i += step) {
+        StoreRow(dst + i, ReverseElementsSse2(LoadRow(src + bytes - i - step), elementSize));
+    }
+    int32_t done = i / elementSize;
+    ReverseRowScalar(src, dst + i, count - done, elementSize);
+}
+#elif defined(CAMERA_TRANSFORM_NEON)
+static void TransposeBytesNeon(const uint8_t *src, ptrdiff_t srcStride, uint8_t *dst, ptrdiff_t dstStride)
+{
+    uint8x8_t rows[TILE_SIZE];
+    for (int32_t i = 0; i < TILE_SIZE; i++) {
+        rows[i] = vld1_u8(src + i * srcStride);
+    }
+    uint8x8x2_t pairs0 = vtrn_u8(rows[0], rows[1]);
+    uint8x8x2_t pairs1 = vtrn_u8(rows[2], rows[3]);
+    uint8x8x2_t pairs2 = vtrn_u8(rows[4], rows[5]);
+    uint8x8x2_t pairs3 = vtrn_u8(rows[6], rows[7]);
+    // quadsN.val[0] holds columns N and N + 4 of four rows, val[1] columns N + 2 and N + 6
+    uint16x4x2_t quads0 = vtrn_u16(vreinterpret_u16_u8(pairs0.val[0]), vreinterpret_u16_u8(pairs1.val[0]));
+    uint16x4x2_t quads1 = vtrn_u16(vreinterpret_u16_u8(pairs0.val[1]), vreinterpret_u16_u8(pairs1.val[1]));
+    uint16x4x2_t quads2 = vtrn_u16(vreinterpret_u16_u8(pairs2.val[0]), vreinterpret_u16_u8(pairs3.val[0]));
+    uint16x4x2_t quads3 = vtrn_u16(vreinterpret_u16_u8(pairs2.val[1]), vreinterpret_u16_u8(pairs3.val[1]));
+    uint32x2x2_t columns04 = vtrn_u32(vreinterpret_u32_u16(quads0.val[0]), vreinterpret_u32_u16(quads2.val[0]));
+    uint32x2x2_t columns15 = vtrn_u32(vreinterpret_u32_u16(quads1.val[0]), vreinterpret_u32_u16(quads3.val[0]));
+    uint32x2x2_t columns26 = vtrn_u32(vreinterpret_u32_u16(quads0.val[1]), vreinterpret_u32_u16(quads2.val[1]));
+    uint32x2x2_t columns37 = vtrn_u32(vreinterpret_u32_u16(quads1.val[1]), vreinterpret_u32_u16(quads3.val[1]));
+    const uint32x2_t columns[TILE_SIZE] = {
+        columns04.val[0], columns15.val[0], columns26.val[0], columns37.val[0],
+        columns04.val[1], columns15.val[1], columns26.val[1], columns37.val[1],
+    };
+    for (int32_t i = 0; i < TILE_SIZE; i++) {
+        vst1_u8(dst + i * dstStride, vreinterpret_u8_u32(columns[i]));
+    }
+}
+
+static void TransposeWordsNeon(const uint8_t *src, ptrdiff_t srcStride, uint8_t *dst, ptrdiff_t dstStride)
+{
+    uint16x8_t rows[TILE_SIZE];
+    for (int32_t i = 0; i < TILE_SIZE; i++) {
+        rows[i] = vld1q_u16(reinterpret_cast<const uint16_t *>(src + i * srcStride));
+    }
+    uint16x8x2_t pairs0 = vtrnq_u16(rows[0], rows[1]);
+    uint16x8x2_t pairs1 = vtrnq_u16(rows[2], rows[3]);
+    uint16x8x2_t pairs2 = vtrnq_u16(rows[4], rows[5]);
+    uint16x8x2_t pairs3 = vtrnq_u16(rows[6], rows[7]);
+    // The low halves hold columns N, the high halves columns N + 4, of the top or bottom four rows
+    uint32x4x2_t top0 = vtrnq_u32(vreinterpretq_u32_u16(pairs0.val[0]), vreinterpretq_u32_u16(pairs1.val[0]));
+    uint32x4x2_t top1 = vtrnq_u32(vreinterpretq_u32_u16(pairs0.val[1]), vreinterpretq_u32_u16(pairs1.val[1]));
+    uint32x4x2_t bottom0 = vtrnq_u32(vreinterpretq_u32_u16(pairs2.val[0]), vreinterpretq_u32_u16(pairs3.val[0]));
+    uint32x4x2_t bottom1 = vtrnq_u32(vreinterpretq_u32_u16(pairs2.val[1]), vreinterpretq_u32_u16(pairs3.val[1]));
+    const uint32x4_t tops[TILE_SIZE / 2] = {top0.val[0], top1.val[0], top0.val[1], top1.val[1]};
+    const uint32x4_t bottoms[TILE_SIZE / 2] = {bottom0.val[0], bottom1.val[0], bottom0.val[1], bottom1.val[1]};
+    for (int32_t i = 0; i < TILE_SIZE / 2; i++) {
+        uint32x4_t low = vcombine_u32(vget_low_u32(tops[i]), vget_low_u32(bottoms[i]));
+        uint32x4_t high = vcombine_u32(vget_high_u32(tops[i]), vget_high_u32(bottoms[i]));
+        vst1q_u8(dst + i * dstStride, vreinterpretq_u8_u32(low));
+        vst1q_u8(dst + (i + TILE_SIZE / 2) * dstStride, vreinterpretq_u8_u32(high));
+    }
+}
+
+static void TransposeDwords4x4Neon(const uint8_t *src, ptrdiff_t srcStride, uint8_t *dst, ptrdiff_t dstStride)
+{
+    uint32x4x2_t pairs0 = vtrnq_u32(vld1q_u32(reinterpret_cast<const uint32_t *>(src)),
+                                    vld1q_u32(reinterpret_cast<const uint32_t *>(src + srcStride)));
+    uint32x4x2_t pairs1 = vtrnq_u32(vld1q_u32(reinterpret_cast<const uint32_t *>(src + 2 * srcStride)),
+                                    vld1q_u32(reinterpret_cast<const uint32_t *>(src + 3 * srcStride)));
+    vst1q_u8(dst, vreinterpretq_u8_u32(vcombine_u32(vget_low_u32(pairs0.val[0]), vget_low_u32(pairs1.val[0]))));
+    vst1q_u8(dst + dstStride,
+             vreinterpretq_u8_u32(vcombine_u32(vget_low_u32(pairs0.val[1]), vget_low_u32(pairs1.val[1]))));
+    vst1q_u8(dst + 2 * dstStride,
+             vreinterpretq_u8_u32(vcombine_u32(vget_high_u32(pairs0.val[0]), vget_high_u32(pairs1.val[0]))));
+    vst1q_u8(dst + 3 * dstStride,
+             vreinterpretq_u8_u32(vcombine_u32(vget_high_u32(pairs0.val[1]), vget_high_u32(pairs1.val[1]))));
+}
+
+static void TransposeTileSimd(const uint8_t *src, ptrdiff_t srcStride, uint8_t *dst, ptrdiff_t dstStride,
+                              int32_t elementSize)
+{
+    if (elementSize == 1) {
+        TransposeBytesNeon(src, srcStride, dst, dstStride);
+        return;
+    }
+    if (elementSize == UV_BYTES_PER_PAIR) {
+        TransposeWordsNeon(src, srcStride, dst, dstStride);
+        return;
+    }
+    TransposeDwordQuarters(src, srcStride, dst, dstStride, TransposeDwords4x4Neon);
+}
+
+static inline uint8x16_t ReverseElementsNeon(uint8x16_t value, int32_t elementSize)
+{
+    if (elementSize == 1) {
+        value = vrev64q_u8(value);
+    } else if (elementSize == UV_BYTES_PER_PAIR) {
+        value = vreinterpretq_u8_u16(vrev64q_u16(vreinterpretq_u16_u8(value)));
+    } else {
+        value = vreinterpretq_u8_u32(vrev64q_u32(vreinterpretq_u32_u8(value)));
+    }
+    return vcombine_u8(vget_high_u8(value), vget_low_u8(value));
+}
+
+static void ReverseRowSimd(const uint8_t *src, uint8_t *dst, int32_t count, int32_t elementSize)
+{
+    constexpr int32_t step = 16;
+    int32_t bytes = count * elementSize;
+    int32_t i = 0;
+    for (; i + step <= bytes; i += step) {
+        vst1q_u8(dst + i, ReverseElementsNeon(vld1q_u8(src + bytes - i - step), elementSize));
+    }
+    int32_t done = i / elementSize;
+    ReverseRowScalar(src, dst + i, count - done, elementSize);
+}
+#endif
+
+#if defined(__SSE2__) || defined(CAMERA_TRANSFORM_NEON)
+#define CAMERA_TRANSFORM_SIMD
+#endif
+
+static const TransformKernels SCALAR_KERNELS = {
+    TransposeTileScalar, ReverseRowScalar,
+};
+
+#ifdef CAMERA_TRANSFORM_SIMD
+static const TransformKernels SIMD_KERNELS = {
+    TransposeTileSimd, ReverseRowSimd,
+};
+#endif
+
+static const TransformKernels &GetKernels(bool useSimd)
+{
+#ifdef CAMERA_TRANSFORM_SIMD
+    if (useSimd) {
+        return SIMD_KERNELS;
+    }
+#endif
+    return SCALAR_KERNELS;
+}
+
+static inline int32_t ChromaSize(int32_t size)
+{
+    return (size + 1) / 2;
+}
+
+/*
+ * Transposes width x height elements, walking the frame in cache blocks so the destination rows a
+ * block writes are still cached when the next tile of the same rows is stored.
+ */
+static void TransposePlane(const uint8_t *src, ptrdiff_t srcStride, uint8_t *dst, ptrdiff_t dstStride,
+                           int32_t width, int32_t height, int32_t elementSize, const TransformKernels &kernels)
+{
+    for (int32_t blockRow = 0; blockRow < height; blockRow += BLOCK_SIZE) {
+        int32_t rowEnd = std::min(blockRow + BLOCK_SIZE, height);
+        for (int32_t blockColumn = 0; blockColumn < width; blockColumn += BLOCK_SIZE) {
+            int32_t columnEnd = std::min(blockColumn + BLOCK_SIZE, width);
+            int32_t row = blockRow;
+            for (; row + TILE_SIZE <= rowEnd; row += TILE_SIZE) {
+                int32_t column = blockColumn;
+                for (; column + TILE_SIZE <= columnEnd; column += TILE_SIZE) {
+                    kernels.transposeTile(src + row * srcStride + column * elementSize, srcStride,
+                                          dst + column * dstStride + row * elementSize, dstStride, elementSize);
+                }
+                TransposeRange(src + row * srcStride + column * elementSize, srcStride,
+                               dst + column * dstStride + row * elementSize, dstStride,
+                               TILE_SIZE, columnEnd - column, elementSize);
+            }
+            TransposeRange(src + row * srcStride + blockColumn * elementSize, srcStride,
+                           dst + blockColumn * dstStride + row * elementSize, dstStride,
+                           rowEnd - row, columnEnd - blockColumn, elementSize);
+        }
+    }
+}
+
+static void TransformPlane(const uint8_t *src, int32_t srcStride, uint8_t *dst, int32_t dstStride, int32_t width,
+                           int32_t height, int32_t elementSize, int32_t rotation, bool isMirrored,
+                           const TransformKernels &kernels)
+{
+    if (rotation == ROTATION_90 || rotation == ROTATION_270) {
+        // All four are transposes, the flips come from walking the source or destination rows backwards
+        bool isSrcFlipped = (rotation == ROTATION_90);
+        bool isDstFlipped = (isSrcFlipped == isMirrored);
+        const uint8_t *srcStart = isSrcFlipped ? src + static_cast<ptrdiff_t>(height - 1) * srcStride : src;
+        uint8_t *dstStart = isDstFlipped ? dst + static_cast<ptrdiff_t>(width - 1) * dstStride : dst;
+        TransposePlane(srcStart, isSrcFlipped ? -srcStride : srcStride, dstStart,
+                       isDstFlipped ? -dstStride : dstStride, width, height, elementSize, kernels);
+        return;
+    }
+    bool isReversed = ((rotation == ROTATION_180) != isMirrored);
+    bool isDstFlipped = (rotation == ROTATION_180);
+    for (int32_t row = 0; row < height; row++) {
+        const uint8_t *srcRow = src + static_cast<ptrdiff_t>(row) * srcStride;
+        uint8_t *dstRow = dst + static_cast<ptrdiff_t>(isDstFlipped ? height - 1 - row : row) * dstStride;
+        if (isReversed) {
+            kernels.reverseRow(srcRow, dstRow, width, elementSize);
+        } else {
+            (void)memcpy_s(dstRow, width * elementSize, srcRow, width * elementSize);
+        }
+    }
+}
+
+int32_t TransformImage(const ImageBuffer &src, const ImageBuffer &dst, int32_t rotation, bool isMirrored,
+                       bool useSimd)
+{
+    CAMERA_SYNC_TRACE;
+    bool isTransposed = (rotation == ROTATION_90 || rotation == ROTATION_270);
+    bool isValidRotation = (isTransposed || rotation == ROTATION_0 || rotation == ROTATION_180);
+    int32_t dstWidth = isTransposed ? src.height : src.width;
+    int32_t dstHeight = isTransposed ? src.width : src.height;
+    if (!isValidRotation || !IsValidImage(src) || !IsValidImage(dst) || src.format != dst.format
+        || dst.width != dstWidth || dst.height != dstHeight) {
+        MEDIA_ERR_LOG("TransformImage invalid images or rotation %{public}d, format %{public}d "
+                      "%{public}dx%{public}d to format %{public}d %{public}dx%{public}d", rotation, src.format,
+                      src.width, src.height, dst.format, dst.width, dst.height);
+        return CAMERA_INVALID_ARG;
+    }
+    const TransformKernels &kernels = GetKernels(useSimd);
+    if (src.format == PIXEL_FMT_RGBA_8888) {
+        TransformPlane(src.data, src.stride, dst.data, dst.stride, src.width, src.height, RGBA_BYTES_PER_PIXEL,
+                       rotation, isMirrored, kernels);
+        return CAMERA_OK;
+    }
+    TransformPlane(src.data, src.stride, dst.data, dst.stride, src.width, src.height, 1, rotation, isMirrored,
+                   kernels);
+    const uint8_t *srcChroma = src.data + static_cast<size_t>(src.stride) * src.height;
+    uint8_t *dstChroma = dst.data + static_cast<size_t>(dst.stride) * dst.height;
+    int32_t chromaWidth = ChromaSize(src.width);
+    int32_t chromaHeight = ChromaSize(src.height);
+    if (src.format != PIXEL_FMT_YCBCR_420_P) {
+        // The chroma pairs move as two byte elements so their order is kept
+        TransformPlane(srcChroma, src.stride, dstChroma, dst.stride, chromaWidth, chromaHeight, UV_BYTES_PER_PAIR,
+                       rotation, isMirrored, kernels);
+        return CAMERA_OK;
+    }
+    int32_t srcUVStride = src.stride / 2;
+    int32_t dstUVStride = dst.stride / 2;
+    for (int32_t planeIndex = 0; planeIndex < UV_BYTES_PER_PAIR; planeIndex++) {
+        TransformPlane(srcChroma + static_cast<size_t>(planeIndex) * srcUVStride * chromaHeight, srcUVStride,
+                       dstChroma + static_cast<size_t>(planeIndex) * dstUVStride * ChromaSize(dst.height),
+                       dstUVStride, chromaWidth, chromaHeight, 1, rotation, isMirrored, kernels);
+    }
+    return CAMERA_OK;
+}
+} // namespace CameraStandard
+} // namespace OHOS
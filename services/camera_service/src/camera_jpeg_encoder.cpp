@@ -0,0 +1,691 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "camera_jpeg_encoder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <csetjmp>
+#include <securec.h>
+#include "camera_format_converter.h"
+#include "camera_image_transform.h"
+#include "camera_util.h"
+#include "camera_log.h"
+#include "display_type.h"
+#include "istream_capture.h"
+
+extern "C" {
+#include "jpeglib.h"
+}
+
+namespace OHOS {
+namespace CameraStandard {
+namespace {
+    constexpr int32_t JPEG_STRIDE_ALIGNMENT = 8;
+    constexpr int32_t JPEG_QUEUE_SIZE = 2;
+    constexpr int32_t JPEG_MAX_STRIPS = 4;
+    // Smaller strips cost more in restart overhead than they gain in parallelism
+    constexpr int32_t JPEG_MIN_STRIP_MCU_ROWS = 4;
+    // The DRI segment stores the restart interval in 16 bits
+    constexpr int32_t JPEG_MAX_RESTART_INTERVAL = 65535;
+    constexpr int32_t JPEG_MCU_SIZE = 16;
+    constexpr int32_t JPEG_CHROMA_MCU_SIZE = 8;
+    constexpr int32_t JPEG_MIN_QUALITY = 1;
+    constexpr int32_t JPEG_MAX_QUALITY = 100;
+    constexpr size_t JPEG_MAX_PENDING_CAPTURES = 16;
+    constexpr int64_t NANOSECONDS_PER_MICROSECOND = 1000;
+    constexpr uint8_t JPEG_MARKER_PREFIX = 0xFF;
+    constexpr uint8_t JPEG_MARKER_SOI = 0xD8;
+    constexpr uint8_t JPEG_MARKER_EOI = 0xD9;
+    constexpr uint8_t JPEG_MARKER_SOF0 = 0xC0;
+    constexpr uint8_t JPEG_MARKER_SOS = 0xDA;
+    constexpr uint8_t JPEG_MARKER_RST0 = 0xD0;
+    constexpr uint8_t JPEG_MARKER_APP1 = 0xE1;
+    constexpr int32_t JPEG_RST_MARKER_COUNT = 8;
+    constexpr size_t JPEG_DEST_INITIAL_SIZE = 64 * 1024;
+    // Marker, segment length, sample precision, then the image height
+    constexpr size_t JPEG_SOF_HEIGHT_OFFSET = 5;
+    constexpr int32_t BITS_PER_BYTE = 8;
+    constexpr uint8_t BYTE_MASK = 0xFF;
+}
+
+struct JpegErrorManager {
+    jpeg_error_mgr pub;
+    jmp_buf jumpBuffer;
+};
+
+static void JpegErrorExit(j_common_ptr cinfo)
+{
+    char message[JMSG_LENGTH_MAX] = {0};
+    (*cinfo->err->format_message)(cinfo, message);
+    MEDIA_ERR_LOG("JpegEncoder libjpeg error: %{public}s", message);
+    JpegErrorManager *errorManager = reinterpret_cast<JpegErrorManager *>(cinfo->err);
+    longjmp(errorManager->jumpBuffer, 1);
+}
+
+struct VectorDestination {
+    jpeg_destination_mgr pub;
+    std::vector<uint8_t> *output;
+};
+
+static void InitVectorDestination(j_compress_ptr cinfo)
+{
+    VectorDestination *dest = reinterpret_cast<VectorDestination *>(cinfo->dest);
+    dest->output->resize(JPEG_DEST_INITIAL_SIZE);
+    dest->pub.next_output_byte = dest->output->data();
+    dest->pub.free_in_buffer = dest->output->size();
+}
+
+static boolean EmptyVectorDestination(j_compress_ptr cinfo)
+{
+    VectorDestination *dest = reinterpret_cast<VectorDestination *>(cinfo->dest);
+    size_t used = dest->output->size();
+    dest->output->resize(used * 2);
+    dest->pub.next_output_byte = dest->output->data() + used;
+    dest->pub.free_in_buffer = dest->output->size() - used;
+    return TRUE;
+}
+
+static void TermVectorDestination(j_compress_ptr cinfo)
+{
+    VectorDestination *dest = reinterpret_cast<VectorDestination *>(cinfo->dest);
+    dest->output->resize(dest->output->size() - dest->pub.free_in_buffer);
+}
+
+class JpegBufferListener : public IBufferConsumerListener {
+public:
+    explicit JpegBufferListener(const wptr<JpegEncoder> &encoder) : encoder_(encoder) {}
+    ~JpegBufferListener() = default;
+
+    void OnBufferAvailable() override
+    {
+        sptr<JpegEncoder> encoder = encoder_.promote();
+        if (encoder != nullptr) {
+            encoder->OnBufferAvailable();
+        }
+    }
+
+private:
+    wptr<JpegEncoder> encoder_;
+};
+
+static int64_t GetMonotonicTime()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static uint8_t GetExifOrientation(int32_t orientation)
+{
+    // Clockwise rotation in degrees to the EXIF orientation tag value
+    constexpr int32_t rotation90 = 90;
+    constexpr int32_t rotation180 = 180;
+    constexpr int32_t rotation270 = 270;
+    switch (orientation) {
+        case rotation90:
+            return 6;
+        case rotation180:
+            return 3;
+        case rotation270:
+            return 8;
+        default:
+            return 1;
+    }
+}
+
+static void AppendExifOrientation(std::vector<uint8_t> &jpeg, int32_t orientation)
+{
+    // APP1 with a big endian TIFF header and a single IFD0 entry for the orientation tag
+    const uint8_t exif[] = {
+        JPEG_MARKER_PREFIX, JPEG_MARKER_APP1, 0x00, 0x22,
+        'E', 'x', 'i', 'f', 0x00, 0x00,
+        'M', 'M', 0x00, 0x2A, 0x00, 0x00, 0x00, 0x08,
+        0x00, 0x01,
+        0x01, 0x12, 0x00, 0x03, 0x00, 0x00, 0x00, 0x01, 0x00, GetExifOrientation(orientation), 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+    };
+    jpeg.insert(jpeg.end(), exif, exif + sizeof(exif));
+}
+
+static bool FindScanData(const std::vector<uint8_t> &jpeg, size_t &sofOffset, size_t &scanOffset)
+{
+    // Walks the marker segments of a libjpeg output up to the start of its entropy coded data
+    size_t pos = 2;
+    sofOffset = 0;
+    while (pos + 4 <= jpeg.size()) {
+        if (jpeg[pos] != JPEG_MARKER_PREFIX) {
+            return false;
+        }
+        uint8_t marker = jpeg[pos + 1];
+        size_t length = (static_cast<size_t>(jpeg[pos + 2]) << BITS_PER_BYTE) | jpeg[pos + 3];
+        if (marker == JPEG_MARKER_SOF0) {
+            sofOffset = pos;
+        }
+        if (marker == JPEG_MARKER_SOS) {
+            scanOffset = pos + 2 + length;
+            return sofOffset != 0 && scanOffset + 2 <= jpeg.size()
+                && jpeg[jpeg.size() - 2] == JPEG_MARKER_PREFIX && jpeg[jpeg.size() - 1] == JPEG_MARKER_EOI;
+        }
+        pos += 2 + length;
+    }
+    return false;
+}
+
+static void FillMcuRow(const NV21Image &image, int32_t row, int32_t lastRow, int32_t paddedWidth,
+                       uint8_t *luma, uint8_t *cb, uint8_t *cr)
+{
+    // Copies one MCU row into planar scratch rows, replicating the last column and row as padding
+    for (int32_t i = 0; i < JPEG_MCU_SIZE; i++) {
+        int32_t srcRow = std::min(row + i, lastRow);
+        const uint8_t *src = image.luma + static_cast<int64_t>(srcRow) * image.stride;
+        uint8_t *dst = luma + i * paddedWidth;
+        (void)memcpy_s(dst, paddedWidth, src, image.width);
+        std::fill(dst + image.width, dst + paddedWidth, src[image.width - 1]);
+    }
+    int32_t chromaWidth = (image.width + 1) / 2;
+    int32_t paddedChromaWidth = paddedWidth / 2;
+    int32_t lastChromaRow = lastRow / 2;
+    for (int32_t i = 0; i < JPEG_CHROMA_MCU_SIZE; i++) {
+        int32_t srcRow = std::min(row / 2 + i, lastChromaRow);
+        const uint8_t *src = image.chroma + static_cast<int64_t>(srcRow) * image.stride;
+        for (int32_t x = 0; x < paddedChromaWidth; x++) {
+            int32_t srcX = std::min(x, chromaWidth - 1) * 2;
+            // NV21 interleaves V before U
+            cr[i * paddedChromaWidth + x] = src[srcX];
+            cb[i * paddedChromaWidth + x] = src[srcX + 1];
+        }
+    }
+}
+
+static int32_t EncodeStrip(const NV21Image &image, int32_t firstRow, int32_t rows, int32_t quality,
+                           uint32_t restartInterval, std::vector<uint8_t> &output)
+{
+    int32_t paddedWidth = (image.width + JPEG_MCU_SIZE - 1) / JPEG_MCU_SIZE * JPEG_MCU_SIZE;
+    int32_t paddedChromaWidth = paddedWidth / 2;
+    std::vector<uint8_t> lumaRows(JPEG_MCU_SIZE * paddedWidth);
+    std::vector<uint8_t> cbRows(JPEG_CHROMA_MCU_SIZE * paddedChromaWidth);
+    std::vector<uint8_t> crRows(JPEG_CHROMA_MCU_SIZE * paddedChromaWidth);
+    JSAMPROW lumaPlane[JPEG_MCU_SIZE];
+    JSAMPROW cbPlane[JPEG_CHROMA_MCU_SIZE];
+    JSAMPROW crPlane[JPEG_CHROMA_MCU_SIZE];
+    for (int32_t i = 0; i < JPEG_MCU_SIZE; i++) {
+        lumaPlane[i] = lumaRows.data() + i * paddedWidth;
+    }
+    for (int32_t i = 0; i < JPEG_CHROMA_MCU_SIZE; i++) {
+        cbPlane[i] = cbRows.data() + i * paddedChromaWidth;
+        crPlane[i] = crRows.data() + i * paddedChromaWidth;
+    }
+    JSAMPARRAY planes[] = {lumaPlane, cbPlane, crPlane};
+
+    jpeg_compress_struct cinfo;
+    JpegErrorManager errorManager;
+    VectorDestination dest;
+    dest.pub.init_destination = InitVectorDestination;
+    dest.pub.empty_output_buffer = EmptyVectorDestination;
+    dest.pub.term_destination = TermVectorDestination;
+    dest.output = &output;
+    cinfo.err = jpeg_std_error(&errorManager.pub);
+    errorManager.pub.error_exit = JpegErrorExit;
+    if (setjmp(errorManager.jumpBuffer)) {
+        jpeg_destroy_compress(&cinfo);
+        return CAMERA_UNKNOWN_ERROR;
+    }
+    jpeg_create_compress(&cinfo);
+    cinfo.dest = &dest.pub;
+    cinfo.image_width = static_cast<JDIMENSION>(image.width);
+    cinfo.image_height = static_cast<JDIMENSION>(rows);
+    cinfo.input_components = 3;
+    cinfo.in_color_space = JCS_YCbCr;
+    jpeg_set_defaults(&cinfo);
+    jpeg_set_colorspace(&cinfo, JCS_YCbCr);
+    // Standard tables keep the strips identical in everything but their entropy coded data
+    jpeg_set_quality(&cinfo, quality, TRUE);
+    cinfo.optimize_coding = FALSE;
+    cinfo.write_JFIF_header = FALSE;
+    cinfo.raw_data_in = TRUE;
+    cinfo.restart_interval = restartInterval;
+    cinfo.comp_info[0].h_samp_factor = 2;
+    cinfo.comp_info[0].v_samp_factor = 2;
+    cinfo.comp_info[1].h_samp_factor = 1;
+    cinfo.comp_info[1].v_samp_factor = 1;
+    cinfo.comp_info[2].h_samp_factor = 1;
+    cinfo.comp_info[2].v_samp_factor = 1;
+    jpeg_start_compress(&cinfo, TRUE);
+    for (int32_t row = 0; row < rows; row += JPEG_MCU_SIZE) {
+        FillMcuRow(image, firstRow + row, firstRow + rows - 1, paddedWidth,
+                   lumaRows.data(), cbRows.data(), crRows.data());
+        jpeg_write_raw_data(&cinfo, planes, JPEG_MCU_SIZE);
+    }
+    jpeg_finish_compress(&cinfo);
+    jpeg_destroy_compress(&cinfo);
+    return CAMERA_OK;
+}
+
+static int32_t StitchStrips(const std::vector<std::vector<uint8_t>> &strips, int32_t height, int32_t orientation,
+                            std::vector<uint8_t> &jpeg)
+{
+    std::vector<size_t> scanOffsets(strips.size());
+    size_t sofOffset = 0;
+    size_t totalSize = 0;
+    for (size_t i = 0; i < strips.size(); i++) {
+        size_t stripSofOffset = 0;
+        if (!FindScanData(strips[i], stripSofOffset, scanOffsets[i])) {
+            MEDIA_ERR_LOG("JpegEncoder::StitchStrips malformed strip %{public}zu", i);
+            return CAMERA_UNKNOWN_ERROR;
+        }
+        if (i == 0) {
+            sofOffset = stripSofOffset;
+        }
+        totalSize += strips[i].size();
+    }
+    jpeg.clear();
+    jpeg.reserve(totalSize);
+    jpeg.push_back(JPEG_MARKER_PREFIX);
+    jpeg.push_back(JPEG_MARKER_SOI);
+    if (orientation != 0) {
+        AppendExifOrientation(jpeg, orientation);
+    }
+    // Headers of the first strip, including the restart interval, with the height of the whole frame
+    size_t heightPos = jpeg.size() + sofOffset - 2 + JPEG_SOF_HEIGHT_OFFSET;
+    jpeg.insert(jpeg.end(), strips[0].begin() + 2, strips[0].begin() + scanOffsets[0]);
+    jpeg[heightPos] = static_cast<uint8_t>((height >> BITS_PER_BYTE) & BYTE_MASK);
+    jpeg[heightPos + 1] = static_cast<uint8_t>(height & BYTE_MASK);
+    for (size_t i = 0; i < strips.size(); i++) {
+        jpeg.insert(jpeg.end(), strips[i].begin() + scanOffsets[i], strips[i].end() - 2);
+        if (i + 1 < strips.size()) {
+            jpeg.push_back(JPEG_MARKER_PREFIX);
+            jpeg.push_back(static_cast<uint8_t>(JPEG_MARKER_RST0 + (i % JPEG_RST_MARKER_COUNT)));
+        }
+    }
+    jpeg.push_back(JPEG_MARKER_PREFIX);
+    jpeg.push_back(JPEG_MARKER_EOI);
+    return CAMERA_OK;
+}
+
+JpegEncoder::JpegEncoder(sptr<IBufferProducer> clientProducer)
+{
+    clientProducer_ = clientProducer;
+    surface_ = nullptr;
+    output_ = nullptr;
+}
+
+JpegEncoder::~JpegEncoder()
+{
+    Release();
+}
+
+int32_t JpegEncoder::Init(int32_t width, int32_t height)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (clientProducer_ != nullptr) {
+        output_ = Surface::CreateSurfaceAsProducer(clientProducer_);
+    }
+    surface_ = Surface::CreateSurfaceAsConsumer("JpegEncoder");
+    sptr<IBufferConsumerListener> listener = new(std::nothrow) JpegBufferListener(this);
+    if (output_ == nullptr || surface_ == nullptr || listener == nullptr) {
+        MEDIA_ERR_LOG("JpegEncoder::Init failed to create encoder surfaces");
+        output_ = nullptr;
+        surface_ = nullptr;
+        return CAMERA_ALLOC_ERROR;
+    }
+    surface_->SetDefaultWidthAndHeight(width, height);
+    surface_->SetQueueSize(JPEG_QUEUE_SIZE);
+    surface_->RegisterConsumerListener(listener);
+    StartWorkers();
+    return CAMERA_OK;
+}
+
+sptr<IBufferProducer> JpegEncoder::GetProducer()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (surface_ == nullptr) {
+        return nullptr;
+    }
+    return surface_->GetProducer();
+}
+
+void JpegEncoder::QueueCapture(int32_t captureId, int32_t frameCount, int32_t quality, int32_t orientation,
+                               bool isMirrored)
+{
+    std::lock_guard<std::mutex> lock(captureLock_);
+    if (pendingCaptures_.size() >= JPEG_MAX_PENDING_CAPTURES) {
+        // The HDI dropped frames of older captures, their settings would never be consumed
+        pendingCaptures_.pop_front();
+    }
+    pendingCaptures_.push_back({captureId, frameCount, std::clamp(quality, JPEG_MIN_QUALITY, JPEG_MAX_QUALITY),
+                                orientation, isMirrored, GetMonotonicTime()});
+}
+
+void JpegEncoder::DropCapture(int32_t captureId)
+{
+    std::lock_guard<std::mutex> lock(captureLock_);
+    pendingCaptures_.erase(std::remove_if(pendingCaptures_.begin(), pendingCaptures_.end(),
+        [captureId](const PendingCapture &capture) { return capture.captureId == captureId; }),
+        pendingCaptures_.end());
+    if (lastCapture_.captureId == captureId) {
+        lastCapture_.isEnded = true;
+    }
+}
+
+void JpegEncoder::EndCapture(int32_t captureId)
+{
+    std::lock_guard<std::mutex> lock(captureLock_);
+    for (auto &capture : pendingCaptures_) {
+        if (capture.captureId == captureId) {
+            capture.isEnded = true;
+        }
+    }
+    if (lastCapture_.captureId == captureId) {
+        lastCapture_.isEnded = true;
+    }
+}
+
+bool JpegEncoder::NextCapture(PendingCapture &capture)
+{
+    std::lock_guard<std::mutex> lock(captureLock_);
+    while (!pendingCaptures_.empty()) {
+        PendingCapture &pending = pendingCaptures_.front();
+        if (pending.remainingFrames == CONTINUOUS_CAPTURE_FRAME_COUNT && pendingCaptures_.size() > 1) {
+            // A continuous capture ends once a later capture is queued behind it
+            pendingCaptures_.pop_front();
+            continue;
+        }
+        lastCapture_ = pending;
+        if (pending.remainingFrames != CONTINUOUS_CAPTURE_FRAME_COUNT && --pending.remainingFrames <= 0) {
+            pendingCaptures_.pop_front();
+        }
+        capture = lastCapture_;
+        return true;
+    }
+    // A frame nobody asked for, encode it with the settings of the previous one unless that one is over
+    capture = lastCapture_;
+    return !lastCapture_.isEnded;
+}
+
+void JpegEncoder::StartWorkers()
+{
+    std::lock_guard<std::mutex> lock(workerLock_);
+    if (!workers_.empty()) {
+        return;
+    }
+    int32_t workerCount = std::clamp(static_cast<int32_t>(std::thread::hardware_concurrency()), 1, JPEG_MAX_STRIPS);
+    isWorkerStopped_ = false;
+    for (int32_t i = 0; i < workerCount; i++) {
+        workers_.emplace_back(&JpegEncoder::WorkerLoop, this);
+    }
+}
+
+void JpegEncoder::StopWorkers()
+{
+    std::vector<std::thread> workers;
+    {
+        std::lock_guard<std::mutex> lock(workerLock_);
+        isWorkerStopped_ = true;
+        workers.swap(workers_);
+    }
+    workerCond_.notify_all();
+    for (auto &worker : workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+void JpegEncoder::WorkerLoop()
+{
+    while (true) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(workerLock_);
+            workerCond_.wait(lock, [this] { return isWorkerStopped_ || !jobs_.empty(); });
+            if (jobs_.empty()) {
+                return;
+            }
+            job = std::move(jobs_.front());
+            jobs_.pop_front();
+        }
+        job();
+    }
+}
+
+void JpegEncoder::RunParallel(std::vector<std::function<void()>> &jobs)
+{
+    std::unique_lock<std::mutex> lock(workerLock_);
+    if (workers_.empty()) {
+        lock.unlock();
+        for (auto &job : jobs) {
+            job();
+        }
+        return;
+    }
+    std::mutex doneLock;
+    std::condition_variable doneCond;
+    size_t remaining = jobs.size();
+    for (auto &job : jobs) {
+        jobs_.emplace_back([&job, &doneLock, &doneCond, &remaining]() {
+            job();
+            std::lock_guard<std::mutex> doneGuard(doneLock);
+            if (--remaining == 0) {
+                doneCond.notify_one();
+            }
+        });
+    }
+    lock.unlock();
+    workerCond_.notify_all();
+    std::unique_lock<std::mutex> doneGuard(doneLock);
+    doneCond.wait(doneGuard, [&remaining] { return remaining == 0; });
+}
+
+int32_t JpegEncoder::Encode(const NV21Image &image, int32_t quality, int32_t orientation, std::vector<uint8_t> &jpeg,
+                            bool isStriped)
+{
+    CAMERA_SYNC_TRACE;
+    if (image.luma == nullptr || image.chroma == nullptr || image.width <= 0 || image.height <= 0
+        || image.stride < image.width) {
+        return CAMERA_INVALID_ARG;
+    }
+    int32_t mcuRows = (image.height + JPEG_MCU_SIZE - 1) / JPEG_MCU_SIZE;
+    int32_t mcuColumns = (image.width + JPEG_MCU_SIZE - 1) / JPEG_MCU_SIZE;
+    int32_t stripCount = isStriped ? std::clamp(mcuRows / JPEG_MIN_STRIP_MCU_ROWS, 1, JPEG_MAX_STRIPS) : 1;
+    int32_t stripMcuRows = (mcuRows + stripCount - 1) / stripCount;
+    if (stripCount > 1) {
+        // Very large frames get more strips than JPEG_MAX_STRIPS to keep the interval encodable
+        stripMcuRows = std::min(stripMcuRows, std::max(JPEG_MAX_RESTART_INTERVAL / mcuColumns, 1));
+    }
+    stripCount = (mcuRows + stripMcuRows - 1) / stripMcuRows;
+    // Every strip but the last holds exactly one restart interval, so the encoder never emits
+    // a restart marker inside a strip and the stitched markers line up with the interval.
+    // A single strip is encoded without restart markers
+    uint32_t restartInterval = (stripCount > 1) ? static_cast<uint32_t>(stripMcuRows * mcuColumns) : 0;
+    quality = std::clamp(quality, JPEG_MIN_QUALITY, JPEG_MAX_QUALITY);
+
+    std::vector<std::vector<uint8_t>> strips(stripCount);
+    std::vector<int32_t> results(stripCount, CAMERA_OK);
+    std::vector<std::function<void()>> jobs;
+    for (int32_t i = 0; i < stripCount; i++) {
+        int32_t firstRow = i * stripMcuRows * JPEG_MCU_SIZE;
+        int32_t rows = std::min(stripMcuRows * JPEG_MCU_SIZE, image.height - firstRow);
+        jobs.emplace_back([&image, &strips, &results, i, firstRow, rows, quality, restartInterval]() {
+            results[i] = EncodeStrip(image, firstRow, rows, quality, restartInterval, strips[i]);
+        });
+    }
+    RunParallel(jobs);
+    for (int32_t i = 0; i < stripCount; i++) {
+        if (results[i] != CAMERA_OK) {
+            MEDIA_ERR_LOG("JpegEncoder::Encode failed to encode strip %{public}d", i);
+            return results[i];
+        }
+    }
+    return StitchStrips(strips, image.height, orientation, jpeg);
+}
+
+int32_t JpegEncoder::WriteToClient(const std::vector<uint8_t> &jpeg, int32_t width, int32_t height,
+                                   int64_t timestamp)
+{
+    if (output_ == nullptr) {
+        return CAMERA_INVALID_STATE;
+    }
+    BufferRequestConfig requestConfig = {
+        .width = width,
+        .height = height,
+        .strideAlignment = JPEG_STRIDE_ALIGNMENT,
+        .format = PIXEL_FMT_YCRCB_420_SP,
+        .usage = HBM_USE_CPU_READ | HBM_USE_CPU_WRITE | HBM_USE_MEM_DMA,
+        .timeout = 0,
+    };
+    sptr<SurfaceBuffer> outputBuffer = nullptr;
+    int32_t releaseFence = -1;
+    SurfaceError surfaceRet = output_->RequestBuffer(outputBuffer, releaseFence, requestConfig);
+    if (surfaceRet != SURFACE_ERROR_OK || outputBuffer == nullptr) {
+        MEDIA_ERR_LOG("JpegEncoder::WriteToClient Failed to request output buffer: %{public}d", surfaceRet);
+        return CAMERA_STREAM_BUFFER_LOST;
+    }
+    if (memcpy_s(outputBuffer->GetVirAddr(), outputBuffer->GetSize(), jpeg.data(), jpeg.size()) != EOK) {
+        MEDIA_ERR_LOG("JpegEncoder::WriteToClient jpeg of %{public}zu bytes does not fit the output buffer",
+                      jpeg.size());
+        output_->CancelBuffer(outputBuffer);
+        return CAMERA_UNKNOWN_ERROR;
+    }
+    outputBuffer->GetExtraData()->ExtraSet("dataSize", static_cast<int32_t>(jpeg.size()));
+    BufferFlushConfig flushConfig = {
+        .damage = {
+            .x = 0,
+            .y = 0,
+            .w = width,
+            .h = height,
+        },
+        .timestamp = timestamp,
+    };
+    output_->FlushBuffer(outputBuffer, -1, flushConfig);
+    return CAMERA_OK;
+}
+
+void JpegEncoder::OnBufferAvailable()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (surface_ == nullptr) {
+        return;
+    }
+    int32_t fence = -1;
+    int64_t timestamp = 0;
+    OHOS::Rect damage;
+    sptr<SurfaceBuffer> buffer = nullptr;
+    SurfaceError surfaceRet = surface_->AcquireBuffer(buffer, fence, timestamp, damage);
+    if (surfaceRet != SURFACE_ERROR_OK || buffer == nullptr) {
+        MEDIA_ERR_LOG("JpegEncoder::OnBufferAvailable Failed to acquire surface buffer");
+        return;
+    }
+    PendingCapture capture;
+    if (!NextCapture(capture)) {
+        surface_->ReleaseBuffer(buffer, -1);
+        std::lock_guard<std::mutex> statsLock(statsLock_);
+        droppedFrames_++;
+        MEDIA_DEBUG_LOG("JpegEncoder::OnBufferAvailable dropped a late frame of capture ID: %{public}d",
+                        capture.captureId);
+        return;
+    }
+    int64_t startTime = GetMonotonicTime();
+    NV21Image image = {
+        .luma = static_cast<const uint8_t *>(buffer->GetVirAddr()),
+        .chroma = nullptr,
+        .width = buffer->GetWidth(),
+        .height = buffer->GetHeight(),
+        .stride = buffer->GetStride(),
+    };
+    uint64_t lumaSize = static_cast<uint64_t>(image.stride) * image.height;
+    if (image.luma != nullptr && lumaSize + lumaSize / 2 <= buffer->GetSize()) {
+        image.chroma = image.luma + lumaSize;
+    }
+    bool isMirrored = false;
+    int64_t mirrorTime = 0;
+    if (capture.isMirrored && image.chroma != nullptr) {
+        int64_t mirrorStart = GetMonotonicTime();
+        int32_t mirrorStride = (image.width + 1) & ~1;
+        ImageBuffer src = {const_cast<uint8_t *>(image.luma), buffer->GetSize(), PIXEL_FMT_YCRCB_420_SP,
+                           image.width, image.height, image.stride};
+        mirrorBuffer_.resize(GetImageSize(PIXEL_FMT_YCRCB_420_SP, mirrorStride, image.height));
+        ImageBuffer mirrored = {mirrorBuffer_.data(), mirrorBuffer_.size(), PIXEL_FMT_YCRCB_420_SP,
+                                image.width, image.height, mirrorStride};
+        if (TransformImage(src, mirrored, 0, true) == CAMERA_OK) {
+            image.luma = mirrored.data;
+            image.chroma = mirrored.data + static_cast<size_t>(mirrorStride) * image.height;
+            image.stride = mirrorStride;
+            isMirrored = true;
+            mirrorTime = (GetMonotonicTime() - mirrorStart) / NANOSECONDS_PER_MICROSECOND;
+        }
+    }
+    std::vector<uint8_t> jpeg;
+    int32_t ret = Encode(image, capture.quality, capture.orientation, jpeg);
+    if (ret == CAMERA_OK) {
+        ret = WriteToClient(jpeg, image.width, image.height, timestamp);
+    }
+    surface_->ReleaseBuffer(buffer, -1);
+    int64_t endTime = GetMonotonicTime();
+
+    std::lock_guard<std::mutex> statsLock(statsLock_);
+    if (ret != CAMERA_OK) {
+        failedPhotos_++;
+        MEDIA_ERR_LOG("JpegEncoder::OnBufferAvailable failed to encode photo of capture ID: %{public}d, "
+                      "ret: %{public}d", capture.captureId, ret);
+        return;
+    }
+    encodedPhotos_++;
+    if (isMirrored) {
+        mirroredPhotos_++;
+        lastMirrorTime_ = mirrorTime;
+    }
+    lastEncodeTime_ = (endTime - startTime) / NANOSECONDS_PER_MICROSECOND;
+    maxEncodeTime_ = std::max(maxEncodeTime_, lastEncodeTime_);
+    totalEncodeTime_ += lastEncodeTime_;
+    if (capture.requestTime > 0) {
+        lastCaptureLatency_ = (endTime - capture.requestTime) / NANOSECONDS_PER_MICROSECOND;
+    }
+    MEDIA_INFO_LOG("JpegEncoder::OnBufferAvailable capture ID: %{public}d encoded %{public}dx%{public}d "
+                   "to %{public}zu bytes in %{public}s us, %{public}s us after the request",
+                   capture.captureId, image.width, image.height, jpeg.size(),
+                   std::to_string(lastEncodeTime_).c_str(), std::to_string(lastCaptureLatency_).c_str());
+}
+
+void JpegEncoder::Release()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (surface_ != nullptr) {
+            surface_->UnregisterConsumerListener();
+            surface_ = nullptr;
+        }
+        output_ = nullptr;
+    }
+    StopWorkers();
+}
+
+void JpegEncoder::DumpEncoderInfo(std::string &dumpString)
+{
+    std::lock_guard<std::mutex> lock(statsLock_);
+    int64_t avgEncodeTime = (encodedPhotos_ > 0) ? totalEncodeTime_ / encodedPhotos_ : 0;
+    dumpString += "Jpeg Encoder Photos:[" + std::to_string(encodedPhotos_) + "]:"
+        + " Failed:[" + std::to_string(failedPhotos_) + "]:"
+        + " Dropped Frames:[" + std::to_string(droppedFrames_) + "]:"
+        + " Last Encode Us:[" + std::to_string(lastEncodeTime_) + "]:"
+        + " Avg Encode Us:[" + std::to_string(avgEncodeTime) + "]:"
+        + " Max Encode Us:[" + std::to_string(maxEncodeTime_) + "]:"
+        + " Last Capture Latency Us:[" + std::to_string(lastCaptureLatency_) + "]\n";
+    if (mirroredPhotos_ > 0) {
+        dumpString += "Jpeg Encoder Mirrored Photos:[" + std::to_string(mirroredPhotos_) + "]:"
+            + " Last Mirror Us:[" + std::to_string(lastMirrorTime_) + "]\n";
+    }
+}
+} // namespace CameraStandard
+} // namespace OHOS
@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "camera_latency_stats.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace OHOS {
+namespace CameraStandard {
+namespace {
+    const char *LATENCY_STAGE_NAMES[LATENCY_STAGE_COUNT] = {
+        "OpenCamera",
+        "GetStreamOperator",
+        "IsStreamsSupported",
+        "CreateStreams",
+        "CommitStreams",
+        "Capture",
+        "CancelCapture",
+        "UpdateSettings",
+        "FirstFrame",
+        "ShutterToCaptureEnded",
+    };
+    constexpr double PERCENTILE_MAX = 100.0;
+    const double DUMP_PERCENTILES[] = {50.0, 90.0, 99.0};
+}
+
+static uint32_t GetHighestBit(uint64_t value)
+{
+    uint32_t bit = 0;
+    while (value >>= 1) {
+        bit++;
+    }
+    return bit;
+}
+
+size_t LatencyHistogram::GetBucketIndex(uint64_t valueUs)
+{
+    if (valueUs < LINEAR_BUCKET_COUNT) {
+        return static_cast<size_t>(valueUs);
+    }
+    // The top SUB_BUCKET_BITS + 1 bits select the bucket within the power of two
+    uint32_t highestBit = GetHighestBit(valueUs);
+    uint32_t shift = highestBit - SUB_BUCKET_BITS;
+    return LINEAR_BUCKET_COUNT + (highestBit - LINEAR_BITS) * SUB_BUCKET_COUNT
+        + static_cast<size_t>((valueUs >> shift) - SUB_BUCKET_COUNT);
+}
+
+uint64_t LatencyHistogram::GetBucketUpperBound(size_t index)
+{
+    if (index < LINEAR_BUCKET_COUNT) {
+        return index;
+    }
+    size_t octave = (index - LINEAR_BUCKET_COUNT) / SUB_BUCKET_COUNT;
+    size_t subBucket = (index - LINEAR_BUCKET_COUNT) % SUB_BUCKET_COUNT;
+    uint32_t shift = static_cast<uint32_t>(octave) + LINEAR_BITS - SUB_BUCKET_BITS;
+    return ((static_cast<uint64_t>(SUB_BUCKET_COUNT + subBucket) + 1) << shift) - 1;
+}
+
+void LatencyHistogram::Record(uint64_t valueUs)
+{
+    counts_[GetBucketIndex(std::min(valueUs, MAX_TRACKABLE_US))]++;
+    min_ = (count_ == 0) ? valueUs : std::min(min_, valueUs);
+    max_ = std::max(max_, valueUs);
+    sum_ += valueUs;
+    count_++;
+}
+
+uint64_t LatencyHistogram::GetCount() const
+{
+    return count_;
+}
+
+uint64_t LatencyHistogram::GetMin() const
+{
+    return min_;
+}
+
+uint64_t LatencyHistogram::GetMax() const
+{
+    return max_;
+}
+
+uint64_t LatencyHistogram::GetMean() const
+{
+    return (count_ == 0) ? 0 : sum_ / count_;
+}
+
+uint64_t LatencyHistogram::GetPercentile(double percentile) const
+{
+    if (count_ == 0) {
+        return 0;
+    }
+    percentile = std::clamp(percentile, 0.0, PERCENTILE_MAX);
+    uint64_t rank = static_cast<uint64_t>(std::ceil(percentile / PERCENTILE_MAX * count_));
+    rank = std::max<uint64_t>(rank, 1);
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; i++) {
+        seen += counts_[i];
+        if (seen >= rank) {
+            return std::clamp(GetBucketUpperBound(i), min_, max_);
+        }
+    }
+    return max_;
+}
+
+CameraLatencyStats &CameraLatencyStats::GetInstance()
+{
+    // Never destroyed, HDI callbacks may still record while the process exits
+    static CameraLatencyStats *instance = new CameraLatencyStats();
+    return *instance;
+}
+
+int64_t CameraLatencyStats::GetTimestampUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void CameraLatencyStats::Record(const std::string &cameraId, LatencyStage stage, int64_t startUs)
+{
+    int64_t elapsed = GetTimestampUs() - startUs;
+    RecordDuration(cameraId, stage, static_cast<uint64_t>(std::max<int64_t>(elapsed, 0)));
+}
+
+void CameraLatencyStats::RecordDuration(const std::string &cameraId, LatencyStage stage, uint64_t durationUs)
+{
+    if (stage >= LATENCY_STAGE_COUNT) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(statsLock_);
+    histograms_[cameraId][stage].Record(durationUs);
+}
+
+bool CameraLatencyStats::GetHistogram(const std::string &cameraId, LatencyStage stage, LatencyHistogram &histogram)
+{
+    std::lock_guard<std::mutex> lock(statsLock_);
+    auto it = histograms_.find(cameraId);
+    if (stage >= LATENCY_STAGE_COUNT || it == histograms_.end()) {
+        return false;
+    }
+    histogram = it->second[stage];
+    return true;
+}
+
+void CameraLatencyStats::Reset()
+{
+    std::lock_guard<std::mutex> lock(statsLock_);
+    histograms_.clear();
+}
+
+void CameraLatencyStats::Dump(std::string &dumpString)
+{
+    std::lock_guard<std::mutex> lock(statsLock_);
+    if (histograms_.empty()) {
+        dumpString += "# No latency recorded\n";
+        return;
+    }
+    for (const auto &camera : histograms_) {
+        dumpString += "# Camera ID:[" + camera.first + "]: latency in us\n";
+        for (uint32_t stage = 0; stage < LATENCY_STAGE_COUNT; stage++) {
+            const LatencyHistogram &histogram = camera.second[stage];
+            if (histogram.GetCount() == 0) {
+                continue;
+            }
+            dumpString += "    " + std::string(LATENCY_STAGE_NAMES[stage])
+                + ": Count:[" + std::to_string(histogram.GetCount())
+                + "]:    Min:[" + std::to_string(histogram.GetMin()) + "]:";
+            for (double percentile : DUMP_PERCENTILES) {
+                dumpString += "    P" + std::to_string(static_cast<int32_t>(percentile))
+                    + ":[" + std::to_string(histogram.GetPercentile(percentile)) + "]:";
+            }
+            dumpString += "    Max:[" + std::to_string(histogram.GetMax())
+                + "]:    Mean:[" + std::to_string(histogram.GetMean()) + "]:\n";
+        }
+    }
+}
+} // namespace CameraStandard
+} // namespace OHOS
@@ -0,0 +1,257 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "camera_result_reader.h"
+
+#include <algorithm>
+#include "camera_metadata_info.h"
+#include "securec.h"
+
+namespace OHOS {
+namespace CameraStandard {
+namespace {
+    // Item count, item capacity and data capacity
+    constexpr size_t RESULT_HEADER_FIELDS = 3;
+    // Index, tag, data type and count
+    constexpr size_t ITEM_HEADER_FIELDS = 4;
+}
+
+static size_t GetTypeSize(uint32_t dataType)
+{
+    switch (dataType) {
+        case META_TYPE_BYTE:
+            return sizeof(uint8_t);
+        case META_TYPE_INT32:
+            return sizeof(int32_t);
+        case META_TYPE_UINT32:
+            return sizeof(uint32_t);
+        case META_TYPE_FLOAT:
+            return sizeof(float);
+        case META_TYPE_INT64:
+            return sizeof(int64_t);
+        case META_TYPE_DOUBLE:
+            return sizeof(double);
+        case META_TYPE_RATIONAL:
+            return sizeof(camera_rational_t);
+        default:
+            return 0;
+    }
+}
+
+static uint32_t ReadField(const uint8_t *data)
+{
+    uint32_t value = 0;
+    (void)memcpy_s(&value, sizeof(value), data, sizeof(value));
+    return value;
+}
+
+CameraResultReader::CameraResultReader(const std::vector<uint8_t> &result) : result_(result)
+{
+    // An empty metadata is serialized as a single zero byte
+    if (result_.size() < RESULT_HEADER_FIELDS * sizeof(uint32_t)) {
+        isValid_ = (result_.size() == 1 && result_[0] == 0);
+        return;
+    }
+    const uint8_t *data = result_.data();
+    itemCount_ = ReadField(data);
+    itemCapacity_ = ReadField(data + sizeof(uint32_t));
+    dataCapacity_ = ReadField(data + sizeof(uint32_t) * 2);
+    nextOffset_ = RESULT_HEADER_FIELDS * sizeof(uint32_t);
+    isValid_ = true;
+}
+
+bool CameraResultReader::IsValid() const
+{
+    return isValid_;
+}
+
+bool CameraResultReader::ValidateItems()
+{
+    ResultItem item;
+    Rewind();
+    bool hasItem = Next(item);
+    while (hasItem) {
+        hasItem = Next(item);
+    }
+    Rewind();
+    return isValid_;
+}
+
+uint32_t CameraResultReader::GetItemCount() const
+{
+    return itemCount_;
+}
+
+uint32_t CameraResultReader::GetItemCapacity() const
+{
+    return itemCapacity_;
+}
+
+uint32_t CameraResultReader::GetDataCapacity() const
+{
+    return dataCapacity_;
+}
+
+void CameraResultReader::Rewind()
+{
+    nextIndex_ = 0;
+    nextOffset_ = RESULT_HEADER_FIELDS * sizeof(uint32_t);
+}
+
+bool CameraResultReader::Next(ResultItem &item)
+{
+    constexpr size_t itemHeaderSize = ITEM_HEADER_FIELDS * sizeof(uint32_t);
+    if (!isValid_ || nextIndex_ >= itemCount_) {
+        return false;
+    }
+    if (result_.size() - nextOffset_ < itemHeaderSize) {
+        isValid_ = false;
+        return false;
+    }
+    const uint8_t *header = result_.data() + nextOffset_;
+    item.tag = ReadField(header + sizeof(uint32_t));
+    item.dataType = ReadField(header + sizeof(uint32_t) * 2);
+    item.count = ReadField(header + sizeof(uint32_t) * 3);
+    size_t typeSize = GetTypeSize(item.dataType);
+    size_t available = result_.size() - nextOffset_ - itemHeaderSize;
+    if (typeSize == 0 || item.count > available / typeSize) {
+        isValid_ = false;
+        return false;
+    }
+    item.data = header + itemHeaderSize;
+    item.dataSize = typeSize * item.count;
+    item.offset = nextOffset_;
+    item.size = itemHeaderSize + item.dataSize;
+    nextOffset_ += item.size;
+    nextIndex_++;
+    return true;
+}
+
+bool CameraResultReader::Find(uint32_t tag, ResultItem &item)
+{
+    Rewind();
+    while (Next(item)) {
+        if (item.tag == tag) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool CameraResultReader::FindByte(uint32_t tag, uint8_t &value)
+{
+    ResultItem item;
+    if (!Find(tag, item) || item.dataType != META_TYPE_BYTE || item.count == 0) {
+        return false;
+    }
+    value = item.data[0];
+    return true;
+}
+
+static void WriteResultHeader(uint32_t itemCount, uint32_t itemCapacity, uint32_t dataCapacity,
+                              std::vector<uint8_t> &result)
+{
+    uint32_t header[RESULT_HEADER_FIELDS] = {itemCount, itemCapacity, dataCapacity};
+    (void)memcpy_s(result.data(), sizeof(header), header, sizeof(header));
+}
+
+static bool IsUnchanged(const std::vector<uint8_t> &result, const ResultItem &item, const ResultValues &lastValues,
+                        ResultValues &changedValues)
+{
+    // The index of an item is its position in one result, the rest must match
+    auto begin = result.begin() + item.offset + sizeof(uint32_t);
+    auto end = result.begin() + item.offset + item.size;
+    auto it = lastValues.find(item.tag);
+    if (it != lastValues.end() && it->second.size() == static_cast<size_t>(end - begin)
+        && std::equal(begin, end, it->second.begin())) {
+        return true;
+    }
+    changedValues[item.tag].assign(begin, end);
+    return false;
+}
+
+static uint32_t CopyResultItems(const std::vector<uint8_t> &result, const std::set<int32_t> *tags,
+                                const ResultValues *lastValues, ResultValues *changedValues,
+                                std::vector<uint8_t> &copied)
+{
+    CameraResultReader reader(result);
+    if (!reader.IsValid() || reader.GetItemCount() == 0) {
+        return 0;
+    }
+    // Reused by the caller, keeps its capacity across results
+    copied.resize(RESULT_HEADER_FIELDS * sizeof(uint32_t));
+    uint32_t itemCount = 0;
+    ResultItem item;
+    while (reader.Next(item)) {
+        if (tags != nullptr && tags->find(static_cast<int32_t>(item.tag)) == tags->end()) {
+            continue;
+        }
+        if (lastValues != nullptr && IsUnchanged(result, item, *lastValues, *changedValues)) {
+            continue;
+        }
+        copied.insert(copied.end(), result.begin() + item.offset, result.begin() + item.offset + item.size);
+        itemCount++;
+    }
+    if (!reader.IsValid()) {
+        if (changedValues != nullptr) {
+            changedValues->clear();
+        }
+        return 0;
+    }
+    // The capacities of the whole result still bound the subset decoded by the client
+    WriteResultHeader(itemCount, reader.GetItemCapacity(), reader.GetDataCapacity(), copied);
+    return itemCount;
+}
+
+uint32_t FilterResult(const std::vector<uint8_t> &result, const std::set<int32_t> &tags,
+                      std::vector<uint8_t> &filtered)
+{
+    return CopyResultItems(result, &tags, nullptr, nullptr, filtered);
+}
+
+uint32_t DiffResult(const std::vector<uint8_t> &result, const std::set<int32_t> *tags,
+                    const ResultValues &lastValues, std::vector<uint8_t> &changed, ResultValues &changedValues)
+{
+    changedValues.clear();
+    return CopyResultItems(result, tags, &lastValues, &changedValues, changed);
+}
+
+void CommitResultValues(ResultValues &changedValues, ResultValues &lastValues)
+{
+    for (auto &value : changedValues) {
+        lastValues[value.first] = std::move(value.second);
+    }
+    changedValues.clear();
+}
+
+void BuildResultSnapshot(const ResultValues &values, std::vector<uint8_t> &snapshot)
+{
+    constexpr size_t dataAlignment = 8;
+    snapshot.resize(RESULT_HEADER_FIELDS * sizeof(uint32_t));
+    uint32_t index = 0;
+    size_t dataCapacity = 0;
+    for (const auto &value : values) {
+        const uint8_t *indexBytes = reinterpret_cast<const uint8_t *>(&index);
+        snapshot.insert(snapshot.end(), indexBytes, indexBytes + sizeof(index));
+        snapshot.insert(snapshot.end(), value.second.begin(), value.second.end());
+        size_t dataSize = value.second.size() - (ITEM_HEADER_FIELDS - 1) * sizeof(uint32_t);
+        // Enough for the decoder to place every item out of line, rounded up like it does
+        dataCapacity += (dataSize + dataAlignment - 1) / dataAlignment * dataAlignment;
+        index++;
+    }
+    WriteResultHeader(index, index, static_cast<uint32_t>(dataCapacity), snapshot);
+}
+} // namespace CameraStandard
+} // namespace OHOS
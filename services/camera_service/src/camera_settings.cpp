@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "camera_settings.h"
+
+#include <algorithm>
+#include <cstring>
+#include "camera_util.h"
+#include "camera_log.h"
+#include "metadata_utils.h"
+
+namespace OHOS {
+namespace CameraStandard {
+static const size_t MIN_SETTINGS_ITEM_CAPACITY = 8;
+static const size_t MIN_SETTINGS_DATA_CAPACITY = 64;
+
+static size_t GetItemDataSize(const camera_metadata_item_t &item)
+{
+    size_t typeSize = 0;
+    switch (item.data_type) {
+        case META_TYPE_BYTE:
+            typeSize = sizeof(uint8_t);
+            break;
+        case META_TYPE_INT32:
+            typeSize = sizeof(int32_t);
+            break;
+        case META_TYPE_UINT32:
+            typeSize = sizeof(uint32_t);
+            break;
+        case META_TYPE_FLOAT:
+            typeSize = sizeof(float);
+            break;
+        case META_TYPE_INT64:
+            typeSize = sizeof(int64_t);
+            break;
+        case META_TYPE_DOUBLE:
+            typeSize = sizeof(double);
+            break;
+        case META_TYPE_RATIONAL:
+            typeSize = sizeof(camera_rational_t);
+            break;
+        default:
+            break;
+    }
+    return typeSize * item.count;
+}
+
+static bool IsSameItem(const camera_metadata_item_t &current, const camera_metadata_item_t &item)
+{
+    if (current.data_type != item.data_type || current.count != item.count) {
+        return false;
+    }
+    size_t size = GetItemDataSize(item);
+    return size != 0 && memcmp(current.data.u8, item.data.u8, size) == 0;
+}
+
+static bool AddEntries(const std::shared_ptr<OHOS::Camera::CameraMetadata> &metadata,
+                       const std::vector<camera_metadata_item_t> &items)
+{
+    for (const auto &item : items) {
+        if (!metadata->addEntry(item.item, item.data.u8, item.count)) {
+            MEDIA_ERR_LOG("CameraSettings Failed to add metadata item: %{public}d", item.item);
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool GetItems(const std::shared_ptr<OHOS::Camera::CameraMetadata> &metadata,
+                     std::vector<camera_metadata_item_t> &items, size_t &dataSize)
+{
+    camera_metadata_item_t item;
+    uint32_t count = OHOS::Camera::GetCameraMetadataItemCount(metadata->get());
+    for (uint32_t index = 0; index < count; index++) {
+        if (OHOS::Camera::GetCameraMetadataItem(metadata->get(), index, &item) != CAM_META_SUCCESS) {
+            MEDIA_ERR_LOG("CameraSettings Failed to get metadata item at index: %{public}d", index);
+            return false;
+        }
+        items.emplace_back(item);
+        dataSize += GetItemDataSize(item);
+    }
+    return true;
+}
+
+CameraSettings::CameraSettings(const std::shared_ptr<OHOS::Camera::CameraMetadata> &metadata)
+{
+    // Metadata handed in is only read, the first merge copies it
+    metadata_ = metadata;
+    isOwned_ = false;
+    serialized_ = nullptr;
+    version_ = 1;
+    serializedVersion_ = 0;
+}
+
+std::shared_ptr<OHOS::Camera::CameraMetadata> CameraSettings::GetMetadata()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return metadata_;
+}
+
+uint64_t CameraSettings::GetVersion()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return version_;
+}
+
+SettingsBlob CameraSettings::GetSerialized()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (serialized_ != nullptr && serializedVersion_ == version_) {
+        return serialized_;
+    }
+    auto blob = std::make_shared<std::vector<uint8_t>>();
+    if (metadata_ != nullptr) {
+        OHOS::Camera::MetadataUtils::ConvertMetadataToVec(metadata_, *blob);
+    }
+    serialized_ = blob;
+    serializedVersion_ = version_;
+    return serialized_;
+}
+
+bool CameraSettings::Grow(size_t extraDataSize)
+{
+    std::vector<camera_metadata_item_t> items;
+    size_t dataSize = 0;
+    if (metadata_ != nullptr && !GetItems(metadata_, items, dataSize)) {
+        return false;
+    }
+    size_t itemCapacity = std::max(items.size() * 2, MIN_SETTINGS_ITEM_CAPACITY);
+    size_t dataCapacity = std::max((dataSize + extraDataSize) * 2, MIN_SETTINGS_DATA_CAPACITY);
+    auto metadata = std::make_shared<OHOS::Camera::CameraMetadata>(itemCapacity, dataCapacity);
+    if (!AddEntries(metadata, items)) {
+        return false;
+    }
+    metadata_ = metadata;
+    isOwned_ = true;
+    return true;
+}
+
+bool CameraSettings::SetEntry(const camera_metadata_item_t &item, bool &isChanged)
+{
+    camera_metadata_item_t currentItem;
+    int ret = OHOS::Camera::FindCameraMetadataItem(metadata_->get(), item.item, &currentItem);
+    if (ret == CAM_META_SUCCESS && IsSameItem(currentItem, item)) {
+        isChanged = false;
+        return true;
+    }
+    isChanged = true;
+    bool isFound = (ret == CAM_META_SUCCESS);
+    if (isFound ? metadata_->updateEntry(item.item, item.data.u8, item.count) :
+        metadata_->addEntry(item.item, item.data.u8, item.count)) {
+        return true;
+    }
+    // Out of item or data capacity, the entry goes into a larger copy
+    if (!Grow(GetItemDataSize(item))) {
+        return false;
+    }
+    return isFound ? metadata_->updateEntry(item.item, item.data.u8, item.count) :
+        metadata_->addEntry(item.item, item.data.u8, item.count);
+}
+
+int32_t CameraSettings::Merge(const std::shared_ptr<OHOS::Camera::CameraMetadata> &settings,
+                              std::shared_ptr<OHOS::Camera::CameraMetadata> *changed)
+{
+    if (settings == nullptr) {
+        return CAMERA_INVALID_ARG;
+    }
+    std::vector<camera_metadata_item_t> items;
+    size_t dataSize = 0;
+    if (!GetItems(settings, items, dataSize)) {
+        return CAMERA_INVALID_ARG;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!isOwned_ && !Grow(dataSize)) {
+        return CAMERA_UNKNOWN_ERROR;
+    }
+    std::vector<camera_metadata_item_t> changedItems;
+    size_t changedDataSize = 0;
+    for (const auto &item : items) {
+        bool isChanged = false;
+        if (!SetEntry(item, isChanged)) {
+            MEDIA_ERR_LOG("CameraSettings::Merge Failed to update metadata item: %{public}d", item.item);
+            version_++;
+            return CAMERA_UNKNOWN_ERROR;
+        }
+        if (isChanged) {
+            changedItems.emplace_back(item);
+            changedDataSize += GetItemDataSize(item);
+        }
+    }
+    if (changedItems.empty()) {
+        return CAMERA_OK;
+    }
+    version_++;
+    if (changed != nullptr) {
+        *changed = std::make_shared<OHOS::Camera::CameraMetadata>(changedItems.size(), changedDataSize);
+        if (!AddEntries(*changed, changedItems)) {
+            *changed = nullptr;
+            return CAMERA_UNKNOWN_ERROR;
+        }
+    }
+    return CAMERA_OK;
+}
+} // namespace CameraStandard
+} // namespace OHOS
@@ -0,0 +1,273 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "camera_stream_fan_out.h"
+
+#include <algorithm>
+#include "camera_frame_relay.h"
+#include "camera_latency_stats.h"
+#include "camera_util.h"
+#include "camera_log.h"
+
+namespace OHOS {
+namespace CameraStandard {
+namespace {
+    constexpr int32_t FAN_OUT_QUEUE_SIZE = 3;
+}
+
+class FanOutBufferListener : public IBufferConsumerListener {
+public:
+    explicit FanOutBufferListener(const wptr<StreamFanOut> &fanOut) : fanOut_(fanOut) {}
+    ~FanOutBufferListener() = default;
+
+    void OnBufferAvailable() override
+    {
+        sptr<StreamFanOut> fanOut = fanOut_.promote();
+        if (fanOut != nullptr) {
+            fanOut->OnBufferAvailable();
+        }
+    }
+
+private:
+    wptr<StreamFanOut> fanOut_;
+};
+
+StreamFanOut::StreamFanOut()
+{
+    surface_ = nullptr;
+}
+
+StreamFanOut::~StreamFanOut()
+{
+    Release();
+}
+
+int32_t StreamFanOut::Init(int32_t width, int32_t height)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    surface_ = Surface::CreateSurfaceAsConsumer("StreamFanOut");
+    if (surface_ == nullptr) {
+        MEDIA_ERR_LOG("StreamFanOut::Init failed to create fan out surface");
+        return CAMERA_ALLOC_ERROR;
+    }
+    sptr<IBufferConsumerListener> listener = new(std::nothrow) FanOutBufferListener(this);
+    if (listener == nullptr) {
+        MEDIA_ERR_LOG("StreamFanOut::Init failed to create buffer listener");
+        surface_ = nullptr;
+        return CAMERA_ALLOC_ERROR;
+    }
+    surface_->SetDefaultWidthAndHeight(width, height);
+    surface_->SetQueueSize(FAN_OUT_QUEUE_SIZE);
+    surface_->RegisterConsumerListener(listener);
+    if (!worker_.joinable()) {
+        isWorkerStopped_ = false;
+        worker_ = std::thread(&StreamFanOut::WorkerLoop, this);
+    }
+    return CAMERA_OK;
+}
+
+sptr<IBufferProducer> StreamFanOut::GetProducer()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (surface_ == nullptr) {
+        return nullptr;
+    }
+    return surface_->GetProducer();
+}
+
+std::vector<StreamFanOut::Consumer>::iterator StreamFanOut::FindConsumerLocked(
+    const sptr<IBufferProducer> &producer)
+{
+    return std::find_if(consumers_.begin(), consumers_.end(),
+        [&producer](const Consumer &consumer) { return consumer.producer == producer; });
+}
+
+int32_t StreamFanOut::AddConsumer(const sptr<IBufferProducer> &producer)
+{
+    if (producer == nullptr) {
+        return CAMERA_INVALID_ARG;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (FindConsumerLocked(producer) != consumers_.end()) {
+        return CAMERA_OK;
+    }
+    sptr<Surface> output = Surface::CreateSurfaceAsProducer(producer);
+    if (output == nullptr) {
+        MEDIA_ERR_LOG("StreamFanOut::AddConsumer failed to create consumer surface");
+        return CAMERA_ALLOC_ERROR;
+    }
+    consumers_.push_back({producer, output, false, 0, 0});
+    return CAMERA_OK;
+}
+
+void StreamFanOut::RemoveConsumer(const sptr<IBufferProducer> &producer)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = FindConsumerLocked(producer);
+    if (it != consumers_.end()) {
+        consumers_.erase(it);
+    }
+}
+
+void StreamFanOut::SetConsumerActive(const sptr<IBufferProducer> &producer, bool isActive)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = FindConsumerLocked(producer);
+    if (it == consumers_.end() || it->isActive == isActive) {
+        return;
+    }
+    it->isActive = isActive;
+    if (isActive) {
+        it->deliveredFrames = 0;
+        it->droppedFrames = 0;
+    }
+}
+
+uint64_t StreamFanOut::GetDeliveredFrames(const sptr<IBufferProducer> &producer)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = FindConsumerLocked(producer);
+    return (it != consumers_.end()) ? it->deliveredFrames : 0;
+}
+
+uint64_t StreamFanOut::GetDroppedFrames(const sptr<IBufferProducer> &producer)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = FindConsumerLocked(producer);
+    return (it != consumers_.end()) ? it->droppedFrames : 0;
+}
+
+void StreamFanOut::OnBufferAvailable()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (surface_ == nullptr) {
+            return;
+        }
+        int32_t fence = -1;
+        int64_t timestamp = 0;
+        OHOS::Rect damage;
+        sptr<SurfaceBuffer> buffer = nullptr;
+        SurfaceError surfaceRet = surface_->AcquireBuffer(buffer, fence, timestamp, damage);
+        if (surfaceRet != SURFACE_ERROR_OK || buffer == nullptr) {
+            MEDIA_ERR_LOG("StreamFanOut::OnBufferAvailable Failed to acquire surface buffer");
+            return;
+        }
+        receivedFrames_++;
+        pendingFrames_.push_back({buffer, timestamp});
+    }
+    frameCond_.notify_one();
+}
+
+void StreamFanOut::WorkerLoop()
+{
+    while (true) {
+        PendingFrame frame;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            frameCond_.wait(lock, [this] { return isWorkerStopped_ || !pendingFrames_.empty(); });
+            if (isWorkerStopped_) {
+                return;
+            }
+            frame = pendingFrames_.front();
+            pendingFrames_.pop_front();
+        }
+        DeliverFrame(frame);
+    }
+}
+
+void StreamFanOut::DeliverFrame(const PendingFrame &frame)
+{
+    std::vector<std::pair<sptr<IBufferProducer>, sptr<Surface>>> outputs;
+    sptr<Surface> surface;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        surface = surface_;
+        for (auto &consumer : consumers_) {
+            if (consumer.isActive) {
+                outputs.emplace_back(consumer.producer, consumer.output);
+            }
+        }
+    }
+    // The device buffer goes back to the stream once every consumer has its copy. Consumer
+    // buffers are requested without waiting, so a consumer that holds all of its buffers
+    // loses this frame instead of stalling the stream for the others.
+    std::vector<bool> isDelivered(outputs.size());
+    int64_t startTime = CameraLatencyStats::GetTimestampUs();
+    for (size_t i = 0; i < outputs.size(); i++) {
+        isDelivered[i] = (CopyBufferToSurface(frame.buffer, frame.timestamp, outputs[i].second) == CAMERA_OK);
+    }
+    int64_t copyTimeUs = CameraLatencyStats::GetTimestampUs() - startTime;
+    std::lock_guard<std::mutex> lock(mutex_);
+    copyTimeUs_ += copyTimeUs;
+    for (size_t i = 0; i < outputs.size(); i++) {
+        if (isDelivered[i]) {
+            copiedBytes_ += frame.buffer->GetSize();
+        }
+        auto it = FindConsumerLocked(outputs[i].first);
+        if (it == consumers_.end()) {
+            continue;
+        }
+        if (isDelivered[i]) {
+            it->deliveredFrames++;
+        } else {
+            it->droppedFrames++;
+        }
+    }
+    if (surface != nullptr) {
+        surface->ReleaseBuffer(frame.buffer, -1);
+    }
+}
+
+void StreamFanOut::Release()
+{
+    std::thread worker;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        isWorkerStopped_ = true;
+        worker.swap(worker_);
+    }
+    frameCond_.notify_all();
+    if (worker.joinable()) {
+        worker.join();
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (surface_ != nullptr) {
+        surface_->UnregisterConsumerListener();
+        for (auto &frame : pendingFrames_) {
+            surface_->ReleaseBuffer(frame.buffer, -1);
+        }
+        surface_ = nullptr;
+    }
+    pendingFrames_.clear();
+    consumers_.clear();
+}
+
+void StreamFanOut::DumpFanOutInfo(std::string &dumpString)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    dumpString += "Stream Fan Out Consumers:[" + std::to_string(consumers_.size()) + "]:"
+        + " Received:[" + std::to_string(receivedFrames_) + "]:"
+        + " Copied Bytes:[" + std::to_string(copiedBytes_) + "]:"
+        + " Copy Time Us:[" + std::to_string(copyTimeUs_) + "]\n";
+    for (size_t i = 0; i < consumers_.size(); i++) {
+        dumpString += "    Consumer:[" + std::to_string(i) + "]:"
+            + " Active:[" + std::to_string(consumers_[i].isActive) + "]:"
+            + " Delivered:[" + std::to_string(consumers_[i].deliveredFrames) + "]:"
+            + " Dropped:[" + std::to_string(consumers_[i].droppedFrames) + "]\n";
+    }
+}
+} // namespace CameraStandard
+} // namespace OHOS
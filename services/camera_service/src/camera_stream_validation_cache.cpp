@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "camera_stream_validation_cache.h"
+
+#include <algorithm>
+
+namespace OHOS {
+namespace CameraStandard {
+using namespace OHOS::HDI::Camera::V1_0;
+
+template<typename T>
+static void AppendValue(std::string &key, T value)
+{
+    key.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+StreamValidationCache::StreamValidationCache(size_t capacity) : capacity_(std::max<size_t>(capacity, 1))
+{
+}
+
+std::string StreamValidationCache::GetKey(const std::vector<StreamInfo> &streamInfos, uint64_t abilityGeneration)
+{
+    // Support does not depend on the order of the streams, so the records are sorted
+    std::vector<std::string> records;
+    records.reserve(streamInfos.size());
+    for (const auto &info : streamInfos) {
+        std::string record;
+        AppendValue(record, info.format_);
+        AppendValue(record, info.width_);
+        AppendValue(record, info.height_);
+        AppendValue(record, info.dataspace_);
+        AppendValue(record, static_cast<int32_t>(info.intent_));
+        AppendValue(record, static_cast<int32_t>(info.tunneledMode_));
+        AppendValue(record, info.minFrameDuration_);
+        AppendValue(record, static_cast<int32_t>(info.encodeType_));
+        records.emplace_back(std::move(record));
+    }
+    std::sort(records.begin(), records.end());
+
+    std::string key;
+    AppendValue(key, abilityGeneration);
+    AppendValue(key, static_cast<int32_t>(records.size()));
+    for (const auto &record : records) {
+        key += record;
+    }
+    return key;
+}
+
+bool StreamValidationCache::Find(const std::vector<StreamInfo> &streamInfos, uint64_t abilityGeneration)
+{
+    auto it = index_.find(GetKey(streamInfos, abilityGeneration));
+    if (it == index_.end()) {
+        misses_++;
+        return false;
+    }
+    entries_.splice(entries_.begin(), entries_, it->second);
+    hits_++;
+    return true;
+}
+
+void StreamValidationCache::Add(const std::vector<StreamInfo> &streamInfos, uint64_t abilityGeneration)
+{
+    std::string key = GetKey(streamInfos, abilityGeneration);
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+        entries_.splice(entries_.begin(), entries_, it->second);
+        return;
+    }
+    if (entries_.size() >= capacity_) {
+        index_.erase(entries_.back());
+        entries_.pop_back();
+    }
+    entries_.emplace_front(std::move(key));
+    index_.emplace(entries_.front(), entries_.begin());
+}
+
+void StreamValidationCache::Clear()
+{
+    entries_.clear();
+    index_.clear();
+}
+
+size_t StreamValidationCache::GetSize() const
+{
+    return entries_.size();
+}
+
+uint32_t StreamValidationCache::GetHits() const
+{
+    return hits_;
+}
+
+uint32_t StreamValidationCache::GetMisses() const
+{
+    return misses_;
+}
+} // namespace CameraStandard
+} // namespace OHOS
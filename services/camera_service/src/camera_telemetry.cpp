@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "camera_telemetry.h"
+
+#include <algorithm>
+#include <chrono>
+#include <pthread.h>
+#include <sys/resource.h>
+#include <vector>
+#include "camera_util.h"
+#include "camera_log.h"
+
+namespace OHOS {
+namespace CameraStandard {
+namespace {
+    // Records posted this long after a wake are drained together
+    constexpr int32_t TELEMETRY_COALESCE_INTERVAL_MS = 500;
+    // Nice value of the telemetry thread, below every camera thread
+    constexpr int32_t TELEMETRY_THREAD_NICE = 10;
+}
+
+static bool IsStateEvent(uint32_t type)
+{
+    return type <= TELEMETRY_FOCUS_STATE;
+}
+
+static bool IsSameRecord(const TelemetryRecord &lhs, const TelemetryRecord &rhs)
+{
+    return lhs.type == rhs.type && lhs.values[0] == rhs.values[0] && lhs.values[1] == rhs.values[1]
+        && lhs.values[2] == rhs.values[2];
+}
+
+CameraTelemetry &CameraTelemetry::GetInstance()
+{
+    static CameraTelemetry instance;
+    return instance;
+}
+
+CameraTelemetry::CameraTelemetry()
+{
+    for (size_t i = 0; i < RING_SIZE; i++) {
+        ring_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    drainThread_ = std::thread([this]() {
+        Run();
+    });
+}
+
+CameraTelemetry::~CameraTelemetry()
+{
+    Stop();
+}
+
+void CameraTelemetry::Stop()
+{
+    std::thread drainThread;
+    {
+        std::lock_guard<std::mutex> lock(wakeLock_);
+        isStopping_ = true;
+        drainThread = std::move(drainThread_);
+    }
+    wakeCondition_.notify_one();
+    if (drainThread.joinable()) {
+        drainThread.join();
+    }
+    Flush();
+}
+
+void CameraTelemetry::Run()
+{
+    pthread_setname_np(pthread_self(), "CameraTelemetry");
+    // Linux applies the nice value of PRIO_PROCESS 0 to the calling thread only
+    if (setpriority(PRIO_PROCESS, 0, TELEMETRY_THREAD_NICE) != 0) {
+        MEDIA_ERR_LOG("CameraTelemetry::Run failed to lower the thread priority");
+    }
+    std::unique_lock<std::mutex> lock(wakeLock_);
+    while (!isStopping_) {
+        wakeCondition_.wait(lock, [this]() {
+            return isWakeRequested_.load() || isStopping_;
+        });
+        wakeCondition_.wait_for(lock, std::chrono::milliseconds(TELEMETRY_COALESCE_INTERVAL_MS), [this]() {
+            return isUrgent_.load() || isStopping_;
+        });
+        // Records posted from here on wake the thread again
+        isWakeRequested_.store(false);
+        isUrgent_.store(false);
+        lock.unlock();
+        Flush();
+        lock.lock();
+    }
+}
+
+void CameraTelemetry::Wake(uint32_t type, int32_t value0)
+{
+    bool isUrgent = (type == TELEMETRY_FLASH_STATE) && (lastTorchState_.exchange(value0) != value0);
+    if (isUrgent) {
+        isUrgent_.store(true);
+    }
+    if (!isWakeRequested_.exchange(true) || isUrgent) {
+        // Taking the lock orders the notify after the drain thread checked the flags
+        std::lock_guard<std::mutex> lock(wakeLock_);
+        wakeCondition_.notify_one();
+    }
+}
+
+bool CameraTelemetry::Post(uint32_t type, int32_t value0, int32_t value1, int32_t value2)
+{
+    posted_.fetch_add(1, std::memory_order_relaxed);
+    size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+    Cell *cell = nullptr;
+    while (true) {
+        cell = &ring_[pos % RING_SIZE];
+        size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        if (sequence == pos) {
+            if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (sequence < pos) {
+            // The cell still holds the record posted one lap earlier
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            pos = enqueuePos_.load(std::memory_order_relaxed);
+        }
+    }
+    cell->record = {type, {value0, value1, value2}};
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    Wake(type, value0);
+    return true;
+}
+
+bool CameraTelemetry::Pop(TelemetryRecord &record)
+{
+    Cell &cell = ring_[dequeuePos_ % RING_SIZE];
+    if (cell.sequence.load(std::memory_order_acquire) != dequeuePos_ + 1) {
+        return false;
+    }
+    record = cell.record;
+    cell.sequence.store(dequeuePos_ + RING_SIZE, std::memory_order_release);
+    dequeuePos_++;
+    return true;
+}
+
+uint32_t CameraTelemetry::Flush()
+{
+    std::lock_guard<std::mutex> lock(flushLock_);
+    std::vector<std::pair<TelemetryRecord, uint32_t>> faults;
+    TelemetryRecord record;
+    uint32_t drained = 0;
+    while (Pop(record)) {
+        drained++;
+        if (record.type >= TELEMETRY_EVENT_COUNT) {
+            continue;
+        }
+        if (IsStateEvent(record.type)) {
+            if (hasLastState_[record.type] && lastState_[record.type] == record.values[0]) {
+                coalesced_++;
+                continue;
+            }
+            hasLastState_[record.type] = true;
+            lastState_[record.type] = record.values[0];
+            Write(record, 1);
+            continue;
+        }
+        auto it = std::find_if(faults.begin(), faults.end(), [&record](const auto &fault) {
+            return IsSameRecord(fault.first, record);
+        });
+        if (it != faults.end()) {
+            it->second++;
+            coalesced_++;
+        } else {
+            faults.emplace_back(record, 1);
+        }
+    }
+    for (const auto &fault : faults) {
+        Write(fault.first, fault.second);
+    }
+    return drained;
+}
+
+void CameraTelemetry::Write(const TelemetryRecord &record, uint32_t count)
+{
+    written_++;
+    const int32_t *values = record.values;
+    std::string repeats = (count > 1) ? CreateMsg(", repeated %u times", count) : "";
+    switch (record.type) {
+        case TELEMETRY_FLASH_MODE:
+            CAMERA_SYSEVENT_BEHAVIOR(CreateMsg("FlashModeChanged! current OHOS_CONTROL_FLASH_MODE is %d", values[0]));
+            break;
+        case TELEMETRY_FLASH_STATE:
+            CAMERA_SYSEVENT_BEHAVIOR(CreateMsg("FlashStateChanged! current OHOS_CONTROL_FLASH_STATE is %d",
+                                               values[0]));
+            POWERMGR_SYSEVENT_TORCH_STATE(values[1], values[2], values[0]);
+            break;
+        case TELEMETRY_FOCUS_MODE:
+            CAMERA_SYSEVENT_BEHAVIOR(CreateMsg("FocusModeChanged! current OHOS_CONTROL_FOCUS_MODE is %d", values[0]));
+            break;
+        case TELEMETRY_FOCUS_STATE:
+            CAMERA_SYSEVENT_BEHAVIOR(CreateMsg("FocusStateChanged! current OHOS_CONTROL_FOCUS_STATE is %d",
+                                               values[0]));
+            break;
+        case TELEMETRY_DEVICE_ERROR:
+            CAMERA_SYSEVENT_FAULT(CreateMsg("CameraDeviceServiceCallback::OnError() is called!, errorType: %d,"
+                                            "errorMsg: %d", values[0], values[1]) + repeats);
+            break;
+        case TELEMETRY_FRAME_ERROR:
+            CAMERA_SYSEVENT_FAULT(CreateMsg("Preview OnFrameError! errorCode:%d", values[0]) + repeats);
+            break;
+        case TELEMETRY_CAPTURE_ERROR:
+            CAMERA_SYSEVENT_FAULT(CreateMsg("Photo OnCaptureError! captureId:%d & errorCode:%d",
+                                            values[0], values[1]) + repeats);
+            break;
+        default:
+            break;
+    }
+}
+
+TelemetryStats CameraTelemetry::GetStats()
+{
+    std::lock_guard<std::mutex> lock(flushLock_);
+    return {posted_.load(), dropped_.load(), written_, coalesced_};
+}
+
+void CameraTelemetry::Dump(std::string &dumpString)
+{
+    TelemetryStats stats = GetStats();
+    dumpString += "# Telemetry Posted:[" + std::to_string(stats.posted)
+        + "]:    Written:[" + std::to_string(stats.written)
+        + "]:    Coalesced:[" + std::to_string(stats.coalesced)
+        + "]:    Dropped:[" + std::to_string(stats.dropped) + "]:\n";
+}
+} // namespace CameraStandard
+} // namespace OHOS
@@ -15,6 +15,7 @@
 
 #include "camera_util.h"
 #include <securec.h>
+#include "camera_format_converter.h"
 #include "camera_log.h"
 
 namespace OHOS {
@@ -103,6 +104,9 @@ int32_t HdiToServiceError(CamRetCode ret)
         case CAMERA_CLOSED:
             err = CAMERA_DEVICE_CLOSED;
             break;
+        case METHOD_NOT_SUPPORTED:
+            err = CAMERA_UNSUPPORTED;
+            break;
         default:
             MEDIA_ERR_LOG("HdiToServiceError() error code from hdi: %{public}d", ret);
             break;
@@ -156,6 +160,19 @@ bool IsValidSize(std::shared_ptr<OHOS::Camera::CameraMetadata> cameraAbility,
 #ifndef PRODUCT_M40
     return true;
 #endif
+    if (IsSupportedSize(cameraAbility, format, width, height)) {
+        MEDIA_INFO_LOG("Format:%{public}d, width:%{public}d, height:%{public}d found in supported streams",
+                       format, width, height);
+        return true;
+    }
+    MEDIA_ERR_LOG("Format:%{public}d, width:%{public}d, height:%{public}d not found in supported streams",
+                  format, width, height);
+    return false;
+}
+
+bool IsSupportedSize(std::shared_ptr<OHOS::Camera::CameraMetadata> cameraAbility,
+    int32_t format, int32_t width, int32_t height)
+{
     constexpr uint32_t unitLen = 3;
     camera_metadata_item_t item;
     int ret = Camera::FindCameraMetadataItem(cameraAbility->get(),
@@ -168,18 +185,113 @@ bool IsValidSize(std::shared_ptr<OHOS::Camera::CameraMetadata> cameraAbility,
         MEDIA_ERR_LOG("Invalid stream configuration count: %{public}u", item.count);
         return false;
     }
-    for (uint32_t index = 0; index < item.count; index += 3) {
-        if (item.data.i32[index] == format) {
-            if (item.data.i32[index + 1] == width && item.data.i32[index + 2] == height) {
-                MEDIA_INFO_LOG("Format:%{public}d, width:%{public}d, height:%{public}d found in supported streams",
-                               format, width, height);
-                return true;
-            }
+    for (uint32_t index = 0; index < item.count; index += unitLen) {
+        if (item.data.i32[index] == format && item.data.i32[index + 1] == width
+            && item.data.i32[index + 2] == height) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int32_t GetPixelFormat(int32_t format)
+{
+    auto it = g_cameraToPixelFormat.find(format);
+    if (it != g_cameraToPixelFormat.end()) {
+        return it->second;
+    }
+#ifdef RK_CAMERA
+    return PIXEL_FMT_RGBA_8888;
+#else
+    return PIXEL_FMT_YCRCB_420_SP;
+#endif
+}
+
+bool FindConvertibleFormat(std::shared_ptr<OHOS::Camera::CameraMetadata> cameraAbility,
+    int32_t format, int32_t width, int32_t height, int32_t &hdiFormat)
+{
+    constexpr uint32_t unitLen = 3;
+    auto target = g_cameraToPixelFormat.find(format);
+    if (target == g_cameraToPixelFormat.end() || format == OHOS_CAMERA_FORMAT_JPEG
+        || !IsConvertibleFormat(target->second)) {
+        return false;
+    }
+    camera_metadata_item_t item;
+    int ret = Camera::FindCameraMetadataItem(cameraAbility->get(),
+                                             OHOS_ABILITY_STREAM_AVAILABLE_BASIC_CONFIGURATIONS, &item);
+    if (ret != CAM_META_SUCCESS || item.count % unitLen != 0) {
+        return false;
+    }
+    for (uint32_t index = 0; index < item.count; index += unitLen) {
+        int32_t candidate = item.data.i32[index];
+        if (candidate == OHOS_CAMERA_FORMAT_JPEG || item.data.i32[index + 1] != width
+            || item.data.i32[index + 2] != height) {
+            continue;
+        }
+        auto it = g_cameraToPixelFormat.find(candidate);
+        if (it != g_cameraToPixelFormat.end() && IsConvertibleFormat(it->second)) {
+            MEDIA_INFO_LOG("Format:%{public}d, width:%{public}d, height:%{public}d is converted from format "
+                           "%{public}d", format, width, height, candidate);
+            hdiFormat = candidate;
+            return true;
         }
     }
-    MEDIA_ERR_LOG("Format:%{public}d, width:%{public}d, height:%{public}d not found in supported streams",
-                  format, width, height);
     return false;
 }
+
+bool FindScaledSize(std::shared_ptr<OHOS::Camera::CameraMetadata> cameraAbility,
+    int32_t format, int32_t width, int32_t height, int32_t &hdiFormat, int32_t &hdiWidth, int32_t &hdiHeight)
+{
+    constexpr uint32_t unitLen = 3;
+    auto target = g_cameraToPixelFormat.find(format);
+    if (width <= 0 || height <= 0 || target == g_cameraToPixelFormat.end() || format == OHOS_CAMERA_FORMAT_JPEG) {
+        return false;
+    }
+    camera_metadata_item_t item;
+    int ret = Camera::FindCameraMetadataItem(cameraAbility->get(),
+                                             OHOS_ABILITY_STREAM_AVAILABLE_BASIC_CONFIGURATIONS, &item);
+    if (ret != CAM_META_SUCCESS || item.count % unitLen != 0) {
+        return false;
+    }
+    bool isConvertible = IsConvertibleFormat(target->second);
+    int64_t bestArea = 0;
+    bool isBestSameFormat = false;
+    for (uint32_t index = 0; index < item.count; index += unitLen) {
+        int32_t candidate = item.data.i32[index];
+        int32_t candidateWidth = item.data.i32[index + 1];
+        int32_t candidateHeight = item.data.i32[index + 2];
+        bool isSameFormat = (candidate == format);
+        if (!isSameFormat) {
+            auto it = g_cameraToPixelFormat.find(candidate);
+            if (!isConvertible || candidate == OHOS_CAMERA_FORMAT_JPEG || it == g_cameraToPixelFormat.end()
+                || !IsConvertibleFormat(it->second)) {
+                continue;
+            }
+        }
+        if (candidateWidth == width && candidateHeight == height) {
+            // The device produces the size itself, at most a format conversion is needed
+            return false;
+        }
+        if (candidateWidth < width || candidateHeight < height) {
+            continue;
+        }
+        // The smallest larger size costs the least to scale, the client format saves a conversion
+        int64_t area = static_cast<int64_t>(candidateWidth) * candidateHeight;
+        if (bestArea == 0 || (isSameFormat && !isBestSameFormat)
+            || (isSameFormat == isBestSameFormat && area < bestArea)) {
+            bestArea = area;
+            isBestSameFormat = isSameFormat;
+            hdiFormat = candidate;
+            hdiWidth = candidateWidth;
+            hdiHeight = candidateHeight;
+        }
+    }
+    if (bestArea == 0) {
+        return false;
+    }
+    MEDIA_INFO_LOG("Format:%{public}d, width:%{public}d, height:%{public}d is scaled from format %{public}d, "
+                   "width:%{public}d, height:%{public}d", format, width, height, hdiFormat, hdiWidth, hdiHeight);
+    return true;
+}
 } // namespace CameraStandard
 } // namespace OHOS
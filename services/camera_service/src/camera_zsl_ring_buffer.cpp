@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "camera_zsl_ring_buffer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include "camera_frame_relay.h"
+#include "camera_util.h"
+#include "camera_log.h"
+
+namespace OHOS {
+namespace CameraStandard {
+namespace {
+    // Buffers the HDI keeps in flight on top of the frames pinned by the ring
+    constexpr int32_t ZSL_INFLIGHT_BUFFERS = 3;
+    // Every 4th row and every 2nd pixel of the luma plane is enough to rank frames
+    constexpr int32_t SHARPNESS_ROW_STEP = 4;
+    constexpr int32_t SHARPNESS_COLUMN_STEP = 2;
+}
+
+class ZslBufferListener : public IBufferConsumerListener {
+public:
+    explicit ZslBufferListener(const wptr<ZslRingBuffer> &ringBuffer) : ringBuffer_(ringBuffer) {}
+    ~ZslBufferListener() = default;
+
+    void OnBufferAvailable() override
+    {
+        sptr<ZslRingBuffer> ringBuffer = ringBuffer_.promote();
+        if (ringBuffer != nullptr) {
+            ringBuffer->OnBufferAvailable();
+        }
+    }
+
+private:
+    wptr<ZslRingBuffer> ringBuffer_;
+};
+
+static int64_t GetSteadyTimeNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static int64_t ComputeSharpness(const sptr<SurfaceBuffer> &buffer)
+{
+    // Sum of horizontal luma gradients, the first plane of the YUV formats used by the HDI
+    const uint8_t *luma = static_cast<const uint8_t *>(buffer->GetVirAddr());
+    int32_t width = buffer->GetWidth();
+    int32_t height = buffer->GetHeight();
+    int32_t stride = buffer->GetStride();
+    if (luma == nullptr || width <= SHARPNESS_COLUMN_STEP || height <= 0 || stride < width
+        || static_cast<uint64_t>(stride) * height > buffer->GetSize()) {
+        return 0;
+    }
+    int64_t sharpness = 0;
+    for (int32_t row = 0; row < height; row += SHARPNESS_ROW_STEP) {
+        const uint8_t *line = luma + static_cast<int64_t>(row) * stride;
+        for (int32_t col = SHARPNESS_COLUMN_STEP; col < width; col += SHARPNESS_COLUMN_STEP) {
+            sharpness += std::abs(static_cast<int32_t>(line[col]) - static_cast<int32_t>(line[col - 1]));
+        }
+    }
+    return sharpness;
+}
+
+ZslRingBuffer::ZslRingBuffer(int32_t depth, uint64_t memoryBudget)
+{
+    depth_ = depth;
+    memoryBudget_ = memoryBudget;
+    surface_ = nullptr;
+}
+
+ZslRingBuffer::~ZslRingBuffer()
+{
+    Release();
+}
+
+int32_t ZslRingBuffer::Init(int32_t width, int32_t height)
+{
+    if (depth_ <= 0 || depth_ > MAX_ZSL_RING_DEPTH) {
+        MEDIA_ERR_LOG("ZslRingBuffer::Init invalid ring depth: %{public}d", depth_);
+        return CAMERA_INVALID_ARG;
+    }
+    surface_ = Surface::CreateSurfaceAsConsumer("ZslRingBuffer");
+    if (surface_ == nullptr) {
+        MEDIA_ERR_LOG("ZslRingBuffer::Init failed to create consumer surface");
+        return CAMERA_ALLOC_ERROR;
+    }
+    sptr<IBufferConsumerListener> listener = new(std::nothrow) ZslBufferListener(this);
+    if (listener == nullptr) {
+        MEDIA_ERR_LOG("ZslRingBuffer::Init failed to create buffer listener");
+        surface_ = nullptr;
+        return CAMERA_ALLOC_ERROR;
+    }
+    surface_->SetDefaultWidthAndHeight(width, height);
+    surface_->SetQueueSize(depth_ + ZSL_INFLIGHT_BUFFERS);
+    surface_->RegisterConsumerListener(listener);
+    return CAMERA_OK;
+}
+
+int32_t ZslRingBuffer::Reconfigure(int32_t depth, uint64_t memoryBudget)
+{
+    if (depth <= 0 || depth > MAX_ZSL_RING_DEPTH) {
+        MEDIA_ERR_LOG("ZslRingBuffer::Reconfigure invalid ring depth: %{public}d", depth);
+        return CAMERA_INVALID_ARG;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (surface_ == nullptr) {
+        return CAMERA_INVALID_STATE;
+    }
+    depth_ = depth;
+    memoryBudget_ = memoryBudget;
+    EvictFramesLocked(static_cast<size_t>(depth_), 0);
+    surface_->SetQueueSize(depth_ + ZSL_INFLIGHT_BUFFERS);
+    return CAMERA_OK;
+}
+
+sptr<IBufferProducer> ZslRingBuffer::GetProducer()
+{
+    if (surface_ == nullptr) {
+        return nullptr;
+    }
+    return surface_->GetProducer();
+}
+
+void ZslRingBuffer::ReleaseFrameLocked(const ZslFrame &frame)
+{
+    usedMemory_ -= frame.size;
+    if (surface_ != nullptr) {
+        surface_->ReleaseBuffer(frame.buffer, -1);
+    }
+}
+
+void ZslRingBuffer::EvictFramesLocked(size_t maxFrames, uint64_t incomingSize)
+{
+    while (!frames_.empty() && (frames_.size() > maxFrames
+        || (memoryBudget_ != 0 && usedMemory_ + incomingSize > memoryBudget_))) {
+        ReleaseFrameLocked(frames_.front());
+        frames_.pop_front();
+        evictedFrames_++;
+    }
+}
+
+void ZslRingBuffer::PushFrameLocked(const ZslFrame &frame)
+{
+    if (memoryBudget_ != 0 && frame.size > memoryBudget_) {
+        surface_->ReleaseBuffer(frame.buffer, -1);
+        evictedFrames_++;
+        return;
+    }
+    // Leaves room for the incoming frame
+    EvictFramesLocked(static_cast<size_t>(depth_) - 1, frame.size);
+    frames_.push_back(frame);
+    usedMemory_ += frame.size;
+    if (usedMemory_ > peakMemory_) {
+        peakMemory_ = usedMemory_;
+    }
+}
+
+void ZslRingBuffer::OnBufferAvailable()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (surface_ == nullptr) {
+        return;
+    }
+    int32_t fence = -1;
+    int64_t timestamp = 0;
+    OHOS::Rect damage;
+    sptr<SurfaceBuffer> buffer = nullptr;
+    SurfaceError surfaceRet = surface_->AcquireBuffer(buffer, fence, timestamp, damage);
+    if (surfaceRet != SURFACE_ERROR_OK || buffer == nullptr) {
+        MEDIA_ERR_LOG("ZslRingBuffer::OnBufferAvailable Failed to acquire surface buffer");
+        return;
+    }
+    ZslFrame frame = {buffer, timestamp, GetSteadyTimeNs(), buffer->GetSize(), -1};
+    PushFrameLocked(frame);
+}
+
+int32_t ZslRingBuffer::SelectFrameLocked(int32_t selection, int64_t shutterTime)
+{
+    int32_t selected = -1;
+    if (selection == ZSL_SELECTION_SHARPEST) {
+        int64_t bestSharpness = -1;
+        for (size_t i = 0; i < frames_.size(); i++) {
+            if (frames_[i].sharpness < 0) {
+                frames_[i].sharpness = ComputeSharpness(frames_[i].buffer);
+            }
+            if (frames_[i].sharpness > bestSharpness) {
+                bestSharpness = frames_[i].sharpness;
+                selected = static_cast<int32_t>(i);
+            }
+        }
+    } else {
+        int64_t bestDistance = INT64_MAX;
+        for (size_t i = 0; i < frames_.size(); i++) {
+            int64_t distance = std::abs(frames_[i].arrivalTime - shutterTime);
+            if (distance < bestDistance) {
+                bestDistance = distance;
+                selected = static_cast<int32_t>(i);
+            }
+        }
+    }
+    return selected;
+}
+
+int32_t ZslRingBuffer::CopyFrame(int32_t selection, int64_t shutterTime, sptr<Surface> &output,
+                                 int64_t &frameTimestamp)
+{
+    CAMERA_SYNC_TRACE;
+    std::lock_guard<std::mutex> lock(mutex_);
+    int32_t index = SelectFrameLocked(selection, shutterTime);
+    if (index < 0 || output == nullptr) {
+        zslMisses_++;
+        return CAMERA_INVALID_STATE;
+    }
+    const ZslFrame &frame = frames_[index];
+    int32_t ret = CopyBufferToSurface(frame.buffer, frame.timestamp, output);
+    if (ret != CAMERA_OK) {
+        MEDIA_ERR_LOG("ZslRingBuffer::CopyFrame Failed to copy frame: %{public}d", ret);
+        zslMisses_++;
+        return ret;
+    }
+    frameTimestamp = frame.timestamp;
+    zslHits_++;
+    return CAMERA_OK;
+}
+
+void ZslRingBuffer::Flush()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &frame : frames_) {
+        ReleaseFrameLocked(frame);
+    }
+    frames_.clear();
+}
+
+void ZslRingBuffer::Release()
+{
+    Flush();
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (surface_ != nullptr) {
+        surface_->UnregisterConsumerListener();
+        surface_ = nullptr;
+    }
+}
+
+void ZslRingBuffer::DumpRingInfo(std::string &dumpString)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    dumpString += "ZSL Ring:[" + std::to_string(frames_.size()) + "/" + std::to_string(depth_) + "]:"
+        + " Memory:[" + std::to_string(usedMemory_) + "/" + std::to_string(memoryBudget_) + "]:"
+        + " Peak Memory:[" + std::to_string(peakMemory_) + "]:"
+        + " Evicted:[" + std::to_string(evictedFrames_) + "]:"
+        + " Hits:[" + std::to_string(zslHits_) + "]:"
+        + " Misses:[" + std::to_string(zslMisses_) + "]\n";
+}
+} // namespace CameraStandard
+} // namespace OHOS
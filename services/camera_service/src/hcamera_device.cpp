@@ -15,6 +15,9 @@
 
 #include "hcamera_device.h"
 
+#include <thread>
+#include "camera_latency_stats.h"
+#include "camera_telemetry.h"
 #include "camera_util.h"
 #include "camera_log.h"
 #include "ipc_skeleton.h"
@@ -22,11 +25,19 @@
 
 namespace OHOS {
 namespace CameraStandard {
-static bool isCameraOpened = false;
+static std::set<std::string> g_openedCameraIds;
+static std::mutex g_openedCameraLock;
+static const int32_t PREWARM_TIMEOUT_MS = 5000;
+// Results the service reads itself in OnResult, kept enabled in the HDI whatever the client subscribed
+static const int32_t SERVICE_RESULT_TAGS[] = {
+    OHOS_CONTROL_FLASH_MODE, OHOS_CONTROL_FLASH_STATE, OHOS_CONTROL_FOCUS_MODE, OHOS_CONTROL_FOCUS_STATE
+};
+
 HCameraDevice::HCameraDevice(sptr<HCameraHostManager> &cameraHostManager, std::string cameraID)
 {
     cameraHostManager_ = cameraHostManager;
     cameraID_ = cameraID;
+    ownerUid_ = IPCSkeleton::GetCallingUid();
     streamOperator_ = nullptr;
     isReleaseCameraDevice_ = false;
 }
@@ -65,58 +76,216 @@ std::shared_ptr<OHOS::Camera::CameraMetadata> HCameraDevice::GetSettings()
 int32_t HCameraDevice::Open()
 {
     CAMERA_SYNC_TRACE;
-    int32_t errorCode;
-    std::vector<uint8_t> setting;
+    {
+        std::unique_lock<std::mutex> prewarmLock(prewarmLock_);
+        prewarmCond_.wait(prewarmLock, [this] { return prewarmState_ != PrewarmState::PREWARMING; });
+        if (prewarmState_ == PrewarmState::PREWARMED) {
+            MEDIA_INFO_LOG("HCameraDevice::Open Using prewarmed camera device: %{public}s", cameraID_.c_str());
+            prewarmState_ = PrewarmState::CLAIMED;
+            prewarmCond_.notify_all();
+            std::lock_guard<std::mutex> lock(deviceLock_);
+            return ApplyPendingSettings();
+        }
+    }
     std::lock_guard<std::mutex> lock(deviceLock_);
-    if (isCameraOpened) {
-        MEDIA_ERR_LOG("HCameraDevice::Open failed, camera is busy");
+    return OpenDevice();
+}
+
+int32_t HCameraDevice::OpenDevice()
+{
+    int32_t errorCode;
+    {
+        std::lock_guard<std::mutex> openedLock(g_openedCameraLock);
+        if (g_openedCameraIds.find(cameraID_) != g_openedCameraIds.end()) {
+            MEDIA_ERR_LOG("HCameraDevice::Open camera %{public}s is busy", cameraID_.c_str());
+        }
     }
-    if (deviceHDICallback_ == nullptr) {
-        deviceHDICallback_ = new(std::nothrow) CameraDeviceCallback(this);
+    sptr<ICameraDeviceCallback> keptAliveCallback = nullptr;
+    bool isKeptAlive = cameraHostManager_->AcquireKeptAliveDevice(cameraID_, ownerUid_,
+                                                                  hdiCameraDevice_, keptAliveCallback);
+    if (isKeptAlive) {
+        // Result mode and device state survive on the kept alive device, only pending settings are applied
+        MEDIA_INFO_LOG("HCameraDevice::Open Reusing kept alive camera device: %{public}s", cameraID_.c_str());
+        deviceHDICallback_ = static_cast<CameraDeviceCallback *>(keptAliveCallback.GetRefPtr());
+        errorCode = CAMERA_OK;
+    } else {
         if (deviceHDICallback_ == nullptr) {
-            MEDIA_ERR_LOG("HCameraDevice::Open CameraDeviceCallback allocation failed");
-            return CAMERA_ALLOC_ERROR;
+            deviceHDICallback_ = new(std::nothrow) CameraDeviceCallback(this, cameraHostManager_, cameraID_);
+            if (deviceHDICallback_ == nullptr) {
+                MEDIA_ERR_LOG("HCameraDevice::Open CameraDeviceCallback allocation failed");
+                return CAMERA_ALLOC_ERROR;
+            }
+        }
+        MEDIA_INFO_LOG("HCameraDevice::Open Opening camera device: %{public}s", cameraID_.c_str());
+        int64_t startTime = CameraLatencyStats::GetTimestampUs();
+        errorCode = cameraHostManager_->OpenCameraDevice(cameraID_, deviceHDICallback_, hdiCameraDevice_);
+        CameraLatencyStats::GetInstance().Record(cameraID_, LATENCY_OPEN_CAMERA, startTime);
+        if (errorCode == CAMERA_DEVICE_BUSY && cameraHostManager_->FlushKeptAliveDevices() > 0) {
+            // A device kept alive for reuse may hold the sensor this camera needs
+            startTime = CameraLatencyStats::GetTimestampUs();
+            errorCode = cameraHostManager_->OpenCameraDevice(cameraID_, deviceHDICallback_, hdiCameraDevice_);
+            CameraLatencyStats::GetInstance().Record(cameraID_, LATENCY_OPEN_CAMERA, startTime);
         }
     }
-    MEDIA_INFO_LOG("HCameraDevice::Open Opening camera device: %{public}s", cameraID_.c_str());
-    errorCode = cameraHostManager_->OpenCameraDevice(cameraID_, deviceHDICallback_, hdiCameraDevice_);
     if (errorCode == CAMERA_OK) {
-        isCameraOpened = true;
-        if (updateSettings_ != nullptr) {
-            OHOS::Camera::MetadataUtils::ConvertMetadataToVec(updateSettings_, setting);
-            CamRetCode rc = (CamRetCode)(hdiCameraDevice_->UpdateSettings(setting));
-            if (rc != HDI::Camera::V1_0::NO_ERROR) {
-                MEDIA_ERR_LOG("HCameraDevice::Open Update setting failed with error Code: %{public}d", rc);
-                return HdiToServiceError(rc);
-            }
-            updateSettings_ = nullptr;
-            MEDIA_DEBUG_LOG("HCameraDevice::Open Updated device settings");
+        deviceHDICallback_->SetCameraDevice(this);
+        {
+            std::lock_guard<std::mutex> openedLock(g_openedCameraLock);
+            g_openedCameraIds.insert(cameraID_);
+        }
+        errorCode = ApplyPendingSettings();
+        if (errorCode != CAMERA_OK) {
+            return errorCode;
+        }
+        if (!isKeptAlive) {
+            errorCode = HdiToServiceError((CamRetCode)(hdiCameraDevice_->SetResultMode(ON_CHANGED)));
         }
-        errorCode = HdiToServiceError((CamRetCode)(hdiCameraDevice_->SetResultMode(ON_CHANGED)));
     } else {
         MEDIA_ERR_LOG("HCameraDevice::Open Failed to open camera");
     }
     return errorCode;
 }
 
+int32_t HCameraDevice::ApplyPendingSettings()
+{
+    // Results subscribed before the device opened are applied along with the settings
+    if (hdiCameraDevice_ != nullptr) {
+        (void)ApplyResultSubscription();
+    }
+    if (updateSettings_ == nullptr || hdiCameraDevice_ == nullptr) {
+        return CAMERA_OK;
+    }
+    SettingsBlob setting = updateSettings_->GetSerialized();
+    int64_t startTime = CameraLatencyStats::GetTimestampUs();
+    CamRetCode rc = (CamRetCode)(hdiCameraDevice_->UpdateSettings(*setting));
+    CameraLatencyStats::GetInstance().Record(cameraID_, LATENCY_UPDATE_SETTINGS, startTime);
+    if (rc != HDI::Camera::V1_0::NO_ERROR) {
+        MEDIA_ERR_LOG("HCameraDevice::Open Update setting failed with error Code: %{public}d", rc);
+        return HdiToServiceError(rc);
+    }
+    MEDIA_DEBUG_LOG("HCameraDevice::Open Updated device settings");
+    return CAMERA_OK;
+}
+
+int32_t HCameraDevice::Prewarm()
+{
+    {
+        std::lock_guard<std::mutex> openedLock(g_openedCameraLock);
+        if (!g_openedCameraIds.empty()) {
+            // Opening now could preempt a camera in use, the device is opened at commit instead
+            MEDIA_INFO_LOG("HCameraDevice::Prewarm skipped for %{public}s, a camera is in use", cameraID_.c_str());
+            return CAMERA_DEVICE_BUSY;
+        }
+    }
+    {
+        std::lock_guard<std::mutex> prewarmLock(prewarmLock_);
+        if (prewarmState_ != PrewarmState::NONE || hdiCameraDevice_ != nullptr) {
+            return CAMERA_OK;
+        }
+        prewarmState_ = PrewarmState::PREWARMING;
+    }
+    sptr<HCameraDevice> device = this;
+    std::thread([device]() {
+        device->PrewarmDevice();
+    }).detach();
+    return CAMERA_OK;
+}
+
+void HCameraDevice::PrewarmDevice()
+{
+    CAMERA_SYNC_TRACE;
+    int32_t rc;
+    {
+        std::lock_guard<std::mutex> lock(deviceLock_);
+        rc = OpenDevice();
+        if (rc == CAMERA_OK) {
+            rc = PrewarmStreamOperator();
+        }
+        if (rc != CAMERA_OK) {
+            CloseDevice(false);
+        }
+    }
+    std::unique_lock<std::mutex> prewarmLock(prewarmLock_);
+    prewarmState_ = (rc == CAMERA_OK) ? PrewarmState::PREWARMED : PrewarmState::NONE;
+    prewarmCond_.notify_all();
+    MEDIA_INFO_LOG("HCameraDevice::PrewarmDevice camera %{public}s prewarmed, rc: %{public}d", cameraID_.c_str(), rc);
+    if (rc != CAMERA_OK) {
+        return;
+    }
+    if (!prewarmCond_.wait_for(prewarmLock, std::chrono::milliseconds(PREWARM_TIMEOUT_MS),
+                               [this] { return prewarmState_ != PrewarmState::PREWARMED; })) {
+        // Closed while holding the prewarm lock so a racing Open cannot lose a freshly opened device
+        MEDIA_INFO_LOG("HCameraDevice::PrewarmDevice unused prewarm of %{public}s cancelled", cameraID_.c_str());
+        prewarmState_ = PrewarmState::NONE;
+        std::lock_guard<std::mutex> lock(deviceLock_);
+        CloseDevice(false);
+    }
+}
+
+int32_t HCameraDevice::PrewarmStreamOperator()
+{
+    streamOperatorRelay_ = new(std::nothrow) StreamOperatorCallbackRelay();
+    if (streamOperatorRelay_ == nullptr) {
+        MEDIA_ERR_LOG("HCameraDevice::PrewarmStreamOperator StreamOperatorCallbackRelay allocation failed");
+        return CAMERA_ALLOC_ERROR;
+    }
+    sptr<IStreamOperator> streamOperator = nullptr;
+    int64_t startTime = CameraLatencyStats::GetTimestampUs();
+    CamRetCode rc = (CamRetCode)(hdiCameraDevice_->GetStreamOperator(streamOperatorRelay_, streamOperator));
+    CameraLatencyStats::GetInstance().Record(cameraID_, LATENCY_GET_STREAM_OPERATOR, startTime);
+    if (rc != HDI::Camera::V1_0::NO_ERROR) {
+        MEDIA_ERR_LOG("HCameraDevice::PrewarmStreamOperator failed with error Code:%{public}d", rc);
+        streamOperatorRelay_ = nullptr;
+        return HdiToServiceError(rc);
+    }
+    streamOperator_ = streamOperator;
+    return CAMERA_OK;
+}
+
 int32_t HCameraDevice::Close()
 {
     CAMERA_SYNC_TRACE;
+    bool isPrewarmUnused = false;
+    {
+        std::unique_lock<std::mutex> prewarmLock(prewarmLock_);
+        prewarmCond_.wait(prewarmLock, [this] { return prewarmState_ != PrewarmState::PREWARMING; });
+        isPrewarmUnused = (prewarmState_ == PrewarmState::PREWARMED);
+        prewarmState_ = PrewarmState::NONE;
+        prewarmCond_.notify_all();
+    }
     std::lock_guard<std::mutex> lock(deviceLock_);
+    // A prewarm nobody used is not worth keeping alive
+    return CloseDevice(!isPrewarmUnused);
+}
+
+int32_t HCameraDevice::CloseDevice(bool isKeepAliveAllowed)
+{
     if (hdiCameraDevice_ != nullptr) {
         MEDIA_INFO_LOG("HCameraDevice::Close Closing camera device: %{public}s", cameraID_.c_str());
-        hdiCameraDevice_->Close();
+        // Detached first so nothing of the kept alive device reaches this client any more
+        if (deviceHDICallback_ != nullptr) {
+            deviceHDICallback_->SetCameraDevice(nullptr);
+        }
+        if (!isKeepAliveAllowed ||
+            !cameraHostManager_->KeepAliveCameraDevice(cameraID_, ownerUid_, hdiCameraDevice_, deviceHDICallback_)) {
+            hdiCameraDevice_->Close();
+        }
+        std::lock_guard<std::mutex> openedLock(g_openedCameraLock);
+        g_openedCameraIds.erase(cameraID_);
     }
-    isCameraOpened = false;
     hdiCameraDevice_ = nullptr;
+    // The stream operator belongs to the closed HDI device, a reopen gets a new one
+    streamOperator_ = nullptr;
+    streamOperatorRelay_ = nullptr;
+    // Settings last as long as the device stays open
+    updateSettings_ = nullptr;
     return CAMERA_OK;
 }
 
 int32_t HCameraDevice::Release()
 {
-    if (hdiCameraDevice_ != nullptr) {
-        Close();
-    }
+    // Also cancels a prewarm that has not been used yet
+    Close();
     deviceHDICallback_ = nullptr;
     deviceSvcCallback_ = nullptr;
     return CAMERA_OK;
@@ -124,6 +293,17 @@ int32_t HCameraDevice::Release()
 
 int32_t HCameraDevice::GetEnabledResults(std::vector<int32_t> &results)
 {
+    {
+        std::lock_guard<std::mutex> resultLock(resultLock_);
+        if (hasResultSubscription_) {
+            results.assign(subscribedResults_.begin(), subscribedResults_.end());
+            return CAMERA_OK;
+        }
+    }
+    if (hdiCameraDevice_ == nullptr) {
+        MEDIA_ERR_LOG("HCameraDevice::hdiCameraDevice_ is null");
+        return CAMERA_UNKNOWN_ERROR;
+    }
     CamRetCode rc = (CamRetCode)(hdiCameraDevice_->GetEnabledResults(results));
     if (rc != HDI::Camera::V1_0::NO_ERROR) {
         MEDIA_ERR_LOG("HCameraDevice::GetEnabledResults failed with error Code:%{public}d", rc);
@@ -145,41 +325,31 @@ int32_t HCameraDevice::UpdateSetting(const std::shared_ptr<OHOS::Camera::CameraM
         MEDIA_DEBUG_LOG("HCameraDevice::UpdateSetting Nothing to update");
         return CAMERA_OK;
     }
-    if (updateSettings_) {
-        camera_metadata_item_t metadataItem;
-        for (uint32_t index = 0; index < count; index++) {
-            int ret = OHOS::Camera::GetCameraMetadataItem(settings->get(), index, &metadataItem);
-            if (ret != CAM_META_SUCCESS) {
-                MEDIA_ERR_LOG("HCameraDevice::UpdateSetting Failed to get metadata item at index: %{public}d", index);
-                return CAMERA_INVALID_ARG;
-            }
-            bool status = false;
-            uint32_t currentIndex;
-            ret = OHOS::Camera::FindCameraMetadataItemIndex(updateSettings_->get(), metadataItem.item, &currentIndex);
-            if (ret == CAM_META_ITEM_NOT_FOUND) {
-                status = updateSettings_->addEntry(metadataItem.item, metadataItem.data.u8, metadataItem.count);
-            } else if (ret == CAM_META_SUCCESS) {
-                status = updateSettings_->updateEntry(metadataItem.item, metadataItem.data.u8, metadataItem.count);
-            }
-            if (!status) {
-                MEDIA_ERR_LOG("HCameraDevice::UpdateSetting Failed to update metadata item: %{public}d",
-                              metadataItem.item);
-                return CAMERA_UNKNOWN_ERROR;
-            }
-        }
-    } else {
-        updateSettings_ = settings;
+    if (updateSettings_ == nullptr) {
+        updateSettings_ = std::make_shared<CameraSettings>(nullptr);
+    }
+    std::shared_ptr<OHOS::Camera::CameraMetadata> changedSettings;
+    int32_t ret = updateSettings_->Merge(settings, &changedSettings);
+    if (ret != CAMERA_OK) {
+        MEDIA_ERR_LOG("HCameraDevice::UpdateSetting Failed to merge settings: %{public}d", ret);
+        return ret;
     }
     if (hdiCameraDevice_ != nullptr) {
+        // The HDI keeps what it was sent while the device is open, so only the changed entries go out
+        if (changedSettings == nullptr) {
+            MEDIA_DEBUG_LOG("HCameraDevice::UpdateSetting Settings unchanged");
+            return CAMERA_OK;
+        }
         std::vector<uint8_t> setting;
-        OHOS::Camera::MetadataUtils::ConvertMetadataToVec(updateSettings_, setting);
+        OHOS::Camera::MetadataUtils::ConvertMetadataToVec(changedSettings, setting);
+        int64_t startTime = CameraLatencyStats::GetTimestampUs();
         CamRetCode rc = (CamRetCode)(hdiCameraDevice_->UpdateSettings(setting));
+        CameraLatencyStats::GetInstance().Record(cameraID_, LATENCY_UPDATE_SETTINGS, startTime);
         if (rc != HDI::Camera::V1_0::NO_ERROR) {
             MEDIA_ERR_LOG("HCameraDevice::UpdateSetting failed with error Code: %{public}d", rc);
             return HdiToServiceError(rc);
         }
-        ReportFlashEvent(updateSettings_);
-        updateSettings_ = nullptr;
+        ReportFlashEvent(settings);
     }
     MEDIA_DEBUG_LOG("HCameraDevice::UpdateSetting Updated device settings");
     return CAMERA_OK;
@@ -207,18 +377,14 @@ int32_t HCameraDevice::EnableResult(std::vector<int32_t> &results)
         return CAMERA_INVALID_ARG;
     }
 
-    if (hdiCameraDevice_ == nullptr) {
-        MEDIA_ERR_LOG("HCameraDevice::hdiCameraDevice_ is null");
-        return CAMERA_UNKNOWN_ERROR;
-    }
-
-    CamRetCode rc = (CamRetCode)(hdiCameraDevice_->EnableResult(results));
-    if (rc != HDI::Camera::V1_0::NO_ERROR) {
-        MEDIA_ERR_LOG("HCameraDevice::EnableResult failed with error Code:%{public}d", rc);
-        return HdiToServiceError(rc);
+    std::lock_guard<std::mutex> lock(deviceLock_);
+    {
+        std::lock_guard<std::mutex> resultLock(resultLock_);
+        hasResultSubscription_ = true;
+        subscribedResults_.insert(results.begin(), results.end());
     }
-
-    return CAMERA_OK;
+    // Applied when the device opens otherwise
+    return (hdiCameraDevice_ != nullptr) ? ApplyResultSubscription() : CAMERA_OK;
 }
 
 int32_t HCameraDevice::DisableResult(std::vector<int32_t> &results)
@@ -228,9 +394,23 @@ int32_t HCameraDevice::DisableResult(std::vector<int32_t> &results)
         return CAMERA_INVALID_ARG;
     }
 
+    std::lock_guard<std::mutex> lock(deviceLock_);
+    bool hasResultSubscription = false;
+    {
+        std::lock_guard<std::mutex> resultLock(resultLock_);
+        hasResultSubscription = hasResultSubscription_;
+        for (int32_t result : results) {
+            subscribedResults_.erase(result);
+            // Delivered again in full once subscribed again
+            lastResultValues_.erase(static_cast<uint32_t>(result));
+        }
+    }
     if (hdiCameraDevice_ == nullptr) {
         MEDIA_ERR_LOG("HCameraDevice::hdiCameraDevice_ is null");
-        return CAMERA_UNKNOWN_ERROR;
+        return hasResultSubscription ? CAMERA_OK : CAMERA_UNKNOWN_ERROR;
+    }
+    if (hasResultSubscription) {
+        return ApplyResultSubscription();
     }
 
     CamRetCode rc = (CamRetCode)(hdiCameraDevice_->DisableResult(results));
@@ -241,6 +421,56 @@ int32_t HCameraDevice::DisableResult(std::vector<int32_t> &results)
     return CAMERA_OK;
 }
 
+int32_t HCameraDevice::ApplyResultSubscription()
+{
+    std::set<int32_t> wanted;
+    {
+        std::lock_guard<std::mutex> resultLock(resultLock_);
+        if (!hasResultSubscription_) {
+            // The client gets every result the HDI sends until it subscribes
+            return CAMERA_OK;
+        }
+        wanted = subscribedResults_;
+    }
+    wanted.insert(std::begin(SERVICE_RESULT_TAGS), std::end(SERVICE_RESULT_TAGS));
+    std::vector<int32_t> enabled;
+    CamRetCode rc = (CamRetCode)(hdiCameraDevice_->GetEnabledResults(enabled));
+    if (rc != HDI::Camera::V1_0::NO_ERROR) {
+        MEDIA_ERR_LOG("HCameraDevice::ApplyResultSubscription GetEnabledResults failed with error Code:%{public}d", rc);
+        return HdiToServiceError(rc);
+    }
+    std::set<int32_t> enabledSet(enabled.begin(), enabled.end());
+    std::vector<int32_t> toEnable;
+    std::vector<int32_t> toDisable;
+    for (int32_t tag : wanted) {
+        if (enabledSet.find(tag) == enabledSet.end()) {
+            toEnable.push_back(tag);
+        }
+    }
+    for (int32_t tag : enabledSet) {
+        if (wanted.find(tag) == wanted.end()) {
+            toDisable.push_back(tag);
+        }
+    }
+    if (!toEnable.empty()) {
+        rc = (CamRetCode)(hdiCameraDevice_->EnableResult(toEnable));
+        if (rc != HDI::Camera::V1_0::NO_ERROR) {
+            MEDIA_ERR_LOG("HCameraDevice::EnableResult failed with error Code:%{public}d", rc);
+            return HdiToServiceError(rc);
+        }
+    }
+    if (!toDisable.empty()) {
+        rc = (CamRetCode)(hdiCameraDevice_->DisableResult(toDisable));
+        if (rc != HDI::Camera::V1_0::NO_ERROR) {
+            MEDIA_ERR_LOG("HCameraDevice::DisableResult failed with error Code:%{public}d", rc);
+            return HdiToServiceError(rc);
+        }
+    }
+    MEDIA_DEBUG_LOG("HCameraDevice::ApplyResultSubscription enabled %{public}zu, disabled %{public}zu results",
+                    toEnable.size(), toDisable.size());
+    return CAMERA_OK;
+}
+
 int32_t HCameraDevice::SetCallback(sptr<ICameraDeviceServiceCallback> &callback)
 {
     if (callback == nullptr) {
@@ -259,12 +489,22 @@ int32_t HCameraDevice::GetStreamOperator(sptr<IStreamOperatorCallback> callback,
         return CAMERA_INVALID_ARG;
     }
 
+    // The prewarm thread sets the operator and its relay under the same lock
+    std::lock_guard<std::mutex> lock(deviceLock_);
     if (hdiCameraDevice_ == nullptr) {
         MEDIA_ERR_LOG("HCameraDevice::hdiCameraDevice_ is null");
         return CAMERA_UNKNOWN_ERROR;
     }
 
+    if (streamOperatorRelay_ != nullptr && streamOperator_ != nullptr) {
+        // Obtained while prewarming, the session callback is only routed to it now
+        streamOperatorRelay_->SetCallback(callback);
+        streamOperator = streamOperator_;
+        return CAMERA_OK;
+    }
+    int64_t startTime = CameraLatencyStats::GetTimestampUs();
     CamRetCode rc = (CamRetCode)(hdiCameraDevice_->GetStreamOperator(callback, streamOperator));
+    CameraLatencyStats::GetInstance().Record(cameraID_, LATENCY_GET_STREAM_OPERATOR, startTime);
     if (rc != HDI::Camera::V1_0::NO_ERROR) {
         MEDIA_ERR_LOG("HCameraDevice::GetStreamOperator failed with error Code:%{public}d", rc);
         return HdiToServiceError(rc);
@@ -275,6 +515,7 @@ int32_t HCameraDevice::GetStreamOperator(sptr<IStreamOperatorCallback> callback,
 
 sptr<IStreamOperator> HCameraDevice::GetStreamOperator()
 {
+    std::lock_guard<std::mutex> lock(deviceLock_);
     return streamOperator_;
 }
 
@@ -290,69 +531,185 @@ int32_t HCameraDevice::OnError(const ErrorType type, const int32_t errorMsg)
             errorType = CAMERA_UNKNOWN_ERROR;
         }
         deviceSvcCallback_->OnError(errorType, errorMsg);
-        CAMERA_SYSEVENT_FAULT(CreateMsg("CameraDeviceServiceCallback::OnError() is called!, errorType: %d,"
-                                        "errorMsg: %d", errorType, errorMsg));
+        CameraTelemetry::GetInstance().Post(TELEMETRY_DEVICE_ERROR, errorType, errorMsg);
+    }
+    return CAMERA_OK;
+}
+
+void HCameraDevice::DumpResultInfo(std::string &dumpString)
+{
+    uint64_t forwarded = forwardedResults_.load();
+    uint64_t copiedBytes = copiedResultBytes_.load();
+    size_t subscribedCount = 0;
+    {
+        std::lock_guard<std::mutex> resultLock(resultLock_);
+        subscribedCount = subscribedResults_.size();
+    }
+    dumpString += "session Camera results:[" + std::to_string(forwarded)
+        + "]:    Dropped:[" + std::to_string(droppedResults_.load())
+        + "]:    Filtered:[" + std::to_string(filteredResults_.load())
+        + "]:    Malformed:[" + std::to_string(malformedResults_.load())
+        + "]:    Subscribed Tags:[" + std::to_string(subscribedCount)
+        + "]:    Copied Bytes Per Result:[" + std::to_string(forwarded > 0 ? copiedBytes / forwarded : 0)
+        + "]:\n";
+}
+
+void HCameraDevice::ForwardResult(const uint64_t timestamp, const std::vector<uint8_t> &result,
+                                  uint32_t itemCount)
+{
+    std::lock_guard<std::mutex> resultLock(resultLock_);
+    const std::set<int32_t> *tags = hasResultSubscription_ ? &subscribedResults_ : nullptr;
+    ResultValues changedValues;
+    uint32_t changedCount = DiffResult(result, tags, lastResultValues_, filteredResult_, changedValues);
+    if (changedCount == 0) {
+        // Nothing the client subscribed to changed
+        filteredResults_++;
+        return;
+    }
+    // A result whose every item changed goes out as the HDI sent it
+    const std::vector<uint8_t> &forwarded = (changedCount == itemCount) ? result : filteredResult_;
+    if (deviceSvcCallback_->OnRawResult(timestamp, forwarded) != CAMERA_OK) {
+        // Results are delivered one-way, drop instead of blocking the HDI callback thread. The values
+        // stay uncommitted so the next result carries them again
+        droppedResults_++;
+        return;
+    }
+    CommitResultValues(changedValues, lastResultValues_);
+    forwardedResults_++;
+    copiedResultBytes_ += forwarded.size();
+}
+
+int32_t HCameraDevice::GetResultSnapshot(std::shared_ptr<OHOS::Camera::CameraMetadata> &snapshot)
+{
+    std::vector<uint8_t> serialized;
+    {
+        std::lock_guard<std::mutex> resultLock(resultLock_);
+        if (lastResultValues_.empty()) {
+            snapshot = std::make_shared<OHOS::Camera::CameraMetadata>(0, 0);
+            return CAMERA_OK;
+        }
+        BuildResultSnapshot(lastResultValues_, serialized);
+    }
+    OHOS::Camera::MetadataUtils::ConvertVecToMetadata(serialized, snapshot);
+    if (snapshot == nullptr) {
+        MEDIA_ERR_LOG("HCameraDevice::GetResultSnapshot failed to decode %{public}zu bytes", serialized.size());
+        return CAMERA_UNKNOWN_ERROR;
     }
     return CAMERA_OK;
 }
 
-int32_t HCameraDevice::OnResult(const uint64_t timestamp,
-                                const std::shared_ptr<OHOS::Camera::CameraMetadata> &result)
+int32_t HCameraDevice::OnResult(const uint64_t timestamp, const std::vector<uint8_t> &result)
 {
+    CameraResultReader reader(result);
+    if (!reader.ValidateItems()) {
+        malformedResults_++;
+        MEDIA_ERR_LOG("HCameraDevice::OnResult malformed result of %{public}zu bytes", result.size());
+        return CAMERA_OK;
+    }
     if (deviceSvcCallback_ != nullptr) {
-        deviceSvcCallback_->OnResult(timestamp, result);
+        ForwardResult(timestamp, result, reader.GetItemCount());
     }
-    camera_metadata_item_t item;
-    common_metadata_header_t *metadata = result->get();
-    int ret = OHOS::Camera::FindCameraMetadataItem(metadata, OHOS_CONTROL_FLASH_MODE, &item);
-    if (ret == 0) {
-        MEDIA_INFO_LOG("CameraDeviceServiceCallback::OnResult() OHOS_CONTROL_FLASH_MODE is %{public}d",
-                        item.data.u8[0]);
-        CAMERA_SYSEVENT_BEHAVIOR(CreateMsg("FlashModeChanged! current OHOS_CONTROL_FLASH_MODE is %d",
-                                            item.data.u8[0]));
-    }
-    ret = OHOS::Camera::FindCameraMetadataItem(metadata, OHOS_CONTROL_FLASH_STATE, &item);
-    if (ret == 0) {
-        MEDIA_INFO_LOG("CameraDeviceServiceCallback::OnResult() OHOS_CONTROL_FLASH_STATE is %{public}d",
-                        item.data.u8[0]);
-        CAMERA_SYSEVENT_BEHAVIOR(CreateMsg("FlashStateChanged! current OHOS_CONTROL_FLASH_STATE is %d",
-                                            item.data.u8[0]));
-        POWERMGR_SYSEVENT_TORCH_STATE(IPCSkeleton::GetCallingPid(),
-                                      IPCSkeleton::GetCallingUid(), item.data.u8[0]);
-    }
-
-    ret = OHOS::Camera::FindCameraMetadataItem(metadata, OHOS_CONTROL_FOCUS_MODE, &item);
-    if (ret == CAM_META_SUCCESS) {
-        MEDIA_DEBUG_LOG("Focus mode: %{public}d", item.data.u8[0]);
-        CAMERA_SYSEVENT_BEHAVIOR(CreateMsg("FocusModeChanged! current OHOS_CONTROL_FOCUS_MODE is %d",
-                                           item.data.u8[0]));
+    // Only the few tags reported below are looked up, in place in the HDI bytes, and the sysevents are
+    // written off this HDI callback thread
+    CameraTelemetry &telemetry = CameraTelemetry::GetInstance();
+    uint8_t value = 0;
+    if (reader.FindByte(OHOS_CONTROL_FLASH_MODE, value)) {
+        MEDIA_INFO_LOG("CameraDeviceServiceCallback::OnResult() OHOS_CONTROL_FLASH_MODE is %{public}d", value);
+        telemetry.Post(TELEMETRY_FLASH_MODE, value);
     }
-    ret = OHOS::Camera::FindCameraMetadataItem(metadata, OHOS_CONTROL_FOCUS_STATE, &item);
-    if (ret == CAM_META_SUCCESS) {
-        MEDIA_INFO_LOG("Focus state: %{public}d", item.data.u8[0]);
-        CAMERA_SYSEVENT_BEHAVIOR(CreateMsg("FocusStateChanged! current OHOS_CONTROL_FOCUS_STATE is %d",
-                                           item.data.u8[0]));
+    if (reader.FindByte(OHOS_CONTROL_FLASH_STATE, value)) {
+        MEDIA_INFO_LOG("CameraDeviceServiceCallback::OnResult() OHOS_CONTROL_FLASH_STATE is %{public}d", value);
+        telemetry.Post(TELEMETRY_FLASH_STATE, value, IPCSkeleton::GetCallingPid(), IPCSkeleton::GetCallingUid());
+    }
+    if (reader.FindByte(OHOS_CONTROL_FOCUS_MODE, value)) {
+        MEDIA_DEBUG_LOG("Focus mode: %{public}d", value);
+        telemetry.Post(TELEMETRY_FOCUS_MODE, value);
+    }
+    if (reader.FindByte(OHOS_CONTROL_FOCUS_STATE, value)) {
+        MEDIA_INFO_LOG("Focus state: %{public}d", value);
+        telemetry.Post(TELEMETRY_FOCUS_STATE, value);
     }
 
     return CAMERA_OK;
 }
 
-CameraDeviceCallback::CameraDeviceCallback(sptr<HCameraDevice> hCameraDevice)
+void StreamOperatorCallbackRelay::SetCallback(const sptr<IStreamOperatorCallback> &callback)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    callback_ = callback;
+}
+
+sptr<IStreamOperatorCallback> StreamOperatorCallbackRelay::GetCallback()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return callback_;
+}
+
+int32_t StreamOperatorCallbackRelay::OnCaptureStarted(int32_t captureId, const std::vector<int32_t>& streamIds)
+{
+    sptr<IStreamOperatorCallback> callback = GetCallback();
+    return (callback != nullptr) ? callback->OnCaptureStarted(captureId, streamIds) : CAMERA_OK;
+}
+
+int32_t StreamOperatorCallbackRelay::OnCaptureEnded(int32_t captureId, const std::vector<CaptureEndedInfo>& infos)
+{
+    sptr<IStreamOperatorCallback> callback = GetCallback();
+    return (callback != nullptr) ? callback->OnCaptureEnded(captureId, infos) : CAMERA_OK;
+}
+
+int32_t StreamOperatorCallbackRelay::OnCaptureError(int32_t captureId, const std::vector<CaptureErrorInfo>& infos)
+{
+    sptr<IStreamOperatorCallback> callback = GetCallback();
+    return (callback != nullptr) ? callback->OnCaptureError(captureId, infos) : CAMERA_OK;
+}
+
+int32_t StreamOperatorCallbackRelay::OnFrameShutter(int32_t captureId,
+    const std::vector<int32_t>& streamIds, uint64_t timestamp)
+{
+    sptr<IStreamOperatorCallback> callback = GetCallback();
+    return (callback != nullptr) ? callback->OnFrameShutter(captureId, streamIds, timestamp) : CAMERA_OK;
+}
+
+CameraDeviceCallback::CameraDeviceCallback(sptr<HCameraDevice> hCameraDevice,
+    sptr<HCameraHostManager> cameraHostManager, std::string cameraId)
 {
     hCameraDevice_ = hCameraDevice;
+    cameraHostManager_ = cameraHostManager;
+    cameraId_ = cameraId;
+}
+
+void CameraDeviceCallback::SetCameraDevice(sptr<HCameraDevice> hCameraDevice)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    hCameraDevice_ = hCameraDevice;
+}
+
+sptr<HCameraDevice> CameraDeviceCallback::GetCameraDevice()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return hCameraDevice_;
 }
 
 int32_t CameraDeviceCallback::OnError(const ErrorType type, const int32_t errorCode)
 {
-    hCameraDevice_->OnError(type, errorCode);
+    sptr<HCameraDevice> hCameraDevice = GetCameraDevice();
+    if (hCameraDevice == nullptr) {
+        MEDIA_INFO_LOG("CameraDeviceCallback::OnError kept alive camera %{public}s error type: %{public}d",
+                       cameraId_.c_str(), type);
+        cameraHostManager_->EvictKeptAliveDevice(cameraId_, type == DEVICE_PREEMPT);
+        return CAMERA_OK;
+    }
+    hCameraDevice->OnError(type, errorCode);
     return CAMERA_OK;
 }
 
 int32_t CameraDeviceCallback::OnResult(uint64_t timestamp, const std::vector<uint8_t>& result)
 {
-    std::shared_ptr<OHOS::Camera::CameraMetadata> cameraResult;
-    OHOS::Camera::MetadataUtils::ConvertVecToMetadata(result, cameraResult);
-    hCameraDevice_->OnResult(timestamp, cameraResult);
+    sptr<HCameraDevice> hCameraDevice = GetCameraDevice();
+    if (hCameraDevice == nullptr) {
+        return CAMERA_OK;
+    }
+    hCameraDevice->OnResult(timestamp, result);
     return CAMERA_OK;
 }
 } // namespace CameraStandard
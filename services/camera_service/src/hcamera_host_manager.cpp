@@ -15,8 +15,11 @@
 
 #include "hcamera_host_manager.h"
 
+#include <algorithm>
+
 #include "v1_0/icamera_host_callback.h"
 #include "metadata_utils.h"
+#include "camera_stream_validation_cache.h"
 #include "camera_util.h"
 #include "hdf_io_service_if.h"
 #include "iservmgr_hdi.h"
@@ -24,16 +27,41 @@
 
 namespace OHOS {
 namespace CameraStandard {
+static const int32_t MAX_DEVICE_KEEP_ALIVE_MS = 10000;
+
+#ifndef CAMERA_DEVICE_KEEP_ALIVE_MS
+#define CAMERA_DEVICE_KEEP_ALIVE_MS 0
+#endif
+
+#ifdef CAMERA_DEVICE_PREWARM
+static const bool DEFAULT_DEVICE_PREWARM = true;
+#else
+static const bool DEFAULT_DEVICE_PREWARM = false;
+#endif
+
 struct HCameraHostManager::CameraDeviceInfo {
     std::string cameraId;
     std::shared_ptr<OHOS::Camera::CameraMetadata> ability;
+    // The ability as the HDI sent it, handed back to the HDI on stream commits
+    std::vector<uint8_t> serializedAbility;
     std::mutex mutex;
+    uint64_t abilityGeneration;
+    StreamValidationCache validationCache;
 
     explicit CameraDeviceInfo(const std::string& cameraId, sptr<ICameraDevice> device = nullptr)
-        : cameraId(cameraId), ability(nullptr)
+        : cameraId(cameraId), ability(nullptr), abilityGeneration(0)
     {
     }
 
+    void InvalidateAbility()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ability = nullptr;
+        serializedAbility.clear();
+        abilityGeneration++;
+        validationCache.Clear();
+    }
+
     ~CameraDeviceInfo() = default;
 };
 
@@ -49,6 +77,14 @@ public:
     int32_t OpenCamera(std::string& cameraId, const sptr<ICameraDeviceCallback>& callback,
                        sptr<ICameraDevice>& pDevice);
     int32_t SetFlashlight(const std::string& cameraId, bool isEnable);
+    bool GetSerializedAbility(const std::string& cameraId,
+                              const std::shared_ptr<OHOS::Camera::CameraMetadata>& ability,
+                              std::vector<uint8_t>& setting);
+    bool IsStreamsValidated(const std::string& cameraId, const std::vector<StreamInfo>& streamInfos,
+                            uint64_t& abilityGeneration);
+    void AddValidatedStreams(const std::string& cameraId, const std::vector<StreamInfo>& streamInfos,
+                             uint64_t abilityGeneration);
+    void DumpValidationCache(const std::string& cameraId, std::string& dumpString);
 
     // CameraHostCallbackStub
     int32_t OnCameraStatus(const std::string& cameraId, HDI::Camera::V1_0::CameraStatus status) override;
@@ -131,10 +167,10 @@ int32_t HCameraHostManager::CameraHostInfo::GetCameraAbility(std::string& camera
         return CAMERA_UNKNOWN_ERROR;
     }
 
+    std::lock_guard<std::mutex> lock(deviceInfo->mutex);
     if (deviceInfo->ability) {
         ability = deviceInfo->ability;
     } else {
-        std::lock_guard<std::mutex> lock(deviceInfo->mutex);
         if (cameraHostProxy_ == nullptr) {
             MEDIA_ERR_LOG("CameraHostInfo::GetCameraAbility cameraHostProxy_ is null");
             return CAMERA_UNKNOWN_ERROR;
@@ -148,6 +184,9 @@ int32_t HCameraHostManager::CameraHostInfo::GetCameraAbility(std::string& camera
             }
             OHOS::Camera::MetadataUtils::ConvertVecToMetadata(cameraAbility, ability);
             deviceInfo->ability = ability;
+            deviceInfo->serializedAbility = std::move(cameraAbility);
+            deviceInfo->abilityGeneration++;
+            deviceInfo->validationCache.Clear();
         }
     }
     return CAMERA_OK;
@@ -192,6 +231,61 @@ int32_t HCameraHostManager::CameraHostInfo::SetFlashlight(const std::string& cam
     return CAMERA_OK;
 }
 
+bool HCameraHostManager::CameraHostInfo::GetSerializedAbility(const std::string& cameraId,
+    const std::shared_ptr<OHOS::Camera::CameraMetadata>& ability, std::vector<uint8_t>& setting)
+{
+    auto deviceInfo = FindCameraDeviceInfo(cameraId);
+    if (deviceInfo == nullptr) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(deviceInfo->mutex);
+    if (ability == nullptr || deviceInfo->ability != ability || deviceInfo->serializedAbility.empty()) {
+        return false;
+    }
+    setting = deviceInfo->serializedAbility;
+    return true;
+}
+
+bool HCameraHostManager::CameraHostInfo::IsStreamsValidated(const std::string& cameraId,
+    const std::vector<StreamInfo>& streamInfos, uint64_t& abilityGeneration)
+{
+    auto deviceInfo = FindCameraDeviceInfo(cameraId);
+    if (deviceInfo == nullptr) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(deviceInfo->mutex);
+    abilityGeneration = deviceInfo->abilityGeneration;
+    return deviceInfo->validationCache.Find(streamInfos, abilityGeneration);
+}
+
+void HCameraHostManager::CameraHostInfo::AddValidatedStreams(const std::string& cameraId,
+    const std::vector<StreamInfo>& streamInfos, uint64_t abilityGeneration)
+{
+    auto deviceInfo = FindCameraDeviceInfo(cameraId);
+    if (deviceInfo == nullptr) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(deviceInfo->mutex);
+    // A set checked against an ability that changed since is not kept
+    if (abilityGeneration == deviceInfo->abilityGeneration) {
+        deviceInfo->validationCache.Add(streamInfos, abilityGeneration);
+    }
+}
+
+void HCameraHostManager::CameraHostInfo::DumpValidationCache(const std::string& cameraId, std::string& dumpString)
+{
+    auto deviceInfo = FindCameraDeviceInfo(cameraId);
+    if (deviceInfo == nullptr) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(deviceInfo->mutex);
+    dumpString += "    ## Stream Validation Cache: \n";
+    dumpString += "        Entries:[" + std::to_string(deviceInfo->validationCache.GetSize())
+        + "]    Hits:[" + std::to_string(deviceInfo->validationCache.GetHits())
+        + "]    Misses:[" + std::to_string(deviceInfo->validationCache.GetMisses())
+        + "]    Ability Generation:[" + std::to_string(deviceInfo->abilityGeneration) + "]:\n";
+}
+
 int32_t HCameraHostManager::CameraHostInfo::OnCameraStatus(const std::string& cameraId,
                                                            HDI::Camera::V1_0::CameraStatus status)
 {
@@ -273,6 +367,7 @@ int32_t HCameraHostManager::CameraHostInfo::OnCameraEvent(const std::string &cam
             MEDIA_INFO_LOG("CameraHostInfo::OnCameraEvent, camera %{public}s unavailable", cameraId.c_str());
             svcStatus = CAMERA_STATUS_UNAVAILABLE;
             RemoveDevice(cameraId);
+            cameraHostManager_->EvictKeptAliveDevice(cameraId, true);
             break;
         }
         case CAMERA_EVENT_DEVICE_ADD: {
@@ -312,6 +407,12 @@ void HCameraHostManager::CameraHostInfo::AddDevice(const std::string& cameraId)
         devices_.push_back(std::make_shared<HCameraHostManager::CameraDeviceInfo>(cameraId));
         MEDIA_INFO_LOG("CameraHostInfo::AddDevice, camera %{public}s added", cameraId.c_str());
     } else {
+        // A device that comes back may report a different ability, drop what was cached for it
+        for (const auto& deviceInfo : devices_) {
+            if (deviceInfo->cameraId == cameraId) {
+                deviceInfo->InvalidateAbility();
+            }
+        }
         MEDIA_WARNING_LOG("CameraHostInfo::AddDevice, camera %{public}s already exists", cameraId.c_str());
     }
 }
@@ -326,12 +427,14 @@ void HCameraHostManager::CameraHostInfo::RemoveDevice(const std::string& cameraI
 }
 
 HCameraHostManager::HCameraHostManager(StatusCallback* statusCallback)
-    : statusCallback_(statusCallback), cameraHostInfos_()
+    : statusCallback_(statusCallback), cameraHostInfos_(), keepAliveMs_(CAMERA_DEVICE_KEEP_ALIVE_MS),
+      isDevicePrewarmEnabled_(DEFAULT_DEVICE_PREWARM)
 {
 }
 
 HCameraHostManager::~HCameraHostManager()
 {
+    StopDevicePool();
     statusCallback_ = nullptr;
 }
 
@@ -353,6 +456,7 @@ int32_t HCameraHostManager::Init()
 
 void HCameraHostManager::DeInit()
 {
+    StopDevicePool();
     using namespace OHOS::HDI::ServiceManager::V1_0;
     auto svcMgr = IServiceManager::Get();
     if (svcMgr == nullptr) {
@@ -410,9 +514,243 @@ int32_t HCameraHostManager::SetFlashlight(const std::string& cameraId, bool isEn
         MEDIA_ERR_LOG("HCameraHostManager::OpenCameraDevice failed with invalid device info");
         return CAMERA_INVALID_ARG;
     }
+    // The torch cannot be driven while the device is held open for reuse
+    EvictKeptAliveDevice(cameraId, false);
     return cameraHostInfo->SetFlashlight(cameraId, isEnable);
 }
 
+void HCameraHostManager::GetSerializedAbility(const std::string& cameraId,
+                                              const std::shared_ptr<OHOS::Camera::CameraMetadata>& ability,
+                                              std::vector<uint8_t>& setting)
+{
+    auto cameraHostInfo = FindCameraHostInfo(cameraId);
+    if (cameraHostInfo == nullptr || !cameraHostInfo->GetSerializedAbility(cameraId, ability, setting)) {
+        OHOS::Camera::MetadataUtils::ConvertMetadataToVec(ability, setting);
+    }
+}
+
+bool HCameraHostManager::IsStreamsValidated(const std::string& cameraId, const std::vector<StreamInfo>& streamInfos,
+                                            uint64_t& abilityGeneration)
+{
+    auto cameraHostInfo = FindCameraHostInfo(cameraId);
+    if (cameraHostInfo == nullptr) {
+        return false;
+    }
+    return cameraHostInfo->IsStreamsValidated(cameraId, streamInfos, abilityGeneration);
+}
+
+void HCameraHostManager::AddValidatedStreams(const std::string& cameraId, const std::vector<StreamInfo>& streamInfos,
+                                             uint64_t abilityGeneration)
+{
+    auto cameraHostInfo = FindCameraHostInfo(cameraId);
+    if (cameraHostInfo == nullptr) {
+        return;
+    }
+    cameraHostInfo->AddValidatedStreams(cameraId, streamInfos, abilityGeneration);
+}
+
+void HCameraHostManager::DumpValidationCache(const std::string& cameraId, std::string& dumpString)
+{
+    auto cameraHostInfo = FindCameraHostInfo(cameraId);
+    if (cameraHostInfo == nullptr) {
+        return;
+    }
+    cameraHostInfo->DumpValidationCache(cameraId, dumpString);
+}
+
+void HCameraHostManager::SetDevicePrewarm(bool isEnabled)
+{
+    MEDIA_INFO_LOG("HCameraHostManager::SetDevicePrewarm %{public}d", isEnabled);
+    isDevicePrewarmEnabled_ = isEnabled;
+}
+
+bool HCameraHostManager::IsDevicePrewarmEnabled()
+{
+    return isDevicePrewarmEnabled_;
+}
+
+void HCameraHostManager::SetDeviceKeepAliveTime(int32_t keepAliveMs)
+{
+    {
+        std::lock_guard<std::mutex> lock(poolMutex_);
+        keepAliveMs_ = std::min(std::max(keepAliveMs, 0), MAX_DEVICE_KEEP_ALIVE_MS);
+        MEDIA_INFO_LOG("HCameraHostManager::SetDeviceKeepAliveTime %{public}d ms", keepAliveMs_);
+        if (keepAliveMs_ > 0) {
+            return;
+        }
+    }
+    FlushKeptAliveDevices();
+}
+
+bool HCameraHostManager::KeepAliveCameraDevice(const std::string& cameraId, int32_t ownerUid,
+    const sptr<ICameraDevice>& device, const sptr<ICameraDeviceCallback>& callback)
+{
+    if (device == nullptr || callback == nullptr) {
+        return false;
+    }
+    sptr<ICameraDevice> replacedDevice = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(poolMutex_);
+        if (keepAliveMs_ <= 0 || isPoolStopping_) {
+            return false;
+        }
+        auto it = devicePool_.find(cameraId);
+        if (it != devicePool_.end() && it->second.device != device) {
+            replacedDevice = it->second.device;
+            poolEvicted_++;
+        }
+        devicePool_[cameraId] = {device, callback, ownerUid,
+                                 std::chrono::steady_clock::now() + std::chrono::milliseconds(keepAliveMs_)};
+        if (!poolReaper_.joinable()) {
+            poolReaper_ = std::thread(&HCameraHostManager::DevicePoolReaper, this);
+        }
+    }
+    poolCond_.notify_all();
+    if (replacedDevice != nullptr) {
+        replacedDevice->Close();
+    }
+    MEDIA_INFO_LOG("HCameraHostManager::KeepAliveCameraDevice camera %{public}s kept open", cameraId.c_str());
+    return true;
+}
+
+bool HCameraHostManager::AcquireKeptAliveDevice(const std::string& cameraId, int32_t ownerUid,
+    sptr<ICameraDevice>& device, sptr<ICameraDeviceCallback>& callback)
+{
+    sptr<ICameraDevice> evictedDevice = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(poolMutex_);
+        auto it = devicePool_.find(cameraId);
+        if (it == devicePool_.end()) {
+            if (keepAliveMs_ > 0) {
+                poolMisses_++;
+            }
+            return false;
+        }
+        if (it->second.ownerUid == ownerUid) {
+            device = it->second.device;
+            callback = it->second.callback;
+            devicePool_.erase(it);
+            poolHits_++;
+            MEDIA_INFO_LOG("HCameraHostManager::AcquireKeptAliveDevice camera %{public}s reused", cameraId.c_str());
+            return true;
+        }
+        // Settings left by another client must not carry over, so that device is reopened afresh
+        evictedDevice = it->second.device;
+        devicePool_.erase(it);
+        poolMisses_++;
+        poolEvicted_++;
+    }
+    evictedDevice->Close();
+    return false;
+}
+
+void HCameraHostManager::EvictKeptAliveDevice(const std::string& cameraId, bool isDeviceLost)
+{
+    sptr<ICameraDevice> evictedDevice = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(poolMutex_);
+        auto it = devicePool_.find(cameraId);
+        if (it == devicePool_.end()) {
+            return;
+        }
+        evictedDevice = it->second.device;
+        devicePool_.erase(it);
+        if (isDeviceLost) {
+            poolLost_++;
+        } else {
+            poolEvicted_++;
+        }
+    }
+    MEDIA_INFO_LOG("HCameraHostManager::EvictKeptAliveDevice camera %{public}s, lost: %{public}d",
+                   cameraId.c_str(), isDeviceLost);
+    // A preempted or removed device is already gone on the HDI side
+    if (!isDeviceLost) {
+        evictedDevice->Close();
+    }
+}
+
+int32_t HCameraHostManager::FlushKeptAliveDevices()
+{
+    std::vector<sptr<ICameraDevice>> evictedDevices;
+    {
+        std::lock_guard<std::mutex> lock(poolMutex_);
+        for (auto& it : devicePool_) {
+            evictedDevices.emplace_back(it.second.device);
+        }
+        devicePool_.clear();
+        poolEvicted_ += evictedDevices.size();
+    }
+    for (auto& device : evictedDevices) {
+        device->Close();
+    }
+    return static_cast<int32_t>(evictedDevices.size());
+}
+
+void HCameraHostManager::DevicePoolReaper()
+{
+    std::unique_lock<std::mutex> lock(poolMutex_);
+    while (!isPoolStopping_) {
+        if (devicePool_.empty()) {
+            poolCond_.wait(lock);
+            continue;
+        }
+        auto now = std::chrono::steady_clock::now();
+        auto nextExpiry = std::chrono::steady_clock::time_point::max();
+        std::vector<sptr<ICameraDevice>> expiredDevices;
+        for (auto it = devicePool_.begin(); it != devicePool_.end();) {
+            if (it->second.expiry <= now) {
+                MEDIA_INFO_LOG("HCameraHostManager::DevicePoolReaper camera %{public}s expired", it->first.c_str());
+                expiredDevices.emplace_back(it->second.device);
+                it = devicePool_.erase(it);
+                poolExpired_++;
+            } else {
+                nextExpiry = std::min(nextExpiry, it->second.expiry);
+                ++it;
+            }
+        }
+        if (!expiredDevices.empty()) {
+            lock.unlock();
+            for (auto& device : expiredDevices) {
+                device->Close();
+            }
+            lock.lock();
+            continue;
+        }
+        poolCond_.wait_until(lock, nextExpiry);
+    }
+}
+
+void HCameraHostManager::StopDevicePool()
+{
+    {
+        std::lock_guard<std::mutex> lock(poolMutex_);
+        isPoolStopping_ = true;
+    }
+    poolCond_.notify_all();
+    if (poolReaper_.joinable()) {
+        poolReaper_.join();
+    }
+    FlushKeptAliveDevices();
+}
+
+void HCameraHostManager::DumpDevicePool(std::string& dumpString)
+{
+    std::lock_guard<std::mutex> lock(poolMutex_);
+    auto now = std::chrono::steady_clock::now();
+    dumpString += "# Device Keep-Alive Time:[" + std::to_string(keepAliveMs_) + " ms]:\n";
+    dumpString += "# Kept Alive Devices:[" + std::to_string(devicePool_.size())
+        + "]    Hits:[" + std::to_string(poolHits_)
+        + "]    Misses:[" + std::to_string(poolMisses_)
+        + "]    Expired:[" + std::to_string(poolExpired_)
+        + "]    Evicted:[" + std::to_string(poolEvicted_)
+        + "]    Lost:[" + std::to_string(poolLost_) + "]:\n";
+    for (auto& it : devicePool_) {
+        int64_t remainingMs = std::chrono::duration_cast<std::chrono::milliseconds>(it.second.expiry - now).count();
+        dumpString += "    Camera ID:[" + it.first + "]    Owner Uid:[" + std::to_string(it.second.ownerUid)
+            + "]    Closes In:[" + std::to_string(std::max<int64_t>(remainingMs, 0)) + " ms]:\n";
+    }
+}
+
 void HCameraHostManager::OnReceive(const HDI::ServiceManager::V1_0::ServiceStatus& status)
 {
     MEDIA_INFO_LOG("HCameraHostManager::OnReceive for camera host %{public}s, status %{public}d",
@@ -471,6 +809,7 @@ void HCameraHostManager::RemoveCameraHost(const std::string& svcName)
     std::vector<std::string> cameraIds;
     if ((*it)->GetCameras(cameraIds) == CAMERA_OK) {
         for (const auto& cameraId : cameraIds) {
+            EvictKeptAliveDevice(cameraId, true);
             (*it)->OnCameraStatus(cameraId, UN_AVAILABLE);
         }
     }
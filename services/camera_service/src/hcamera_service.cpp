@@ -20,6 +20,8 @@
 
 #include "access_token.h"
 #include "accesstoken_kit.h"
+#include "camera_latency_stats.h"
+#include "camera_telemetry.h"
 #include "camera_util.h"
 #include "iservice_registry.h"
 #include "camera_log.h"
@@ -32,7 +34,6 @@ REGISTER_SYSTEM_ABILITY_BY_ID(HCameraService, CAMERA_SERVICE_ID, true)
 HCameraService::HCameraService(int32_t systemAbilityId, bool runOnCreate)
     : SystemAbility(systemAbilityId, runOnCreate),
       cameraHostManager_(nullptr),
-      streamOperatorCallback_(nullptr),
       cameraServiceCallback_(nullptr)
 {
 }
@@ -73,6 +74,7 @@ void HCameraService::OnStop()
         delete cameraHostManager_;
         cameraHostManager_ = nullptr;
     }
+    CameraTelemetry::GetInstance().Stop();
 }
 
 int32_t HCameraService::GetCameras(std::vector<std::string> &cameraIds,
@@ -160,6 +162,10 @@ int32_t HCameraService::CreateCameraDevice(std::string cameraId, sptr<ICameraDev
         return CAMERA_ALLOC_ERROR;
     }
     devices_.insert(std::make_pair(cameraId, cameraDevice));
+    if (cameraHostManager_->IsDevicePrewarmEnabled()) {
+        // Opens the device while the client is still adding outputs, CommitConfig picks it up
+        cameraDevice->Prewarm();
+    }
     device = cameraDevice;
     CAMERA_SYSEVENT_STATISTIC(CreateMsg("CameraManager_CreateCameraInput CameraId:%s", cameraId.c_str()));
     return CAMERA_OK;
@@ -169,16 +175,14 @@ int32_t HCameraService::CreateCaptureSession(sptr<ICaptureSession> &session)
 {
     CAMERA_SYNC_TRACE;
     sptr<HCaptureSession> captureSession;
-    if (streamOperatorCallback_ == nullptr) {
-        streamOperatorCallback_ = new(std::nothrow) StreamOperatorCallback();
-        if (streamOperatorCallback_ == nullptr) {
-            MEDIA_ERR_LOG("HCameraService::CreateCaptureSession streamOperatorCallback_ allocation failed");
-            return CAMERA_ALLOC_ERROR;
-        }
+    sptr<StreamOperatorCallback> streamOperatorCallback = new(std::nothrow) StreamOperatorCallback();
+    if (streamOperatorCallback == nullptr) {
+        MEDIA_ERR_LOG("HCameraService::CreateCaptureSession streamOperatorCallback allocation failed");
+        return CAMERA_ALLOC_ERROR;
     }
 
     std::lock_guard<std::mutex> lock(mutex_);
-    captureSession = new(std::nothrow) HCaptureSession(cameraHostManager_, streamOperatorCallback_);
+    captureSession = new(std::nothrow) HCaptureSession(cameraHostManager_, streamOperatorCallback);
     if (captureSession == nullptr) {
         MEDIA_ERR_LOG("HCameraService::CreateCaptureSession HCaptureSession allocation failed");
         return CAMERA_ALLOC_ERROR;
@@ -233,7 +237,7 @@ int32_t HCameraService::CreateCustomPreviewOutput(const sptr<OHOS::IBufferProduc
     CAMERA_SYNC_TRACE;
     sptr<HStreamRepeat> streamRepeatPreview;
 
-    if ((producer == nullptr) || (width == 0) || (height == 0)) {
+    if ((producer == nullptr) || (width <= 0) || (height <= 0)) {
         MEDIA_ERR_LOG("HCameraService::CreateCustomPreviewOutput producer is null or invalid custom size is set");
         return CAMERA_INVALID_ARG;
     }
@@ -247,6 +251,26 @@ int32_t HCameraService::CreateCustomPreviewOutput(const sptr<OHOS::IBufferProduc
     return CAMERA_OK;
 }
 
+int32_t HCameraService::CreateDeferredPreviewOutput(int32_t format, int32_t width, int32_t height,
+                                                    sptr<IStreamRepeat> &previewOutput)
+{
+    CAMERA_SYNC_TRACE;
+    sptr<HStreamRepeat> streamRepeatPreview;
+
+    if ((width <= 0) || (height <= 0)) {
+        MEDIA_ERR_LOG("HCameraService::CreateDeferredPreviewOutput invalid size is set");
+        return CAMERA_INVALID_ARG;
+    }
+    streamRepeatPreview = new(std::nothrow) HStreamRepeat(nullptr, format, width, height, false);
+    if (streamRepeatPreview == nullptr) {
+        MEDIA_ERR_LOG("HCameraService::CreateDeferredPreviewOutput HStreamRepeat allocation failed");
+        return CAMERA_ALLOC_ERROR;
+    }
+    POWERMGR_SYSEVENT_CAMERA_CONFIG(PREVIEW, width, height);
+    previewOutput = streamRepeatPreview;
+    return CAMERA_OK;
+}
+
 int32_t HCameraService::CreateMetadataOutput(const sptr<OHOS::IBufferProducer> &producer, int32_t format,
                                              sptr<IStreamMetadata> &metadataOutput)
 {
@@ -289,6 +313,26 @@ int32_t HCameraService::CreateVideoOutput(const sptr<OHOS::IBufferProducer> &pro
     return CAMERA_OK;
 }
 
+int32_t HCameraService::CreateDeferredVideoOutput(int32_t format, int32_t width, int32_t height,
+                                                  sptr<IStreamRepeat> &videoOutput)
+{
+    CAMERA_SYNC_TRACE;
+    sptr<HStreamRepeat> streamRepeatVideo;
+
+    if ((width <= 0) || (height <= 0)) {
+        MEDIA_ERR_LOG("HCameraService::CreateDeferredVideoOutput invalid size is set");
+        return CAMERA_INVALID_ARG;
+    }
+    streamRepeatVideo = new(std::nothrow) HStreamRepeat(nullptr, format, width, height, true);
+    if (streamRepeatVideo == nullptr) {
+        MEDIA_ERR_LOG("HCameraService::CreateDeferredVideoOutput HStreamRepeat allocation failed");
+        return CAMERA_ALLOC_ERROR;
+    }
+    POWERMGR_SYSEVENT_CAMERA_CONFIG(VIDEO, width, height);
+    videoOutput = streamRepeatVideo;
+    return CAMERA_OK;
+}
+
 void HCameraService::OnCameraStatus(const std::string& cameraId, CameraStatus status)
 {
     if (cameraServiceCallback_) {
@@ -325,6 +369,8 @@ void HCameraService::CameraSummary(std::vector<std::string> cameraIds,
     dumpString += "# Number of Cameras:[" + std::to_string(cameraIds.size()) + "]:\n";
     dumpString += "# Number of Active Cameras:[" + std::to_string(devices_.size()) + "]:\n";
     HCaptureSession::CameraSessionSummary(dumpString);
+    cameraHostManager_->DumpDevicePool(dumpString);
+    CameraTelemetry::GetInstance().Dump(dumpString);
 }
 
 void HCameraService::CameraDumpAbility(common_metadata_header_t *metadataEntry,
@@ -613,6 +659,8 @@ int32_t HCameraService::Dump(int fd, const std::vector<std::u16string>& args)
     std::u16string arg1(u"summary");
     std::u16string arg2(u"ability");
     std::u16string arg3(u"clientwiseinfo");
+    std::u16string arg4(u"perf");
+    std::u16string arg5(u"perfreset");
     for (decltype(args.size()) index = 0; index < args.size(); ++index) {
         argSets.insert(args[index]);
     }
@@ -647,12 +695,21 @@ int32_t HCameraService::Dump(int fd, const std::vector<std::u16string>& args)
             CameraDumpSensorInfo(metadataEntry, dumpString);
             CameraDumpVideoStabilization(metadataEntry, dumpString);
             CameraDumpVideoFrameRateRange(metadataEntry, dumpString);
+            cameraHostManager_->DumpValidationCache(it, dumpString);
         }
     }
     if (args.size() == 0 || argSets.count(arg3) != 0) {
         dumpString += "-------- Clientwise Info -------\n";
         HCaptureSession::dumpSessions(dumpString);
     }
+    if (args.size() == 0 || argSets.count(arg4) != 0) {
+        dumpString += "-------- Latency -------\n";
+        CameraLatencyStats::GetInstance().Dump(dumpString);
+    }
+    if (argSets.count(arg5) != 0) {
+        CameraLatencyStats::GetInstance().Reset();
+        dumpString += "# Latency histograms reset\n";
+    }
 
     if (dumpString.size() == 0) {
         MEDIA_ERR_LOG("Dump string empty!");
@@ -15,10 +15,13 @@
 
 #include "hcapture_session.h"
 
+#include <thread>
+#include "camera_latency_stats.h"
 #include "camera_util.h"
 #include "camera_log.h"
 #include "surface.h"
 #include "ipc_skeleton.h"
+#include "accesstoken_kit.h"
 #include "metadata_utils.h"
 #include "bundle_mgr_interface.h"
 #include "iservice_registry.h"
@@ -63,45 +66,71 @@ static std::string GetClientBundle(int uid)
     return bundleName;
 }
 
+static int32_t GetClientPriority(Security::AccessToken::AccessTokenID callerToken)
+{
+    Security::AccessToken::ATokenTypeEnum tokenType =
+        Security::AccessToken::AccessTokenKit::GetTokenTypeFlag(callerToken);
+    if (tokenType == Security::AccessToken::ATokenTypeEnum::TOKEN_NATIVE) {
+        return CAMERA_CLIENT_PRIORITY_SYSTEM;
+    }
+    return CAMERA_CLIENT_PRIORITY_APP;
+}
+
 HCaptureSession::HCaptureSession(sptr<HCameraHostManager> cameraHostManager,
     sptr<StreamOperatorCallback> streamOperatorCb)
     : cameraHostManager_(cameraHostManager), streamOperatorCallback_(streamOperatorCb),
     sessionCallback_(nullptr)
 {
-    std::map<int32_t, sptr<HCaptureSession>>::iterator it;
     pid_ = IPCSkeleton::GetCallingPid();
     uid_ = IPCSkeleton::GetCallingUid();
+    priority_ = GetClientPriority(IPCSkeleton::GetCallingTokenID());
     sessionState_.insert(std::make_pair(CaptureSessionState::SESSION_INIT, "Init"));
     sessionState_.insert(std::make_pair(CaptureSessionState::SESSION_CONFIG_INPROGRESS, "Config_In-progress"));
     sessionState_.insert(std::make_pair(CaptureSessionState::SESSION_CONFIG_COMMITTED, "Committed"));
-
-    MEDIA_DEBUG_LOG("HCaptureSession: camera stub services(%{public}zu) pid(%{public}d).", session_.size(), pid_);
-    std::map<int32_t, sptr<HCaptureSession>> oldSessions;
-    for (auto it = session_.begin(); it != session_.end(); it++) {
-        sptr<HCaptureSession> session = it->second;
-        oldSessions[it->first] = session;
+    sessionState_.insert(std::make_pair(CaptureSessionState::SESSION_CONFIG_COMMITTING, "Config_Committing"));
+
+    sptr<HCaptureSession> oldSession;
+    {
+        std::lock_guard<std::mutex> lock(sessionLock_);
+        MEDIA_DEBUG_LOG("HCaptureSession: camera stub services(%{public}zu) pid(%{public}d).", session_.size(), pid_);
+        auto it = session_.find(pid_);
+        if (it != session_.end()) {
+            oldSession = it->second;
+        }
     }
-    for (auto it = oldSessions.begin(); it != oldSessions.end(); it++) {
-        sptr<HCaptureSession> session = it->second;
+    if (oldSession != nullptr) {
         sptr<HCameraDevice> disconnectDevice;
-        int32_t rc = session->GetCurrentCameraDevice(disconnectDevice);
+        int32_t rc = oldSession->GetCurrentCameraDevice(disconnectDevice);
         if (rc == CAMERA_OK) {
             disconnectDevice->OnError(DEVICE_PREEMPT, 0);
         }
-        session->Release(it->first);
-        MEDIA_ERR_LOG("currently multi-session not supported, release session for pid(%{public}d)", it->first);
-    }
-    it = session_.find(pid_);
-    if (it != session_.end()) {
-        MEDIA_ERR_LOG("HCaptureSession::HCaptureSession doesn't support multiple sessions per pid");
-    } else {
-        session_[pid_] = this;
+        oldSession->Release(pid_);
+        MEDIA_INFO_LOG("HCaptureSession: one session per pid, release previous session for pid(%{public}d)", pid_);
     }
+    std::lock_guard<std::mutex> lock(sessionLock_);
+    session_[pid_] = this;
     MEDIA_DEBUG_LOG("HCaptureSession: camera stub services(%{public}zu).", session_.size());
 }
 
 HCaptureSession::~HCaptureSession()
-{}
+{
+    // The worker holds a reference to the session, so it has either finished or is dropping the last one
+    if (commitWorker_.joinable()) {
+        if (commitWorker_.get_id() == std::this_thread::get_id()) {
+            commitWorker_.detach();
+        } else {
+            commitWorker_.join();
+        }
+    }
+}
+
+static sptr<HStreamRepeat> GetSharedSource(const sptr<HStreamCommon> &stream)
+{
+    if (stream->GetStreamType() != StreamType::REPEAT) {
+        return nullptr;
+    }
+    return static_cast<HStreamRepeat *>(stream.GetRefPtr())->GetSharedSource();
+}
 
 int32_t HCaptureSession::BeginConfig()
 {
@@ -110,6 +139,10 @@ int32_t HCaptureSession::BeginConfig()
         MEDIA_ERR_LOG("HCaptureSession::BeginConfig Already in config inprogress state!");
         return CAMERA_INVALID_STATE;
     }
+    if (curState_ == CaptureSessionState::SESSION_CONFIG_COMMITTING) {
+        MEDIA_ERR_LOG("HCaptureSession::BeginConfig Previous commit has not completed yet!");
+        return CAMERA_INVALID_STATE;
+    }
     prevState_ = curState_;
     curState_ = CaptureSessionState::SESSION_CONFIG_INPROGRESS;
     tempCameraDevices_.clear();
@@ -162,6 +195,7 @@ int32_t HCaptureSession::AddOutputStream(sptr<HStreamCommon> stream)
     }
     stream->SetReleaseStream(false);
     tempStreams_.emplace_back(stream);
+    UpdateSensorRateSharing();
     return CAMERA_OK;
 }
 
@@ -229,14 +263,25 @@ int32_t HCaptureSession::RemoveOutputStream(sptr<HStreamCommon> stream)
         it = std::find(streams_.begin(), streams_.end(), stream);
         if (it != streams_.end()) {
             if (!stream->IsReleaseStream()) {
-                deletedStreamIds_.emplace_back(stream->GetStreamId());
                 stream->SetReleaseStream(true);
+                sptr<HStreamRepeat> sharedSource = GetSharedSource(stream);
+                auto isFedBySource = [&sharedSource](const auto &curStream) {
+                    return !curStream->IsReleaseStream() && GetSharedSource(curStream) == sharedSource;
+                };
+                if (sharedSource == nullptr) {
+                    deletedStreamIds_.emplace_back(stream->GetStreamId());
+                } else if (std::none_of(streams_.begin(), streams_.end(), isFedBySource)) {
+                    // The HDI stream goes with the last output it feeds
+                    sharedSource->SetReleaseStream(true);
+                    deletedStreamIds_.emplace_back(sharedSource->GetStreamId());
+                }
             }
         } else {
             MEDIA_ERR_LOG("HCaptureSession::RemoveOutputStream Invalid output");
             return CAMERA_INVALID_SESSION_CFG;
         }
     }
+    UpdateSensorRateSharing();
     return CAMERA_OK;
 }
 
@@ -248,7 +293,12 @@ int32_t HCaptureSession::RemoveOutput(StreamType streamType, sptr<IStreamCommon>
         return rc;
     }
     if (streamType == StreamType::CAPTURE) {
-        rc = RemoveOutputStream(static_cast<HStreamCapture *>(stream.GetRefPtr()));
+        sptr<HStreamCapture> captureStream = static_cast<HStreamCapture *>(stream.GetRefPtr());
+        rc = RemoveOutputStream(captureStream);
+        if (rc == CAMERA_OK && captureStream->GetZslStream() != nullptr) {
+            // The zsl stream feeding this output is internal and goes away with it
+            RemoveOutputStream(captureStream->GetZslStream());
+        }
     } else if (streamType == StreamType::REPEAT) {
         rc = RemoveOutputStream(static_cast<HStreamRepeat *>(stream.GetRefPtr()));
     } else if (streamType == StreamType::METADATA) {
@@ -288,6 +338,10 @@ int32_t HCaptureSession::GetCameraDevice(sptr<HCameraDevice> &device)
         return CAMERA_OK;
     }
     camDevice = tempCameraDevices_[0];
+    rc = ArbitrateCameraDevice(camDevice->GetCameraId());
+    if (rc != CAMERA_OK) {
+        return rc;
+    }
     rc = camDevice->Open();
     if (rc != CAMERA_OK) {
         MEDIA_ERR_LOG("HCaptureSession::GetCameraDevice Failed to open camera, rc: %{public}d", rc);
@@ -303,6 +357,40 @@ int32_t HCaptureSession::GetCameraDevice(sptr<HCameraDevice> &device)
     return rc;
 }
 
+int32_t HCaptureSession::ArbitrateCameraDevice(const std::string &cameraId)
+{
+    std::map<int32_t, sptr<HCaptureSession>> preemptedSessions;
+    {
+        std::lock_guard<std::mutex> lock(sessionLock_);
+        for (auto it = session_.begin(); it != session_.end(); it++) {
+            sptr<HCaptureSession> session = it->second;
+            sptr<HCameraDevice> holdDevice = session->GetHeldCameraDevice();
+            if (session == this || holdDevice == nullptr || holdDevice->IsReleaseCameraDevice()
+                || holdDevice->GetCameraId() != cameraId) {
+                continue;
+            }
+            if (session->priority_ > priority_) {
+                MEDIA_ERR_LOG("HCaptureSession::ArbitrateCameraDevice camera %{public}s is held by pid(%{public}d) "
+                              "with higher priority", cameraId.c_str(), it->first);
+                return CAMERA_DEVICE_BUSY;
+            }
+            preemptedSessions[it->first] = session;
+        }
+    }
+    for (auto it = preemptedSessions.begin(); it != preemptedSessions.end(); it++) {
+        sptr<HCaptureSession> session = it->second;
+        sptr<HCameraDevice> disconnectDevice;
+        int32_t rc = session->GetCurrentCameraDevice(disconnectDevice);
+        if (rc == CAMERA_OK) {
+            disconnectDevice->OnError(DEVICE_PREEMPT, 0);
+        }
+        session->Release(it->first);
+        MEDIA_INFO_LOG("HCaptureSession::ArbitrateCameraDevice camera %{public}s preempted from pid(%{public}d) "
+                       "by pid(%{public}d)", cameraId.c_str(), it->first, pid_);
+    }
+    return CAMERA_OK;
+}
+
 int32_t HCaptureSession::GetCurrentCameraDevice(sptr<HCameraDevice> &device)
 {
     if (cameraDevice_ != nullptr && !cameraDevice_->IsReleaseCameraDevice()) {
@@ -337,6 +425,7 @@ int32_t HCaptureSession::GetCurrentStreamInfos(sptr<HCameraDevice> &device,
             continue;
         }
         if (isNeedLink) {
+            curStream->SetCameraId(device->GetCameraId());
             rc = curStream->LinkInput(streamOperator, deviceSettings, streamId);
             if (rc != CAMERA_OK) {
                 MEDIA_ERR_LOG("HCaptureSession::GetCurrentStreamInfos() Failed to link Output, %{public}d", rc);
@@ -344,6 +433,9 @@ int32_t HCaptureSession::GetCurrentStreamInfos(sptr<HCameraDevice> &device,
             }
             streamId++;
         }
+        if (GetSharedSource(curStream) != nullptr) {
+            continue;
+        }
         curStream->SetStreamInfo(curStreamInfo);
         streamInfos.push_back(curStreamInfo);
     }
@@ -364,15 +456,21 @@ int32_t HCaptureSession::CreateAndCommitStreams(sptr<HCameraDevice> &device,
     sptr<IStreamOperator> streamOperator;
     std::vector<uint8_t> setting;
 
+    std::string cameraId = device->GetCameraId();
+    CameraLatencyStats &latencyStats = CameraLatencyStats::GetInstance();
     streamOperator = device->GetStreamOperator();
     if (streamOperator != nullptr && !streamInfos.empty()) {
+        int64_t startTime = CameraLatencyStats::GetTimestampUs();
         hdiRc = (CamRetCode)(streamOperator->CreateStreams(streamInfos));
+        latencyStats.Record(cameraId, LATENCY_CREATE_STREAMS, startTime);
     } else {
         MEDIA_INFO_LOG("HCaptureSession::CreateAndCommitStreams(), No new streams to create");
     }
     if (streamOperator != nullptr && hdiRc == HDI::Camera::V1_0::NO_ERROR) {
-        OHOS::Camera::MetadataUtils::ConvertMetadataToVec(deviceSettings, setting);
+        cameraHostManager_->GetSerializedAbility(cameraId, deviceSettings, setting);
+        int64_t startTime = CameraLatencyStats::GetTimestampUs();
         hdiRc = (CamRetCode)(streamOperator->CommitStreams(NORMAL, setting));
+        latencyStats.Record(cameraId, LATENCY_COMMIT_STREAMS, startTime);
         if (hdiRc != HDI::Camera::V1_0::NO_ERROR) {
             MEDIA_ERR_LOG("HCaptureSession::CreateAndCommitStreams(), Failed to commit %{public}d", hdiRc);
             for (auto item = streamInfos.begin(); item != streamInfos.end(); ++item) {
@@ -395,11 +493,19 @@ int32_t HCaptureSession::CheckAndCommitStreams(sptr<HCameraDevice> &device,
 #ifndef PRODUCT_M40
     CamRetCode hdiRc = HDI::Camera::V1_0::NO_ERROR;
     StreamSupportType supportType = DYNAMIC_SUPPORTED;
-
+    std::string cameraId = device->GetCameraId();
     std::vector<uint8_t> setting;
-    OHOS::Camera::MetadataUtils::ConvertMetadataToVec(deviceSettings, setting);
+    uint64_t abilityGeneration = 0;
+
+    if (cameraHostManager_->IsStreamsValidated(cameraId, allStreamInfos, abilityGeneration)) {
+        MEDIA_DEBUG_LOG("HCaptureSession::CheckAndCommitStreams(), stream set already validated");
+        return CreateAndCommitStreams(device, deviceSettings, newStreamInfos);
+    }
+    cameraHostManager_->GetSerializedAbility(cameraId, deviceSettings, setting);
+    int64_t startTime = CameraLatencyStats::GetTimestampUs();
     hdiRc = (CamRetCode)(device->GetStreamOperator()->IsStreamsSupported(
         NORMAL, setting, allStreamInfos, supportType));
+    CameraLatencyStats::GetInstance().Record(cameraId, LATENCY_IS_STREAMS_SUPPORTED, startTime);
     if (hdiRc != HDI::Camera::V1_0::NO_ERROR) {
         MEDIA_ERR_LOG("HCaptureSession::CheckAndCommitStreams(), Error from HDI: %{public}d", hdiRc);
         return HdiToServiceError(hdiRc);
@@ -407,6 +513,7 @@ int32_t HCaptureSession::CheckAndCommitStreams(sptr<HCameraDevice> &device,
         MEDIA_ERR_LOG("HCaptureSession::CheckAndCommitStreams(), Config not supported %{public}d", supportType);
         return CAMERA_UNSUPPORTED;
     }
+    cameraHostManager_->AddValidatedStreams(cameraId, allStreamInfos, abilityGeneration);
 #endif
     return CreateAndCommitStreams(device, deviceSettings, newStreamInfos);
 }
@@ -441,11 +548,20 @@ void HCaptureSession::RestorePreviousState(sptr<HCameraDevice> &device, bool isC
 
     for (auto item = streams_.begin(); item != streams_.end(); ++item) {
         curStream = *item;
-        if (isCreateReleaseStreams && curStream->IsReleaseStream()) {
+        if (isCreateReleaseStreams && curStream->IsReleaseStream() && GetSharedSource(curStream) == nullptr) {
             curStream->SetStreamInfo(streamInfo);
             streamInfos.push_back(streamInfo);
         }
         curStream->SetReleaseStream(false);
+        if (curStream->GetStreamType() == StreamType::CAPTURE) {
+            // A zsl stream staged for a committed output is released below, so is the ring feeding on it
+            sptr<HStreamCapture> captureStream = static_cast<HStreamCapture *>(curStream.GetRefPtr());
+            sptr<HStreamCommon> zslStream = captureStream->GetZslStream();
+            if (zslStream != nullptr
+                && std::find(tempStreams_.begin(), tempStreams_.end(), zslStream) != tempStreams_.end()) {
+                captureStream->DisableZsl();
+            }
+        }
     }
 
     for (auto item = tempStreams_.begin(); item != tempStreams_.end(); ++item) {
@@ -464,6 +580,7 @@ void HCaptureSession::RestorePreviousState(sptr<HCameraDevice> &device, bool isC
             }
         }
     }
+    UpdateSensorRateSharing();
     curState_ = prevState_;
 }
 
@@ -485,12 +602,25 @@ void HCaptureSession::UpdateSessionConfig(sptr<HCameraDevice> &device)
         streams_.emplace_back(curStream);
     }
     tempStreams_.clear();
-    streamOperatorCallback_->SetCaptureSession(this);
-    cameraDevice_ = device;
+    for (auto item = captureStreams_.begin(); item != captureStreams_.end(); ++item) {
+        sptr<HStreamCapture> captureStream = static_cast<HStreamCapture *>((*item).GetRefPtr());
+        sptr<HStreamCommon> zslStream = captureStream->GetZslStream();
+        if (zslStream == nullptr) {
+            continue;
+        }
+        // A new depth or budget applies to the running ring, a deleted zsl stream takes its ring along
+        if (std::find(streams_.begin(), streams_.end(), zslStream) == streams_.end()) {
+            captureStream->DisableZsl();
+        } else if (captureStream->EnableZsl(zslRingDepth_, zslSelection_, zslMemoryBudget_) != CAMERA_OK) {
+            MEDIA_ERR_LOG("HCaptureSession::UpdateSessionConfig Failed to reconfigure the zsl ring");
+        }
+    }
+    streamOperatorCallback_->PublishStreams(streams_);
+    SetHeldCameraDevice(device);
     curState_ = CaptureSessionState::SESSION_CONFIG_COMMITTED;
 }
 
-int32_t HCaptureSession::HandleCaptureOuputsConfig(sptr<HCameraDevice> &device)
+int32_t HCaptureSession::HandleCaptureOuputsConfig(sptr<HCameraDevice> &device, bool isFullCommit)
 {
     int32_t rc;
     int32_t streamId;
@@ -512,7 +642,7 @@ int32_t HCaptureSession::HandleCaptureOuputsConfig(sptr<HCameraDevice> &device)
         return rc;
     }
 
-    if (cameraDevice_ != device) {
+    if (cameraDevice_ != device || isFullCommit) {
         newStreamInfos = allStreamInfos;
     }
 
@@ -524,17 +654,27 @@ int32_t HCaptureSession::HandleCaptureOuputsConfig(sptr<HCameraDevice> &device)
             MEDIA_ERR_LOG("HCaptureSession::HandleCaptureOuputsConfig() curStream is null");
             return CAMERA_UNKNOWN_ERROR;
         }
+        curStream->SetCameraId(device->GetCameraId());
         rc = curStream->LinkInput(streamOperator, settings, streamId);
         if (rc != CAMERA_OK) {
             MEDIA_ERR_LOG("HCaptureSession::HandleCaptureOuputsConfig() Failed to link Output, %{public}d", rc);
             return rc;
         }
+        streamId++;
+        if (GetSharedSource(curStream) != nullptr) {
+            // Fed by its shared source, only the source has an HDI stream
+            continue;
+        }
         curStream->SetStreamInfo(curStreamInfo);
         newStreamInfos.push_back(curStreamInfo);
         allStreamInfos.push_back(curStreamInfo);
-        streamId++;
     }
 
+    if (newStreamInfos.empty()) {
+        // Removing outputs leaves a subset of the committed set, nothing to validate or commit
+        MEDIA_DEBUG_LOG("HCaptureSession::HandleCaptureOuputsConfig() No new streams to commit");
+        return CAMERA_OK;
+    }
     rc = CheckAndCommitStreams(device, settings, allStreamInfos, newStreamInfos);
     if (rc == CAMERA_OK) {
         streamId_ = streamId;
@@ -542,10 +682,312 @@ int32_t HCaptureSession::HandleCaptureOuputsConfig(sptr<HCameraDevice> &device)
     return rc;
 }
 
-int32_t HCaptureSession::CommitConfig()
+int32_t HCaptureSession::ApplyDeltaConfig(sptr<HCameraDevice> &device, bool &isStreamsReleased)
+{
+    // Only the added and removed outputs are touched, the streams that stay keep running
+    std::vector<sptr<HStreamCommon>> removedStreams;
+    std::vector<sptr<HStreamRepeat>> liveStreams;
+    std::vector<sptr<HStreamRepeat>> stoppedStreams;
+    std::vector<sptr<HStreamCommon>> prevGroupStreams;
+    for (auto item = streams_.begin(); item != streams_.end(); ++item) {
+        if ((*item)->IsReleaseStream()) {
+            removedStreams.emplace_back(*item);
+            if ((*item)->IsGroupCapture()) {
+                prevGroupStreams = groupStreams_;
+            }
+        } else if ((*item)->GetStreamType() == StreamType::REPEAT && (*item)->curCaptureID_ != 0) {
+            liveStreams.emplace_back(static_cast<HStreamRepeat *>((*item).GetRefPtr()));
+            liveStreams.back()->BeginReconfigure();
+        }
+    }
+    if (!prevGroupStreams.empty()) {
+        // The grouped request names the removed streams, it is reissued for the remaining ones
+        StopCaptureGroup();
+    }
+    bool isDetachSupported = true;
+    for (auto item = removedStreams.begin(); item != removedStreams.end(); ++item) {
+        if ((*item)->GetStreamType() == StreamType::REPEAT && (*item)->curCaptureID_ != 0) {
+            sptr<HStreamRepeat> repeatStream = static_cast<HStreamRepeat *>((*item).GetRefPtr());
+            repeatStream->Stop();
+            stoppedStreams.emplace_back(repeatStream);
+        }
+        // Cuts the removed output off at once, the stream itself is released after the new ones are in
+        if (GetSharedSource(*item) == nullptr && isDetachSupported) {
+            int32_t detachRc = (*item)->DetachBufferQueue();
+            if (detachRc == CAMERA_UNSUPPORTED) {
+                isDetachSupported = false;
+            } else if (detachRc != CAMERA_OK) {
+                // The output keeps getting frames until its stream is released below
+                MEDIA_ERR_LOG("HCaptureSession::ApplyDeltaConfig() Failed to detach stream %{public}d, rc: %{public}d",
+                              (*item)->GetStreamId(), detachRc);
+            }
+        }
+    }
+
+    isStreamsReleased = false;
+    if (!isDetachSupported) {
+        MEDIA_INFO_LOG("HCaptureSession::ApplyDeltaConfig() Buffer queues cannot be detached, reconfiguring all");
+        if (prevGroupStreams.empty() && !groupStreams_.empty()) {
+            prevGroupStreams = groupStreams_;
+            StopCaptureGroup();
+        }
+        int32_t rc = ApplyFullConfig(device, liveStreams);
+        isStreamsReleased = (rc == CAMERA_OK);
+        // On failure the previous streams are committed again with their buffer queues attached
+        for (auto item = stoppedStreams.begin(); rc != CAMERA_OK && item != stoppedStreams.end(); ++item) {
+            (*item)->Start();
+        }
+        if (!prevGroupStreams.empty()) {
+            auto matchFunction = [rc](const auto &curStream) {
+                return rc == CAMERA_OK && curStream->IsReleaseStream();
+            };
+            prevGroupStreams.erase(std::remove_if(prevGroupStreams.begin(), prevGroupStreams.end(), matchFunction),
+                                   prevGroupStreams.end());
+            StartCaptureGroup(prevGroupStreams);
+        }
+        for (auto item = liveStreams.begin(); item != liveStreams.end(); ++item) {
+            (*item)->EndReconfigure();
+        }
+        return rc;
+    }
+    int32_t rc = HandleCaptureOuputsConfig(device, false);
+    if (rc == CAMERA_OK && !deletedStreamIds_.empty()) {
+        isStreamsReleased = true;
+        if (device->GetStreamOperator()->ReleaseStreams(deletedStreamIds_) != HDI::Camera::V1_0::NO_ERROR) {
+            // The removed streams are already detached, leaving them on the device does not affect the session
+            MEDIA_ERR_LOG("HCaptureSession::ApplyDeltaConfig() Failed to release removed streams");
+        }
+    } else if (rc != CAMERA_OK && !deletedStreamIds_.empty() && !tempStreams_.empty()) {
+        // The device may need what the removed streams hold before it can take the new ones
+        MEDIA_INFO_LOG("HCaptureSession::ApplyDeltaConfig() Retrying with removed streams released");
+        rc = HdiToServiceError((CamRetCode)(device->GetStreamOperator()->ReleaseStreams(deletedStreamIds_)));
+        if (rc == CAMERA_OK) {
+            isStreamsReleased = true;
+            rc = HandleCaptureOuputsConfig(device, false);
+        }
+    }
+    if (rc != CAMERA_OK && !isStreamsReleased) {
+        for (auto item = removedStreams.begin(); item != removedStreams.end(); ++item) {
+            if (GetSharedSource(*item) == nullptr && (*item)->AttachBufferQueue() != CAMERA_OK) {
+                MEDIA_ERR_LOG("HCaptureSession::ApplyDeltaConfig() Failed to reattach stream %{public}d, its output "
+                              "gets no frames until the next commit", (*item)->GetStreamId());
+            }
+        }
+        for (auto item = stoppedStreams.begin(); item != stoppedStreams.end(); ++item) {
+            (*item)->Start();
+        }
+    }
+    if (!prevGroupStreams.empty()) {
+        bool isRemovedRestored = (rc != CAMERA_OK && !isStreamsReleased);
+        auto matchFunction = [isRemovedRestored](const auto &curStream) {
+            return !isRemovedRestored && curStream->IsReleaseStream();
+        };
+        prevGroupStreams.erase(std::remove_if(prevGroupStreams.begin(), prevGroupStreams.end(), matchFunction),
+                               prevGroupStreams.end());
+        StartCaptureGroup(prevGroupStreams);
+    }
+    for (auto item = liveStreams.begin(); item != liveStreams.end(); ++item) {
+        (*item)->EndReconfigure();
+    }
+    return rc;
+}
+
+int32_t HCaptureSession::ApplyFullConfig(sptr<HCameraDevice> &device, std::vector<sptr<HStreamRepeat>> &liveStreams)
+{
+    // For a device that cannot change streams while others run, everything is stopped, released and
+    // committed again. The previous streams are committed back when the new configuration fails
+    std::vector<sptr<HStreamRepeat>> stoppedStreams;
+    std::vector<StreamInfo> prevStreamInfos;
+    std::vector<int32_t> streamIds;
+    StreamInfo streamInfo;
+    for (auto item = liveStreams.begin(); item != liveStreams.end(); ++item) {
+        if ((*item)->curCaptureID_ != 0 && (*item)->Stop() == CAMERA_OK) {
+            stoppedStreams.emplace_back(*item);
+        }
+    }
+    for (auto item = streams_.begin(); item != streams_.end(); ++item) {
+        if (GetSharedSource(*item) != nullptr) {
+            continue;
+        }
+        (*item)->SetStreamInfo(streamInfo);
+        prevStreamInfos.emplace_back(streamInfo);
+        streamIds.emplace_back((*item)->GetStreamId());
+    }
+    int32_t rc = HdiToServiceError((CamRetCode)(device->GetStreamOperator()->ReleaseStreams(streamIds)));
+    if (rc != CAMERA_OK) {
+        MEDIA_ERR_LOG("HCaptureSession::ApplyFullConfig() Failed to release streams, rc: %{public}d", rc);
+    } else {
+        rc = HandleCaptureOuputsConfig(device, true);
+        std::shared_ptr<OHOS::Camera::CameraMetadata> settings = (rc != CAMERA_OK) ? device->GetSettings() : nullptr;
+        if (settings != nullptr && CreateAndCommitStreams(device, settings, prevStreamInfos) != CAMERA_OK) {
+            MEDIA_ERR_LOG("HCaptureSession::ApplyFullConfig() Failed to restore the previous streams");
+        }
+    }
+    for (auto item = stoppedStreams.begin(); item != stoppedStreams.end(); ++item) {
+        (*item)->Start();
+    }
+    return rc;
+}
+
+void HCaptureSession::PrepareZslStreams()
+{
+    std::vector<sptr<HStreamCommon>> captureStreams;
+    for (auto item = streams_.begin(); item != streams_.end(); ++item) {
+        if ((*item)->GetStreamType() != StreamType::CAPTURE) {
+            continue;
+        }
+        sptr<HStreamCapture> captureStream = static_cast<HStreamCapture *>((*item).GetRefPtr());
+        sptr<HStreamRepeat> zslStream = captureStream->GetZslStream();
+        if (zslStream == nullptr) {
+            if (!(*item)->IsReleaseStream()) {
+                captureStreams.emplace_back(*item);
+            }
+        } else if ((*item)->IsReleaseStream() || zslRingDepth_ == 0) {
+            // Goes away with the commit, the ring of its output is disabled once the commit succeeded
+            zslStream->SetReleaseStream(true);
+        }
+    }
+    if (zslRingDepth_ == 0) {
+        return;
+    }
+    captureStreams.insert(captureStreams.end(), tempStreams_.begin(), tempStreams_.end());
+    std::vector<sptr<HStreamCommon>> zslStreams;
+    for (auto item = captureStreams.begin(); item != captureStreams.end(); ++item) {
+        if ((*item)->GetStreamType() != StreamType::CAPTURE) {
+            continue;
+        }
+        sptr<HStreamCapture> captureStream = static_cast<HStreamCapture *>((*item).GetRefPtr());
+        int32_t rc = captureStream->EnableZsl(zslRingDepth_, zslSelection_, zslMemoryBudget_);
+        if (rc != CAMERA_OK) {
+            // Not fatal, captures on this output go through the HDI as usual
+            MEDIA_ERR_LOG("HCaptureSession::PrepareZslStreams Failed to enable zsl, rc: %{public}d", rc);
+            continue;
+        }
+        sptr<HStreamCommon> zslStream = captureStream->GetZslStream();
+        if (std::find(streams_.begin(), streams_.end(), zslStream) == streams_.end()) {
+            zslStreams.emplace_back(zslStream);
+        }
+    }
+    for (auto &zslStream : zslStreams) {
+        zslStream->SetReleaseStream(false);
+        tempStreams_.emplace_back(zslStream);
+    }
+}
+
+void HCaptureSession::PrepareSharedStreams()
+{
+#ifdef CAMERA_STREAM_FAN_OUT
+    std::vector<sptr<HStreamRepeat>> sources;
+    for (auto item = streams_.begin(); item != streams_.end(); ++item) {
+        if ((*item)->GetStreamType() == StreamType::REPEAT && !(*item)->IsReleaseStream()
+            && static_cast<HStreamRepeat *>((*item).GetRefPtr())->IsSharedSource()) {
+            sources.emplace_back(static_cast<HStreamRepeat *>((*item).GetRefPtr()));
+        }
+    }
+    std::vector<sptr<HStreamRepeat>> candidates;
+    for (auto item = tempStreams_.begin(); item != tempStreams_.end(); ++item) {
+        if ((*item)->GetStreamType() != StreamType::REPEAT) {
+            continue;
+        }
+        sptr<HStreamRepeat> repeatStream = static_cast<HStreamRepeat *>((*item).GetRefPtr());
+        // Video streams carry their own encode intent and deferred outputs have no surface to copy to yet
+        if (!repeatStream->IsVideo() && repeatStream->producer_ != nullptr && repeatStream->width_ > 0
+            && repeatStream->height_ > 0 && repeatStream->GetSharedSource() == nullptr) {
+            candidates.emplace_back(repeatStream);
+        }
+    }
+    // A smaller output of the same format is scaled from the larger stream, so the largest output of a group leads it
+    auto isCompatible = [](const sptr<HStreamRepeat> &stream, const sptr<HStreamRepeat> &other) {
+        return stream->format_ == other->format_ && stream->width_ >= other->width_
+            && stream->height_ >= other->height_;
+    };
+    auto getArea = [](const sptr<HStreamRepeat> &stream) {
+        return static_cast<int64_t>(stream->width_) * stream->height_;
+    };
+    std::stable_sort(candidates.begin(), candidates.end(),
+        [&getArea](const sptr<HStreamRepeat> &stream, const sptr<HStreamRepeat> &other) {
+            return getArea(stream) > getArea(other);
+        });
+    std::vector<sptr<HStreamRepeat>> newSources;
+    for (size_t i = 0; i < candidates.size(); i++) {
+        sptr<HStreamRepeat> candidate = candidates[i];
+        if (candidate->GetSharedSource() != nullptr) {
+            continue;
+        }
+        sptr<HStreamRepeat> source = nullptr;
+        for (auto &stream : sources) {
+            if (isCompatible(stream, candidate) && (source == nullptr || getArea(stream) < getArea(source))) {
+                source = stream;
+            }
+        }
+        if (source != nullptr) {
+            candidate->SetSharedSource(source);
+            continue;
+        }
+        std::vector<sptr<HStreamRepeat>> outputs = {candidate};
+        for (size_t j = i + 1; j < candidates.size(); j++) {
+            if (candidates[j]->GetSharedSource() == nullptr && isCompatible(candidate, candidates[j])) {
+                outputs.emplace_back(candidates[j]);
+            }
+        }
+        if (outputs.size() < 2) {
+            continue;
+        }
+        sptr<StreamFanOut> fanOut = new(std::nothrow) StreamFanOut();
+        if (fanOut == nullptr || fanOut->Init(candidate->width_, candidate->height_) != CAMERA_OK) {
+            // Not fatal, the outputs get an HDI stream each
+            MEDIA_ERR_LOG("HCaptureSession::PrepareSharedStreams Failed to create stream fan out");
+            continue;
+        }
+        sptr<HStreamRepeat> sharedSource = new(std::nothrow) HStreamRepeat(fanOut->GetProducer(),
+            candidate->format_, candidate->width_, candidate->height_);
+        if (sharedSource == nullptr) {
+            MEDIA_ERR_LOG("HCaptureSession::PrepareSharedStreams Failed to create shared source stream");
+            fanOut->Release();
+            continue;
+        }
+        sharedSource->SetFanOut(fanOut);
+        for (auto &output : outputs) {
+            output->SetSharedSource(sharedSource);
+        }
+        MEDIA_INFO_LOG("HCaptureSession::PrepareSharedStreams %{public}zu outputs share one %{public}dx%{public}d "
+                       "stream", outputs.size(), candidate->width_, candidate->height_);
+        sources.emplace_back(sharedSource);
+        newSources.emplace_back(sharedSource);
+    }
+    for (auto &sharedSource : newSources) {
+        sharedSource->SetReleaseStream(false);
+        tempStreams_.emplace_back(sharedSource);
+    }
+#endif
+}
+
+void HCaptureSession::UpdateSensorRateSharing()
+{
+    // Kept current on every staged change, so SetFps before the commit already sees the staged outputs
+    std::vector<sptr<HStreamRepeat>> activeRepeatStreams;
+    for (auto &stream : streams_) {
+        if (stream->GetStreamType() == StreamType::REPEAT && !stream->IsReleaseStream()) {
+            activeRepeatStreams.emplace_back(static_cast<HStreamRepeat *>(stream.GetRefPtr()));
+        }
+    }
+    for (auto &stream : tempStreams_) {
+        if (stream->GetStreamType() == StreamType::REPEAT) {
+            activeRepeatStreams.emplace_back(static_cast<HStreamRepeat *>(stream.GetRefPtr()));
+        }
+    }
+    // A device frame rate would apply to every repeat stream, so it is only used by a stream running alone.
+    // Outputs fed by a shared source have no HDI stream of their own
+    auto isHdiStream = [](const sptr<HStreamRepeat> &stream) { return stream->GetSharedSource() == nullptr; };
+    bool isShared = std::count_if(activeRepeatStreams.begin(), activeRepeatStreams.end(), isHdiStream) > 1;
+    for (auto &stream : activeRepeatStreams) {
+        stream->SetSensorRateShared(isShared);
+    }
+}
+
+int32_t HCaptureSession::ValidateCommitConfig()
 {
     int32_t rc;
-    sptr<HCameraDevice> device = nullptr;
 
     if (curState_ != CaptureSessionState::SESSION_CONFIG_INPROGRESS) {
         MEDIA_ERR_LOG("HCaptureSession::CommitConfig() Need to call BeginConfig before committing configuration");
@@ -556,17 +998,87 @@ int32_t HCaptureSession::CommitConfig()
     if (rc != CAMERA_OK) {
         return rc;
     }
-    rc = ValidateSessionOutputs();
+    return ValidateSessionOutputs();
+}
+
+int32_t HCaptureSession::CommitConfig()
+{
+    int32_t rc = ValidateCommitConfig();
     if (rc != CAMERA_OK) {
         return rc;
     }
+    return ApplyConfig();
+}
 
-    std::lock_guard<std::mutex> lock(mutex_);
-    rc = GetCameraDevice(device);
-    if ((rc == CAMERA_OK) && (device == cameraDevice_) && !deletedStreamIds_.empty()) {
-        rc = HdiToServiceError((CamRetCode)(device->GetStreamOperator()->ReleaseStreams(deletedStreamIds_)));
+int32_t HCaptureSession::CommitConfigAsync(int32_t &transactionId)
+{
+    CAMERA_SYNC_TRACE;
+    if (sessionCallback_ == nullptr) {
+        MEDIA_ERR_LOG("HCaptureSession::CommitConfigAsync Need a session callback to report the result");
+        return CAMERA_INVALID_STATE;
     }
+    int32_t rc = ValidateCommitConfig();
+    if (rc != CAMERA_OK) {
+        return rc;
+    }
+    // The previous worker has reported its result already, it may still be on its way out
+    JoinCommitWorker();
+    // Rejects any other configuration or streaming request until the commit completes
+    curState_ = CaptureSessionState::SESSION_CONFIG_COMMITTING;
+    std::lock_guard<std::mutex> lock(commitLock_);
+    transactionId = ++commitTransactionId_;
+    isCommitPending_ = true;
+    sptr<HCaptureSession> session = this;
+    commitWorker_ = std::thread([session, transactionId]() {
+        session->ApplyConfigAsync(transactionId);
+    });
+    return CAMERA_OK;
+}
 
+void HCaptureSession::JoinCommitWorker()
+{
+    std::thread worker;
+    {
+        std::lock_guard<std::mutex> lock(commitLock_);
+        // A release deferred to the end of the commit runs on the worker itself
+        if (!commitWorker_.joinable() || commitWorker_.get_id() == std::this_thread::get_id()) {
+            return;
+        }
+        worker = std::move(commitWorker_);
+    }
+    worker.join();
+}
+
+void HCaptureSession::ApplyConfigAsync(int32_t transactionId)
+{
+    int32_t rc = ApplyConfig();
+    MEDIA_INFO_LOG("HCaptureSession::ApplyConfigAsync transaction %{public}d done, rc: %{public}d", transactionId, rc);
+    sptr<ICaptureSessionCallback> callback = sessionCallback_;
+    bool isReleasePending;
+    pid_t releasePid;
+    {
+        std::lock_guard<std::mutex> lock(commitLock_);
+        isCommitPending_ = false;
+        isReleasePending = isReleasePending_;
+        isReleasePending_ = false;
+        releasePid = releasePid_;
+    }
+    if (isReleasePending) {
+        Release(releasePid);
+        rc = CAMERA_INVALID_STATE;
+    }
+    if (callback != nullptr) {
+        callback->OnCommitConfigDone(transactionId, rc);
+    }
+}
+
+int32_t HCaptureSession::ApplyConfig()
+{
+    int32_t rc;
+    sptr<HCameraDevice> device = nullptr;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    rc = GetCameraDevice(device);
     if (rc != CAMERA_OK) {
         MEDIA_ERR_LOG("HCaptureSession::CommitConfig() Failed to commit config. rc: %{public}d", rc);
         if (device != nullptr && device != cameraDevice_) {
@@ -576,25 +1088,33 @@ int32_t HCaptureSession::CommitConfig()
         return rc;
     }
 
-    rc = HandleCaptureOuputsConfig(device);
+    // Before the zsl streams are added, those feed the capture outputs and are never shared
+    PrepareSharedStreams();
+    PrepareZslStreams();
+    UpdateSensorRateSharing();
+    bool isStreamsReleased = false;
+    if (device == cameraDevice_) {
+        rc = ApplyDeltaConfig(device, isStreamsReleased);
+    } else {
+        rc = HandleCaptureOuputsConfig(device, false);
+    }
     if (rc != CAMERA_OK) {
         MEDIA_ERR_LOG("HCaptureSession::CommitConfig() Failed to commit config. rc: %{public}d", rc);
         if (device != nullptr && device != cameraDevice_) {
             device->Close();
         }
-        RestorePreviousState(cameraDevice_, !deletedStreamIds_.empty());
+        RestorePreviousState(cameraDevice_, isStreamsReleased);
         return rc;
     }
     if (device != nullptr) {
-        int32_t pid = IPCSkeleton::GetCallingPid();
-        int32_t uid = IPCSkeleton::GetCallingUid();
-        POWERMGR_SYSEVENT_CAMERA_CONNECT(pid, uid, device->GetCameraId().c_str(),
-                                         GetClientBundle(uid));
+        // May run off the binder thread, so the client identity comes from the session
+        POWERMGR_SYSEVENT_CAMERA_CONNECT(pid_, uid_, device->GetCameraId().c_str(),
+                                         GetClientBundle(uid_));
     }
 
     if (cameraDevice_ != nullptr && device != cameraDevice_) {
         cameraDevice_->Close();
-        cameraDevice_ = nullptr;
+        SetHeldCameraDevice(nullptr);
     }
     UpdateSessionConfig(device);
     return rc;
@@ -612,7 +1132,8 @@ int32_t HCaptureSession::Start()
     std::lock_guard<std::mutex> lock(mutex_);
     for (auto item = repeatStreams_.begin(); item != repeatStreams_.end(); ++item) {
         curStreamRepeat = static_cast<HStreamRepeat *>((*item).GetRefPtr());
-        if (!curStreamRepeat->IsVideo()) {
+        // A shared source is started by the outputs it feeds
+        if (!curStreamRepeat->IsVideo() && !curStreamRepeat->IsSharedSource()) {
             rc = curStreamRepeat->Start();
             if (rc != CAMERA_OK) {
                 MEDIA_ERR_LOG("HCaptureSession::Start(), Failed to start preview, rc: %{public}d", rc);
@@ -623,6 +1144,142 @@ int32_t HCaptureSession::Start()
     return rc;
 }
 
+int32_t HCaptureSession::StartGrouped()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (curState_ != CaptureSessionState::SESSION_CONFIG_COMMITTED) {
+        MEDIA_ERR_LOG("HCaptureSession::StartGrouped(), Invalid session state");
+        return CAMERA_INVALID_STATE;
+    }
+    if (groupCaptureId_ != 0) {
+        MEDIA_ERR_LOG("HCaptureSession::StartGrouped(), Already started with captureID: %{public}d", groupCaptureId_);
+        return CAMERA_INVALID_STATE;
+    }
+    std::vector<sptr<HStreamCommon>> groupStreams;
+    auto collectStreams = [&groupStreams](const std::vector<sptr<HStreamCommon>> &streams) {
+        for (auto item = streams.begin(); item != streams.end(); ++item) {
+            // Outputs already started on their own keep their own request
+            if ((*item)->curCaptureID_ == 0) {
+                groupStreams.emplace_back(*item);
+            }
+        }
+    };
+    collectStreams(repeatStreams_);
+    collectStreams(metadataStreams_);
+    return StartCaptureGroup(groupStreams);
+}
+
+int32_t HCaptureSession::StartCaptureGroup(const std::vector<sptr<HStreamCommon>> &groupStreams)
+{
+    if (groupStreams.empty()) {
+        MEDIA_ERR_LOG("HCaptureSession::StartCaptureGroup(), No outputs to start");
+        return CAMERA_INVALID_STATE;
+    }
+    sptr<IStreamOperator> streamOperator = groupStreams.front()->streamOperator_;
+    SettingsBlob ability = groupStreams.front()->GetAbilitySettings();
+    if (streamOperator == nullptr || ability == nullptr) {
+        MEDIA_ERR_LOG("HCaptureSession::StartCaptureGroup(), Outputs are not linked to the device");
+        return CAMERA_INVALID_STATE;
+    }
+    CaptureInfo captureInfo;
+    captureInfo.captureSetting_ = *ability;
+    captureInfo.enableShutterCallback_ = false;
+    for (auto item = groupStreams.begin(); item != groupStreams.end(); ++item) {
+        if (GetSharedSource(*item) != nullptr) {
+            // Fed by its shared source, which the request names instead
+            continue;
+        }
+        captureInfo.streamIds_.emplace_back((*item)->GetStreamId());
+        if ((*item)->GetStreamType() == StreamType::REPEAT &&
+            static_cast<HStreamRepeat *>((*item).GetRefPtr())->IsFrameGapMonitored()) {
+            captureInfo.enableShutterCallback_ = true;
+        }
+    }
+    int32_t captureId = 0;
+    int32_t rc = AllocateCaptureId(captureId);
+    if (rc != CAMERA_OK) {
+        MEDIA_ERR_LOG("HCaptureSession::StartCaptureGroup(), Failed to allocate a captureId");
+        return rc;
+    }
+    MEDIA_INFO_LOG("HCaptureSession::StartCaptureGroup(), Starting %{public}zu streams with capture ID: %{public}d",
+                   captureInfo.streamIds_.size(), captureId);
+    auto setFirstFrameStartTime = [&groupStreams](int64_t startTime) {
+        for (auto item = groupStreams.begin(); item != groupStreams.end(); ++item) {
+            if ((*item)->GetStreamType() == StreamType::REPEAT) {
+                static_cast<HStreamRepeat *>((*item).GetRefPtr())->SetFirstFrameStartTime(startTime);
+            }
+        }
+    };
+    // Armed before the request, the HDI may report it started before Capture returns
+    int64_t startTime = CameraLatencyStats::GetTimestampUs();
+    setFirstFrameStartTime(startTime);
+    CamRetCode hdiRc = (CamRetCode)(streamOperator->Capture(captureId, captureInfo, true));
+    CameraLatencyStats::GetInstance().Record(groupStreams.front()->GetCameraId(), LATENCY_CAPTURE, startTime);
+    if (hdiRc != HDI::Camera::V1_0::NO_ERROR) {
+        setFirstFrameStartTime(0);
+        ReleaseCaptureId(captureId);
+        MEDIA_ERR_LOG("HCaptureSession::StartCaptureGroup(), Failed with error Code: %{public}d", hdiRc);
+        return HdiToServiceError(hdiRc);
+    }
+    // Weak, a stream outliving the session must not keep it alive
+    wptr<HCaptureSession> weakSession(this);
+    auto leaver = [weakSession](const sptr<HStreamCommon> &stream) {
+        sptr<HCaptureSession> session = weakSession.promote();
+        return (session == nullptr) ? CAMERA_INVALID_STATE : session->RemoveFromCaptureGroup(stream);
+    };
+    for (auto item = groupStreams.begin(); item != groupStreams.end(); ++item) {
+        (*item)->JoinCaptureGroup(captureId, leaver);
+    }
+    groupCaptureId_ = captureId;
+    groupStreams_ = groupStreams;
+    return CAMERA_OK;
+}
+
+int32_t HCaptureSession::StopCaptureGroup()
+{
+    if (groupCaptureId_ == 0) {
+        return CAMERA_OK;
+    }
+    int32_t rc = CAMERA_OK;
+    sptr<IStreamOperator> streamOperator = groupStreams_.empty() ? nullptr : groupStreams_.front()->streamOperator_;
+    if (streamOperator != nullptr) {
+        int64_t startTime = CameraLatencyStats::GetTimestampUs();
+        CamRetCode hdiRc = (CamRetCode)(streamOperator->CancelCapture(groupCaptureId_));
+        CameraLatencyStats::GetInstance().Record(groupStreams_.front()->GetCameraId(), LATENCY_CANCEL_CAPTURE,
+                                                 startTime);
+        if (hdiRc != HDI::Camera::V1_0::NO_ERROR) {
+            MEDIA_ERR_LOG("HCaptureSession::StopCaptureGroup(), Failed with errorCode: %{public}d, "
+                          "captureID: %{public}d", hdiRc, groupCaptureId_);
+            rc = HdiToServiceError(hdiRc);
+        }
+    }
+    for (auto item = groupStreams_.begin(); item != groupStreams_.end(); ++item) {
+        (*item)->LeaveCaptureGroup();
+    }
+    ReleaseCaptureId(groupCaptureId_);
+    groupCaptureId_ = 0;
+    groupStreams_.clear();
+    return rc;
+}
+
+int32_t HCaptureSession::RemoveFromCaptureGroup(const sptr<HStreamCommon> &stream)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = std::find(groupStreams_.begin(), groupStreams_.end(), stream);
+    if (groupCaptureId_ == 0 || it == groupStreams_.end()) {
+        MEDIA_ERR_LOG("HCaptureSession::RemoveFromCaptureGroup(), Stream is not in the capture group");
+        return CAMERA_INVALID_STATE;
+    }
+    std::vector<sptr<HStreamCommon>> remainingStreams = groupStreams_;
+    remainingStreams.erase(remainingStreams.begin() + std::distance(groupStreams_.begin(), it));
+    int32_t rc = StopCaptureGroup();
+    if (!remainingStreams.empty() && StartCaptureGroup(remainingStreams) != CAMERA_OK) {
+        // The stream itself is stopped, the others are left stopped for the session to restart
+        MEDIA_ERR_LOG("HCaptureSession::RemoveFromCaptureGroup(), Failed to restart the other outputs");
+    }
+    return rc;
+}
+
 int32_t HCaptureSession::Stop()
 {
     int32_t rc = CAMERA_OK;
@@ -634,7 +1291,8 @@ int32_t HCaptureSession::Stop()
     std::lock_guard<std::mutex> lock(mutex_);
     for (auto item = repeatStreams_.begin(); item != repeatStreams_.end(); ++item) {
         curStreamRepeat = static_cast<HStreamRepeat *>((*item).GetRefPtr());
-        if (!curStreamRepeat->IsVideo()) {
+        if (!curStreamRepeat->IsVideo() && !curStreamRepeat->IsGroupCapture()
+            && !curStreamRepeat->IsSharedSource()) {
             rc = curStreamRepeat->Stop();
             if (rc != CAMERA_OK) {
                 MEDIA_ERR_LOG("HCaptureSession::Stop(), Failed to stop preview, rc: %{public}d", rc);
@@ -642,6 +1300,14 @@ int32_t HCaptureSession::Stop()
             }
         }
     }
+    if (groupCaptureId_ != 0) {
+        int32_t groupRc = StopCaptureGroup();
+        rc = (rc == CAMERA_OK) ? groupRc : rc;
+    }
+    for (auto item = captureStreams_.begin(); item != captureStreams_.end(); ++item) {
+        // Buffered frames are stale once the stream is stopped
+        static_cast<HStreamCapture *>((*item).GetRefPtr())->FlushZsl();
+    }
     return rc;
 }
 
@@ -660,15 +1326,27 @@ void HCaptureSession::ReleaseStreams()
     std::vector<int32_t> streamIds;
     sptr<HStreamCommon> curStream;
 
+    if (groupCaptureId_ != 0) {
+        // The streams go away with the request, only the capture id is left to give back
+        ReleaseCaptureId(groupCaptureId_);
+        groupCaptureId_ = 0;
+        groupStreams_.clear();
+    }
+
     for (auto item = streams_.begin(); item != streams_.end(); ++item) {
         curStream = *item;
-        streamIds.emplace_back(curStream->GetStreamId());
+        if (GetSharedSource(curStream) == nullptr) {
+            streamIds.emplace_back(curStream->GetStreamId());
+        }
         curStream->Release();
     }
     repeatStreams_.clear();
     captureStreams_.clear();
     metadataStreams_.clear();
     streams_.clear();
+    if (streamOperatorCallback_ != nullptr) {
+        streamOperatorCallback_->PublishStreams(streams_);
+    }
     if ((cameraDevice_ != nullptr) && (cameraDevice_->GetStreamOperator() != nullptr) && !streamIds.empty()) {
         cameraDevice_->GetStreamOperator()->ReleaseStreams(streamIds);
     }
@@ -676,35 +1354,65 @@ void HCaptureSession::ReleaseStreams()
 
 int32_t HCaptureSession::Release(pid_t pid)
 {
-    std::lock_guard<std::mutex> lock(sessionLock_);
-    MEDIA_DEBUG_LOG("HCaptureSession::Release pid(%{public}d).", pid);
-    auto it = session_.find(pid);
-    if (it == session_.end()) {
-        MEDIA_DEBUG_LOG("HCaptureSession::Release session for pid(%{public}d) already released.", pid);
-        return CAMERA_OK;
+    {
+        std::lock_guard<std::mutex> lock(commitLock_);
+        if (isCommitPending_) {
+            // The commit still drives the device, the session is released as soon as it completes
+            MEDIA_INFO_LOG("HCaptureSession::Release deferred until the pending commit completes");
+            isReleasePending_ = true;
+            releasePid_ = pid;
+            return CAMERA_OK;
+        }
     }
-    ReleaseStreams();
-    if (streamOperatorCallback_ != nullptr) {
-        streamOperatorCallback_->SetCaptureSession(nullptr);
-        streamOperatorCallback_ = nullptr;
+    JoinCommitWorker();
+    sptr<HCaptureSession> session;
+    {
+        std::lock_guard<std::mutex> lock(sessionLock_);
+        MEDIA_DEBUG_LOG("HCaptureSession::Release pid(%{public}d).", pid);
+        auto it = session_.find(pid);
+        if (it == session_.end()) {
+            MEDIA_DEBUG_LOG("HCaptureSession::Release session for pid(%{public}d) already released.", pid);
+            return CAMERA_OK;
+        }
+        // Unregistered first, a concurrent release or arbitration no longer finds the session
+        session = it->second;
+        ClearCaptureSession(pid);
     }
-    if (cameraDevice_ != nullptr) {
-        cameraDevice_->Close();
-        POWERMGR_SYSEVENT_CAMERA_DISCONNECT(cameraDevice_->GetCameraId().c_str());
-        cameraDevice_ = nullptr;
+    ReleaseStreams();
+    streamOperatorCallback_ = nullptr;
+    sptr<HCameraDevice> device = GetHeldCameraDevice();
+    SetHeldCameraDevice(nullptr);
+    if (device != nullptr) {
+        device->Close();
+        POWERMGR_SYSEVENT_CAMERA_DISCONNECT(device->GetCameraId().c_str());
     }
-    ClearCaptureSession(pid);
     return CAMERA_OK;
 }
 
+void HCaptureSession::SetHeldCameraDevice(const sptr<HCameraDevice> &device)
+{
+    std::lock_guard<std::mutex> lock(deviceLock_);
+    cameraDevice_ = device;
+}
+
+sptr<HCameraDevice> HCaptureSession::GetHeldCameraDevice()
+{
+    std::lock_guard<std::mutex> lock(deviceLock_);
+    return cameraDevice_;
+}
+
 void HCaptureSession::DestroyStubObjectForPid(pid_t pid)
 {
-    MEDIA_DEBUG_LOG("camera stub services(%{public}zu) pid(%{public}d).", session_.size(), pid);
     sptr<HCaptureSession> session;
-
-    auto it = session_.find(pid);
-    if (it != session_.end()) {
-        session = it->second;
+    {
+        std::lock_guard<std::mutex> lock(sessionLock_);
+        MEDIA_DEBUG_LOG("camera stub services(%{public}zu) pid(%{public}d).", session_.size(), pid);
+        auto it = session_.find(pid);
+        if (it != session_.end()) {
+            session = it->second;
+        }
+    }
+    if (session != nullptr) {
         session->Release(pid);
     }
     MEDIA_DEBUG_LOG("camera stub services(%{public}zu).", session_.size());
@@ -721,6 +1429,144 @@ int32_t HCaptureSession::SetCallback(sptr<ICaptureSessionCallback> &callback)
     return CAMERA_OK;
 }
 
+static sptr<HStreamCommon> GetSessionOutputStream(const SessionOutput &output)
+{
+    switch (output.first) {
+        case StreamType::CAPTURE:
+            return static_cast<HStreamCapture *>(output.second.GetRefPtr());
+        case StreamType::REPEAT:
+            return static_cast<HStreamRepeat *>(output.second.GetRefPtr());
+        case StreamType::METADATA:
+            return static_cast<HStreamMetadata *>(output.second.GetRefPtr());
+        default:
+            return nullptr;
+    }
+}
+
+int32_t HCaptureSession::StageSessionConfig(sptr<ICameraDeviceService> &cameraDevice,
+                                            std::vector<SessionOutput> &outputs)
+{
+    int32_t rc;
+    std::vector<sptr<HStreamCommon>> requestedStreams;
+
+    for (auto &output : outputs) {
+        sptr<HStreamCommon> stream = (output.second == nullptr) ? nullptr : GetSessionOutputStream(output);
+        if (stream == nullptr) {
+            MEDIA_ERR_LOG("HCaptureSession::StageSessionConfig stream is null or of unknown type");
+            return CAMERA_INVALID_ARG;
+        }
+        requestedStreams.emplace_back(stream);
+        if (output.first == StreamType::CAPTURE) {
+            sptr<HStreamRepeat> zslStream = static_cast<HStreamCapture *>(output.second.GetRefPtr())->GetZslStream();
+            if (zslStream != nullptr) {
+                requestedStreams.emplace_back(zslStream);
+            }
+        }
+    }
+    // The request carries the complete configuration, drop whatever is not part of it
+    if (cameraDevice_ != nullptr) {
+        cameraDevice_->SetReleaseCameraDevice(true);
+    }
+    for (auto item = streams_.begin(); item != streams_.end(); ++item) {
+        // Shared sources are internal and go with the last output they feed
+        if ((*item)->GetStreamType() == StreamType::REPEAT
+            && static_cast<HStreamRepeat *>((*item).GetRefPtr())->IsSharedSource()) {
+            continue;
+        }
+        if (std::find(requestedStreams.begin(), requestedStreams.end(), *item) == requestedStreams.end()) {
+            rc = RemoveOutputStream(*item);
+            if (rc != CAMERA_OK) {
+                return rc;
+            }
+        }
+    }
+    rc = AddInput(cameraDevice);
+    if (rc != CAMERA_OK) {
+        return rc;
+    }
+    for (auto &output : outputs) {
+        if (std::find(streams_.begin(), streams_.end(), GetSessionOutputStream(output)) != streams_.end()) {
+            continue;
+        }
+        rc = AddOutput(output.first, output.second);
+        if (rc != CAMERA_OK) {
+            return rc;
+        }
+    }
+    return CAMERA_OK;
+}
+
+void HCaptureSession::AbortConfig(const std::vector<sptr<HStreamCommon>> &activeStreams, bool isDeviceReleased)
+{
+    // Brings back the outputs the staged configuration removed, and only those
+    for (auto item = streams_.begin(); item != streams_.end(); ++item) {
+        bool isActive = std::find(activeStreams.begin(), activeStreams.end(), *item) != activeStreams.end();
+        (*item)->SetReleaseStream(!isActive);
+    }
+    if (cameraDevice_ != nullptr) {
+        cameraDevice_->SetReleaseCameraDevice(isDeviceReleased);
+    }
+    tempStreams_.clear();
+    deletedStreamIds_.clear();
+    tempCameraDevices_.clear();
+    curState_ = prevState_;
+}
+
+int32_t HCaptureSession::ConfigureSession(sptr<ICameraDeviceService> cameraDevice,
+                                          std::vector<SessionOutput> &outputs,
+                                          const std::shared_ptr<OHOS::Camera::CameraMetadata> &settings)
+{
+    CAMERA_SYNC_TRACE;
+    if (cameraDevice == nullptr || outputs.empty()) {
+        MEDIA_ERR_LOG("HCaptureSession::ConfigureSession input or outputs are missing");
+        return CAMERA_INVALID_ARG;
+    }
+    int32_t rc = BeginConfig();
+    if (rc != CAMERA_OK) {
+        return rc;
+    }
+    std::vector<sptr<HStreamCommon>> activeStreams;
+    for (auto item = streams_.begin(); item != streams_.end(); ++item) {
+        if (!(*item)->IsReleaseStream()) {
+            activeStreams.emplace_back(*item);
+        }
+    }
+    bool isDeviceReleased = (cameraDevice_ != nullptr) && cameraDevice_->IsReleaseCameraDevice();
+    rc = StageSessionConfig(cameraDevice, outputs);
+    if (rc == CAMERA_OK && settings != nullptr) {
+        // Cached on the device before it is opened, so the settings reach the HDI together with the open
+        rc = static_cast<HCameraDevice*>(cameraDevice.GetRefPtr())->UpdateSetting(settings);
+    }
+    if (rc != CAMERA_OK) {
+        MEDIA_ERR_LOG("HCaptureSession::ConfigureSession Failed to stage config, rc: %{public}d", rc);
+        AbortConfig(activeStreams, isDeviceReleased);
+        return rc;
+    }
+    // CommitConfig restores the previous configuration by itself on failure
+    return CommitConfig();
+}
+
+int32_t HCaptureSession::SetZslConfig(int32_t ringDepth, int32_t selection, uint64_t memoryBudget)
+{
+    if (ringDepth < 0 || ringDepth > MAX_ZSL_RING_DEPTH) {
+        MEDIA_ERR_LOG("HCaptureSession::SetZslConfig invalid ring depth: %{public}d", ringDepth);
+        return CAMERA_INVALID_ARG;
+    }
+    if (selection < ZSL_SELECTION_NONE || selection > ZSL_SELECTION_SHARPEST) {
+        MEDIA_ERR_LOG("HCaptureSession::SetZslConfig invalid selection: %{public}d", selection);
+        return CAMERA_INVALID_ARG;
+    }
+    if (curState_ != CaptureSessionState::SESSION_CONFIG_INPROGRESS) {
+        MEDIA_ERR_LOG("HCaptureSession::SetZslConfig Need to call BeginConfig before configuring zsl");
+        return CAMERA_INVALID_STATE;
+    }
+    // Applies to the photo outputs added from this configuration on
+    zslRingDepth_ = ringDepth;
+    zslSelection_ = selection;
+    zslMemoryBudget_ = memoryBudget;
+    return CAMERA_OK;
+}
+
 std::string HCaptureSession::GetSessionState()
 {
     std::map<CaptureSessionState, std::string>::const_iterator iter =
@@ -733,11 +1579,13 @@ std::string HCaptureSession::GetSessionState()
 
 void HCaptureSession::CameraSessionSummary(std::string& dumpString)
 {
+    std::lock_guard<std::mutex> lock(sessionLock_);
     dumpString += "# Number of Camera clients:[" + std::to_string(session_.size()) + "]:\n";
 }
 
 void HCaptureSession::dumpSessions(std::string& dumpString)
 {
+    std::lock_guard<std::mutex> lock(sessionLock_);
     for (auto it = session_.begin(); it != session_.end(); it++) {
         sptr<HCaptureSession> session = it->second;
         dumpString += "No. of sessions for client:[" + std::to_string(1) + "]:\n";
@@ -748,12 +1596,14 @@ void HCaptureSession::dumpSessions(std::string& dumpString)
 void HCaptureSession::dumpSessionInfo(std::string& dumpString)
 {
     dumpString += "Client pid:[" + std::to_string(pid_)
-        + "]    Client uid:[" + std::to_string(uid_) + "]:\n";
+        + "]    Client uid:[" + std::to_string(uid_)
+        + "]    Client priority:[" + std::to_string(priority_) + "]:\n";
     dumpString += "session state:[" + GetSessionState() + "]:\n";
     if (cameraDevice_ != nullptr) {
         dumpString += "session Camera Id:[" + cameraDevice_->GetCameraId() + "]:\n";
         dumpString += "session Camera release status:["
         + std::to_string(cameraDevice_->IsReleaseCameraDevice()) + "]:\n";
+        cameraDevice_->DumpResultInfo(dumpString);
     }
     for (const auto& stream : captureStreams_) {
         stream->DumpStreamInfo(dumpString);
@@ -766,26 +1616,14 @@ void HCaptureSession::dumpSessionInfo(std::string& dumpString)
     }
 }
 
-StreamOperatorCallback::StreamOperatorCallback(sptr<HCaptureSession> session)
-{
-    captureSession_ = session;
-}
-
 sptr<HStreamCommon> StreamOperatorCallback::GetStreamByStreamID(int32_t streamId)
 {
-    sptr<HStreamCommon> curStream;
-    sptr<HStreamCommon> result = nullptr;
-
-    if (captureSession_ != nullptr) {
-        for (auto item = captureSession_->streams_.begin(); item != captureSession_->streams_.end(); ++item) {
-            curStream = *item;
-            if (curStream->GetStreamId() == streamId) {
-                result = curStream;
-                break;
-            }
-        }
+    std::shared_ptr<const StreamRoutingTable> table = std::atomic_load(&routingTable_);
+    if (table == nullptr) {
+        return nullptr;
     }
-    return result;
+    auto it = table->find(streamId);
+    return (it != table->end()) ? it->second : nullptr;
 }
 
 int32_t StreamOperatorCallback::OnCaptureStarted(int32_t captureId,
@@ -859,6 +1697,8 @@ int32_t StreamOperatorCallback::OnFrameShutter(int32_t captureId,
         curStream = GetStreamByStreamID(*item);
         if ((curStream != nullptr) && (curStream->GetStreamType() == StreamType::CAPTURE)) {
             static_cast<HStreamCapture *>(curStream.GetRefPtr())->OnFrameShutter(captureId, timestamp);
+        } else if ((curStream != nullptr) && (curStream->GetStreamType() == StreamType::REPEAT)) {
+            static_cast<HStreamRepeat *>(curStream.GetRefPtr())->OnFrameShutter(captureId, timestamp);
         } else {
             MEDIA_ERR_LOG("StreamOperatorCallback::OnFrameShutter StreamId: %{public}d not found", *item);
             return CAMERA_INVALID_ARG;
@@ -867,9 +1707,13 @@ int32_t StreamOperatorCallback::OnFrameShutter(int32_t captureId,
     return CAMERA_OK;
 }
 
-void StreamOperatorCallback::SetCaptureSession(sptr<HCaptureSession> captureSession)
+void StreamOperatorCallback::PublishStreams(const std::vector<sptr<HStreamCommon>> &streams)
 {
-    captureSession_ = captureSession;
+    auto table = std::make_shared<StreamRoutingTable>();
+    for (auto item = streams.begin(); item != streams.end(); ++item) {
+        (*table)[(*item)->GetStreamId()] = *item;
+    }
+    std::atomic_store(&routingTable_, std::shared_ptr<const StreamRoutingTable>(table));
 }
 } // namespace CameraStandard
 } // namespace OHOS
@@ -15,6 +15,9 @@
 
 #include "hstream_capture.h"
 
+#include <chrono>
+#include "camera_latency_stats.h"
+#include "camera_telemetry.h"
 #include "camera_util.h"
 #include "camera_log.h"
 #include "metadata_utils.h"
@@ -26,12 +29,21 @@ HStreamCapture::HStreamCapture(sptr<OHOS::IBufferProducer> producer, int32_t for
 {}
 
 HStreamCapture::~HStreamCapture()
-{}
+{
+    StopCancelWorker();
+}
 
 int32_t HStreamCapture::LinkInput(sptr<IStreamOperator> streamOperator,
                                   std::shared_ptr<OHOS::Camera::CameraMetadata> cameraAbility, int32_t streamId)
 {
-    return HStreamCommon::LinkInput(streamOperator, cameraAbility, streamId);
+    int32_t ret = HStreamCommon::LinkInput(streamOperator, cameraAbility, streamId);
+    if (ret != CAMERA_OK) {
+        return ret;
+    }
+    if (PrepareJpegEncoder() != CAMERA_OK) {
+        MEDIA_ERR_LOG("HStreamCapture::LinkInput Failed to create jpeg encoder, the HDI output is delivered as is");
+    }
+    return CAMERA_OK;
 }
 
 void HStreamCapture::SetStreamInfo(StreamInfo &streamInfo)
@@ -39,37 +51,145 @@ void HStreamCapture::SetStreamInfo(StreamInfo &streamInfo)
     HStreamCommon::SetStreamInfo(streamInfo);
     streamInfo.intent_ = STILL_CAPTURE;
     streamInfo.encodeType_ = ENCODE_TYPE_JPEG;
+    if (jpegEncoder_ != nullptr && jpegEncoder_->GetProducer() != nullptr) {
+        // The HDI delivers YUV to the service, which encodes it for the client
+        streamInfo.bufferQueue_ = new BufferProducerSequenceable(jpegEncoder_->GetProducer());
+        streamInfo.encodeType_ = ENCODE_TYPE_NULL;
+    }
+}
+
+int32_t HStreamCapture::PrepareJpegEncoder()
+{
+#ifdef CAMERA_JPEG_ENCODER
+    if (jpegEncoder_ != nullptr || format_ != OHOS_CAMERA_FORMAT_JPEG) {
+        return CAMERA_OK;
+    }
+    sptr<JpegEncoder> encoder = new(std::nothrow) JpegEncoder(producer_);
+    if (encoder == nullptr) {
+        MEDIA_ERR_LOG("HStreamCapture::PrepareJpegEncoder failed to allocate jpeg encoder");
+        return CAMERA_ALLOC_ERROR;
+    }
+    int32_t ret = encoder->Init(width_, height_);
+    if (ret != CAMERA_OK) {
+        return ret;
+    }
+    jpegEncoder_ = encoder;
+#endif
+    return CAMERA_OK;
+}
+
+void HStreamCapture::QueueJpegCapture(const std::shared_ptr<OHOS::Camera::CameraMetadata> &captureSettings,
+                                      int32_t captureId, int32_t frameCount)
+{
+    if (jpegEncoder_ == nullptr) {
+        return;
+    }
+    int32_t quality = JPEG_DEFAULT_QUALITY;
+    int32_t orientation = 0;
+    bool isMirrored = false;
+    if (captureSettings != nullptr) {
+        camera_metadata_item_t item;
+        int ret = OHOS::Camera::FindCameraMetadataItem(captureSettings->get(), OHOS_JPEG_QUALITY, &item);
+        if (ret == CAM_META_SUCCESS) {
+            quality = item.data.u8[0];
+        }
+        ret = OHOS::Camera::FindCameraMetadataItem(captureSettings->get(), OHOS_JPEG_ORIENTATION, &item);
+        if (ret == CAM_META_SUCCESS) {
+            orientation = item.data.i32[0];
+        }
+        // The rotation stays an EXIF tag, only the mirroring has to be done on the pixels
+        ret = OHOS::Camera::FindCameraMetadataItem(captureSettings->get(), OHOS_CONTROL_CAPTURE_MIRROR, &item);
+        if (ret == CAM_META_SUCCESS && item.data.u8[0] == 1) {
+            isMirrored = !IsHdiMirrorSupported();
+        }
+    }
+    jpegEncoder_->QueueCapture(captureId, frameCount, quality, orientation, isMirrored);
+}
+
+bool HStreamCapture::IsHdiMirrorSupported()
+{
+    if (cameraAbility_ == nullptr) {
+        return false;
+    }
+    camera_metadata_item_t item;
+    int ret = OHOS::Camera::FindCameraMetadataItem(cameraAbility_->get(), OHOS_CONTROL_CAPTURE_MIRROR_SUPPORTED, &item);
+    return ret == CAM_META_SUCCESS && item.data.u8[0] == 1;
+}
+
+void HStreamCapture::SetCaptureSetting(const std::shared_ptr<OHOS::Camera::CameraMetadata> &captureSettings,
+                                       std::vector<uint8_t> &setting)
+{
+    if (captureSettings == nullptr || !OHOS::Camera::GetCameraMetadataItemCount(captureSettings->get())) {
+        SettingsBlob ability = GetAbilitySettings();
+        if (ability != nullptr) {
+            setting = *ability;
+        }
+    } else {
+        OHOS::Camera::MetadataUtils::ConvertMetadataToVec(captureSettings, setting);
+    }
 }
 
 int32_t HStreamCapture::Capture(const std::shared_ptr<OHOS::Camera::CameraMetadata> &captureSettings)
+{
+    return ZslCapture(captureSettings, ZSL_SELECTION_DEFAULT);
+}
+
+int32_t HStreamCapture::ZslCapture(const std::shared_ptr<OHOS::Camera::CameraMetadata> &captureSettings,
+                                   int32_t selection)
 {
     CAMERA_SYNC_TRACE;
 
     if (streamOperator_ == nullptr) {
         return CAMERA_INVALID_STATE;
     }
+    if (selection < ZSL_SELECTION_DEFAULT || selection > ZSL_SELECTION_SHARPEST) {
+        MEDIA_ERR_LOG("HStreamCapture::Capture invalid zsl selection: %{public}d", selection);
+        return CAMERA_INVALID_ARG;
+    }
+    if (selection == ZSL_SELECTION_DEFAULT) {
+        selection = zslSelection_;
+    }
+    std::unique_lock<std::mutex> lock(burstLock_);
+    if (isBurstActive_) {
+        MEDIA_ERR_LOG("HStreamCapture::Capture burst capture %{public}d is in progress", burstCaptureId_);
+        return CAMERA_INVALID_STATE;
+    }
     int32_t ret = AllocateCaptureId(curCaptureID_);
     if (ret != CAMERA_OK) {
         MEDIA_ERR_LOG("HStreamCapture::Capture Failed to allocate a captureId");
         return ret;
     }
+    if (curCaptureID_ == burstCaptureId_) {
+        // The id of a cancelled burst got reused, stop filtering its late callbacks
+        burstCaptureId_ = 0;
+    }
+    lock.unlock();
+    QueueJpegCapture(captureSettings, curCaptureID_, 1);
+
+    if (selection != ZSL_SELECTION_NONE && zslRingBuffer_ != nullptr) {
+        ret = CaptureFromZsl(curCaptureID_, selection);
+        if (ret == CAMERA_OK) {
+            ReleaseCaptureId(curCaptureID_);
+            curCaptureID_ = 0;
+            return ret;
+        }
+        MEDIA_INFO_LOG("HStreamCapture::Capture no zsl frame available, falling back to HDI capture");
+    }
 
     CaptureInfo captureInfoPhoto;
     captureInfoPhoto.streamIds_ = {streamId_};
-    std::vector<uint8_t> setting;
-    if (!OHOS::Camera::GetCameraMetadataItemCount(captureSettings->get())) {
-        OHOS::Camera::MetadataUtils::ConvertMetadataToVec(cameraAbility_, setting);
-        captureInfoPhoto.captureSetting_ = setting;
-    } else {
-        OHOS::Camera::MetadataUtils::ConvertMetadataToVec(captureSettings, setting);
-        captureInfoPhoto.captureSetting_ = setting;
-    }
+    SetCaptureSetting(captureSettings, captureInfoPhoto.captureSetting_);
     captureInfoPhoto.enableShutterCallback_ = true;
 
     MEDIA_INFO_LOG("HStreamCapture::Capture Starting photo capture with capture ID: %{public}d", curCaptureID_);
+    int64_t startTime = CameraLatencyStats::GetTimestampUs();
     CamRetCode rc = (CamRetCode)(streamOperator_->Capture(curCaptureID_, captureInfoPhoto, false));
+    CameraLatencyStats::GetInstance().Record(GetCameraId(), LATENCY_CAPTURE, startTime);
     if (rc != HDI::Camera::V1_0::NO_ERROR) {
         MEDIA_ERR_LOG("HStreamCapture::Capture failed with error Code: %{public}d", rc);
+        if (jpegEncoder_ != nullptr) {
+            jpegEncoder_->DropCapture(curCaptureID_);
+        }
         ret = HdiToServiceError(rc);
     }
     ReleaseCaptureId(curCaptureID_);
@@ -77,14 +197,254 @@ int32_t HStreamCapture::Capture(const std::shared_ptr<OHOS::Camera::CameraMetada
     return ret;
 }
 
-int32_t HStreamCapture::CancelCapture()
+int32_t HStreamCapture::CaptureFromZsl(int32_t captureId, int32_t selection)
+{
+    CAMERA_SYNC_TRACE;
+    // Matched against the steady clock arrival time of the buffered frames, not their HDI timestamps
+    int64_t shutterTime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    int64_t frameTimestamp = 0;
+    int32_t ret = zslRingBuffer_->CopyFrame(selection, shutterTime, zslOutput_, frameTimestamp);
+    if (ret != CAMERA_OK) {
+        return ret;
+    }
+    MEDIA_INFO_LOG("HStreamCapture::CaptureFromZsl delivered buffered frame for capture ID: %{public}d", captureId);
+    OnCaptureStarted(captureId);
+    OnFrameShutter(captureId, static_cast<uint64_t>(frameTimestamp));
+    OnCaptureEnded(captureId, 1);
+    return CAMERA_OK;
+}
+
+int32_t HStreamCapture::EnableZsl(int32_t ringDepth, int32_t selection, uint64_t memoryBudget)
+{
+    if (ringDepth == 0) {
+        DisableZsl();
+        return CAMERA_OK;
+    }
+    if (zslRingBuffer_ != nullptr) {
+        // The zsl stream stays as committed, only the ring and the selection change
+        int32_t ret = zslRingBuffer_->Reconfigure(ringDepth, memoryBudget);
+        if (ret == CAMERA_OK) {
+            zslSelection_ = selection;
+        }
+        return ret;
+    }
+    // Buffered frames are YCRCB_420_SP, only the service encoder turns them into the photos of other formats
+    if (PrepareJpegEncoder() != CAMERA_OK || (jpegEncoder_ == nullptr && format_ != OHOS_CAMERA_FORMAT_YCRCB_420_SP)) {
+        MEDIA_ERR_LOG("HStreamCapture::EnableZsl Zsl frames cannot be delivered in format %{public}d", format_);
+        return CAMERA_UNSUPPORTED;
+    }
+    sptr<ZslRingBuffer> ringBuffer = new(std::nothrow) ZslRingBuffer(ringDepth, memoryBudget);
+    if (ringBuffer == nullptr) {
+        MEDIA_ERR_LOG("HStreamCapture::EnableZsl failed to allocate ring buffer");
+        return CAMERA_ALLOC_ERROR;
+    }
+    int32_t ret = ringBuffer->Init(width_, height_);
+    if (ret != CAMERA_OK) {
+        return ret;
+    }
+    sptr<Surface> output = Surface::CreateSurfaceAsProducer(
+        (jpegEncoder_ != nullptr) ? jpegEncoder_->GetProducer() : producer_);
+    // The ring holds raw sensor frames whatever the format of the photo output
+    sptr<HStreamRepeat> zslStream = new(std::nothrow) HStreamRepeat(ringBuffer->GetProducer(),
+                                                                   OHOS_CAMERA_FORMAT_YCRCB_420_SP, width_, height_);
+    if (output == nullptr || zslStream == nullptr) {
+        MEDIA_ERR_LOG("HStreamCapture::EnableZsl failed to create zsl stream");
+        ringBuffer->Release();
+        return CAMERA_ALLOC_ERROR;
+    }
+    zslRingBuffer_ = ringBuffer;
+    zslOutput_ = output;
+    zslStream_ = zslStream;
+    zslSelection_ = selection;
+    return CAMERA_OK;
+}
+
+void HStreamCapture::DisableZsl()
+{
+    if (zslRingBuffer_ != nullptr) {
+        zslRingBuffer_->Release();
+    }
+    zslRingBuffer_ = nullptr;
+    zslOutput_ = nullptr;
+    zslStream_ = nullptr;
+    zslSelection_ = ZSL_SELECTION_NONE;
+}
+
+void HStreamCapture::FlushZsl()
 {
-    // Cancel cature is dummy till continuous/burst mode is supported
+    if (zslRingBuffer_ != nullptr) {
+        zslRingBuffer_->Flush();
+    }
+}
+
+sptr<HStreamRepeat> HStreamCapture::GetZslStream()
+{
+    return zslStream_;
+}
+
+int32_t HStreamCapture::BurstCapture(const std::shared_ptr<OHOS::Camera::CameraMetadata> &captureSettings,
+                                     int32_t frameCount)
+{
+    CAMERA_SYNC_TRACE;
+
+    if (streamOperator_ == nullptr) {
+        return CAMERA_INVALID_STATE;
+    }
+    if (frameCount < CONTINUOUS_CAPTURE_FRAME_COUNT || frameCount > MAX_BURST_FRAME_COUNT) {
+        MEDIA_ERR_LOG("HStreamCapture::BurstCapture invalid frame count: %{public}d", frameCount);
+        return CAMERA_INVALID_ARG;
+    }
+    int32_t captureId = 0;
+    {
+        std::lock_guard<std::mutex> lock(burstLock_);
+        if (isBurstActive_) {
+            MEDIA_ERR_LOG("HStreamCapture::BurstCapture burst capture %{public}d is in progress", burstCaptureId_);
+            return CAMERA_INVALID_STATE;
+        }
+        int32_t ret = AllocateCaptureId(captureId);
+        if (ret != CAMERA_OK) {
+            MEDIA_ERR_LOG("HStreamCapture::BurstCapture Failed to allocate a captureId");
+            return ret;
+        }
+        // Shutter callbacks may arrive before the HDI call returns, so the burst is armed up front
+        isBurstActive_ = true;
+        burstCaptureId_ = captureId;
+        burstFrameCount_ = frameCount;
+        burstShutterCount_ = 0;
+    }
+
+    CaptureInfo captureInfoPhoto;
+    captureInfoPhoto.streamIds_ = {streamId_};
+    SetCaptureSetting(captureSettings, captureInfoPhoto.captureSetting_);
+    captureInfoPhoto.enableShutterCallback_ = true;
+    QueueJpegCapture(captureSettings, captureId, frameCount);
+
+    MEDIA_INFO_LOG("HStreamCapture::BurstCapture Starting burst of %{public}d frames with capture ID: %{public}d",
+                   frameCount, captureId);
+    int64_t startTime = CameraLatencyStats::GetTimestampUs();
+    CamRetCode rc = (CamRetCode)(streamOperator_->Capture(captureId, captureInfoPhoto, true));
+    CameraLatencyStats::GetInstance().Record(GetCameraId(), LATENCY_CAPTURE, startTime);
+    if (rc != HDI::Camera::V1_0::NO_ERROR) {
+        MEDIA_ERR_LOG("HStreamCapture::BurstCapture failed with error Code: %{public}d", rc);
+        if (jpegEncoder_ != nullptr) {
+            jpegEncoder_->DropCapture(captureId);
+        }
+        std::lock_guard<std::mutex> lock(burstLock_);
+        if (isBurstActive_ && burstCaptureId_ == captureId) {
+            isBurstActive_ = false;
+            ReleaseCaptureId(captureId);
+        }
+        return HdiToServiceError(rc);
+    }
     return CAMERA_OK;
 }
 
+int32_t HStreamCapture::StopBurst()
+{
+    int32_t captureId = 0;
+    {
+        std::lock_guard<std::mutex> lock(burstLock_);
+        if (!isBurstActive_) {
+            return CAMERA_OK;
+        }
+        isBurstActive_ = false;
+        captureId = burstCaptureId_;
+    }
+    // Frames still in flight for the cancelled burst are not encoded and delivered
+    if (jpegEncoder_ != nullptr) {
+        jpegEncoder_->DropCapture(captureId);
+    }
+    return CancelHdiCapture(captureId);
+}
+
+int32_t HStreamCapture::CancelHdiCapture(int32_t captureId)
+{
+    int32_t ret = CAMERA_OK;
+    if (streamOperator_ != nullptr) {
+        int64_t startTime = CameraLatencyStats::GetTimestampUs();
+        CamRetCode rc = (CamRetCode)(streamOperator_->CancelCapture(captureId));
+        CameraLatencyStats::GetInstance().Record(GetCameraId(), LATENCY_CANCEL_CAPTURE, startTime);
+        if (rc != HDI::Camera::V1_0::NO_ERROR) {
+            MEDIA_ERR_LOG("HStreamCapture::CancelHdiCapture failed with errorCode:%{public}d, captureId: %{public}d",
+                          rc, captureId);
+            ret = HdiToServiceError(rc);
+        }
+    }
+    ReleaseCaptureId(captureId);
+    return ret;
+}
+
+void HStreamCapture::PostCancelCapture(int32_t captureId)
+{
+    {
+        std::lock_guard<std::mutex> lock(cancelLock_);
+        if (!isCancelWorkerStopped_) {
+            if (!cancelWorker_.joinable()) {
+                cancelWorker_ = std::thread(&HStreamCapture::CancelWorker, this);
+            }
+            pendingCancels_.push_back(captureId);
+            cancelCond_.notify_one();
+            return;
+        }
+    }
+    // The stream is being released, nothing is left to hold up
+    CancelHdiCapture(captureId);
+}
+
+void HStreamCapture::CancelWorker()
+{
+    std::unique_lock<std::mutex> lock(cancelLock_);
+    while (true) {
+        cancelCond_.wait(lock, [this] { return isCancelWorkerStopped_ || !pendingCancels_.empty(); });
+        if (pendingCancels_.empty()) {
+            return;
+        }
+        int32_t captureId = pendingCancels_.front();
+        pendingCancels_.pop_front();
+        lock.unlock();
+        CancelHdiCapture(captureId);
+        lock.lock();
+    }
+}
+
+void HStreamCapture::StopCancelWorker()
+{
+    std::thread cancelWorker;
+    {
+        std::lock_guard<std::mutex> lock(cancelLock_);
+        // Cancels already posted still run before the worker exits
+        isCancelWorkerStopped_ = true;
+        cancelCond_.notify_one();
+        cancelWorker.swap(cancelWorker_);
+    }
+    if (cancelWorker.joinable()) {
+        cancelWorker.join();
+    }
+    // A stream released by a failed commit may still be configured again
+    std::lock_guard<std::mutex> lock(cancelLock_);
+    isCancelWorkerStopped_ = false;
+}
+
+int32_t HStreamCapture::CancelCapture()
+{
+    // Single shot captures complete on their own, only burst/continuous capture can be cancelled
+    return StopBurst();
+}
+
 int32_t HStreamCapture::Release()
 {
+    StopBurst();
+    StopCancelWorker();
+    DisableZsl();
+    {
+        std::lock_guard<std::mutex> lock(burstLock_);
+        shutterTimes_.clear();
+    }
+    if (jpegEncoder_ != nullptr) {
+        jpegEncoder_->Release();
+        jpegEncoder_ = nullptr;
+    }
     if (curCaptureID_) {
         ReleaseCaptureId(curCaptureID_);
     }
@@ -106,7 +466,7 @@ int32_t HStreamCapture::OnCaptureStarted(int32_t captureId)
 {
     CAMERA_SYNC_TRACE;
     if (streamCaptureCallback_ != nullptr) {
-        streamCaptureCallback_->OnCaptureStarted(captureId);
+        CheckCallbackDelivery(streamCaptureCallback_->OnCaptureStarted(captureId));
     }
     return CAMERA_OK;
 }
@@ -114,14 +474,38 @@ int32_t HStreamCapture::OnCaptureStarted(int32_t captureId)
 int32_t HStreamCapture::OnCaptureEnded(int32_t captureId, int32_t frameCount)
 {
     CAMERA_SYNC_TRACE;
+    {
+        std::lock_guard<std::mutex> lock(burstLock_);
+        auto shutterTime = shutterTimes_.find(captureId);
+        if (shutterTime != shutterTimes_.end()) {
+            CameraLatencyStats::GetInstance().Record(GetCameraId(), LATENCY_SHUTTER_TO_CAPTURE_ENDED,
+                                                     shutterTime->second);
+            shutterTimes_.erase(shutterTime);
+        }
+        if (captureId == burstCaptureId_) {
+            if (isBurstActive_) {
+                // Ended by the HDI itself, e.g. after an error
+                isBurstActive_ = false;
+                ReleaseCaptureId(captureId);
+            }
+            // Frames that were still in flight when the burst was cancelled are not reported
+            frameCount = burstShutterCount_;
+            burstCaptureId_ = 0;
+        }
+    }
     if (streamCaptureCallback_ != nullptr) {
-        streamCaptureCallback_->OnCaptureEnded(captureId, frameCount);
+        CheckCallbackDelivery(streamCaptureCallback_->OnCaptureEnded(captureId, frameCount));
     }
     return CAMERA_OK;
 }
 
 int32_t HStreamCapture::OnCaptureError(int32_t captureId, int32_t errorCode)
 {
+    {
+        // A failed capture may never end, its shutter time would stay behind
+        std::lock_guard<std::mutex> lock(burstLock_);
+        shutterTimes_.erase(captureId);
+    }
     if (streamCaptureCallback_ != nullptr) {
         int32_t captureErrorCode;
         if (errorCode == BUFFER_LOST) {
@@ -129,9 +513,8 @@ int32_t HStreamCapture::OnCaptureError(int32_t captureId, int32_t errorCode)
         } else {
             captureErrorCode = CAMERA_UNKNOWN_ERROR;
         }
-        CAMERA_SYSEVENT_FAULT(CreateMsg("Photo OnCaptureError! captureId:%d & "
-                                        "errorCode:%{public}d", captureId, captureErrorCode));
-        streamCaptureCallback_->OnCaptureError(captureId, captureErrorCode);
+        CameraTelemetry::GetInstance().Post(TELEMETRY_CAPTURE_ERROR, captureId, captureErrorCode);
+        CheckCallbackDelivery(streamCaptureCallback_->OnCaptureError(captureId, captureErrorCode));
     }
     return CAMERA_OK;
 }
@@ -139,8 +522,31 @@ int32_t HStreamCapture::OnCaptureError(int32_t captureId, int32_t errorCode)
 int32_t HStreamCapture::OnFrameShutter(int32_t captureId, uint64_t timestamp)
 {
     CAMERA_SYNC_TRACE;
+    bool isLastFrame = false;
+    {
+        std::lock_guard<std::mutex> lock(burstLock_);
+        if (captureId == burstCaptureId_) {
+            if (!isBurstActive_) {
+                return CAMERA_OK;
+            }
+            burstShutterCount_++;
+            isLastFrame = (burstShutterCount_ == burstFrameCount_);
+            if (isLastFrame) {
+                // Later shutters of the burst are dropped from here on, the cancel itself is posted below
+                isBurstActive_ = false;
+            }
+        }
+        // Only the first shutter of a burst is kept
+        shutterTimes_.emplace(captureId, CameraLatencyStats::GetTimestampUs());
+    }
     if (streamCaptureCallback_ != nullptr) {
-        streamCaptureCallback_->OnFrameShutter(captureId, timestamp);
+        CheckCallbackDelivery(streamCaptureCallback_->OnFrameShutter(captureId, timestamp));
+    }
+    if (isLastFrame) {
+        if (jpegEncoder_ != nullptr) {
+            jpegEncoder_->EndCapture(captureId);
+        }
+        PostCancelCapture(captureId);
     }
     return CAMERA_OK;
 }
@@ -149,6 +555,18 @@ void HStreamCapture::DumpStreamInfo(std::string& dumpString)
 {
     dumpString += "capture stream:\n";
     HStreamCommon::DumpStreamInfo(dumpString);
+    if (zslRingBuffer_ != nullptr) {
+        zslRingBuffer_->DumpRingInfo(dumpString);
+    }
+    if (jpegEncoder_ != nullptr) {
+        jpegEncoder_->DumpEncoderInfo(dumpString);
+    }
+    std::lock_guard<std::mutex> lock(burstLock_);
+    if (isBurstActive_) {
+        dumpString += "Burst Capture ID:[" + std::to_string(burstCaptureId_) + "]:"
+            + " Frames:[" + std::to_string(burstShutterCount_) + "/"
+            + std::to_string(burstFrameCount_) + "]\n";
+    }
 }
 } // namespace CameraStandard
 } // namespace OHOS
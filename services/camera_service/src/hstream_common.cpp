@@ -25,12 +25,16 @@ HStreamCommon::HStreamCommon(StreamType streamType, sptr<OHOS::IBufferProducer>
     streamId_ = 0;
     curCaptureID_ = 0;
     isReleaseStream_ = false;
+    isGroupCapture_ = false;
     streamOperator_ = nullptr;
     cameraAbility_ = nullptr;
     producer_ = producer;
-    width_ = producer->GetDefaultWidth();
-    height_ = producer->GetDefaultHeight();
+    width_ = (producer != nullptr) ? producer->GetDefaultWidth() : 0;
+    height_ = (producer != nullptr) ? producer->GetDefaultHeight() : 0;
+    hdiWidth_ = width_;
+    hdiHeight_ = height_;
     format_ = format;
+    hdiFormat_ = format;
     streamType_ = streamType;
 }
 
@@ -65,7 +69,18 @@ int32_t HStreamCommon::LinkInput(sptr<IStreamOperator> streamOperator,
         MEDIA_ERR_LOG("HStreamCommon::LinkInput streamOperator is null");
         return CAMERA_INVALID_ARG;
     }
-    if (!IsValidSize(cameraAbility, format_, width_, height_)) {
+    hdiFormat_ = format_;
+    hdiWidth_ = width_;
+    hdiHeight_ = height_;
+    // Only repeat streams pass through the frame relay that converts and scales the frames
+    bool isRepeat = (streamType_ == StreamType::REPEAT);
+    // The conversion is chosen from the ability itself, IsValidSize accepts any size on most products
+    bool isLinked = (isRepeat && FindScaledSize(cameraAbility, format_, width_, height_,
+                                                hdiFormat_, hdiWidth_, hdiHeight_))
+        || (isRepeat && !IsSupportedSize(cameraAbility, format_, width_, height_)
+            && FindConvertibleFormat(cameraAbility, format_, width_, height_, hdiFormat_))
+        || IsValidSize(cameraAbility, format_, width_, height_);
+    if (!isLinked) {
         return CAMERA_INVALID_SESSION_CFG;
     }
     streamId_ = streamId;
@@ -74,27 +89,44 @@ int32_t HStreamCommon::LinkInput(sptr<IStreamOperator> streamOperator,
     return CAMERA_OK;
 }
 
-void HStreamCommon::SetStreamInfo(StreamInfo &streamInfo)
+void HStreamCommon::SetCameraId(const std::string &cameraId)
 {
-    int32_t pixelFormat;
-    auto it = g_cameraToPixelFormat.find(format_);
-    if (it != g_cameraToPixelFormat.end()) {
-        pixelFormat = it->second;
-    } else {
-#ifdef RK_CAMERA
-        pixelFormat = PIXEL_FMT_RGBA_8888;
-#else
-        pixelFormat = PIXEL_FMT_YCRCB_420_SP;
-#endif
+    std::lock_guard<std::mutex> lock(cameraIdLock_);
+    cameraId_ = cameraId;
+}
+
+std::string HStreamCommon::GetCameraId()
+{
+    std::lock_guard<std::mutex> lock(cameraIdLock_);
+    return cameraId_;
+}
+
+SettingsBlob HStreamCommon::GetAbilitySettings()
+{
+    if (cameraAbility_ == nullptr) {
+        return nullptr;
+    }
+    // Serialized once per linked ability and shared by every start or capture on this stream
+    if (abilitySettings_ == nullptr || abilitySettings_->GetMetadata() != cameraAbility_) {
+        abilitySettings_ = std::make_shared<CameraSettings>(cameraAbility_);
     }
+    return abilitySettings_->GetSerialized();
+}
+
+void HStreamCommon::SetStreamInfo(StreamInfo &streamInfo)
+{
+    int32_t pixelFormat = GetPixelFormat(hdiFormat_);
     MEDIA_INFO_LOG("HStreamCommon::SetStreamInfo pixelFormat is %{public}d", pixelFormat);
     streamInfo.streamId_ = streamId_;
-    streamInfo.width_ = width_;
-    streamInfo.height_ = height_;
+    streamInfo.width_ = hdiWidth_;
+    streamInfo.height_ = hdiHeight_;
     streamInfo.format_ = pixelFormat;
     streamInfo.minFrameDuration_ = 0;
     streamInfo.tunneledMode_ = true;
-    streamInfo.bufferQueue_ = new BufferProducerSequenceable(producer_);
+    // A deferred output is committed without a buffer queue and gets it through AttachBufferQueue
+    if (producer_ != nullptr) {
+        streamInfo.bufferQueue_ = new BufferProducerSequenceable(producer_);
+    }
     streamInfo.dataspace_ = CAMERA_COLOR_SPACE;
 }
 
@@ -102,19 +134,102 @@ int32_t HStreamCommon::Release()
 {
     streamId_ = 0;
     curCaptureID_ = 0;
+    isGroupCapture_ = false;
     streamOperator_ = nullptr;
     cameraAbility_ = nullptr;
+    abilitySettings_ = nullptr;
     producer_ = nullptr;
     return CAMERA_OK;
 }
 
+void HStreamCommon::JoinCaptureGroup(int32_t captureId, CaptureGroupLeaver leaver)
+{
+    curCaptureID_ = captureId;
+    isGroupCapture_ = true;
+    std::lock_guard<std::mutex> lock(groupLock_);
+    groupLeaver_ = leaver;
+}
+
+void HStreamCommon::LeaveCaptureGroup()
+{
+    curCaptureID_ = 0;
+    isGroupCapture_ = false;
+    std::lock_guard<std::mutex> lock(groupLock_);
+    groupLeaver_ = nullptr;
+}
+
+int32_t HStreamCommon::ExitCaptureGroup()
+{
+    CaptureGroupLeaver leaver;
+    {
+        std::lock_guard<std::mutex> lock(groupLock_);
+        leaver = groupLeaver_;
+    }
+    if (leaver == nullptr) {
+        MEDIA_ERR_LOG("HStreamCommon::ExitCaptureGroup, Stream is not in a capture group");
+        return CAMERA_INVALID_STATE;
+    }
+    // Called without the group lock, the session takes its own lock and calls LeaveCaptureGroup
+    return leaver(this);
+}
+
+bool HStreamCommon::IsGroupCapture()
+{
+    return isGroupCapture_;
+}
+
+int32_t HStreamCommon::AttachBufferQueue()
+{
+    if (streamOperator_ == nullptr) {
+        return CAMERA_INVALID_STATE;
+    }
+    StreamInfo streamInfo;
+    SetStreamInfo(streamInfo);
+    if (streamInfo.bufferQueue_ == nullptr) {
+        return CAMERA_OK;
+    }
+    CamRetCode rc = (CamRetCode)(streamOperator_->AttachBufferQueue(streamId_, streamInfo.bufferQueue_));
+    if (rc != HDI::Camera::V1_0::NO_ERROR) {
+        MEDIA_ERR_LOG("HStreamCommon::AttachBufferQueue stream %{public}d failed: %{public}d", streamId_, rc);
+        return HdiToServiceError(rc);
+    }
+    return CAMERA_OK;
+}
+
+int32_t HStreamCommon::DetachBufferQueue()
+{
+    if (streamOperator_ == nullptr) {
+        return CAMERA_INVALID_STATE;
+    }
+    CamRetCode rc = (CamRetCode)(streamOperator_->DetachBufferQueue(streamId_));
+    if (rc != HDI::Camera::V1_0::NO_ERROR) {
+        MEDIA_ERR_LOG("HStreamCommon::DetachBufferQueue stream %{public}d failed: %{public}d", streamId_, rc);
+        return HdiToServiceError(rc);
+    }
+    return CAMERA_OK;
+}
+
+void HStreamCommon::CheckCallbackDelivery(int32_t result)
+{
+    // Stream callbacks are one-way, a failure means the client's async buffer is full or the client is gone
+    if (result != CAMERA_OK) {
+        droppedCallbacks_++;
+        MEDIA_DEBUG_LOG("HStreamCommon::CheckCallbackDelivery stream %{public}d dropped callback, ret: %{public}d",
+                        streamId_, result);
+    }
+}
+
 void HStreamCommon::DumpStreamInfo(std::string& dumpString)
 {
     StreamInfo curStreamInfo;
     SetStreamInfo(curStreamInfo);
     dumpString += "release status:[" + std::to_string(isReleaseStream_) + "]:\n";
     dumpString += "stream info: \n";
-    dumpString += "    Buffer producer Id:[" + std::to_string(curStreamInfo.bufferQueue_->producer_->GetUniqueId());
+    if (curStreamInfo.bufferQueue_ != nullptr && curStreamInfo.bufferQueue_->producer_ != nullptr) {
+        dumpString += "    Buffer producer Id:[" + std::to_string(curStreamInfo.bufferQueue_->producer_->GetUniqueId());
+    } else {
+        dumpString += "    Buffer producer Id:[deferred";
+    }
     dumpString += "]    stream Id:[" + std::to_string(curStreamInfo.streamId_);
     std::map<int, std::string>::const_iterator iter =
         g_cameraFormat.find(format_);
@@ -126,7 +241,8 @@ void HStreamCommon::DumpStreamInfo(std::string& dumpString)
     dumpString += "]    dataspace:[" + std::to_string(curStreamInfo.dataspace_);
     dumpString += "]    StreamType:[" + std::to_string(curStreamInfo.intent_);
     dumpString += "]    TunnelMode:[" + std::to_string(curStreamInfo.tunneledMode_);
-    dumpString += "]    Encoding Type:[" + std::to_string(curStreamInfo.encodeType_) + "]:\n";
+    dumpString += "]    Encoding Type:[" + std::to_string(curStreamInfo.encodeType_);
+    dumpString += "]    Dropped Callbacks:[" + std::to_string(droppedCallbacks_.load()) + "]:\n";
 }
 } // namespace CameraStandard
 } // namespace OHOS
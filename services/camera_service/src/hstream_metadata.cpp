@@ -15,9 +15,9 @@
 
 #include "hstream_metadata.h"
 
+#include "camera_latency_stats.h"
 #include "camera_util.h"
 #include "camera_log.h"
-#include "metadata_utils.h"
 
 namespace OHOS {
 namespace CameraStandard {
@@ -63,14 +63,21 @@ int32_t HStreamMetadata::Start()
         MEDIA_ERR_LOG("HStreamMetadata::Start Failed to allocate a captureId");
         return ret;
     }
-    std::vector<uint8_t> ability;
-    OHOS::Camera::MetadataUtils::ConvertMetadataToVec(cameraAbility_, ability);
+    SettingsBlob ability = GetAbilitySettings();
+    if (ability == nullptr) {
+        ReleaseCaptureId(curCaptureID_);
+        curCaptureID_ = 0;
+        MEDIA_ERR_LOG("HStreamMetadata::Start camera ability is null");
+        return CAMERA_INVALID_STATE;
+    }
     CaptureInfo captureInfo;
     captureInfo.streamIds_ = {streamId_};
-    captureInfo.captureSetting_ = ability;
+    captureInfo.captureSetting_ = *ability;
     captureInfo.enableShutterCallback_ = false;
     MEDIA_INFO_LOG("HStreamMetadata::Start Starting with capture ID: %{public}d", curCaptureID_);
+    int64_t startTime = CameraLatencyStats::GetTimestampUs();
     CamRetCode rc = (CamRetCode)(streamOperator_->Capture(curCaptureID_, captureInfo, true));
+    CameraLatencyStats::GetInstance().Record(GetCameraId(), LATENCY_CAPTURE, startTime);
     if (rc != HDI::Camera::V1_0::NO_ERROR) {
         ReleaseCaptureId(curCaptureID_);
         curCaptureID_ = 0;
@@ -91,8 +98,14 @@ int32_t HStreamMetadata::Stop()
         MEDIA_ERR_LOG("HStreamMetadata::Stop, Stream not started yet");
         return CAMERA_INVALID_STATE;
     }
+    if (IsGroupCapture()) {
+        MEDIA_ERR_LOG("HStreamMetadata::Stop, Stream is started with its session group, stop the session");
+        return CAMERA_INVALID_STATE;
+    }
     int32_t ret = CAMERA_OK;
+    int64_t startTime = CameraLatencyStats::GetTimestampUs();
     CamRetCode rc = (CamRetCode)(streamOperator_->CancelCapture(curCaptureID_));
+    CameraLatencyStats::GetInstance().Record(GetCameraId(), LATENCY_CANCEL_CAPTURE, startTime);
     if (rc != HDI::Camera::V1_0::NO_ERROR) {
         MEDIA_ERR_LOG("HStreamMetadata::Stop Failed with errorCode:%{public}d, curCaptureID_: %{public}d",
                       rc, curCaptureID_);
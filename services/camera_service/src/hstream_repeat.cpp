@@ -15,11 +15,16 @@
 
 #include "hstream_repeat.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include "camera_latency_stats.h"
+#include "camera_telemetry.h"
 #include "camera_util.h"
-#include "metadata_utils.h"
 #include "display.h"
 #include "display_manager.h"
 #include "camera_log.h"
+#include "metadata_utils.h"
 
 namespace OHOS {
 namespace CameraStandard {
@@ -27,11 +32,30 @@ static const int32_t STREAM_ROTATE_90 = 90;
 static const int32_t STREAM_ROTATE_180 = 180;
 static const int32_t STREAM_ROTATE_270 = 270;
 static const int32_t STREAM_ROTATE_360 = 360;
+static const int32_t FPS_RANGE_STEP = 2;
+static const int32_t FPS_SETTINGS_ITEMS = 1;
+static const int32_t FPS_SETTINGS_DATA_LENGTH = 8;
+// A shutter interval this much over the nominal one counts as missed frames
+static const uint64_t FRAME_GAP_THRESHOLD_NUM = 3;
+static const uint64_t FRAME_GAP_THRESHOLD_DEN = 2;
+static const uint64_t FRAME_INTERVAL_SMOOTHING = 8;
+static const uint64_t NANOSECONDS_PER_MICROSECOND = 1000;
+
+static int64_t GetSteadyTimeNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
 
 HStreamRepeat::HStreamRepeat(sptr<OHOS::IBufferProducer> producer, int32_t format)
     : HStreamCommon(StreamType::REPEAT, producer, format)
 {
     isVideo_ = false;
+#ifdef CAMERA_FRAME_GAP_MONITOR
+    isFrameGapMonitored_ = true;
+#else
+    isFrameGapMonitored_ = false;
+#endif
 }
 
 HStreamRepeat::HStreamRepeat(sptr<OHOS::IBufferProducer> producer, int32_t format, int32_t width, int32_t height)
@@ -47,6 +71,13 @@ HStreamRepeat::HStreamRepeat(sptr<OHOS::IBufferProducer> producer, int32_t forma
     isVideo_ = isVideo;
 }
 
+HStreamRepeat::HStreamRepeat(sptr<OHOS::IBufferProducer> producer, int32_t format, int32_t width, int32_t height,
+                             bool isVideo)
+    : HStreamRepeat(producer, format, width, height)
+{
+    isVideo_ = isVideo;
+}
+
 HStreamRepeat::~HStreamRepeat()
 {}
 
@@ -60,11 +91,57 @@ int32_t HStreamRepeat::LinkInput(sptr<IStreamOperator> streamOperator,
     if (!isVideo_) {
         SetStreamTransform();
     }
+    sptr<HStreamRepeat> sharedSource = GetSharedSource();
+    if (sharedSource != nullptr) {
+        // The shared source converts the frames for all of its outputs, a smaller output scales them from its size
+        hdiFormat_ = format_;
+        hdiWidth_ = sharedSource->width_;
+        hdiHeight_ = sharedSource->height_;
+    }
+    sptr<OHOS::IBufferProducer> outputProducer;
+    {
+        std::lock_guard<std::mutex> lock(fpsLock_);
+        bool isConverted = (hdiFormat_ != format_);
+        bool isScaled = (hdiWidth_ != width_ || hdiHeight_ != height_);
+        bool isRequired = (isConverted || isScaled);
+        // A deferred surface may turn down the transform once it arrives, the relay then rotates its frames
+        bool isRotated = (softwareRotation_ != 0) || (producer_ == nullptr && !isVideo_ && GetStreamRotation() != 0);
+        if (frameRelay_ == nullptr
+            && (isRequired || isRotated || (targetFps_ > 0 && !IsHdiFrameRateSupported(targetFps_)))) {
+            // The device cannot run this stream at its own rate, size or in the client format, or the
+            // client surface cannot rotate it, frames are decimated, scaled, converted or rotated in the service
+            sptr<FrameRelay> relay = new(std::nothrow) FrameRelay(producer_);
+            if (relay == nullptr || relay->Init(hdiWidth_, hdiHeight_) != CAMERA_OK) {
+                MEDIA_ERR_LOG("HStreamRepeat::LinkInput Failed to create frame relay, streaming as the device "
+                              "delivers");
+                if (isRequired) {
+                    return CAMERA_ALLOC_ERROR;
+                }
+            } else {
+                relay->SetTargetFps(targetFps_);
+                if (isConverted) {
+                    relay->SetConversion(GetPixelFormat(hdiFormat_), GetPixelFormat(format_));
+                }
+                if (isScaled) {
+                    relay->SetOutputSize(width_, height_);
+                }
+                frameRelay_ = relay;
+            }
+        }
+        if (frameRelay_ != nullptr) {
+            frameRelay_->SetTransform(softwareRotation_, false);
+        }
+        outputProducer = (frameRelay_ != nullptr) ? frameRelay_->GetProducer() : producer_;
+    }
+    if (sharedSource != nullptr) {
+        return sharedSource->AddSharedOutput(this, outputProducer);
+    }
     return CAMERA_OK;
 }
 
 void HStreamRepeat::SetStreamInfo(StreamInfo &streamInfo)
 {
+    std::lock_guard<std::mutex> lock(fpsLock_);
     HStreamCommon::SetStreamInfo(streamInfo);
     if (isVideo_) {
         streamInfo.intent_ = VIDEO;
@@ -73,6 +150,62 @@ void HStreamRepeat::SetStreamInfo(StreamInfo &streamInfo)
         streamInfo.intent_ = PREVIEW;
         streamInfo.encodeType_ = ENCODE_TYPE_NULL;
     }
+    if (frameRelay_ != nullptr && frameRelay_->GetProducer() != nullptr) {
+        streamInfo.bufferQueue_ = new BufferProducerSequenceable(frameRelay_->GetProducer());
+    }
+}
+
+bool HStreamRepeat::IsHdiFrameRateSupported(float fps)
+{
+    // The HDI only takes whole frame rates and applies them to the sensor, which every stream follows
+    if (isSensorRateShared_ || cameraAbility_ == nullptr || fps != std::floor(fps)) {
+        return false;
+    }
+    camera_metadata_item_t item;
+    int ret = OHOS::Camera::FindCameraMetadataItem(cameraAbility_->get(), OHOS_ABILITY_FPS_RANGES, &item);
+    if (ret != CAM_META_SUCCESS) {
+        return false;
+    }
+    for (uint32_t i = 0; i + 1 < item.count; i += FPS_RANGE_STEP) {
+        if (item.data.i32[i] <= fps && fps <= item.data.i32[i + 1]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void HStreamRepeat::GetStreamingSettings(std::vector<uint8_t> &settings)
+{
+    isHdiFrameRate_ = (frameRelay_ == nullptr && targetFps_ > 0 && IsHdiFrameRateSupported(targetFps_));
+    SettingsBlob ability = GetAbilitySettings();
+    if (!isHdiFrameRate_) {
+        if (ability != nullptr) {
+            settings = *ability;
+        }
+        return;
+    }
+    // The request carries the settings of every other request with the frame rate range on top,
+    // the serialized size bounds the data of the copied entries
+    uint32_t count = OHOS::Camera::GetCameraMetadataItemCount(cameraAbility_->get());
+    size_t dataLength = ((ability != nullptr) ? ability->size() : 0) + FPS_SETTINGS_DATA_LENGTH;
+    std::shared_ptr<OHOS::Camera::CameraMetadata> streamingSettings =
+        std::make_shared<OHOS::Camera::CameraMetadata>(count + FPS_SETTINGS_ITEMS, dataLength);
+    camera_metadata_item_t item;
+    for (uint32_t index = 0; index < count; index++) {
+        if (OHOS::Camera::GetCameraMetadataItem(cameraAbility_->get(), index, &item) != CAM_META_SUCCESS
+            || item.item == OHOS_CONTROL_FPS_RANGES) {
+            continue;
+        }
+        if (!streamingSettings->addEntry(item.item, item.data.u8, item.count)) {
+            MEDIA_ERR_LOG("HStreamRepeat::GetStreamingSettings Failed to copy setting: %{public}d", item.item);
+        }
+    }
+    int32_t fps = static_cast<int32_t>(targetFps_);
+    int32_t frameRateRange[FPS_RANGE_STEP] = {fps, fps};
+    if (!streamingSettings->addEntry(OHOS_CONTROL_FPS_RANGES, frameRateRange, FPS_RANGE_STEP)) {
+        MEDIA_ERR_LOG("HStreamRepeat::GetStreamingSettings Failed to add frame rate range");
+    }
+    OHOS::Camera::MetadataUtils::ConvertMetadataToVec(streamingSettings, settings);
 }
 
 int32_t HStreamRepeat::Start()
@@ -86,24 +219,48 @@ int32_t HStreamRepeat::Start()
         MEDIA_ERR_LOG("HStreamRepeat::Start, Already started with captureID: %{public}d", curCaptureID_);
         return CAMERA_INVALID_STATE;
     }
+    sptr<HStreamRepeat> sharedSource = GetSharedSource();
+    if (sharedSource != nullptr) {
+        return sharedSource->StartSharedOutput(this, false);
+    }
     int32_t ret = AllocateCaptureId(curCaptureID_);
     if (ret != CAMERA_OK) {
         MEDIA_ERR_LOG("HStreamRepeat::Start Failed to allocate a captureId");
         return ret;
     }
-    std::vector<uint8_t> ability;
-    OHOS::Camera::MetadataUtils::ConvertMetadataToVec(cameraAbility_, ability);
+    if (cameraAbility_ == nullptr) {
+        ReleaseCaptureId(curCaptureID_);
+        curCaptureID_ = 0;
+        MEDIA_ERR_LOG("HStreamRepeat::Start camera ability is null");
+        return CAMERA_INVALID_STATE;
+    }
     CaptureInfo captureInfo;
     captureInfo.streamIds_ = {streamId_};
-    captureInfo.captureSetting_ = ability;
-    captureInfo.enableShutterCallback_ = false;
+    {
+        std::lock_guard<std::mutex> lock(fpsLock_);
+        GetStreamingSettings(captureInfo.captureSetting_);
+    }
+    // Per frame shutter callbacks are only requested to measure frame gaps
+    captureInfo.enableShutterCallback_ = isFrameGapMonitored_;
+    {
+        std::lock_guard<std::mutex> lock(frameGapLock_);
+        lastShutterTime_ = 0;
+    }
     MEDIA_INFO_LOG("HStreamRepeat::Start Starting with capture ID: %{public}d", curCaptureID_);
+    // Armed before the request, the HDI may report it started before Capture returns
+    int64_t startTime = CameraLatencyStats::GetTimestampUs();
+    SetFirstFrameStartTime(startTime);
     CamRetCode rc = (CamRetCode)(streamOperator_->Capture(curCaptureID_, captureInfo, true));
+    CameraLatencyStats::GetInstance().Record(GetCameraId(), LATENCY_CAPTURE, startTime);
     if (rc != HDI::Camera::V1_0::NO_ERROR) {
+        SetFirstFrameStartTime(0);
         ReleaseCaptureId(curCaptureID_);
         curCaptureID_ = 0;
         MEDIA_ERR_LOG("HStreamRepeat::Start Failed with error Code:%{public}d", rc);
         ret = HdiToServiceError(rc);
+    } else {
+        std::lock_guard<std::mutex> lock(fpsLock_);
+        streamingStartTime_ = GetSteadyTimeNs();
     }
     return ret;
 }
@@ -119,8 +276,18 @@ int32_t HStreamRepeat::Stop()
         MEDIA_ERR_LOG("HStreamRepeat::Stop, Stream not started yet");
         return CAMERA_INVALID_STATE;
     }
+    if (IsGroupCapture()) {
+        // The other outputs of the group keep streaming with a reissued request
+        return ExitCaptureGroup();
+    }
+    sptr<HStreamRepeat> sharedSource = GetSharedSource();
+    if (sharedSource != nullptr) {
+        return sharedSource->StopSharedOutput(this);
+    }
     int32_t ret = CAMERA_OK;
+    int64_t startTime = CameraLatencyStats::GetTimestampUs();
     CamRetCode rc = (CamRetCode)(streamOperator_->CancelCapture(curCaptureID_));
+    CameraLatencyStats::GetInstance().Record(GetCameraId(), LATENCY_CANCEL_CAPTURE, startTime);
     if (rc != HDI::Camera::V1_0::NO_ERROR) {
         MEDIA_ERR_LOG("HStreamRepeat::Stop Failed with errorCode:%{public}d, curCaptureID_: %{public}d",
                       rc, curCaptureID_);
@@ -133,15 +300,90 @@ int32_t HStreamRepeat::Stop()
 
 int32_t HStreamRepeat::SetFps(float Fps)
 {
+    if (std::isnan(Fps) || Fps < 0 || Fps > MAX_STREAM_FPS) {
+        MEDIA_ERR_LOG("HStreamRepeat::SetFps invalid frame rate: %{public}f", Fps);
+        return CAMERA_INVALID_ARG;
+    }
+    bool isRestartNeeded = false;
+    {
+        std::lock_guard<std::mutex> lock(fpsLock_);
+        if (frameRelay_ != nullptr) {
+            targetFps_ = Fps;
+            frameRelay_->SetTargetFps(Fps);
+            return CAMERA_OK;
+        }
+        if (streamOperator_ != nullptr && Fps > 0 && !IsHdiFrameRateSupported(Fps)) {
+            // Decimation needs the relay in the buffer path, which is only set up when the stream is committed
+            MEDIA_ERR_LOG("HStreamRepeat::SetFps %{public}f fps needs the frame rate set before CommitConfig", Fps);
+            return CAMERA_INVALID_STATE;
+        }
+        targetFps_ = Fps;
+        // A grouped request carries no per stream frame rate, so there is nothing to reissue
+        isRestartNeeded = (curCaptureID_ != 0) && !IsGroupCapture() && (Fps > 0 || isHdiFrameRate_);
+    }
+    if (isRestartNeeded) {
+        // The HDI takes the frame rate with the streaming request, so the request is reissued
+        Stop();
+        return Start();
+    }
+    return CAMERA_OK;
+}
+
+int32_t HStreamRepeat::GetAchievedFps(float &fps)
+{
+    std::lock_guard<std::mutex> lock(fpsLock_);
+    if (frameRelay_ != nullptr) {
+        fps = frameRelay_->GetAchievedFps();
+    } else {
+        fps = lastAchievedFps_;
+    }
     return CAMERA_OK;
 }
 
+void HStreamRepeat::SetSensorRateShared(bool isShared)
+{
+    bool isRestartNeeded = false;
+    {
+        std::lock_guard<std::mutex> lock(fpsLock_);
+        if (isSensorRateShared_ == isShared) {
+            return;
+        }
+        isSensorRateShared_ = isShared;
+        // A running request that set the device frame rate would now pace the other streams too
+        isRestartNeeded = isShared && isHdiFrameRate_ && curCaptureID_ != 0 && !IsGroupCapture();
+    }
+    if (isRestartNeeded) {
+        Stop();
+        Start();
+    }
+}
+
 int32_t HStreamRepeat::Release()
 {
-    if (curCaptureID_) {
+    sptr<HStreamRepeat> sharedSource = GetSharedSource();
+    if (sharedSource != nullptr) {
+        // The capture id belongs to the source
+        sharedSource->RemoveSharedOutput(this);
+        SetSharedSource(nullptr);
+    } else if (curCaptureID_ && !IsGroupCapture()) {
         ReleaseCaptureId(curCaptureID_);
     }
     streamRepeatCallback_ = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(sharedLock_);
+        if (fanOut_ != nullptr) {
+            fanOut_->Release();
+            fanOut_ = nullptr;
+        }
+        sharedOutputs_.clear();
+    }
+    {
+        std::lock_guard<std::mutex> lock(fpsLock_);
+        if (frameRelay_ != nullptr) {
+            frameRelay_->Release();
+            frameRelay_ = nullptr;
+        }
+    }
     return HStreamCommon::Release();
 }
 
@@ -160,11 +402,53 @@ int32_t HStreamRepeat::SetCallback(sptr<IStreamRepeatCallback> &callback)
     return CAMERA_OK;
 }
 
+int32_t HStreamRepeat::AddDeferredSurface(const sptr<OHOS::IBufferProducer> &producer)
+{
+    if (producer == nullptr) {
+        MEDIA_ERR_LOG("HStreamRepeat::AddDeferredSurface producer is null");
+        return CAMERA_INVALID_ARG;
+    }
+    {
+        std::lock_guard<std::mutex> lock(fpsLock_);
+        if (producer_ != nullptr) {
+            MEDIA_ERR_LOG("HStreamRepeat::AddDeferredSurface stream already has a surface");
+            return CAMERA_INVALID_STATE;
+        }
+        producer_ = producer;
+        if (!isVideo_ && cameraAbility_ != nullptr) {
+            SetStreamTransform();
+        }
+        if (streamOperator_ == nullptr) {
+            // Not committed yet, the surface goes into the stream info at commit
+            return CAMERA_OK;
+        }
+        if (frameRelay_ != nullptr) {
+            // The device already writes into the relay, only the relay output was missing
+            frameRelay_->SetClientProducer(producer_);
+            frameRelay_->SetTransform(softwareRotation_, false);
+            return CAMERA_OK;
+        }
+    }
+    int32_t ret = AttachBufferQueue();
+    if (ret != CAMERA_OK) {
+        std::lock_guard<std::mutex> lock(fpsLock_);
+        producer_ = nullptr;
+    }
+    return ret;
+}
+
 int32_t HStreamRepeat::OnFrameStarted()
 {
     CAMERA_SYNC_TRACE;
+    int64_t startTime = firstFrameStartTime_.exchange(0);
+    if (startTime != 0) {
+        CameraLatencyStats::GetInstance().Record(GetCameraId(), LATENCY_FIRST_FRAME, startTime);
+    }
     if (streamRepeatCallback_ != nullptr) {
-        streamRepeatCallback_->OnFrameStarted();
+        CheckCallbackDelivery(streamRepeatCallback_->OnFrameStarted());
+    }
+    for (auto &output : GetActiveSharedOutputs()) {
+        output->OnFrameStarted();
     }
     return CAMERA_OK;
 }
@@ -172,8 +456,17 @@ int32_t HStreamRepeat::OnFrameStarted()
 int32_t HStreamRepeat::OnFrameEnded(int32_t frameCount)
 {
     CAMERA_SYNC_TRACE;
+    {
+        std::lock_guard<std::mutex> lock(fpsLock_);
+        int64_t elapsed = GetSteadyTimeNs() - streamingStartTime_;
+        if (streamingStartTime_ != 0 && elapsed > 0) {
+            // Without the relay the service only sees the frame count once streaming ends
+            lastAchievedFps_ = static_cast<float>(frameCount) * std::nano::den / elapsed;
+        }
+        streamingStartTime_ = 0;
+    }
     if (streamRepeatCallback_ != nullptr) {
-        streamRepeatCallback_->OnFrameEnded(frameCount);
+        CheckCallbackDelivery(streamRepeatCallback_->OnFrameEnded(frameCount));
     }
     return CAMERA_OK;
 }
@@ -187,32 +480,334 @@ int32_t HStreamRepeat::OnFrameError(int32_t errorType)
         } else {
             repeatErrorCode = CAMERA_UNKNOWN_ERROR;
         }
-        CAMERA_SYSEVENT_FAULT(CreateMsg("Preview OnFrameError! errorCode:%d", repeatErrorCode));
-        streamRepeatCallback_->OnFrameError(repeatErrorCode);
+        CameraTelemetry::GetInstance().Post(TELEMETRY_FRAME_ERROR, repeatErrorCode);
+        CheckCallbackDelivery(streamRepeatCallback_->OnFrameError(repeatErrorCode));
+    }
+    for (auto &output : GetActiveSharedOutputs()) {
+        output->OnFrameError(errorType);
     }
     return CAMERA_OK;
 }
 
+int32_t HStreamRepeat::OnFrameShutter(int32_t captureId, uint64_t timestamp)
+{
+    for (auto &output : GetActiveSharedOutputs()) {
+        output->OnFrameShutter(captureId, timestamp);
+    }
+    std::lock_guard<std::mutex> lock(frameGapLock_);
+    if (captureId != curCaptureID_) {
+        return CAMERA_OK;
+    }
+    monitoredFrames_++;
+    if (lastShutterTime_ == 0 || timestamp <= lastShutterTime_) {
+        lastShutterTime_ = timestamp;
+        return CAMERA_OK;
+    }
+    uint64_t gap = timestamp - lastShutterTime_;
+    lastShutterTime_ = timestamp;
+    uint64_t missed = 0;
+    if (frameInterval_ == 0) {
+        frameInterval_ = gap;
+    } else if (gap * FRAME_GAP_THRESHOLD_DEN < frameInterval_ * FRAME_GAP_THRESHOLD_NUM) {
+        // Only regular intervals feed the nominal one, so a stall does not stretch it
+        frameInterval_ = (frameInterval_ * (FRAME_INTERVAL_SMOOTHING - 1) + gap) / FRAME_INTERVAL_SMOOTHING;
+    } else {
+        missed = (gap + frameInterval_ / FRAME_GAP_THRESHOLD_DEN) / frameInterval_ - 1;
+    }
+    missedFrames_ += missed;
+    maxFrameGap_ = std::max(maxFrameGap_, gap);
+    if (isReconfiguring_) {
+        reconfigureGap_ = std::max(reconfigureGap_, gap);
+        reconfigureMissedFrames_ += missed;
+        if (isReconfigureEnding_) {
+            isReconfiguring_ = false;
+            isReconfigureEnding_ = false;
+            MEDIA_INFO_LOG("HStreamRepeat::OnFrameShutter stream %{public}d reconfigure gap %{public}s us,"
+                           " missed frames %{public}s", streamId_,
+                           std::to_string(reconfigureGap_ / NANOSECONDS_PER_MICROSECOND).c_str(),
+                           std::to_string(reconfigureMissedFrames_).c_str());
+        }
+    }
+    return CAMERA_OK;
+}
+
+void HStreamRepeat::JoinCaptureGroup(int32_t captureId, CaptureGroupLeaver leaver)
+{
+    HStreamCommon::JoinCaptureGroup(captureId, leaver);
+    {
+        std::lock_guard<std::mutex> lock(fpsLock_);
+        isHdiFrameRate_ = false;
+        streamingStartTime_ = GetSteadyTimeNs();
+    }
+    {
+        std::lock_guard<std::mutex> lock(frameGapLock_);
+        lastShutterTime_ = 0;
+    }
+    sptr<HStreamRepeat> sharedSource = GetSharedSource();
+    if (sharedSource != nullptr) {
+        sharedSource->StartSharedOutput(this, true);
+    }
+}
+
+void HStreamRepeat::LeaveCaptureGroup()
+{
+    HStreamCommon::LeaveCaptureGroup();
+    sptr<HStreamRepeat> sharedSource = GetSharedSource();
+    if (sharedSource != nullptr) {
+        sharedSource->StopSharedOutput(this);
+    }
+}
+
+bool HStreamRepeat::IsFrameGapMonitored()
+{
+    return isFrameGapMonitored_;
+}
+
+void HStreamRepeat::SetFirstFrameStartTime(int64_t startTime)
+{
+    firstFrameStartTime_ = startTime;
+}
+
+void HStreamRepeat::BeginReconfigure()
+{
+    std::lock_guard<std::mutex> lock(frameGapLock_);
+    isReconfiguring_ = true;
+    isReconfigureEnding_ = false;
+    reconfigureGap_ = 0;
+    reconfigureMissedFrames_ = 0;
+}
+
+void HStreamRepeat::EndReconfigure()
+{
+    std::lock_guard<std::mutex> lock(frameGapLock_);
+    isReconfigureEnding_ = isReconfiguring_;
+}
+
+void HStreamRepeat::DumpFrameGapInfo(std::string& dumpString)
+{
+    std::lock_guard<std::mutex> lock(frameGapLock_);
+    if (!isFrameGapMonitored_) {
+        return;
+    }
+    dumpString += "Frame Gap Monitor Frames:[" + std::to_string(monitoredFrames_) + "]:"
+        + " Nominal Interval(us):[" + std::to_string(frameInterval_ / NANOSECONDS_PER_MICROSECOND) + "]:"
+        + " Max Gap(us):[" + std::to_string(maxFrameGap_ / NANOSECONDS_PER_MICROSECOND) + "]:"
+        + " Missed Frames:[" + std::to_string(missedFrames_) + "]:"
+        + " Last Reconfigure Gap(us):[" + std::to_string(reconfigureGap_ / NANOSECONDS_PER_MICROSECOND) + "]:"
+        + " Last Reconfigure Missed Frames:[" + std::to_string(reconfigureMissedFrames_) + "]\n";
+}
+
+void HStreamRepeat::SetFanOut(sptr<StreamFanOut> fanOut)
+{
+    std::lock_guard<std::mutex> lock(sharedLock_);
+    fanOut_ = fanOut;
+}
+
+bool HStreamRepeat::IsSharedSource()
+{
+    std::lock_guard<std::mutex> lock(sharedLock_);
+    return fanOut_ != nullptr;
+}
+
+void HStreamRepeat::SetSharedSource(sptr<HStreamRepeat> source)
+{
+    std::lock_guard<std::mutex> lock(sharedLock_);
+    sharedSource_ = source;
+}
+
+sptr<HStreamRepeat> HStreamRepeat::GetSharedSource()
+{
+    std::lock_guard<std::mutex> lock(sharedLock_);
+    return sharedSource_;
+}
+
+int32_t HStreamRepeat::AddSharedOutput(const sptr<HStreamRepeat> &output,
+                                       const sptr<OHOS::IBufferProducer> &producer)
+{
+    std::lock_guard<std::mutex> lock(sharedLock_);
+    if (fanOut_ == nullptr || output == nullptr) {
+        return CAMERA_INVALID_STATE;
+    }
+    auto it = std::find_if(sharedOutputs_.begin(), sharedOutputs_.end(),
+        [&output](const SharedOutput &shared) { return shared.stream.GetRefPtr() == output.GetRefPtr(); });
+    if (it != sharedOutputs_.end()) {
+        // Linked again for another device, the output may come with another relay
+        fanOut_->RemoveConsumer(it->producer);
+        sharedOutputs_.erase(it);
+    }
+    int32_t ret = fanOut_->AddConsumer(producer);
+    if (ret != CAMERA_OK) {
+        MEDIA_ERR_LOG("HStreamRepeat::AddSharedOutput Failed to add output to stream %{public}d", streamId_);
+        return ret;
+    }
+    sharedOutputs_.push_back({output, producer, false});
+    return CAMERA_OK;
+}
+
+void HStreamRepeat::RemoveSharedOutput(const sptr<HStreamRepeat> &output)
+{
+    std::lock_guard<std::mutex> lock(sharedLock_);
+    auto it = std::find_if(sharedOutputs_.begin(), sharedOutputs_.end(),
+        [&output](const SharedOutput &shared) { return shared.stream.GetRefPtr() == output.GetRefPtr(); });
+    if (it == sharedOutputs_.end()) {
+        return;
+    }
+    if (fanOut_ != nullptr) {
+        fanOut_->RemoveConsumer(it->producer);
+    }
+    sharedOutputs_.erase(it);
+}
+
+int32_t HStreamRepeat::StartSharedOutput(const sptr<HStreamRepeat> &output, bool isGroupCapture)
+{
+    sptr<OHOS::IBufferProducer> producer;
+    bool isStartNeeded;
+    {
+        std::lock_guard<std::mutex> lock(sharedLock_);
+        auto it = std::find_if(sharedOutputs_.begin(), sharedOutputs_.end(),
+            [&output](const SharedOutput &shared) { return shared.stream.GetRefPtr() == output.GetRefPtr(); });
+        if (fanOut_ == nullptr || it == sharedOutputs_.end()) {
+            MEDIA_ERR_LOG("HStreamRepeat::StartSharedOutput output is not linked to stream %{public}d", streamId_);
+            return CAMERA_INVALID_STATE;
+        }
+        // Active before the request goes out so the output does not miss the first frames
+        it->isActive = true;
+        producer = it->producer;
+        fanOut_->SetConsumerActive(producer, true);
+        // A grouped request already names the source
+        isStartNeeded = !isGroupCapture && curCaptureID_ == 0;
+    }
+    int32_t ret = isStartNeeded ? Start() : CAMERA_OK;
+    if (ret != CAMERA_OK) {
+        std::lock_guard<std::mutex> lock(sharedLock_);
+        for (auto &shared : sharedOutputs_) {
+            if (shared.producer == producer) {
+                shared.isActive = false;
+            }
+        }
+        if (fanOut_ != nullptr) {
+            fanOut_->SetConsumerActive(producer, false);
+        }
+        return ret;
+    }
+    if (!isGroupCapture) {
+        output->OnSharedOutputStarted(curCaptureID_, !isStartNeeded);
+    }
+    return CAMERA_OK;
+}
+
+int32_t HStreamRepeat::StopSharedOutput(const sptr<HStreamRepeat> &output)
+{
+    uint64_t frameCount = 0;
+    bool isStopNeeded = false;
+    {
+        std::lock_guard<std::mutex> lock(sharedLock_);
+        auto it = std::find_if(sharedOutputs_.begin(), sharedOutputs_.end(),
+            [&output](const SharedOutput &shared) { return shared.stream.GetRefPtr() == output.GetRefPtr(); });
+        if (it == sharedOutputs_.end() || !it->isActive) {
+            return CAMERA_INVALID_STATE;
+        }
+        it->isActive = false;
+        if (fanOut_ != nullptr) {
+            frameCount = fanOut_->GetDeliveredFrames(it->producer);
+            fanOut_->SetConsumerActive(it->producer, false);
+        }
+        bool isAnyActive = std::any_of(sharedOutputs_.begin(), sharedOutputs_.end(),
+            [](const SharedOutput &shared) { return shared.isActive; });
+        // The HDI stream runs as long as one of its outputs does, a grouped request is stopped by the session
+        isStopNeeded = !isAnyActive && curCaptureID_ != 0 && !IsGroupCapture();
+    }
+    int32_t ret = isStopNeeded ? Stop() : CAMERA_OK;
+    output->OnSharedOutputStopped(frameCount);
+    return ret;
+}
+
+std::vector<sptr<HStreamRepeat>> HStreamRepeat::GetActiveSharedOutputs()
+{
+    std::vector<sptr<HStreamRepeat>> outputs;
+    std::lock_guard<std::mutex> lock(sharedLock_);
+    for (auto &shared : sharedOutputs_) {
+        sptr<HStreamRepeat> output = shared.stream.promote();
+        if (shared.isActive && output != nullptr) {
+            outputs.emplace_back(output);
+        }
+    }
+    return outputs;
+}
+
+void HStreamRepeat::OnSharedOutputStarted(int32_t captureId, bool isStreaming)
+{
+    curCaptureID_ = captureId;
+    {
+        std::lock_guard<std::mutex> lock(fpsLock_);
+        streamingStartTime_ = GetSteadyTimeNs();
+    }
+    {
+        std::lock_guard<std::mutex> lock(frameGapLock_);
+        lastShutterTime_ = 0;
+    }
+    if (isStreaming) {
+        // The source was already streaming, its frame started callback went out before this output joined
+        OnFrameStarted();
+    }
+}
+
+void HStreamRepeat::OnSharedOutputStopped(uint64_t frameCount)
+{
+    curCaptureID_ = 0;
+    // The source may keep streaming for other outputs, so the end of this output is reported here
+    OnFrameEnded(static_cast<int32_t>(frameCount));
+}
+
 void HStreamRepeat::DumpStreamInfo(std::string& dumpString)
 {
     dumpString += "repeat stream:\n";
     HStreamCommon::DumpStreamInfo(dumpString);
+    DumpFrameGapInfo(dumpString);
+    {
+        std::lock_guard<std::mutex> lock(sharedLock_);
+        if (fanOut_ != nullptr) {
+            fanOut_->DumpFanOutInfo(dumpString);
+        } else if (sharedSource_ != nullptr) {
+            dumpString += "Shared Source Stream Id:[" + std::to_string(sharedSource_->GetStreamId()) + "]\n";
+        }
+    }
+    std::lock_guard<std::mutex> lock(fpsLock_);
+    if (frameRelay_ != nullptr) {
+        frameRelay_->DumpRelayInfo(dumpString);
+    } else if (targetFps_ > 0) {
+        dumpString += "Target Fps:[" + std::to_string(targetFps_) + "]:"
+            + " Device Frame Rate:[" + std::to_string(isHdiFrameRate_) + "]:"
+            + " Last Achieved Fps:[" + std::to_string(lastAchievedFps_) + "]\n";
+    }
 }
 
-void HStreamRepeat::SetStreamTransform()
+int32_t HStreamRepeat::GetStreamRotation()
 {
     camera_metadata_item_t item;
     int ret = OHOS::Camera::FindCameraMetadataItem(cameraAbility_->get(), OHOS_SENSOR_ORIENTATION, &item);
     if (ret != CAM_META_SUCCESS) {
-        MEDIA_ERR_LOG("HStreamRepeat::SetStreamTransform get sensor orientation failed");
-        return;
+        MEDIA_ERR_LOG("HStreamRepeat::GetStreamRotation get sensor orientation failed");
+        return 0;
     }
     int32_t sensorOrientation = item.data.i32[0];
-    MEDIA_INFO_LOG("HStreamRepeat::SetStreamTransform sensor orientation %{public}d", sensorOrientation);
+    MEDIA_INFO_LOG("HStreamRepeat::GetStreamRotation sensor orientation %{public}d", sensorOrientation);
     auto display = OHOS::Rosen::DisplayManager::GetInstance().GetDefaultDisplay();
-    if (display->GetWidth() < display->GetHeight()) {
-        ret = SurfaceError::SURFACE_ERROR_OK;
-        int32_t streamRotation = STREAM_ROTATE_360 - sensorOrientation;
+    if (display == nullptr || display->GetWidth() >= display->GetHeight()) {
+        return 0;
+    }
+    return (STREAM_ROTATE_360 - sensorOrientation) % STREAM_ROTATE_360;
+}
+
+void HStreamRepeat::SetStreamTransform()
+{
+    softwareRotation_ = 0;
+    if (producer_ == nullptr) {
+        return;
+    }
+    int32_t streamRotation = GetStreamRotation();
+    if (streamRotation != 0) {
+        int32_t ret = SurfaceError::SURFACE_ERROR_OK;
         switch (streamRotation) {
             case STREAM_ROTATE_90: {
                 ret = producer_->SetTransform(ROTATE_90);
@@ -232,7 +827,9 @@ void HStreamRepeat::SetStreamTransform()
         }
         MEDIA_INFO_LOG("HStreamRepeat::SetStreamTransform rotate %{public}d", streamRotation);
         if (ret != SurfaceError::SURFACE_ERROR_OK) {
-            MEDIA_ERR_LOG("HStreamRepeat::SetStreamTransform failed %{public}d", ret);
+            // The frame relay rotates the frames instead, the client then gets them upright
+            MEDIA_ERR_LOG("HStreamRepeat::SetStreamTransform failed %{public}d, rotating in the service", ret);
+            softwareRotation_ = streamRotation;
         }
     }
 }